@@ -3,17 +3,32 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "systems/logging.h"
 #include "systems/timer.h"
+#include "systems/jobSystem.h"
+#include "systems/fixedTimestep.h"
+#include "systems/frameLimiter.h"
+#include "systems/frameStats.h"
+#include "systems/frameAllocator.h"
+#include "systems/memoryTracker.h"
+#include "systems/powerPolicy.h"
+#include "systems/latencyStats.h"
+#include "systems/deferredScheduler.h"
+#include "systems/task.h"
 
 #include "events/event.h"
 #include "events/eventDispatcher.h"
+#include "events/eventDispatchTable.h"
+#include "events/eventQueue.h"
 #include "events/keyEvents.h"
 #include "events/mouseEvents.h"
 #include "events/windowEvents.h"
 #include "events/codes.h"
 #include "events/inputPoller.h"
+#include "events/inputState.h"
+#include "events/inputRecorder.h"
 
 #include "windows/window.h"
 
@@ -21,6 +36,20 @@
 
 namespace Engine {
 
+	/**\ Struct ApplicationProperties
+	*	 How the application runs, set before it is created. Read from the command line by the entry point
+	*/
+	struct ApplicationProperties
+	{
+		bool headless = false; //!< Null window and render API, no GPU needed. Always on when there's no window system for the platform
+		uint32_t frameCount = 0; //!< Frames to run before closing, 0 runs until the window is closed
+		std::string recordPath; //!< Input and frame times are recorded to this file when set
+		std::string replayPath; //!< A recording to play back in place of live input and time, the run ends with it. Takes precedence over recording
+		LatencySettings latency;
+
+		static ApplicationProperties fromCommandLine(int argc, char** argv); //!< --headless, --frames N, --record file, --replay file, --low-latency, --gpu-sync
+	};
+
 	/**\Class Application
 	*	Fundemental class of the engine. A singleton which runs the game loop infinitely. Provides:
 	*	Event management
@@ -39,13 +68,25 @@ namespace Engine {
 
 		std::shared_ptr<logging> m_Log; //!< Logging object that can output information to the console
 		std::shared_ptr<timer> m_Timer; //!< Timer object records timeframes and calculates timesteps
+		std::shared_ptr<jobSystem> m_jobSystem; //!< Worker threads for jobs, one per core
+		FixedTimestep m_fixedTimestep{ 60.0, 5 }; //!< Simulation tick rate and catch up cap, rendering runs as fast as it likes
+		FrameLimiter m_frameLimiter; //!< Off by default, setTargetRate() caps the frame rate without vsync
+		FrameStats m_frameStats; //!< Frame times over the last 240 frames
+		PowerPolicy m_powerPolicy; //!< Throttles drawing when the window is unfocused or minimised, sets the frame limiter's rate
+		LatencySettings m_latencySettings;
+		LatencyStats m_latencyStats; //!< Input to present, measured every frame
+		DeferredScheduler m_deferredWork; //!< Run on the main thread in the slack before each frame is handed over
+		DeferredScheduler m_renderWork; //!< Run on the render thread at the end of each frame, for work that needs the context
 
 
 		std::shared_ptr<System> m_windowsSystem; //!< System class for the window. Start/stop interface
 		std::unique_ptr<Window> m_Window; //!< A single instance of a window
 
 
-		void onEvent(Event& e); //!< Called when an event happens
+		EventQueue m_eventQueue; //!< Window events and any posted by other threads, dispatched once a frame after polling
+		EventDispatchTable m_events; //!< The handlers below, filled in once by the constructor. The queue's bottom layer
+		InputRecorder m_inputRecorder; //!< Records or replays the input, see ApplicationProperties
+		void onEvent(Event& e); //!< Called by the window when an event happens, queues it
 		/**\ Key events */
 		bool onKeyPressed(KeyPressedEvent& e);
 		bool onKeyReleased(KeyReleasedEvent& e);
@@ -63,17 +104,11 @@ namespace Engine {
 		bool onWindowResize(WindowResizeEvent& e);
 	private:
 		static Application* s_instance; //!< Singleton instance of the application
+		static ApplicationProperties s_properties; //!< Set before the application is created
 		bool m_Running = true; //!< Bool controls application loop
 
-		bool m_directionKeyPressed[4] = { false, false, false, false }; //!< Boolean set depending on whether the direction keys are pressed. {up, dowm, left, right}
-
-		bool m_spacePressed = false; //!< Boolean set to true if a key is held down or false if released
 		int m_currentCamPos = 0; //!< Index of camera position
 
-		bool m_mouseButton1Pressed = false; //!< Boolean set to true if left mouse button is held down or false if released
-		glm::vec2 m_mousePosCurrent = { 0,0 };
-		glm::vec2 m_mousePosStart = { 0,0 };
-
 		float m_badgeRotation = 0.f; //!< Stores th fps badge rotation to be updated every frame
 
 		std::shared_ptr<rp3d::DynamicsWorld> m_worldInstance;
@@ -81,6 +116,15 @@ namespace Engine {
 	public:
 		virtual ~Application(); //!< Deconstructor
 		inline static Application& getInstance() { return *s_instance; } //!< Returns instance from singleton pattern
+		inline static void setProperties(const ApplicationProperties& arg_properties) { s_properties = arg_properties; } //!< Before startApplication()
+		inline static const ApplicationProperties& getProperties() { return s_properties; }
+		inline EventQueue& getEventQueue() { return m_eventQueue; } //!< Post to it from anywhere, push a layer to see events before the application
+		inline PowerPolicy& getPowerPolicy() { return m_powerPolicy; } //!< i.e. on demand drawing for tools, which markDirty() when they change something
+		void setLatencySettings(const LatencySettings& arg_settings); //!< Takes effect from the next frame
+		inline const LatencySettings& getLatencySettings() const { return m_latencySettings; }
+		inline const LatencyStats& getLatencyStats() const { return m_latencyStats; }
+		inline DeferredScheduler& getDeferredWork() { return m_deferredWork; } //!< Post work that can wait a few frames, from any thread
+		inline DeferredScheduler& getRenderWork() { return m_renderWork; } //!< The same, run with the graphics context current
 		void run(); //!< Main loop
 	};
 
@@ -10,6 +10,7 @@ extern Engine::Application* Engine::startApplication();
 */
 int main(int argc, char** argv)
 {
+	Engine::Application::setProperties(Engine::ApplicationProperties::fromCommandLine(argc, argv)); //!< i.e. --headless --frames 10000 for a soak run without a GPU
 	auto application = Engine::startApplication(); //!< Creates an application object
 	application->run(); //!< Calls application.run() which subsiquently initiallizes the necessary code, before running the event loop
 	delete application; //!< Once the event loop has closed in application, and it can close, entrypoint deletes application.
@@ -0,0 +1,66 @@
+/** \file archetype.h */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ecs/entity.h"
+
+namespace Engine {
+	/**\ Class Archetype
+	*	 Every entity with exactly the same set of components, packed into fixed size chunks.
+	*	 Inside a chunk each component type has its own array (structure of arrays) starting on a cache line,
+	*	 so a query only pulls the components it asks for through the cache.
+	*	 Rows are kept dense: removing one moves the last row into the gap, so every chunk but the last is full.
+	*/
+	class Archetype
+	{
+	public:
+		Archetype(ComponentMask arg_mask, uint32_t arg_chunkBytes);
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+
+		uint32_t addRow(Entity arg_entity); //!< The new row's components are left uninitialised
+		Entity removeRow(uint32_t arg_row); //!< Returns the entity moved into the row, or a null entity if it was the last row
+
+		inline bool hasComponent(ComponentID arg_id) const { return (m_mask >> arg_id) & 1; }
+		inline void* getComponent(uint32_t arg_row, ComponentID arg_id)
+		{
+			return m_chunks[arg_row / m_chunkCapacity].data + m_offsets[m_columns[arg_id]] + static_cast<size_t>(arg_row % m_chunkCapacity) * m_sizes[m_columns[arg_id]];
+		}
+		inline uint32_t getComponentSize(ComponentID arg_id) const { return m_sizes[m_columns[arg_id]]; }
+		inline Entity getEntity(uint32_t arg_row) const { return getEntities(arg_row / m_chunkCapacity)[arg_row % m_chunkCapacity]; }
+
+		/**\ Chunk access, for iterating */
+		inline uint32_t getChunkCount() const { return (m_count + m_chunkCapacity - 1) / m_chunkCapacity; } //!< Chunks in use, empty ones are kept for reuse
+		inline uint32_t getChunkSize(uint32_t arg_chunk) const { return arg_chunk + 1 < getChunkCount() ? m_chunkCapacity : m_count - arg_chunk * m_chunkCapacity; }
+		inline const Entity* getEntities(uint32_t arg_chunk) const { return reinterpret_cast<const Entity*>(m_chunks[arg_chunk].data); }
+		template <typename T>
+		inline T* getArray(uint32_t arg_chunk) { return reinterpret_cast<T*>(m_chunks[arg_chunk].data + m_offsets[m_columns[ComponentRegistry::getID<T>()]]); }
+
+		inline ComponentMask getMask() const { return m_mask; }
+		inline const std::vector<ComponentID>& getTypes() const { return m_types; }
+		inline uint32_t getCount() const { return m_count; }
+		inline uint32_t getChunkCapacity() const { return m_chunkCapacity; } //!< Entities per chunk
+
+		/**\ The archetype with one component added or removed, filled in by the World the first time that move happens */
+		inline Archetype*& getEdge(ComponentID arg_id) { return m_edges[arg_id]; }
+	private:
+		struct Chunk
+		{
+			std::unique_ptr<unsigned char[]> memory;
+			unsigned char* data; //!< memory rounded up to a cache line
+		};
+
+		ComponentMask m_mask;
+		std::vector<ComponentID> m_types; //!< In ID order
+		std::vector<uint32_t> m_offsets; //!< Byte offset of each type's array in a chunk, entities are at 0
+		std::vector<uint32_t> m_sizes;
+		uint8_t m_columns[s_maxComponentTypes]; //!< Component ID to index in m_types
+		uint32_t m_chunkCapacity;
+		uint32_t m_chunkBytes;
+		uint32_t m_count = 0;
+		std::vector<Chunk> m_chunks;
+		Archetype* m_edges[s_maxComponentTypes] = {};
+	};
+}
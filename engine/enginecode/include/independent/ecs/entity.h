@@ -0,0 +1,57 @@
+/** \file entity.h */
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace Engine {
+	/**\ Handle to an entity in a World. The generation changes when the slot is reused, so an old handle can't reach the new entity */
+	struct Entity
+	{
+		uint32_t index = 0;
+		uint32_t generation = 0; //!< 0 is never used by a live entity, so Entity() is always null
+
+		inline bool isNull() const { return generation == 0; }
+		inline bool operator==(const Entity& arg_other) const { return index == arg_other.index && generation == arg_other.generation; }
+		inline bool operator!=(const Entity& arg_other) const { return !(*this == arg_other); }
+
+		inline uint64_t toKey() const { return (static_cast<uint64_t>(generation) << 32) | index; } //!< Both halves in one number, i.e. for DynamicBVH user data
+		inline static Entity fromKey(uint64_t arg_key) { return { static_cast<uint32_t>(arg_key), static_cast<uint32_t>(arg_key >> 32) }; }
+	};
+
+	using ComponentID = uint32_t;
+	using ComponentMask = uint64_t; //!< One bit per component type
+	constexpr uint32_t s_maxComponentTypes = 64;
+
+	/**\ Size and alignment of a component type, all the archetype chunks need to lay it out */
+	struct ComponentInfo
+	{
+		uint32_t size;
+		uint32_t alignment;
+	};
+
+	/**\ Class ComponentRegistry
+	*	 Gives each component type a small ID the first time it is used. IDs are shared by every World.
+	*	 Components are moved between chunks with memcpy and never have their destructors run, so they have to be trivially copyable.
+	*	 Resources are held by pointer or handle, i.e. the VertexArray* a mesh points at is owned by the scene's loader.
+	*/
+	class ComponentRegistry
+	{
+	public:
+		template <typename T>
+		static ComponentID getID()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Components are moved with memcpy, hold resources by pointer");
+			static const ComponentID s_id = registerType(sizeof(T), alignof(T));
+			return s_id;
+		}
+
+		template <typename... Ts>
+		static ComponentMask getMask() { return (ComponentMask(0) | ... | (ComponentMask(1) << getID<Ts>())); }
+
+		static ComponentInfo getInfo(ComponentID arg_id);
+	private:
+		static ComponentID registerType(uint32_t arg_size, uint32_t arg_alignment);
+	};
+}
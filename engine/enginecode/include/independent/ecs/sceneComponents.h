@@ -0,0 +1,63 @@
+/** \file sceneComponents.h */
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "systems/fixedTimestep.h"
+#include "physics/bounds.h"
+
+namespace reactphysics3d { class RigidBody; }
+
+namespace Engine {
+	class VertexArray;
+	class Material;
+
+	/**\ Where an entity is for the last two simulation ticks, drawn blended between them */
+	struct TransformComponent
+	{
+		SimTransform current;
+		SimTransform previous;
+	};
+
+	/**\ Geometry to draw. Owned by whoever loaded it and must outlive the entity */
+	struct MeshComponent
+	{
+		VertexArray* geometry = nullptr;
+	};
+
+	/**\ How to draw the mesh. Owned like the geometry */
+	struct MaterialComponent
+	{
+		Material* material = nullptr;
+		uint32_t sortKey = 0; //!< Passed on to the DrawList
+	};
+
+	/**\ Physics body whose transform is copied to the entity each tick */
+	struct RigidBodyComponent
+	{
+		reactphysics3d::RigidBody* body = nullptr;
+	};
+
+	/**\ Constant rotation, for props */
+	struct SpinComponent
+	{
+		glm::vec3 axis = glm::vec3(0.f, 1.f, 0.f); //!< Normalised
+		float speed = 1.f; //!< Radians per second
+	};
+
+	/**\ Box around the mesh in its own space, kept in the scene's DynamicBVH by SceneSystems::updateBounds */
+	struct BoundsComponent
+	{
+		AABB local;
+		uint32_t proxy = 0xFFFFFFFF; //!< Its leaf in the tree, set the first time it's updated. Remove it from the tree before destroying the entity
+	};
+
+	/**\ CPU copy of the mesh's triangles for picking, positions first in each vertex. Owned like the geometry */
+	struct PickMeshComponent
+	{
+		const float* vertices = nullptr;
+		uint32_t stride = 3; //!< Floats per vertex
+		const uint32_t* indices = nullptr;
+		uint32_t triangleCount = 0;
+	};
+}
@@ -0,0 +1,25 @@
+/** \file sceneSystems.h */
+#pragma once
+
+#include "ecs/world.h"
+#include "ecs/sceneComponents.h"
+#include "rendering/drawList.h"
+#include "physics/dynamicBVH.h"
+
+namespace Engine {
+	/**\ Class SceneSystems
+	*	 The per tick and per frame work on the scene components. Each is a query over the World.
+	*	 Tick order: storePrevious, then anything that moves entities (spin, game code, physics step), then syncRigidBodies.
+	*	 updateBounds after the ticks, before anything queries the tree.
+	*/
+	class SceneSystems
+	{
+	public:
+		static void storePrevious(World& arg_world); //!< Start of a tick, keeps the last tick's transform for blending
+		static void spin(World& arg_world, float arg_step); //!< Applies SpinComponents in parallel
+		static void syncRigidBodies(World& arg_world); //!< After the physics step, copies each body's transform to its entity
+		static void updateBounds(World& arg_world, DynamicBVH& arg_tree); //!< Moves each BoundsComponent's leaf to the entity's current transform, inserting new ones
+		static Entity pick(World& arg_world, const DynamicBVH& arg_tree, const Ray& arg_ray, float arg_maxDistance = FLT_MAX); //!< Closest entity hit, tested against its PickMeshComponent or else its bounds. Null if nothing
+		static void submitDraws(World& arg_world, DrawList& arg_drawList, float arg_alpha); //!< Every entity with a transform, mesh and material, blended by the fixed timestep's alpha
+	};
+}
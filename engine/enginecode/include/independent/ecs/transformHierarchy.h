@@ -0,0 +1,93 @@
+/** \file transformHierarchy.h */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Engine {
+	/**\ Class TransformHierarchy
+	*	 Parent/child transforms kept as local position, rotation and scale, with world matrices worked out in update().
+	*	 Node data sits in flat arrays in depth first order, so every parent comes before its children and each subtree
+	*	 is one contiguous range. update() only rebuilds the matrices of nodes that changed and everything below them,
+	*	 static scenery costs one byte check per node.
+	*	 Subtrees bigger than the grain are split at their children and the pieces run in parallel on the job system.
+	*
+	*	 Nodes are named by a handle that stays the same when the arrays are reordered.
+	*	 Adding, removing and reparenting mark the order as stale, it is rebuilt at the start of the next update().
+	*	 Not thread safe, only update() uses other threads.
+	*/
+	class TransformHierarchy
+	{
+	public:
+		using Node = uint32_t;
+		constexpr static Node s_null = 0xFFFFFFFF;
+
+		TransformHierarchy(uint32_t arg_grain = 1024) : m_grain(arg_grain) {} //!< Nodes per parallel job
+
+		Node create(Node arg_parent = s_null, const glm::vec3& arg_position = glm::vec3(0.f), const glm::quat& arg_rotation = glm::quat(1.f, 0.f, 0.f, 0.f), const glm::vec3& arg_scale = glm::vec3(1.f));
+		void destroy(Node arg_node); //!< Along with everything below it
+		bool setParent(Node arg_node, Node arg_parent); //!< Keeps the local transform. False if it would make a loop
+		inline Node getParent(Node arg_node) const { return m_links[arg_node].parent; }
+
+		inline void setPosition(Node arg_node, const glm::vec3& arg_position) { uint32_t i = m_indices[arg_node]; m_positions[i] = arg_position; m_dirty[i] = 1; }
+		inline void setRotation(Node arg_node, const glm::quat& arg_rotation) { uint32_t i = m_indices[arg_node]; m_rotations[i] = arg_rotation; m_dirty[i] = 1; }
+		inline void setScale(Node arg_node, const glm::vec3& arg_scale) { uint32_t i = m_indices[arg_node]; m_scales[i] = arg_scale; m_dirty[i] = 1; }
+		inline const glm::vec3& getPosition(Node arg_node) const { return m_positions[m_indices[arg_node]]; }
+		inline const glm::quat& getRotation(Node arg_node) const { return m_rotations[m_indices[arg_node]]; }
+		inline const glm::vec3& getScale(Node arg_node) const { return m_scales[m_indices[arg_node]]; }
+		inline const glm::mat4& getWorld(Node arg_node) const { return m_worlds[m_indices[arg_node]]; } //!< As of the last update()
+
+		void update(); //!< Rebuilds the order if needed, then the world matrices of changed subtrees
+
+		inline uint32_t getCount() const { return m_liveCount; }
+		inline uint32_t getUpdatedCount() const { return m_updatedCount; } //!< Matrices worked out by the last update()
+	private:
+		/**\ Tree structure by handle, only walked when rebuilding the order */
+		struct Links
+		{
+			Node parent = s_null;
+			Node firstChild = s_null;
+			Node nextSibling = s_null;
+		};
+
+		/**\ A subtree handed to one job */
+		struct Range
+		{
+			uint32_t begin;
+			uint32_t end;
+		};
+
+		void link(Node arg_node, Node arg_parent);
+		void unlink(Node arg_node);
+		void rebuildOrder(); //!< Depth first order, subtree sizes and the parallel split
+		void split(uint32_t arg_index); //!< Adds a subtree to the ranges, or splits it at its children if it's too big
+		uint32_t updateRange(uint32_t arg_begin, uint32_t arg_end); //!< Returns how many matrices it worked out
+
+		uint32_t m_grain;
+
+		/**\ By handle */
+		std::vector<Links> m_links;
+		std::vector<uint32_t> m_indices; //!< Handle to array index
+		std::vector<Node> m_freeNodes;
+		Node m_firstRoot = s_null;
+
+		/**\ By array index, depth first */
+		std::vector<glm::vec3> m_positions;
+		std::vector<glm::quat> m_rotations;
+		std::vector<glm::vec3> m_scales;
+		std::vector<glm::mat4> m_worlds;
+		std::vector<int32_t> m_parents; //!< Array index of the parent, -1 for roots
+		std::vector<uint32_t> m_subtreeSizes; //!< Including the node itself
+		std::vector<uint8_t> m_dirty; //!< Local transform changed since the last update. Bytes not bools, jobs write neighbouring entries
+		std::vector<uint8_t> m_changed; //!< World matrix changed in this update, read by the children
+
+		bool m_orderStale = false;
+		std::vector<uint32_t> m_serial; //!< Ancestors of the split subtrees, worked out first in order
+		std::vector<Range> m_ranges;
+		uint32_t m_liveCount = 0;
+		uint32_t m_updatedCount = 0;
+	};
+}
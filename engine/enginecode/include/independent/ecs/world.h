@@ -0,0 +1,151 @@
+/** \file world.h */
+#pragma once
+
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ecs/entity.h"
+#include "ecs/archetype.h"
+#include "systems/jobSystem.h"
+
+namespace Engine {
+	/**\ Class World
+	*	 Entities and their components, stored by archetype (see Archetype).
+	*	 Adding or removing a component moves the entity's row to the archetype for its new set of components.
+	*	 Queries walk the matching archetypes chunk by chunk, handing out the component arrays directly.
+	*
+	*	 Not thread safe for structural changes: create, destroy, add and remove from one thread, and never
+	*	 while a query is running. Components can be written from any number of threads in parallelForEach,
+	*	 each chunk goes to one job.
+	*/
+	class World
+	{
+	public:
+		World(uint32_t arg_chunkBytes = 16 * 1024) : m_chunkBytes(arg_chunkBytes) {}
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+
+		/**\ Makes an entity with the components given */
+		template <typename... Ts>
+		Entity create(const Ts&... arg_components)
+		{
+			Entity entity = allocateEntity();
+			Archetype* archetype = getArchetype(ComponentRegistry::getMask<Ts...>());
+			Record& record = m_records[entity.index];
+			record.archetype = archetype;
+			record.row = archetype->addRow(entity);
+			(new (archetype->getComponent(record.row, ComponentRegistry::getID<Ts>())) Ts(arg_components), ...);
+			return entity;
+		}
+		void destroy(Entity arg_entity); //!< Does nothing for a dead entity
+		inline bool isAlive(Entity arg_entity) const { return arg_entity.index < m_records.size() && m_records[arg_entity.index].generation == arg_entity.generation && !arg_entity.isNull(); }
+		inline uint32_t getCount() const { return m_liveCount; }
+
+		/**\ Adds a component, or overwrites it if the entity already has one */
+		template <typename T>
+		void add(Entity arg_entity, const T& arg_component = T())
+		{
+			if (!isAlive(arg_entity)) return;
+			ComponentID id = ComponentRegistry::getID<T>();
+			Record& record = m_records[arg_entity.index];
+			if (!record.archetype->hasComponent(id)) move(arg_entity, getNeighbour(record.archetype, id));
+			new (record.archetype->getComponent(record.row, id)) T(arg_component);
+		}
+		template <typename T>
+		void remove(Entity arg_entity)
+		{
+			ComponentID id = ComponentRegistry::getID<T>();
+			if (has<T>(arg_entity)) move(arg_entity, getNeighbour(m_records[arg_entity.index].archetype, id));
+		}
+		template <typename T>
+		inline bool has(Entity arg_entity) const { return isAlive(arg_entity) && m_records[arg_entity.index].archetype->hasComponent(ComponentRegistry::getID<T>()); }
+		/**\ nullptr if the entity is dead or doesn't have one. Only valid until the next structural change */
+		template <typename T>
+		T* get(Entity arg_entity)
+		{
+			if (!has<T>(arg_entity)) return nullptr;
+			const Record& record = m_records[arg_entity.index];
+			return static_cast<T*>(record.archetype->getComponent(record.row, ComponentRegistry::getID<T>()));
+		}
+
+		/**\ Calls func(count, entities, Ts* arrays...) for each chunk of every archetype that has all of Ts */
+		template <typename... Ts, typename F>
+		void forEachChunk(F&& arg_func)
+		{
+			ComponentMask mask = ComponentRegistry::getMask<Ts...>();
+			for (auto& archetype : m_archetypes) {
+				if ((archetype->getMask() & mask) != mask) continue;
+				for (uint32_t chunk = 0; chunk < archetype->getChunkCount(); chunk++)
+					arg_func(archetype->getChunkSize(chunk), archetype->getEntities(chunk), archetype->template getArray<Ts>(chunk)...);
+			}
+		}
+
+		/**\ Calls func(Ts&...) for every entity that has all of Ts */
+		template <typename... Ts, typename F>
+		void forEach(F&& arg_func)
+		{
+			forEachChunk<Ts...>([&arg_func](uint32_t arg_count, const Entity* arg_entities, Ts*... arg_arrays) {
+				for (uint32_t i = 0; i < arg_count; i++) arg_func(arg_arrays[i]...);
+			});
+		}
+
+		/**\ forEach spread over the job system, a batch of chunks per job. Waits for all of them */
+		template <typename... Ts, typename F>
+		void parallelForEach(F&& arg_func, uint32_t arg_chunksPerJob = 1)
+		{
+			ComponentMask mask = ComponentRegistry::getMask<Ts...>();
+			m_chunkRefs.clear();
+			for (auto& archetype : m_archetypes) {
+				if ((archetype->getMask() & mask) != mask) continue;
+				for (uint32_t chunk = 0; chunk < archetype->getChunkCount(); chunk++) m_chunkRefs.push_back({ archetype.get(), chunk });
+			}
+
+			jobSystem::parallelFor(static_cast<uint32_t>(m_chunkRefs.size()), arg_chunksPerJob, [this, &arg_func](uint32_t arg_begin, uint32_t arg_end) {
+				for (uint32_t ref = arg_begin; ref < arg_end; ref++) {
+					Archetype* archetype = m_chunkRefs[ref].archetype;
+					uint32_t chunk = m_chunkRefs[ref].chunk;
+					uint32_t count = archetype->getChunkSize(chunk);
+					invokeRows<Ts...>(arg_func, count, archetype->template getArray<Ts>(chunk)...);
+				}
+			});
+		}
+
+		inline uint32_t getArchetypeCount() const { return static_cast<uint32_t>(m_archetypes.size()); }
+	private:
+		/**\ Where an entity's components live */
+		struct Record
+		{
+			Archetype* archetype = nullptr;
+			uint32_t row = 0;
+			uint32_t generation = 1;
+		};
+
+		struct ChunkRef
+		{
+			Archetype* archetype;
+			uint32_t chunk;
+		};
+
+		template <typename... Ts, typename F>
+		static void invokeRows(F& arg_func, uint32_t arg_count, Ts*... arg_arrays)
+		{
+			for (uint32_t i = 0; i < arg_count; i++) arg_func(arg_arrays[i]...);
+		}
+
+		Entity allocateEntity();
+		Archetype* getArchetype(ComponentMask arg_mask); //!< Made the first time a set of components is seen
+		Archetype* getNeighbour(Archetype* arg_archetype, ComponentID arg_id); //!< With the component's bit flipped, cached on the archetype
+		void move(Entity arg_entity, Archetype* arg_destination); //!< Copies the components both archetypes have, the rest are dropped or left uninitialised
+
+		uint32_t m_chunkBytes;
+		std::vector<std::unique_ptr<Archetype>> m_archetypes;
+		std::unordered_map<ComponentMask, Archetype*> m_archetypeLookup;
+		std::vector<Record> m_records; //!< Indexed by Entity::index
+		std::vector<uint32_t> m_freeIndices;
+		uint32_t m_liveCount = 0;
+		std::vector<ChunkRef> m_chunkRefs; //!< Reused by parallelForEach
+	};
+}
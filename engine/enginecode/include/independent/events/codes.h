@@ -2,7 +2,6 @@
 #pragma once
 
 /**\ This file simply includes files that convert api specific keycodes to simplified difinitions
+*	 Headless builds on other platforms use the GLFW values too, the null input poller never reports a key so any values will do
 */
-#ifdef NG_PLATFORM_WINDOWS
 #include "platform/windows/GLFWCodes.h"
-#endif // NG_PLATFORM_WINDOWS
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace Engine {
 
 	/**\ Enum Class 
@@ -38,11 +40,14 @@ namespace Engine {
 	{
 	private:
 		bool m_handled = false;
+		uint64_t m_time = 0;
 	public:
 		virtual EventType getEventType() const = 0; //!< Get the event type
 		virtual int getCategoryFlags() const = 0; //!< Get the event category
 		inline bool handled() const { return m_handled; } //!< Has the event been handled
 		inline void handle(bool isHandled) { m_handled = isHandled; } //!< Handles the event
+		inline uint64_t getTime() const { return m_time; } //!< timer::now() when it was queued, 0 if it never was
+		inline void setTime(uint64_t arg_time) { m_time = arg_time; }
 		inline bool isInCategory(EventCategory category) { return getCategoryFlags() & category; } //!< Is this event in the category?
 	};
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**\ file eventDispatchTable.h */
+#pragma once
+
+#include <cstdint>
+
+#include "event.h"
+
+namespace Engine {
+	/**\ Class EventDispatchTable
+	*	 Handlers registered once, indexed by EventType, so dispatching an event is one virtual call for its type,
+	*	 a table lookup and a direct call to each handler. Nothing is allocated, either when adding or dispatching.
+	*	 The handler is a template argument and is called through a small function made for it, which the compiler
+	*	 can inline the handler into:
+	*		m_events.add<&Application::onWindowClose>(this);
+	*		m_events.add<&onResize>();
+	*	 Handlers have the same form as for EventDispatcher, bool(T&) for an event type T, returning whether they handled it.
+	*/
+	class EventDispatchTable
+	{
+	public:
+		constexpr static uint32_t s_typeCount = static_cast<uint32_t>(EventType::MouseScrolled) + 1;
+		constexpr static uint32_t s_maxHandlers = 4; //!< Per event type
+		constexpr static int s_allCategories = -1;
+
+		/**\ Adds a member function handler. Returns false if the event type already has s_maxHandlers */
+		template <auto Handler, typename Owner>
+		bool add(Owner* arg_owner)
+		{
+			using T = typename HandlerTraits<decltype(Handler)>::EventT;
+			return addEntry(T::getStaticType(), &callMember<T, Owner, Handler>, arg_owner);
+		}
+
+		/**\ Adds a free or static function handler */
+		template <auto Handler>
+		bool add()
+		{
+			using T = typename HandlerTraits<decltype(Handler)>::EventT;
+			return addEntry(T::getStaticType(), &callFree<T, Handler>, nullptr);
+		}
+
+		/**\ Removes every handler with this owner, i.e. before it is destroyed */
+		void remove(const void* arg_owner)
+		{
+			for (auto& slot : m_slots) {
+				uint32_t kept = 0;
+				for (uint32_t i = 0; i < slot.count; i++) {
+					if (slot.handlers[i].owner != arg_owner) slot.handlers[kept++] = slot.handlers[i];
+				}
+				slot.count = kept;
+			}
+		}
+
+		/**\ Runs the handlers for the event's type in the order they were added, until one handles it.
+		*	 Returns whether there were any to run, as EventDispatcher::dispatch does
+		*/
+		bool dispatch(Event& arg_event) const
+		{
+			const Slot& slot = m_slots[static_cast<uint32_t>(arg_event.getEventType())];
+			if (!slot.count) return false;
+			if (m_categories != s_allCategories && !(arg_event.getCategoryFlags() & m_categories)) return false;
+			for (uint32_t i = 0; i < slot.count; i++) {
+				arg_event.handle(slot.handlers[i].call(slot.handlers[i].owner, arg_event));
+				if (arg_event.handled()) break;
+			}
+			return true;
+		}
+
+		inline void setCategories(int arg_categories) { m_categories = arg_categories; } //!< EventCategory flags to dispatch, others are ignored
+		inline int getCategories() const { return m_categories; }
+		inline uint32_t getHandlerCount(EventType arg_type) const { return m_slots[static_cast<uint32_t>(arg_type)].count; }
+	private:
+		using CallFunc = bool(*)(void*, Event&);
+
+		struct Entry
+		{
+			CallFunc call;
+			void* owner;
+		};
+
+		struct Slot
+		{
+			Entry handlers[s_maxHandlers];
+			uint32_t count = 0;
+		};
+
+		template <typename F> struct HandlerTraits;
+		template <typename T, typename Owner> struct HandlerTraits<bool(Owner::*)(T&)> { using EventT = T; };
+		template <typename T> struct HandlerTraits<bool(*)(T&)> { using EventT = T; };
+
+		template <typename T, typename Owner, auto Handler>
+		static bool callMember(void* arg_owner, Event& arg_event) { return (static_cast<Owner*>(arg_owner)->*Handler)(static_cast<T&>(arg_event)); }
+		template <typename T, auto Handler>
+		static bool callFree(void*, Event& arg_event) { return Handler(static_cast<T&>(arg_event)); }
+
+		bool addEntry(EventType arg_type, CallFunc arg_call, void* arg_owner)
+		{
+			Slot& slot = m_slots[static_cast<uint32_t>(arg_type)];
+			if (slot.count == s_maxHandlers) return false;
+			slot.handlers[slot.count++] = { arg_call, arg_owner };
+			return true;
+		}
+
+		Slot m_slots[s_typeCount];
+		int m_categories = s_allCategories;
+	};
+}
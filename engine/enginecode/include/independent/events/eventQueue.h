@@ -0,0 +1,89 @@
+/**\ file eventQueue.h */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#include "event.h"
+#include "eventDispatchTable.h"
+#include "systems/mpscRing.h"
+#include "systems/timer.h"
+
+namespace Engine {
+	/**\ Struct EventRecord
+	*	 One queued event, copied by value into the ring
+	*/
+	struct alignas(64) EventRecord
+	{
+		constexpr static size_t s_storageSize = 48;
+
+		std::atomic<uint64_t> sequence; //!< Ring bookkeeping, see MPSCRing
+		EventType type;
+		alignas(16) unsigned char storage[s_storageSize]; //!< The event, constructed in place
+
+		Event& get(); //!< The event as its own type, seen through its base
+	};
+
+	/**\ Class EventQueue
+	*	 Events posted from any thread, stored by value in a lock free ring and dispatched together on the main thread
+	*	 by dispatch(), once a frame. The window's callbacks post into it while it is polled, so nothing runs in the middle
+	*	 of glfwPollEvents, and a job can post to the main thread without a lock.
+	*
+	*	 Each event goes to the layers from the last pushed to the first until one handles it, so an overlay pushed over
+	*	 the game sees input first. Runs of the same coalesced event type, mouse moves and window moves and resizes by
+	*	 default, are dispatched as their last event alone. Events posted by a handler wait for the next dispatch().
+	*	 Each event is stamped with the time it was posted.
+	*/
+	class EventQueue
+	{
+	public:
+		constexpr static uint32_t s_maxLayers = 8;
+
+		EventQueue(uint32_t arg_capacity = 1024); //!< Events that can wait at once, a power of two
+
+		/**\ Copies the event into the queue, from any thread. False when the queue is full and the event is dropped */
+		template <typename T>
+		bool post(const T& arg_event)
+		{
+			static_assert(std::is_base_of_v<Event, T> && sizeof(T) <= EventRecord::s_storageSize && alignof(T) <= 16, "Not an event that fits in an EventRecord");
+			static_assert(std::is_trivially_destructible_v<T>, "Queued events are never destroyed");
+			uint64_t ticket;
+			EventRecord* record = m_ring.tryClaim(ticket);
+			if (!record) {
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			record->type = T::getStaticType();
+			new (record->storage) T(arg_event);
+			reinterpret_cast<T*>(record->storage)->handle(false);
+			reinterpret_cast<T*>(record->storage)->setTime(timer::now()); //!< For measuring input latency
+			m_ring.publish(*record, ticket);
+			return true;
+		}
+		bool post(const Event& arg_event); //!< For an event only known through its base, i.e. in the window callback
+
+		/**\ Main thread. Dispatches what was posted before the call, returns how many events went to the layers */
+		uint32_t dispatch();
+		/**\ Main thread. Sends one event to the layers now, without queueing or coalescing, i.e. a replayed one */
+		void send(Event& arg_event);
+
+		bool pushLayer(EventDispatchTable& arg_layer); //!< Dispatched to before the layers already pushed. False if there are s_maxLayers
+		void removeLayer(EventDispatchTable& arg_layer);
+
+		inline void setCoalesced(EventType arg_type, bool arg_coalesced) { m_coalesced[static_cast<uint32_t>(arg_type)] = arg_coalesced; }
+		inline bool isCoalesced(EventType arg_type) const { return m_coalesced[static_cast<uint32_t>(arg_type)]; }
+
+		inline uint32_t getCapacity() const { return m_ring.getCapacity(); }
+		inline uint64_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+		inline uint64_t getCoalescedCount() const { return m_coalescedCount; } //!< Events skipped for a later one of their type
+	private:
+		MPSCRing<EventRecord> m_ring;
+		EventDispatchTable* m_layers[s_maxLayers];
+		uint32_t m_layerCount = 0;
+		bool m_coalesced[EventDispatchTable::s_typeCount] = {};
+		std::atomic<uint64_t> m_dropped{ 0 };
+		uint64_t m_coalescedCount = 0;
+	};
+}
@@ -0,0 +1,103 @@
+/**\ file inputRecorder.h */
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "eventDispatchTable.h"
+#include "eventQueue.h"
+#include "keyEvents.h"
+#include "mouseEvents.h"
+#include "windowEvents.h"
+
+namespace Engine {
+	/**\ Class InputRecorder
+	*	 Records the input events dispatched each frame, with the frame's simulation time, to a small binary file,
+	*	 and plays them back. A replay sends the same events to the event queue's layers at the same point in the
+	*	 same frames, and its getTime() is the clock the FixedTimestep reads, so every frame runs the same ticks on
+	*	 the same input and the simulation comes out bit for bit the same, at any frame rate and with or without a window.
+	*
+	*	 Recording: startRecording(), push getLayer() onto the queue above everything else, call endFrame() after
+	*	 each dispatch. Replaying: startReplay(), call beginFrame() before the simulation and sendEvents() in the
+	*	 event phase, and drop live input while isReplaying(). Input events are recorded, and of the window events only
+	*	 resizes: they aren't replayed to the queue, the live window has its own size, but the replay's getWindowWidth()
+	*	 and getWindowHeight() follow them, so mapping the mouse into the scene sees the size the recording had.
+	*	 Main thread only.
+	*
+	*	 The file is a header with the window size, then one record a frame: the frame time in nanoseconds and the event
+	*	 count as varints, then each event's type byte and fields. A frame with no input is two or three bytes.
+	*	 A write that fails is logged and ends the recording.
+	*/
+	class InputRecorder
+	{
+	public:
+		constexpr static uint32_t s_magic = 0x5249474E; //!< "NGIR" in the file, the header is written little endian
+		constexpr static uint32_t s_version = 2; //!< 2 added the window size and resizes
+
+		InputRecorder();
+		~InputRecorder(); //!< Closes any recording
+
+		bool startRecording(const std::string& arg_path, uint32_t arg_windowWidth, uint32_t arg_windowHeight); //!< False if the file can't be created
+		bool startReplay(const std::string& arg_path); //!< Reads the whole file, false if it can't be read or isn't a recording
+		void stop(); //!< Ends a recording or replay, the file is complete once this returns
+
+		/**\ Recording */
+		inline EventDispatchTable& getLayer() { return m_layer; } //!< Never handles an event, so the layers below still see them
+		void endFrame(uint64_t arg_frameTime); //!< Writes the frame, with the nanoseconds the simulation advanced by
+
+		/**\ Replaying */
+		bool beginFrame(); //!< Reads the next frame and moves getTime() on by its frame time. False when the recording has run out
+		void sendEvents(EventQueue& arg_queue); //!< The frame's events to the queue's layers, in the order they were recorded
+		inline uint64_t getTime() const { return m_time; } //!< Nanoseconds of recorded frame time so far, the replay's clock
+		inline uint32_t getWindowWidth() const { return m_windowWidth; } //!< The recorded window size, as of the events sent so far
+		inline uint32_t getWindowHeight() const { return m_windowHeight; }
+
+		inline bool isRecording() const { return m_mode == Mode::Record; }
+		inline bool isReplaying() const { return m_mode == Mode::Replay; }
+		inline uint64_t getFrameCount() const { return m_frameCount; } //!< Recorded or replayed so far
+	private:
+		enum class Mode { Off, Record, Replay };
+
+		/**\ An input event as it is stored, whatever its type */
+		struct StoredEvent
+		{
+			EventType type;
+			int32_t code; //!< Key or button, or width
+			int32_t repeatCount; //!< Or height
+			float x, y; //!< Mouse position or scroll offset
+		};
+
+		template <typename T>
+		bool onEvent(T& e) { m_events.push_back(store(e)); return false; }
+
+		static StoredEvent store(const KeyPressedEvent& e) { return { EventType::KeyPressed, e.GetKeyCode(), e.GetRepeatCount(), 0.f, 0.f }; }
+		static StoredEvent store(const KeyReleasedEvent& e) { return { EventType::KeyReleased, e.GetKeyCode(), 0, 0.f, 0.f }; }
+		static StoredEvent store(const KeyTypedEvent& e) { return { EventType::KeyTyped, e.GetKeyCode(), 0, 0.f, 0.f }; }
+		static StoredEvent store(const MouseButtonPressedEvent& e) { return { EventType::MouseButtonPressed, static_cast<int32_t>(e.getButton()), 0, 0.f, 0.f }; }
+		static StoredEvent store(const MouseButtonReleasedEvent& e) { return { EventType::MouseButtonReleased, static_cast<int32_t>(e.getButton()), 0, 0.f, 0.f }; }
+		static StoredEvent store(const MouseMovedEvent& e) { return { EventType::MouseMoved, 0, 0, e.getX(), e.getY() }; }
+		static StoredEvent store(const MouseScrolledEvent& e) { return { EventType::MouseScrolled, 0, 0, e.getXOffset(), e.getYOffset() }; }
+		static StoredEvent store(const WindowResizeEvent& e) { return { EventType::WindowResize, e.getWidth(), e.getHeight(), 0.f, 0.f }; }
+
+		void writeVarint(uint64_t arg_value);
+		void writeFloat(float arg_value);
+		bool readVarint(uint64_t& arg_value);
+		bool readFloat(float& arg_value);
+		bool checkWrite(); //!< Logs and ends the recording if the file has failed
+
+		Mode m_mode = Mode::Off;
+		EventDispatchTable m_layer; //!< The recording handlers
+		std::vector<StoredEvent> m_events; //!< Dispatched since the last endFrame(), or read by the last beginFrame()
+		uint64_t m_frameCount = 0;
+
+		std::ofstream m_file; //!< Recording
+		std::string m_path; //!< Of the recording, for errors
+		std::vector<unsigned char> m_buffer; //!< A frame being written, or the whole recording being replayed
+		size_t m_read = 0; //!< Replay position in m_buffer
+		uint64_t m_time = 0;
+		uint32_t m_windowWidth = 0;
+		uint32_t m_windowHeight = 0;
+	};
+}
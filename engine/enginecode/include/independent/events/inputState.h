@@ -0,0 +1,79 @@
+/**\ file inputState.h */
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "eventDispatchTable.h"
+#include "keyEvents.h"
+#include "mouseEvents.h"
+
+namespace Engine {
+	/**\ Struct InputSnapshot
+	*	 The keyboard and mouse for one frame. Pressed and released are edges seen during the frame,
+	*	 so a tap that starts and ends between two frames is still a press and a release
+	*/
+	struct InputSnapshot
+	{
+		constexpr static uint32_t s_keyCount = 512; //!< Covers every NG_KEY_ code
+		constexpr static uint32_t s_buttonCount = 8;
+
+		std::bitset<s_keyCount> keysDown;
+		std::bitset<s_keyCount> keysPressed;
+		std::bitset<s_keyCount> keysReleased;
+		std::bitset<s_buttonCount> buttonsDown;
+		std::bitset<s_buttonCount> buttonsPressed;
+		std::bitset<s_buttonCount> buttonsReleased;
+		glm::vec2 mousePosition = glm::vec2(0.f);
+		glm::vec2 mouseDelta = glm::vec2(0.f); //!< Moved during the frame
+		glm::vec2 scrollDelta = glm::vec2(0.f); //!< Scrolled during the frame
+		uint64_t eventTime = 0; //!< When the frame's oldest input event was queued, 0 if there were none. For latency
+	};
+
+	/**\ Class InputState
+	*	 Input built from the event stream rather than asked of the window, one snapshot a frame. Queries read the
+	*	 snapshot, so are the same all frame and cost a bit test rather than a call into the window system.
+	*	 addHandlers() puts its handlers in a table, ahead of any others so they see every input event, and
+	*	 beginFrame() makes what they saw since the last call the current snapshot.
+	*	 setSnapshot() replaces the current one, for tests and replays. Main thread only.
+	*/
+	class InputState
+	{
+	public:
+		static void addHandlers(EventDispatchTable& arg_table); //!< They never handle an event, so the table's later handlers still run
+		static void beginFrame(); //!< The events since the last call become the current snapshot
+		static void setSnapshot(const InputSnapshot& arg_snapshot) { s_current = arg_snapshot; } //!< Replaces this frame's input
+		static void reset(); //!< Nothing down, i.e. between tests
+
+		inline static bool isDown(int arg_key) { return inRange(arg_key, InputSnapshot::s_keyCount) && s_current.keysDown[arg_key]; }
+		inline static bool wasPressed(int arg_key) { return inRange(arg_key, InputSnapshot::s_keyCount) && s_current.keysPressed[arg_key]; } //!< This frame, not counting repeats
+		inline static bool wasReleased(int arg_key) { return inRange(arg_key, InputSnapshot::s_keyCount) && s_current.keysReleased[arg_key]; }
+
+		inline static bool isMouseDown(int arg_button) { return inRange(arg_button, InputSnapshot::s_buttonCount) && s_current.buttonsDown[arg_button]; }
+		inline static bool wasMousePressed(int arg_button) { return inRange(arg_button, InputSnapshot::s_buttonCount) && s_current.buttonsPressed[arg_button]; }
+		inline static bool wasMouseReleased(int arg_button) { return inRange(arg_button, InputSnapshot::s_buttonCount) && s_current.buttonsReleased[arg_button]; }
+
+		inline static glm::vec2 getMousePosition() { return s_current.mousePosition; }
+		inline static glm::vec2 getMouseDelta() { return s_current.mouseDelta; }
+		inline static glm::vec2 getScrollDelta() { return s_current.scrollDelta; }
+
+		inline static const InputSnapshot& getSnapshot() { return s_current; }
+		inline static const InputSnapshot& getPrevious() { return s_previous; } //!< Last frame's
+	private:
+		inline static bool inRange(int arg_code, uint32_t arg_count) { return static_cast<uint32_t>(arg_code) < arg_count; } //!< Negative codes wrap round and fail too
+		inline static void noteTime(const Event& e) { if (e.getTime() && (!s_next.eventTime || e.getTime() < s_next.eventTime)) s_next.eventTime = e.getTime(); }
+
+		static bool onKeyPressed(KeyPressedEvent& e);
+		static bool onKeyReleased(KeyReleasedEvent& e);
+		static bool onMouseButtonPressed(MouseButtonPressedEvent& e);
+		static bool onMouseButtonReleased(MouseButtonReleasedEvent& e);
+		static bool onMouseMoved(MouseMovedEvent& e);
+		static bool onMouseScrolled(MouseScrolledEvent& e);
+
+		static InputSnapshot s_current;
+		static InputSnapshot s_previous;
+		static InputSnapshot s_next; //!< Being built from the events
+		static bool s_hasPosition; //!< False until the first mouse move, which has no delta
+	};
+}
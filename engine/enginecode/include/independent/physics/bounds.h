@@ -0,0 +1,76 @@
+/** \file bounds.h */
+#pragma once
+
+#include <cfloat>
+
+#include <glm/glm.hpp>
+
+namespace Engine {
+	/**\ Struct AABB
+	*	 Axis aligned box. The default one is empty (inverted), so merging anything into it gives that thing back
+	*/
+	struct AABB
+	{
+		glm::vec3 min = glm::vec3(FLT_MAX);
+		glm::vec3 max = glm::vec3(-FLT_MAX);
+
+		AABB() = default;
+		AABB(const glm::vec3& arg_min, const glm::vec3& arg_max) : min(arg_min), max(arg_max) {}
+
+		inline glm::vec3 getCentre() const { return (min + max) * 0.5f; }
+		inline glm::vec3 getExtents() const { return (max - min) * 0.5f; } //!< Half the size
+		inline float getSurfaceArea() const { glm::vec3 d = max - min; return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x); }
+
+		inline bool contains(const AABB& arg_other) const
+		{
+			return min.x <= arg_other.min.x && min.y <= arg_other.min.y && min.z <= arg_other.min.z &&
+				max.x >= arg_other.max.x && max.y >= arg_other.max.y && max.z >= arg_other.max.z;
+		}
+		inline bool overlaps(const AABB& arg_other) const
+		{
+			return min.x <= arg_other.max.x && min.y <= arg_other.max.y && min.z <= arg_other.max.z &&
+				max.x >= arg_other.min.x && max.y >= arg_other.min.y && max.z >= arg_other.min.z;
+		}
+		inline float getDistanceSquared(const glm::vec3& arg_point) const //!< 0 inside
+		{
+			glm::vec3 d = glm::max(glm::max(min - arg_point, arg_point - max), glm::vec3(0.f));
+			return glm::dot(d, d);
+		}
+
+		inline static AABB merge(const AABB& arg_a, const AABB& arg_b) { return AABB(glm::min(arg_a.min, arg_b.min), glm::max(arg_a.max, arg_b.max)); }
+		inline static AABB expand(const AABB& arg_box, float arg_margin) { return AABB(arg_box.min - glm::vec3(arg_margin), arg_box.max + glm::vec3(arg_margin)); }
+		static AABB transform(const AABB& arg_box, const glm::mat4& arg_matrix); //!< The world box around a transformed local box
+	};
+
+	/**\ Struct Ray
+	*	 Origin and direction, with the reciprocal of the direction kept for the slab tests.
+	*	 Distances along it are in units of the direction's length, normalise it for world distances
+	*/
+	struct Ray
+	{
+		glm::vec3 origin;
+		glm::vec3 direction;
+		glm::vec3 inverseDirection;
+
+		Ray(const glm::vec3& arg_origin, const glm::vec3& arg_direction) : origin(arg_origin), direction(arg_direction), inverseDirection(1.f / arg_direction.x, 1.f / arg_direction.y, 1.f / arg_direction.z) {}
+
+		inline glm::vec3 getPoint(float arg_distance) const { return origin + direction * arg_distance; }
+		static Ray transform(const Ray& arg_ray, const glm::mat4& arg_matrix); //!< Direction isn't renormalised, so distances still match the original ray
+		static Ray fromScreen(const glm::vec2& arg_pixel, const glm::vec2& arg_screenSize, const glm::mat4& arg_view, const glm::mat4& arg_projection); //!< Through a pixel (top left origin) from the near to the far plane, normalised
+	};
+
+	/**\ Struct Frustum
+	*	 Six planes facing inwards, (normal, distance) with normalised normals.
+	*	 Built from a view projection matrix with OpenGL clip space (-1 to 1 depth)
+	*/
+	struct Frustum
+	{
+		enum class Result { Outside, Intersects, Inside };
+
+		glm::vec4 planes[6]; //!< Left, right, bottom, top, near, far
+
+		static Frustum fromMatrix(const glm::mat4& arg_viewProjection);
+		Result test(const AABB& arg_box) const;
+		bool test(const glm::vec3& arg_centre, float arg_radius) const; //!< False only if the sphere is wholly outside
+	};
+}
@@ -0,0 +1,214 @@
+/** \file dynamicBVH.h */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "physics/bounds.h"
+#include "physics/intersection.h"
+
+namespace Engine {
+	/**\ Struct RayHit
+	*	 Closest thing a ray cast found. The user data is whatever was given to DynamicBVH::insert
+	*/
+	struct RayHit
+	{
+		float distance = FLT_MAX;
+		uint64_t userData = 0;
+		uint32_t proxy = 0xFFFFFFFF;
+
+		inline bool isHit() const { return proxy != 0xFFFFFFFF; }
+	};
+
+	/**\ Struct NearestHit
+	*	 One result of DynamicBVH::queryNearest
+	*/
+	struct NearestHit
+	{
+		float distanceSquared; //!< From the point to the object's box
+		uint64_t userData;
+		uint32_t proxy;
+	};
+
+	/**\ Class DynamicBVH
+	*	 Bounding volume tree over objects' world boxes, for culling, picking and proximity queries.
+	*	 One object per leaf. Leaves hold the object's box grown by a margin, so small movements don't touch the tree.
+	*
+	*	 Two ways to keep it up to date as things move:
+	*		move() takes the leaf out and reinserts it when the box leaves its margin. Best when few things move.
+	*		setBox() grows the leaf in place and refit() fixes the parents in one pass over the tree. Best when lots move.
+	*		Refitting lets the tree get looser, so refit() rebuilds it once the cost has grown past the rebuild ratio.
+	*	 rebuild() sorts the whole tree out with a binned surface area split, its top levels are built in parallel.
+	*
+	*	 Queries are const and can run from any number of threads at once, never while the tree is being changed.
+	*	 Leaves are tested against the object's own box, not the grown one.
+	*/
+	class DynamicBVH
+	{
+	public:
+		using Proxy = uint32_t;
+		constexpr static uint32_t s_null = 0xFFFFFFFF;
+
+		DynamicBVH(float arg_margin = 0.1f, float arg_rebuildRatio = 1.5f) : m_margin(arg_margin), m_rebuildRatio(arg_rebuildRatio) {}
+
+		Proxy insert(const AABB& arg_box, uint64_t arg_userData);
+		void remove(Proxy arg_proxy);
+		bool move(Proxy arg_proxy, const AABB& arg_box); //!< True if the leaf had to be reinserted
+		void setBox(Proxy arg_proxy, const AABB& arg_box); //!< Leaves the parents stale, call refit() before the next query
+		void refit(); //!< Fixes every parent box after setBox(), then rebuilds if the tree has got too loose
+		void rebuild();
+
+		inline const AABB& getBox(Proxy arg_proxy) const { return m_proxies[arg_proxy].box; }
+		inline uint64_t getUserData(Proxy arg_proxy) const { return m_proxies[arg_proxy].userData; }
+		inline uint32_t getProxyCount() const { return m_proxyCount; }
+		inline uint32_t getRebuildCount() const { return m_rebuildCount; }
+		float getCost() const; //!< Total parent box area over the root's, lower is a tighter tree
+		uint32_t getHeight() const; //!< Walks the tree, for tests and stats
+
+		/**\ Queries, the user data of each object found is added to the results */
+		void queryBox(const AABB& arg_box, std::vector<uint64_t>& arg_results) const;
+		void querySphere(const glm::vec3& arg_centre, float arg_radius, std::vector<uint64_t>& arg_results) const;
+		void queryFrustum(const Frustum& arg_frustum, std::vector<uint64_t>& arg_results) const;
+		void queryNearest(const glm::vec3& arg_point, uint32_t arg_count, std::vector<NearestHit>& arg_results) const; //!< Replaces the results, closest first
+
+		RayHit raycast(const Ray& arg_ray, float arg_maxDistance = FLT_MAX) const; //!< Against the objects' boxes
+		/**\ Calls narrowPhase(userData, ray, distance) for each object whose box the ray reaches before the closest hit so far.
+		*	 It returns true and lowers the distance if the object itself is hit, i.e. with Intersection::rayTriangles
+		*/
+		template <typename F>
+		RayHit raycast(const Ray& arg_ray, float arg_maxDistance, F&& arg_narrowPhase) const
+		{
+			return raycastLeaves(arg_ray, arg_maxDistance, [&arg_narrowPhase](const ProxyData& arg_proxy, const Ray& arg_leafRay, float& arg_distance) {
+				float entry = arg_distance;
+				return Intersection::rayBox(arg_leafRay, arg_proxy.box, entry) && arg_narrowPhase(arg_proxy.userData, arg_leafRay, arg_distance);
+			});
+		}
+
+		/**\ Many queries at once, spread over the job system */
+		void raycastBatch(const Ray* arg_rays, uint32_t arg_count, float arg_maxDistance, RayHit* arg_hits) const;
+		void queryFrustumBatch(const Frustum* arg_frustums, uint32_t arg_count, std::vector<uint64_t>* arg_results) const; //!< One results list per frustum, i.e. shadow cascades
+	private:
+		/**\ Leaves have no left child and keep their proxy in right */
+		struct Node
+		{
+			AABB box;
+			uint32_t parent = s_null;
+			uint32_t left = s_null;
+			uint32_t right = s_null;
+
+			inline bool isLeaf() const { return left == s_null; }
+		};
+
+		struct ProxyData
+		{
+			AABB box; //!< The object's own box, the leaf's is grown by the margin
+			uint64_t userData = 0;
+			uint32_t node = s_null; //!< Its leaf, null for a free proxy
+		};
+
+		struct BuildItem
+		{
+			AABB box;
+			glm::vec3 centre;
+			uint32_t proxy;
+		};
+
+		struct RayEntry
+		{
+			uint32_t node;
+			float distance; //!< Where the ray enters the node's box
+		};
+
+		/**\ Traversal stack, on the stack itself unless the tree is unusually deep */
+		template <typename T>
+		struct Stack
+		{
+			T local[64];
+			std::vector<T> overflow;
+			uint32_t size = 0;
+
+			inline bool empty() const { return size == 0; }
+			inline void push(const T& arg_value)
+			{
+				if (size < 64) local[size] = arg_value;
+				else overflow.push_back(arg_value);
+				size++;
+			}
+			inline T pop()
+			{
+				size--;
+				if (size < 64) return local[size];
+				T value = overflow.back();
+				overflow.pop_back();
+				return value;
+			}
+		};
+
+		/**\ Closest first descent, calls leafTest(proxyData, ray, distance) for each leaf reached */
+		template <typename F>
+		RayHit raycastLeaves(const Ray& arg_ray, float arg_maxDistance, F&& arg_leafTest) const
+		{
+			RayHit hit;
+			hit.distance = arg_maxDistance;
+			float entry = arg_maxDistance;
+			if (m_root == s_null || !Intersection::rayBox(arg_ray, m_nodes[m_root].box, entry)) return hit;
+
+			Stack<RayEntry> stack;
+			stack.push({ m_root, entry });
+			while (!stack.empty()) {
+				RayEntry current = stack.pop();
+				if (current.distance > hit.distance) continue; //!< Something closer was found since it was pushed
+				const Node& node = m_nodes[current.node];
+				if (node.isLeaf()) {
+					const ProxyData& proxy = m_proxies[node.right];
+					float distance = hit.distance;
+					if (arg_leafTest(proxy, arg_ray, distance) && distance <= hit.distance) {
+						hit.distance = distance;
+						hit.userData = proxy.userData;
+						hit.proxy = node.right;
+					}
+					continue;
+				}
+
+				/**\ Both children tested here, the nearer one is pushed last so it's searched first */
+				float leftEntry = hit.distance, rightEntry = hit.distance;
+				bool leftHit = Intersection::rayBox(arg_ray, m_nodes[node.left].box, leftEntry);
+				bool rightHit = Intersection::rayBox(arg_ray, m_nodes[node.right].box, rightEntry);
+				if (leftHit && rightHit) {
+					if (leftEntry < rightEntry) { stack.push({ node.right, rightEntry }); stack.push({ node.left, leftEntry }); }
+					else { stack.push({ node.left, leftEntry }); stack.push({ node.right, rightEntry }); }
+				}
+				else if (leftHit) stack.push({ node.left, leftEntry });
+				else if (rightHit) stack.push({ node.right, rightEntry });
+			}
+			return hit;
+		}
+
+		uint32_t allocateNode();
+		void freeNode(uint32_t arg_node);
+		void insertLeaf(uint32_t arg_leaf);
+		void removeLeaf(uint32_t arg_leaf);
+		void refitAncestors(uint32_t arg_node); //!< From a node up to the root
+		/**\ Items [begin, end) into the 2n - 1 nodes from node on. The bounds of their boxes and centres come from the parent's bins */
+		void buildRange(uint32_t arg_begin, uint32_t arg_end, uint32_t arg_node, uint32_t arg_parent, const AABB& arg_bounds, const AABB& arg_centres);
+		void addLeaves(uint32_t arg_node, std::vector<uint64_t>& arg_results) const; //!< Everything below a node, no tests
+
+		float m_margin;
+		float m_rebuildRatio;
+
+		std::vector<Node> m_nodes;
+		std::vector<uint32_t> m_freeNodes;
+		uint32_t m_root = s_null;
+		bool m_preOrdered = false; //!< Nodes are still in the depth first order rebuild() left them in, so refit() can sweep them backwards
+
+		std::vector<ProxyData> m_proxies;
+		std::vector<Proxy> m_freeProxies;
+		uint32_t m_proxyCount = 0;
+
+		bool m_refitNeeded = false;
+		float m_builtCost = 0.f; //!< Cost straight after the last rebuild, 0 if it has only been built by inserting
+		uint32_t m_rebuildCount = 0;
+		std::vector<BuildItem> m_buildItems; //!< Reused by rebuild()
+		std::vector<uint32_t> m_refitOrder; //!< Reused by refit()
+	};
+}
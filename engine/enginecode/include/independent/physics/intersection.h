@@ -0,0 +1,27 @@
+/** \file intersection.h */
+#pragma once
+
+#include <cstdint>
+
+#include "physics/bounds.h"
+
+/**\ SSE is always there on x64, other targets get the scalar versions */
+#if defined(_M_X64) || defined(__SSE2__)
+#define NG_SSE
+#endif
+
+namespace Engine {
+	/**\ Class Intersection
+	*	 Ray tests for picking. The distance argument goes in as the furthest hit wanted (the closest so far when
+	*	 testing several things) and comes out as the hit, it's left alone on a miss.
+	*	 The box test runs the three slabs side by side in one SSE register, the triangle test runs four triangles at once.
+	*/
+	class Intersection
+	{
+	public:
+		static bool rayBox(const Ray& arg_ray, const AABB& arg_box, float& arg_distance); //!< Hits from inside the box at distance 0
+		static bool rayTriangle(const Ray& arg_ray, const glm::vec3& arg_v0, const glm::vec3& arg_v1, const glm::vec3& arg_v2, float& arg_distance); //!< Either facing
+		/**\ Closest hit in an indexed triangle list. Positions are the first three floats of each vertex, stride is in floats */
+		static bool rayTriangles(const Ray& arg_ray, const float* arg_vertices, uint32_t arg_stride, const uint32_t* arg_indices, uint32_t arg_triangleCount, float& arg_distance);
+	};
+}
@@ -0,0 +1,19 @@
+/**\ file OpenGLProgramBinaryDriver.h */
+#pragma once
+
+#include "rendering/shaderProgramCache.h"
+
+namespace Engine
+{
+	/** Class OpenGLProgramBinaryDriver
+	*	Reads and restores linked programs with glGetProgramBinary and glProgramBinary
+	*/
+	class OpenGLProgramBinaryDriver : public ProgramBinaryDriver
+	{
+	public:
+		virtual bool isSupported() const override;
+		virtual std::string getSignature() const override;
+		virtual bool getProgramBinary(uint32_t arg_program, uint32_t& arg_format, std::vector<unsigned char>& arg_binary) override;
+		virtual bool loadProgramBinary(uint32_t arg_program, uint32_t arg_format, const std::vector<unsigned char>& arg_binary) override;
+	};
+}
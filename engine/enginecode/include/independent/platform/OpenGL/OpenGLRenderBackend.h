@@ -0,0 +1,25 @@
+/** \file OpenGLRenderBackend.h */
+#pragma once
+#include <memory>
+#include "rendering/renderBackend.h"
+#include "windows/graphicsContext.h"
+namespace Engine
+{
+	class OpenGLRenderBackend : public RenderBackend
+	{
+	public:
+		OpenGLRenderBackend(const std::shared_ptr<GraphicsContext>& arg_context) : m_context(arg_context) {}
+
+		virtual void setClearColour(const glm::vec4& arg_colour) override;
+		virtual void clear() override;
+		virtual void setDepthTest(bool arg_enabled) override;
+		virtual void setBlend(bool arg_enabled) override;
+		virtual void useShader(Shader& arg_shader) override;
+		virtual void bindTexture(Texture& arg_texture) override;
+		virtual void drawIndexed(VertexArray& arg_geometry, DrawMode arg_mode = DrawMode::Triangles) override;
+		virtual void present() override;
+		virtual void waitForGpu() override;
+	private:
+		std::shared_ptr<GraphicsContext> m_context; //!< Swaps the buffers on present
+	};
+}
@@ -1,39 +1,49 @@
 /**\ file OpenGLShader.h */
 #pragma once
 
+#include <unordered_map>
+
 #include <glm/glm.hpp>
 
 #include "rendering/shader.h"
+#include "rendering/shaderPreprocessor.h"
+#include "rendering/shaderCompilationService.h"
 namespace Engine
 {
 	/** Class OpenGLShader 
 	*	Takes in text and compiles it to a shader program
+	*	The compile is handed to the ShaderCompilationService, so the program may still be building after construction
 	*/
-	enum Region { R_NONE = -1, R_VERTEX = 0, R_FRAGMENT, R_GEOMETRY, R_TESSELLATIONCONTROL, R_TESSELLATIONEVALUATION, R_COMPUTE };
 	class OpenGLShader : public Shader //API AGNOSTIC
 	{
 	public:
 		OpenGLShader(const char* arg_VerFilepath, const char* arg_FragFilepath); //!< Constructor takes a vertex filepath, and a fragment filepath
-		OpenGLShader(const char* arg_Filepath); //!< Gives the option of a single file containing both shaders
+		OpenGLShader(const char* arg_Filepath, const ShaderDefines& arg_defines = {}); //!< Gives the option of a single file containing both shaders
 		~OpenGLShader();
 
 		/**\ API AGNOSTIC VERSION */
 		virtual uint32_t getID() const override { return m_OpenGL_ID; }
+		virtual bool isReady() override;
 
-		virtual void uploadInt(const char* arg_Name, int arg_Value) override;
-		virtual void uploadFloat(const char* arg_Name, float arg_Value) override;
-		virtual void uploadFloat2(const char* arg_Name, const glm::vec2& arg_Value) override;
-		virtual void uploadFloat3(const char* arg_Name, const glm::vec3& arg_Value) override;
-		virtual void uploadFloat4(const char* arg_Name, const glm::vec4& arg_Value) override;
-		virtual void uploadMat4(const char* arg_Name, const glm::mat4& arg_Value) override;
+		virtual void uploadInt(StringId arg_Name, int arg_Value) override;
+		virtual void uploadFloat(StringId arg_Name, float arg_Value) override;
+		virtual void uploadFloat2(StringId arg_Name, const glm::vec2& arg_Value) override;
+		virtual void uploadFloat3(StringId arg_Name, const glm::vec3& arg_Value) override;
+		virtual void uploadFloat4(StringId arg_Name, const glm::vec4& arg_Value) override;
+		virtual void uploadMat4(StringId arg_Name, const glm::mat4& arg_Value) override;
 
 	private:
-		uint32_t m_OpenGL_ID;
+		uint32_t m_OpenGL_ID = 0;
+		ShaderCompilationService::JobID m_job = 0; //!< Zero if the sources couldn't be read
+		std::shared_ptr<ShaderCompilationService> m_service; //!< Kept so the job can be released after the service instance changes
 
-		std::array<std::string, Region::R_COMPUTE + 1> src; //!< Strings to hold the body of text from each file
+		std::unordered_map<StringId, int32_t> m_locations; //!< Read from the program once it is ready, so uploads don't ask GL by name
+		bool m_locationsRead = false;
 
-		std::array<std::string, Region::R_COMPUTE + 1> readFile(const char* arg_Filepath, std::array<std::string, Region::R_COMPUTE + 1> arg_FileSrc);
+		static ShaderPreprocessor s_preprocessor; //!< Shared so include files are only read once
 
-		void compileAndLink(const char* arg_VerShaderSrc, const char* arg_FragShaderSrc); //!< Private function 
+		int32_t getLocation(StringId arg_name); //!< -1, which glUniform ignores, if the program has no such uniform or isn't ready
+		void readLocations(); //!< Fills m_locations with the program's active uniforms
+		void compileAndLink(const std::string& arg_name, const std::string& arg_fileTable, const char* arg_VerShaderSrc, const char* arg_FragShaderSrc); //!< Submits the sources to the compilation service
 	};
 }
\ No newline at end of file
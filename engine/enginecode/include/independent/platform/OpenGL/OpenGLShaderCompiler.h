@@ -0,0 +1,46 @@
+/**\ file OpenGLShaderCompiler.h */
+#pragma once
+
+#include <unordered_map>
+
+#include "rendering/shaderCompilationService.h"
+#include "rendering/shaderProgramCache.h"
+
+namespace Engine
+{
+	/** Class OpenGLShaderCompiler
+	*	Compiles and links without asking for the status, so the driver is free to work in the background.
+	*	With GL_KHR_parallel_shader_compile completion is polled with GL_COMPLETION_STATUS_KHR,
+	*	without it the status query in finish() is the point where the driver blocks.
+	*	Programs are restored from the binary cache when possible, which completes them straight away.
+	*/
+	class OpenGLShaderCompiler : public ShaderCompiler
+	{
+	public:
+		using LoadProc = void*(*)(const char*); //!< Same signature as glfwGetProcAddress
+
+		OpenGLShaderCompiler(LoadProc arg_loadProc); //!< Looks for the parallel compile extension, needs a current context
+
+		virtual bool isParallel() const override { return m_parallel; }
+		virtual uint32_t begin(const std::string& arg_name, const std::string& arg_sourceTable, const char* arg_vertexSrc, const char* arg_fragmentSrc) override;
+		virtual bool isComplete(uint32_t arg_program) override;
+		virtual bool finish(uint32_t arg_program) override;
+		virtual void discard(uint32_t arg_program) override;
+	private:
+		/**\ A program that has been linked but not checked yet */
+		struct Pending
+		{
+			std::string name;
+			std::string sourceTable;
+			uint32_t vertexShader = 0; //!< Zero when the program came from the cache
+			uint32_t fragmentShader = 0;
+			uint64_t cacheKey = 0;
+		};
+
+		static ShaderProgramCache& getProgramCache(); //!< Program binary cache shared by every OpenGL shader
+		bool checkShader(uint32_t arg_shader, const Pending& arg_pending); //!< Logs the info log if the shader failed to compile
+
+		bool m_parallel = false;
+		std::unordered_map<uint32_t, Pending> m_pending; //!< Program to its shaders
+	};
+}
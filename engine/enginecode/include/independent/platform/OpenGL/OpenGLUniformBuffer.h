@@ -11,7 +11,7 @@ namespace Engine {
 		~OpenGLUniformBuffer();
 
 		void attachShaderBlock(const std::shared_ptr<Shader>& arg_shader, const char* arg_blockName) override; //Const std::sharedptr?
-		void uploadData(const char* arg_Name, void* arg_Data) override;
+		void uploadData(StringId arg_Name, void* arg_Data) override;
 
 		inline uint32_t getRendererID() override { return m_OpenGL_ID; }
 		inline UniformBufferLayout getUBOLayout() override { return m_UBLayout; }
@@ -0,0 +1,28 @@
+/** \file nullRenderBackend.h */
+#pragma once
+#include <memory>
+#include "rendering/renderBackend.h"
+#include "windows/graphicsContext.h"
+namespace Engine
+{
+	/**\ Class NullRenderBackend
+	*	 Counts the state changes and draws it's given into NullRenderStats and does nothing else.
+	*	 Lets the renderers, the render thread and the sort all run without a GPU
+	*/
+	class NullRenderBackend : public RenderBackend
+	{
+	public:
+		NullRenderBackend(const std::shared_ptr<GraphicsContext>& arg_context = nullptr) : m_context(arg_context) {}
+
+		virtual void setClearColour(const glm::vec4& arg_colour) override;
+		virtual void clear() override;
+		virtual void setDepthTest(bool arg_enabled) override;
+		virtual void setBlend(bool arg_enabled) override;
+		virtual void useShader(Shader& arg_shader) override;
+		virtual void bindTexture(Texture& arg_texture) override;
+		virtual void drawIndexed(VertexArray& arg_geometry, DrawMode arg_mode = DrawMode::Triangles) override;
+		virtual void present() override;
+	private:
+		std::shared_ptr<GraphicsContext> m_context; //!< Swapped on present like a real backend, if there is one
+	};
+}
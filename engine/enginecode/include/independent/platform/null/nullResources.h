@@ -0,0 +1,150 @@
+/** \file nullResources.h */
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "rendering/texture.h"
+#include "rendering/shader.h"
+#include "rendering/vertexBuffer.h"
+#include "rendering/indexBuffer.h"
+#include "rendering/vertexArray.h"
+#include "rendering/uniformBuffer.h"
+
+namespace Engine
+{
+	/**\ Struct NullRenderStats
+	*	 What the null render API has been asked to do. Live counts go up in constructors and down in destructors,
+	*	 so a soak run that leaks GPU resources shows up here. Atomic as the render thread writes while the main thread reads
+	*/
+	struct NullRenderStats
+	{
+		std::atomic<int32_t> liveTextures{ 0 };
+		std::atomic<int32_t> liveShaders{ 0 };
+		std::atomic<int32_t> liveVertexBuffers{ 0 };
+		std::atomic<int32_t> liveIndexBuffers{ 0 };
+		std::atomic<int32_t> liveVertexArrays{ 0 };
+		std::atomic<int32_t> liveUniformBuffers{ 0 };
+
+		std::atomic<uint64_t> created{ 0 }; //!< Every resource made since the last reset
+		std::atomic<uint64_t> textureEdits{ 0 };
+		std::atomic<uint64_t> bufferEdits{ 0 }; //!< Vertex buffer edits
+		std::atomic<uint64_t> shaderUploads{ 0 }; //!< upload* calls on shaders
+		std::atomic<uint64_t> uniformUploads{ 0 }; //!< uploadData calls on uniform buffers
+		std::atomic<uint64_t> unknownUniforms{ 0 }; //!< uploadData with a name that isn't in the buffer's layout. The GL buffer logs and skips these
+		std::atomic<uint64_t> blockBinds{ 0 }; //!< attachShaderBlock calls on uniform buffers
+		std::atomic<uint64_t> stateChanges{ 0 }; //!< Clear colour, depth, blend, shader and texture binds
+		std::atomic<uint64_t> clears{ 0 };
+		std::atomic<uint64_t> drawCalls{ 0 };
+		std::atomic<uint64_t> indicesDrawn{ 0 };
+		std::atomic<uint64_t> presents{ 0 };
+
+		static NullRenderStats& get(); //!< The one set of counters every null object writes to
+		void resetCalls(); //!< Zeros the call counts. Live counts are left, the resources are still alive
+		int32_t getLiveResources() const; //!< All types added together
+	};
+
+	/**\ Null API resources. They keep the sizes and layouts they're given, so the engine sees the same answers it would from a GPU */
+	class NullTexture : public Texture
+	{
+	public:
+		NullTexture(const char* arg_file); //!< Reads the size from the image header without decoding it
+		NullTexture(uint32_t arg_width, uint32_t arg_height, uint32_t arg_channels, unsigned char* arg_data);
+		virtual ~NullTexture();
+
+		virtual inline uint32_t getID() override { return m_ID; }
+		virtual glm::vec2 getSize() override { return m_size; }
+		virtual inline uint32_t getChannels() override { return m_channels; }
+		virtual void edit(glm::vec2 arg_offset, glm::vec2 arg_size, uint32_t arg_channels, unsigned char* arg_data) override;
+	private:
+		uint32_t m_ID;
+		glm::vec2 m_size;
+		uint32_t m_channels;
+	};
+
+	class NullShader : public Shader
+	{
+	public:
+		NullShader(const char* arg_VerFilepath, const char* arg_FragFilepath);
+		NullShader(const char* arg_Filepath, const ShaderDefines& arg_defines);
+		virtual ~NullShader();
+
+		virtual uint32_t getID() const override { return m_ID; }
+		virtual bool isReady() override { return true; } //!< Nothing to compile
+
+		virtual void uploadInt(StringId arg_Name, int arg_Value) override;
+		virtual void uploadFloat(StringId arg_Name, float arg_Value) override;
+		virtual void uploadFloat2(StringId arg_Name, const glm::vec2& arg_Value) override;
+		virtual void uploadFloat3(StringId arg_Name, const glm::vec3& arg_Value) override;
+		virtual void uploadFloat4(StringId arg_Name, const glm::vec4& arg_Value) override;
+		virtual void uploadMat4(StringId arg_Name, const glm::mat4& arg_Value) override;
+
+		inline const std::string& getName() const { return m_name; } //!< Path the shader was made from, for logging
+	private:
+		uint32_t m_ID;
+		std::string m_name;
+	};
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(void* arg_vertices, uint32_t arg_size, const VertexBufferLayout& arg_layout);
+		virtual ~NullVertexBuffer();
+
+		virtual void edit(void* arg_vertices, uint32_t arg_size, uint32_t arg_offset) override;
+		virtual inline uint32_t getRenderID() const override { return m_ID; }
+		virtual inline const VertexBufferLayout& getLayout() const override { return m_layout; }
+		inline uint32_t getSize() const { return m_size; }
+	private:
+		uint32_t m_ID;
+		uint32_t m_size; //!< Bytes
+		VertexBufferLayout m_layout;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(uint32_t* arg_indices, uint32_t arg_count);
+		virtual ~NullIndexBuffer();
+
+		virtual inline uint32_t getID() const override { return m_ID; }
+		virtual inline uint32_t getCount() const override { return m_count; }
+	private:
+		uint32_t m_ID;
+		uint32_t m_count;
+	};
+
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		NullVertexArray();
+		virtual ~NullVertexArray();
+
+		virtual void addVertexBuffer(const std::shared_ptr<VertexBuffer>& arg_vertexBuffer) override;
+		virtual void setIndexBuffer(const std::shared_ptr<IndexBuffer>& arg_indexBuffer) override;
+
+		virtual inline uint32_t getID() const override { return m_ID; }
+		virtual inline uint32_t getDrawCount() const override { return m_indexBuffer ? m_indexBuffer->getCount() : 0; }
+		virtual inline std::shared_ptr<IndexBuffer> getIndexBuffer() const override { return m_indexBuffer; }
+	private:
+		uint32_t m_ID;
+		std::vector<std::shared_ptr<VertexBuffer>> m_vertexBuffers;
+		std::shared_ptr<IndexBuffer> m_indexBuffer;
+	};
+
+	class NullUniformBuffer : public UniformBuffer
+	{
+	public:
+		NullUniformBuffer(const UniformBufferLayout& arg_layout);
+		virtual ~NullUniformBuffer();
+
+		virtual void attachShaderBlock(const std::shared_ptr<Shader>& arg_shader, const char* arg_blockName) override;
+		virtual void uploadData(StringId arg_Name, void* arg_Data) override;
+
+		virtual inline uint32_t getRendererID() override { return m_ID; }
+		virtual inline UniformBufferLayout getUBOLayout() override { return m_UBLayout; }
+	private:
+		uint32_t m_ID;
+	};
+}
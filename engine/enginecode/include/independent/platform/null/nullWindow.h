@@ -0,0 +1,52 @@
+/** \file nullWindow.h */
+#pragma once
+
+#include <atomic>
+
+#include "windows/window.h"
+
+namespace Engine {
+	/**\ Class NullGraphicsContext
+	*	 Nothing to bind, swaps are counted so a headless run can check it presented every frame
+	*/
+	class NullGraphicsContext : public GraphicsContext
+	{
+	public:
+		virtual void init() override {}
+		virtual void swapBuffers() override { m_swaps++; }
+		virtual void makeCurrent() override {}
+		virtual void releaseCurrent() override {}
+		inline uint64_t getSwapCount() const { return m_swaps; }
+	private:
+		std::atomic<uint64_t> m_swaps{ 0 };
+	};
+
+	/**\ Class NullWindow
+	*	 A window with no native window behind it, for running the engine headless (soak tests, benchmarks, CI).
+	*	 Never produces events, close() sends the same WindowCloseEvent a user closing a real window would
+	*/
+	class NullWindow : public Window
+	{
+	public:
+		NullWindow(const WindowProperties& properties);
+		virtual ~NullWindow() = default;
+
+		void onUpdate(float timestep) override {}
+		void waitEvents(float timeout) override; //!< Sleeps the whole timeout, there are no events to wake it
+		void onResize(unsigned int width, unsigned int height) override;
+		void setVSync(bool VSync) override { m_properties.m_isVSync = VSync; }
+		void setEventCallback(const std::function<void(Event&)>& callback) override { m_callback = callback; }
+
+		inline unsigned int getWidth() const override { return m_properties.m_width; }
+		inline unsigned int getHeight() const override { return m_properties.m_height; }
+		inline void* getNativeWindow() const override { return nullptr; } //!< The input poller reads nothing as pressed
+		inline bool isFullScreenMode() const override { return m_properties.m_isFullScreen; }
+		inline bool isVSync() const override { return m_properties.m_isVSync; }
+
+		virtual void close() override;
+	private:
+		void init(const WindowProperties& properties) override;
+		WindowProperties m_properties;
+		std::function<void(Event&)> m_callback;
+	};
+}
@@ -10,6 +10,8 @@ namespace Engine {
 		GLFWGraphicsContext(GLFWwindow* win) : m_window(win) {}
 		virtual void init() override;
 		virtual void swapBuffers() override;
+		virtual void makeCurrent() override;
+		virtual void releaseCurrent() override;
 	private:
 		GLFWwindow* m_window;
 	};
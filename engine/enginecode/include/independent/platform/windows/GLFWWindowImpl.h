@@ -13,6 +13,7 @@ namespace Engine {
 		virtual ~GLFWWindowImpl();
 
 		void onUpdate(float timestep) override;
+		void waitEvents(float timeout) override;
 		void onResize(unsigned int width, unsigned int height) override { return; }
 		void setVSync(bool VSync) override;
 		void setEventCallback(const std::function<void(Event&)>& callback) override { m_callback = callback; };
@@ -0,0 +1,88 @@
+/**\ file drawList.h */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "systems/frameAllocator.h"
+#include "systems/linearAllocator.h"
+
+namespace Engine {
+	class VertexArray;
+	class Material;
+
+	/**\ One draw in a DrawList */
+	struct DrawItem
+	{
+		VertexArray* geometry;
+		Material* material;
+		glm::mat4 model;
+		uint32_t key; //!< Order within the list's key, i.e. grouping by shader
+	};
+
+	/**\ Class DrawList
+	*	 Draws recorded by a single thread, so jobs can fill one list each in parallel (one per region, object type...).
+	*	 Items and the array of them come from the list's own LinearAllocator, submitting takes no locks and doesn't
+	*	 touch the heap once warm.
+	*	 Once the jobs filling them are done, the main thread queues each list with Renderer3D::submit(DrawList&) and
+	*	 endScene merges them into one stream, ordered by list key, then item key, then the order things were submitted in.
+	*
+	*	 Geometry and materials are held by pointer, without touching their reference counts, which would be
+	*	 shared between all the threads. They have to outlive the frame, as scene resources do.
+	*	 A list is double buffered to match the render thread: begin() reuses the buffer from two frames ago.
+	*/
+	class DrawList
+	{
+	public:
+		DrawList(uint32_t arg_listKey = 0, size_t arg_blockSize = 64 * 1024) : m_listKey(arg_listKey), m_buffers{ Buffer(arg_blockSize), Buffer(arg_blockSize) } {}
+		DrawList(const DrawList&) = delete;
+		DrawList& operator=(const DrawList&) = delete;
+
+		void begin(); //!< Starts this frame's items, once per frame before submitting
+		/**\ Adds a draw. Lower keys draw first */
+		inline void submit(VertexArray& arg_geometry, Material& arg_material, const glm::mat4& arg_model, uint32_t arg_key = 0)
+		{
+			Buffer& buffer = m_buffers[m_current];
+			buffer.items.push_back(buffer.memory.create<DrawItem>(DrawItem{ &arg_geometry, &arg_material, arg_model, arg_key }));
+		}
+
+		inline uint32_t getListKey() const { return m_listKey; }
+		inline void setListKey(uint32_t arg_listKey) { m_listKey = arg_listKey; }
+		inline const FrameVector<DrawItem*>& getItems() const { return m_buffers[m_current].items; } //!< This frame's items, in submission order
+		inline uint32_t getCount() const { return static_cast<uint32_t>(m_buffers[m_current].items.size()); }
+	private:
+		struct Buffer
+		{
+			Buffer(size_t arg_blockSize) : memory(arg_blockSize), items(ArenaAllocator<DrawItem*>(memory)) {}
+			LinearAllocator memory;
+			FrameVector<DrawItem*> items; //!< In memory, so made again each time it is reset
+		};
+
+		uint32_t m_listKey;
+		Buffer m_buffers[2];
+		uint32_t m_current = 0;
+	};
+
+	/**\ Class DrawQueue
+	*	 The lists queued for a frame, merged into one stream sorted by list key, item key, then submission order.
+	*/
+	class DrawQueue
+	{
+	public:
+		void add(const FrameVector<DrawItem*>& arg_items, uint32_t arg_listKey); //!< Takes the items a list has at the time
+		void sort();
+		inline const std::vector<DrawItem*>& getItems() const { return m_sorted; } //!< Valid after sort()
+		void clear(); //!< Keeps the capacity for next frame
+	private:
+		struct Entry
+		{
+			uint64_t key; //!< List key in the high half
+			uint32_t sequence; //!< Keeps submission order between equal keys
+			DrawItem* item;
+		};
+		std::vector<Entry> m_entries;
+		std::vector<DrawItem*> m_sorted;
+	};
+}
@@ -5,15 +5,16 @@ namespace Engine {
 	class RenderAPI
 	{
 	public:
-		/**\ Enum class for the  */
+		/**\ Enum class for the rendering API the resource factories create for */
 		enum class API
 		{
-			None = 0,
+			None = 0, //!< Headless, the factories make null resources that only count what they're asked to do
 			OpenGL = 1,
 			Direct3d = 2,
 			Vulkan = 3,
 		};
 		inline static API getAPI() { return s_currentAPI; }
+		inline static void setAPI(API arg_api) { s_currentAPI = arg_api; } //!< Before any resource is created, resources from different APIs can't be mixed
 	private:
 		static API s_currentAPI;
 	};
@@ -0,0 +1,33 @@
+/**\ file renderBackend.h */
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Engine {
+	class Shader;
+	class Texture;
+	class VertexArray;
+
+	enum class DrawMode { Triangles, Quads };
+
+	/**\ Class RenderBackend
+	*	 The state and draw calls the renderers make each frame.
+	*	 Recorded commands are handed one of these when they run, on the render thread if it is running.
+	*	 A recording backend stands in for the GPU in the tests.
+	*/
+	class RenderBackend
+	{
+	public:
+		virtual ~RenderBackend() = default;
+
+		virtual void setClearColour(const glm::vec4& arg_colour) = 0;
+		virtual void clear() = 0; //!< Colour and depth
+		virtual void setDepthTest(bool arg_enabled) = 0;
+		virtual void setBlend(bool arg_enabled) = 0; //!< Standard alpha blending when enabled
+		virtual void useShader(Shader& arg_shader) = 0;
+		virtual void bindTexture(Texture& arg_texture) = 0;
+		virtual void drawIndexed(VertexArray& arg_geometry, DrawMode arg_mode = DrawMode::Triangles) = 0;
+		virtual void present() = 0; //!< Swaps the buffers, the last command of every frame
+		virtual void waitForGpu() {} //!< Blocks until the GPU has finished everything so far. After present with RenderThread::setGpuSync
+	};
+}
@@ -0,0 +1,74 @@
+/**\ file renderCommandBuffer.h */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "renderBackend.h"
+
+namespace Engine {
+	/**\ Class RenderCommandBuffer
+	*	 Commands (any callable taking a RenderBackend&) are stored back to back in large blocks,
+	*	 so recording a frame allocates nothing once the blocks have grown to fit.
+	*	 Blocks never move, which keeps captured objects such as shared_ptrs valid until the command has run.
+	*/
+	class RenderCommandBuffer
+	{
+	public:
+		RenderCommandBuffer(uint32_t arg_blockSize = 64 * 1024) : m_blockSize(arg_blockSize) {}
+		~RenderCommandBuffer() { clear(); }
+		RenderCommandBuffer(const RenderCommandBuffer&) = delete;
+		RenderCommandBuffer& operator=(const RenderCommandBuffer&) = delete;
+
+		template <typename F>
+		void record(F&& arg_func)
+		{
+			using Func = std::decay_t<F>;
+			static_assert(alignof(Func) <= s_alignment, "Render command captures are over aligned");
+
+			void* memory = allocate(s_headerSize + align(sizeof(Func)));
+			Header* header = static_cast<Header*>(memory);
+			header->execute = [](void* arg_payload, RenderBackend& arg_backend) { (*static_cast<Func*>(arg_payload))(arg_backend); };
+			header->destroy = [](void* arg_payload) { static_cast<Func*>(arg_payload)->~Func(); };
+			header->size = static_cast<uint32_t>(s_headerSize + align(sizeof(Func)));
+			new (static_cast<unsigned char*>(memory) + s_headerSize) Func(std::forward<F>(arg_func));
+			m_count++;
+		}
+
+		void execute(RenderBackend& arg_backend); //!< Runs every command in recording order, then empties the buffer
+		void clear(); //!< Destroys every command without running it
+
+		inline uint32_t getCommandCount() const { return m_count; }
+		inline bool empty() const { return m_count == 0; }
+	private:
+		struct Header
+		{
+			void(*execute)(void*, RenderBackend&);
+			void(*destroy)(void*);
+			uint32_t size; //!< Header and payload, the offset to the next command
+		};
+		struct Block
+		{
+			std::unique_ptr<unsigned char[]> data;
+			size_t size;
+			size_t used;
+		};
+
+		constexpr static size_t s_alignment = alignof(std::max_align_t);
+		constexpr static size_t align(size_t arg_size) { return (arg_size + s_alignment - 1) & ~(s_alignment - 1); }
+		constexpr static size_t s_headerSize = (sizeof(Header) + s_alignment - 1) & ~(s_alignment - 1);
+
+		void* allocate(size_t arg_size);
+		template <typename Visit> void forEach(Visit arg_visit); //!< Walks the commands in order
+
+		uint32_t m_blockSize;
+		std::vector<Block> m_blocks;
+		size_t m_currentBlock = 0; //!< Block being written to
+		uint32_t m_count = 0;
+	};
+}
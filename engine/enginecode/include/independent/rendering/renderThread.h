@@ -0,0 +1,116 @@
+/**\ file renderThread.h */
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "renderBackend.h"
+#include "renderCommandBuffer.h"
+#include "windows/graphicsContext.h"
+
+namespace Engine {
+	/**\ Class RenderThread
+	*	 Owns the graphics context while the game loop runs and replays the frames the main thread records.
+	*	 Frames are double buffered: the main thread records frame N+1 while frame N is drawn, and endFrame() waits
+	*	 for frame N before handing over N+1, so the render thread is never more than one frame behind.
+	*
+	*	 record() is the only way to reach the GPU from the main thread while the thread runs. When it isn't running,
+	*	 or when called from the render thread itself, commands run straight away, so the same code works either way.
+	*	 record() and endFrame() are for the main thread only.
+	*/
+	class RenderThread
+	{
+	public:
+		static void setBackend(const std::shared_ptr<RenderBackend>& arg_backend) { s_backend = arg_backend; } //!< Backend every command is run with
+		static void start(const std::shared_ptr<GraphicsContext>& arg_context); //!< Moves the context to a new render thread
+		static void stop(); //!< Finishes the recorded work and gives the context back to the calling thread
+
+		/**\ Records a command, a callable taking a RenderBackend& or nothing */
+		template <typename F>
+		static void record(F&& arg_func)
+		{
+			if (!s_running || isRenderThread()) {
+				if constexpr (std::is_invocable_v<F&, RenderBackend&>) arg_func(*s_backend);
+				else arg_func();
+				return;
+			}
+			if constexpr (std::is_invocable_v<F&, RenderBackend&>) s_frames[s_recording].record(std::forward<F>(arg_func));
+			else s_frames[s_recording].record([func = std::forward<F>(arg_func)](RenderBackend&) mutable { func(); });
+		}
+
+		/**\ Runs a function on the render thread ahead of the recorded frames and waits for its result, i.e. to create a resource */
+		template <typename F>
+		static auto invoke(F&& arg_func) -> decltype(arg_func())
+		{
+			if (!s_running || isRenderThread()) return arg_func();
+
+			using Result = decltype(arg_func());
+			std::promise<void> done;
+			if constexpr (std::is_void_v<Result>) {
+				post([&arg_func, &done]() { arg_func(); done.set_value(); });
+				done.get_future().wait();
+			}
+			else {
+				Result result{};
+				post([&arg_func, &done, &result]() { result = arg_func(); done.set_value(); });
+				done.get_future().wait();
+				return result;
+			}
+		}
+
+		static void endFrame(); //!< Records the present, hands the frame to the render thread and waits for the previous one
+		static void skipFrame(); //!< As endFrame, without the present, for a frame that draws nothing. Keeps the frame allocator's frames in step
+		static void waitForIdle(); //!< Blocks until the frame handed over last has been drawn and presented
+
+		/**\ Runs on the render thread after each frame it finishes, once the main thread may hand over the next, so work
+		*	 there adds nothing to the frame's submit to present time. Inline at the end of endFrame() and skipFrame() while
+		*	 the thread isn't running. Set it while the thread isn't running
+		*/
+		inline static void setAfterFrame(std::function<void()>&& arg_work) { s_afterFrame = std::move(arg_work); }
+
+		/**\ With GPU sync on, each present waits for the GPU to finish the frame, so the driver can't queue frames up
+		*	 and add latency. Costs throughput, as the CPU and GPU no longer overlap across frames
+		*/
+		inline static void setGpuSync(bool arg_enabled) { s_gpuSync = arg_enabled; }
+		inline static bool isGpuSync() { return s_gpuSync; }
+		inline static uint64_t getPresentLatency() { return s_presentLatency.load(); } //!< Nanoseconds from the last presented frame's endFrame() to its present returning
+		inline static uint64_t getPresentCount() { return s_presents.load(); } //!< Changes when there is a new getPresentLatency()
+
+		inline static bool isRenderThread() { return s_isRenderThread; }
+		inline static bool isRunning() { return s_running; }
+		inline static uint64_t getFramesDrawn() { return s_framesDrawn.load(); } //!< Frames the render thread has finished
+	private:
+		static void post(std::function<void()>&& arg_task); //!< Queues an immediate task
+		static void threadLoop(std::shared_ptr<GraphicsContext> arg_context);
+		static void submit(); //!< Hands the recording frame over once the render thread is free (s_mutex not held)
+
+		static std::shared_ptr<RenderBackend> s_backend;
+		static std::shared_ptr<GraphicsContext> s_context;
+		static std::thread s_thread;
+		static bool s_running;
+		static thread_local bool s_isRenderThread; //!< Set by the render thread itself, so it is never read before it is known
+
+		static RenderCommandBuffer s_frames[2]; //!< One recording, one drawing
+		static uint32_t s_recording; //!< Index of the frame the main thread records into
+
+		static std::mutex s_mutex;
+		static std::condition_variable s_signal;
+		static bool s_framePending; //!< A frame has been handed over and not finished yet
+		static bool s_stopping;
+		static std::vector<std::function<void()>> s_tasks; //!< Immediate tasks from invoke()
+		static std::function<void()> s_afterFrame;
+		static std::atomic<uint64_t> s_framesDrawn;
+
+		static std::atomic<bool> s_gpuSync;
+		static uint64_t s_submitTimes[2]; //!< timer::now() at each frame's endFrame(), handed over with the frame
+		static std::atomic<uint64_t> s_presentLatency;
+		static std::atomic<uint64_t> s_presents;
+	};
+}
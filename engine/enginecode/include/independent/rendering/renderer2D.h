@@ -33,11 +33,12 @@ namespace Engine {
 	};
 
 	/**\ class Renderer2D
-	*
+	*	 Like Renderer3D, calls are recorded with RenderThread::record and run on the render thread.
 	*/
 	class Renderer2D {
 	public:
 		static void init();
+		static void shutdown(); //!< Releases the shader, texture and quad, while the context is still current
 		static void beginScene(bool arg_blend);
 		static void uploadData(glm::mat4 arg_view, glm::mat4 arg_projection);
 
@@ -57,8 +58,8 @@ namespace Engine {
 			float arg_angle = s_data->defaultAngle
 		);
 
-		static void submitChar(char arg_character, const glm::vec2& arg_position, float& arg_advance, const glm::vec4 arg_tint);
-		static void submitText(const char* arg_text, const glm::vec2& arg_position, const glm::vec4 arg_tint);
+		static void submitChar(char arg_character, const glm::vec2& arg_position, float& arg_advance, const glm::vec4 arg_tint); //!< Edits the font texture, so only from the render thread or before it starts
+		static void submitText(const char* arg_text, const glm::vec2& arg_position, const glm::vec4 arg_tint); //!< Main thread, the text is copied into frame memory so it needn't outlive the call
 
 		static void endScene();
 
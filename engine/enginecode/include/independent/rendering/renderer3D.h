@@ -8,8 +8,11 @@
 #include "vertexArray.h"
 #include "texture.h"
 #include "shader.h"
+#include "shaderPermutations.h"
 #include "shaderDataType.h"
 #include "renderAPI.h"
+#include "renderBackend.h"
+#include "drawList.h"
 
 #include "uniformBuffer.h"
 #include "subTexture.h"
@@ -17,12 +20,16 @@
 namespace Engine {
 	/**\ Class Material 
 	*	 Holds a shader and uniform data associated
+	*	 The flags are fixed when the material is made. They pick the shader variant and the function that applies
+	*	 the material each draw, so the draw itself never checks them.
 	*/
 	class Material {
 	public:
+		using ApplyFunc = void(*)(const Material&, RenderBackend&); //!< Binds the texture and uploads the tint, whichever the material has
+
 		/**\ Constructor that takes only a shader (necessary for a material) */
 		Material(const std::shared_ptr<Shader>& arg_shader) : m_shader(arg_shader), m_flags(0), m_texture(nullptr), m_tint(glm::vec4(0.f)) {
-
+			m_apply = getApplyFunc(m_flags);
 		}
 		/**\ Constructor that takes a texture */
 		Material(const std::shared_ptr<Shader>& arg_shader, const std::shared_ptr<Texture> arg_texture) : m_shader(arg_shader), m_texture(arg_texture), m_tint(glm::vec4(0.f)) {
@@ -37,9 +44,16 @@ namespace Engine {
 			setFlag(flag_texture | flag_tint);
 		}
 
+		/**\ Constructors that take the variants of a shader built with getKeywords(), and use the one matching the flags */
+		Material(const std::shared_ptr<ShaderPermutations>& arg_variants) : Material(arg_variants->getVariant(0)) {}
+		Material(const std::shared_ptr<ShaderPermutations>& arg_variants, const std::shared_ptr<Texture> arg_texture) : Material(arg_variants->getVariant(flag_texture), arg_texture) {}
+		Material(const std::shared_ptr<ShaderPermutations>& arg_variants, const glm::vec4 arg_tint) : Material(arg_variants->getVariant(flag_tint), arg_tint) {}
+		Material(const std::shared_ptr<ShaderPermutations>& arg_variants, const std::shared_ptr<Texture> arg_texture, const glm::vec4 arg_tint) : Material(arg_variants->getVariant(flag_texture | flag_tint), arg_texture, arg_tint) {}
+
 		inline std::shared_ptr<Shader> getShader() const { return m_shader; } //!< Returns the shader 
 		inline std::shared_ptr<Texture> getTexture() const { return m_texture; } //!< Returns the texture
 		inline glm::vec4 getTint() const { return m_tint; } //!< Returns the tint
+		inline void apply(RenderBackend& arg_backend) const { m_apply(*this, arg_backend); } //!< Sets the per material state before a draw
 
 		/**\ Bitwise AND, returns false if none of the values match
 		*
@@ -52,6 +66,9 @@ namespace Engine {
 		void setShader(const std::shared_ptr<Shader>& arg_shader) { m_shader = arg_shader; }
 		void setTexture(const std::shared_ptr<Texture>& arg_texture) { m_texture = arg_texture; }
 		void setTint(const glm::vec4& arg_tint) { m_tint = arg_tint; }
+
+		/**\ Shader keywords in flag order, so a material's flags are also its variant mask */
+		static const std::vector<std::string>& getKeywords() { static const std::vector<std::string> keywords = { "USE_TEXTURE", "USE_TINT" }; return keywords; }
 		
 		constexpr static uint32_t flag_texture = 1 << 0; //!< 00000001. constexpr lets the compiler calculate it at compile time. 
 		/** Possible textures to implement:
@@ -73,29 +90,35 @@ namespace Engine {
 		*	 e.g. 
 		*	 00000001 for one setting being true can go to:
 		*	 00000011 for two settings being true.
-		*
-		*	 Also gives the option of default colours and textures
 		*/
 		uint32_t m_flags = 0;
 
-		void setFlag(uint32_t arg_flag) { m_flags |= arg_flag; } //!< If the flag passed is different, add it using bitwise addition 
+		void setFlag(uint32_t arg_flag) { m_flags |= arg_flag; m_apply = getApplyFunc(m_flags); } //!< If the flag passed is different, add it using bitwise addition 
+		static ApplyFunc getApplyFunc(uint32_t arg_flags); //!< One function per flag combination, picked once
 
 		std::shared_ptr<Shader> m_shader; //!< Shader for the material
 		std::shared_ptr<Texture> m_texture; //!< Texture associated
 		glm::vec4 m_tint;
+		ApplyFunc m_apply = nullptr;
 	};
 	/**\ Class Renderer3d 
+	*	 Each call records its work with RenderThread::record, arguments are copied so the caller's can change straight after.
 	*/
 	class Renderer3D
 	{
 	public:
 		static void init(); //!< Initializes the renderer
-		static void uploadCamera(const std::shared_ptr<Shader> arg_shader, glm::mat4 arg_view, glm::mat4 arg_projection);
-		static void uploadLights(const std::shared_ptr<Shader> arg_shader, glm::vec3 arg_position, glm::vec3 arg_view, glm::vec3 arg_colour, glm::vec4 arg_tint);
+		static void shutdown(); //!< Releases the blocks and queue, while the context is still current
+		static void uploadCamera(glm::mat4 arg_view, glm::mat4 arg_projection); //!< Bound as b_camera to every shader drawn from now on
+		static void uploadLights(glm::vec3 arg_position, glm::vec3 arg_view, glm::vec3 arg_colour, glm::vec4 arg_tint); //!< Bound as b_lights to every shader drawn from now on
 		static void beginScene();
 		static void submit(const std::shared_ptr<VertexArray>& arg_geometry, const std::shared_ptr<Material> arg_material, const glm::mat4& arg_model);
-		static void endScene();
+		static void submit(const DrawList& arg_list); //!< Queues a list filled this frame. Main thread only, after the jobs filling it are done. Drawn in key order at endScene
+		static void endScene(); //!< Merges and draws the queued lists
 	private:
+		static void draw(VertexArray& arg_geometry, const Material& arg_material, const glm::mat4& arg_model, RenderBackend& arg_backend);
+		static void bindBlocks(const std::shared_ptr<Shader>& arg_shader); //!< Attaches the current camera and lights blocks if the shader hasn't got them yet
+
 		struct InternalData
 		{
 			std::shared_ptr<UniformBuffer> cameraUBO;
@@ -112,10 +135,18 @@ namespace Engine {
 				{"u_tint", ShaderDataType::Float3}
 			};
 
-			/**\ Default texture and tint in case none is passed*/
-			unsigned char PxlColour[4] = { 55, 0, 155, 255 };
-			std::shared_ptr<Texture> defaultTexture;
-			glm::vec4 defaultTint;
+			/**\ Which blocks each shader has. A shader is bound the first time it is drawn after a block is made, so
+			*	 variants compiled after the upload get the blocks too, and only once their program is ready
+			*/
+			struct BoundBlocks
+			{
+				std::weak_ptr<Shader> shader; //!< Expired if a new shader has taken the address
+				uint32_t generation = 0;
+			};
+			std::unordered_map<const Shader*, BoundBlocks> boundBlocks;
+			uint32_t blockGeneration = 1; //!< Bumped each time a block is made
+
+			DrawQueue drawQueue; //!< Queued draw lists, only touched on the render thread
 		};
 		static std::shared_ptr<InternalData> s_data; //!< One set of data per application. It is private so only this class can edit the data.
 	}; 
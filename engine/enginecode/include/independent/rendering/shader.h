@@ -6,23 +6,29 @@
 
 #include <glm/glm.hpp>
 
+#include "shaderPreprocessor.h"
+#include "systems/stringId.h"
+
 namespace Engine {
 	class Shader
 	{
 	private: uint32_t m_OpenGL_ID;
 	public:
 		static Shader* create(const char* arg_VerFilepath, const char* arg_FragFilepath);
-		static Shader* create(const char* arg_Filepath);
-		~Shader() = default;
+		static Shader* create(const char* arg_Filepath, const ShaderDefines& arg_defines = {}); //!< Defines select a variant, see ShaderPermutations
+		virtual ~Shader() = default;
 
-		/**\ API AGNOSTIC SHADER CLASS */
+		/**\ API AGNOSTIC SHADER CLASS
+		*	 Uniforms are found by StringId, names the program doesn't use are ignored
+		*/
 		virtual uint32_t getID() const = 0;
+		virtual bool isReady() = 0; //!< False while the program is still compiling, or if it failed. Never blocks
 
-		virtual void uploadInt(const char* arg_Name, int arg_Value) = 0;
-		virtual void uploadFloat(const char* arg_Name, float arg_Value) = 0;
-		virtual void uploadFloat2(const char* arg_Name, const glm::vec2& arg_Value) = 0; // Should it need glm if its API agnostic?
-		virtual void uploadFloat3(const char* arg_Name, const glm::vec3& arg_Value) = 0;
-		virtual void uploadFloat4(const char* arg_Name, const glm::vec4& arg_Value) = 0;
-		virtual void uploadMat4(const char* arg_Name, const glm::mat4& arg_Value) = 0;
+		virtual void uploadInt(StringId arg_Name, int arg_Value) = 0;
+		virtual void uploadFloat(StringId arg_Name, float arg_Value) = 0;
+		virtual void uploadFloat2(StringId arg_Name, const glm::vec2& arg_Value) = 0; // Should it need glm if its API agnostic?
+		virtual void uploadFloat3(StringId arg_Name, const glm::vec3& arg_Value) = 0;
+		virtual void uploadFloat4(StringId arg_Name, const glm::vec4& arg_Value) = 0;
+		virtual void uploadMat4(StringId arg_Name, const glm::mat4& arg_Value) = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**\ file shaderCompilationService.h */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace Engine {
+
+	/**\ Class ShaderCompiler
+	*	 The driver facing half of the compilation service.
+	*	 begin() must not wait on the driver, only finish() is allowed to block.
+	*/
+	class ShaderCompiler
+	{
+	public:
+		virtual ~ShaderCompiler() = default;
+
+		virtual bool isParallel() const = 0; //!< True if the driver compiles in the background and can report completion
+		virtual uint32_t begin(const std::string& arg_name, const std::string& arg_sourceTable, const char* arg_vertexSrc, const char* arg_fragmentSrc) = 0; //!< Submits the compile and link, returns the program. The table is logged with errors
+		virtual bool isComplete(uint32_t arg_program) = 0; //!< Polls without blocking. False if the driver can't report it, the service finishes those jobs itself
+		virtual bool finish(uint32_t arg_program) = 0; //!< Checks the status (may block), logs errors and tidies up. Returns false on failure, having deleted the program
+		virtual void discard(uint32_t arg_program) = 0; //!< Drops a program whose compile is still outstanding
+	};
+
+	enum class ShaderJobState { Pending, Ready, Failed };
+
+	/**\ Struct ShaderCompileTiming
+	*	 Submit to ready time of one program. With a parallel driver this overlaps the other programs
+	*/
+	struct ShaderCompileTiming
+	{
+		std::string name;
+		float milliseconds;
+		bool succeeded;
+	};
+
+	/**\ Class ShaderCompilationService
+	*	 Every shader is submitted as soon as it is created and the status is only asked for when the program is needed.
+	*	 With KHR_parallel_shader_compile the driver builds them all at once, so startup waits for the slowest program
+	*	 rather than the sum of them, and a variant needed mid game is drawn once it is ready instead of stalling the frame.
+	*	 Without it the status can't be asked for without blocking, so update() finishes the oldest job once it has had
+	*	 s_framesBeforeFinish frames to compile, one a frame, at the start of the frame rather than in the middle of a draw.
+	*/
+	class ShaderCompilationService
+	{
+	public:
+		using JobID = uint32_t;
+		constexpr static uint32_t s_framesBeforeFinish = 2; //!< Frames a job gets before update() blocks on it, without a parallel driver
+
+		ShaderCompilationService(const std::shared_ptr<ShaderCompiler>& arg_compiler) : m_compiler(arg_compiler) {}
+
+		JobID submit(const std::string& arg_name, const std::string& arg_sourceTable, const char* arg_vertexSrc, const char* arg_fragmentSrc); //!< Starts a compile, returns straight away
+		uint32_t getProgram(JobID arg_job) const; //!< Program handle, valid as soon as the job is submitted. Zero once it has failed, the compiler deletes failed programs
+
+		ShaderJobState poll(JobID arg_job); //!< Never blocks, finishes the job if the driver reports it is done
+		inline bool isReady(JobID arg_job) { return poll(arg_job) == ShaderJobState::Ready; }
+		ShaderJobState wait(JobID arg_job); //!< Blocks until the job is finished
+		void release(JobID arg_job); //!< Forgets a job, discarding the compile if still outstanding
+
+		void update(); //!< Polls every outstanding job, or finishes one without a parallel driver. Called once a frame
+		void waitAll(); //!< Blocks until every outstanding job is finished, i.e. at the end of loading
+
+		inline uint32_t getPendingCount() const { return m_pending; }
+		inline bool isParallel() const { return m_compiler->isParallel(); }
+		inline const std::vector<ShaderCompileTiming>& getTimings() const { return m_timings; } //!< One entry per finished job, in finish order
+
+		inline static std::shared_ptr<ShaderCompilationService> getInstance() { return s_instance; } //!< Service used by the shaders, set up with the graphics context
+		inline static void setInstance(const std::shared_ptr<ShaderCompilationService>& arg_service) { s_instance = arg_service; }
+	private:
+		struct Job
+		{
+			std::string name;
+			uint32_t program;
+			ShaderJobState state;
+			std::chrono::steady_clock::time_point submitted;
+			uint32_t framesWaited = 0; //!< update() calls while pending
+		};
+
+		void complete(Job& arg_job); //!< Asks the compiler for the result and records the time
+
+		std::shared_ptr<ShaderCompiler> m_compiler;
+		std::unordered_map<JobID, Job> m_jobs;
+		std::vector<ShaderCompileTiming> m_timings;
+		JobID m_nextJob = 1;
+		uint32_t m_pending = 0;
+
+		static std::shared_ptr<ShaderCompilationService> s_instance;
+	};
+}
@@ -0,0 +1,41 @@
+/**\ file shaderPermutations.h */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+
+#include "shader.h"
+
+namespace Engine {
+	/**\ Class ShaderPermutations
+	*	 Builds specialised variants of one shader file from a set of #define keywords.
+	*	 A variant is picked by a bit mask where bit n turns on keyword n, so features a material doesn't use are compiled out
+	*	 instead of being branched on or fed dummy data every draw.
+	*	 Variants are compiled the first time they are asked for and kept, warmUp() builds them ahead of time.
+	*/
+	class ShaderPermutations
+	{
+	public:
+		using CreateFunc = std::function<Shader*(const char*, const ShaderDefines&)>; //!< Builds one variant, Shader::create unless replaced
+
+		ShaderPermutations(const char* arg_filepath, const std::vector<std::string>& arg_keywords, const CreateFunc& arg_create = nullptr);
+
+		std::shared_ptr<Shader> getVariant(uint32_t arg_keywordMask); //!< Returns the variant, compiling it on first use
+		void warmUp(std::initializer_list<uint32_t> arg_keywordMasks); //!< Compiles variants now, i.e. during loading rather than on first draw
+
+		ShaderDefines getDefines(uint32_t arg_keywordMask) const; //!< Keywords switched on by the mask, in keyword order
+		std::vector<std::shared_ptr<Shader>> getCompiledVariants() const; //!< Every variant built so far, in mask order
+		inline uint32_t getCompiledCount() const { return static_cast<uint32_t>(m_variants.size()); }
+		inline const std::string& getFilepath() const { return m_filepath; }
+	private:
+		std::string m_filepath;
+		std::vector<std::string> m_keywords;
+		uint32_t m_validMask; //!< Bits past the last keyword are ignored so they can't create duplicate variants
+		CreateFunc m_create;
+		std::unordered_map<uint32_t, std::shared_ptr<Shader>> m_variants; //!< Keyword mask to compiled variant
+	};
+}
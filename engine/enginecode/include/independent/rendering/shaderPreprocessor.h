@@ -0,0 +1,50 @@
+/**\ file shaderPreprocessor.h */
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace Engine
+{
+	enum Region { R_NONE = -1, R_VERTEX = 0, R_FRAGMENT, R_GEOMETRY, R_TESSELLATIONCONTROL, R_TESSELLATIONEVALUATION, R_COMPUTE };
+	using ShaderSources = std::array<std::string, Region::R_COMPUTE + 1>; //!< One string per shader stage
+	using ShaderDefines = std::vector<std::string>; //!< Names written as #define after each #version
+
+	/** Class ShaderPreprocessor
+	*	Splits a .glsl file into its #region stages in a single scan of the whole file.
+	*	#include "file" is resolved relative to the including file, and files are read once and cached.
+	*	An include containing #pragma once is only pasted once per stage.
+	*	#line directives are emitted so driver errors read as (source number, line), see getFileTable().
+	*	Defines passed in are inserted straight after #version, which is how shader variants are built.
+	*/
+	class ShaderPreprocessor
+	{
+	public:
+		bool process(const char* arg_filepath, ShaderSources& arg_sources, const ShaderDefines& arg_defines = {}); //!< Reads and splits a file. Returns false if it can't be opened
+		bool processSource(const std::string& arg_name, const std::string& arg_text, ShaderSources& arg_sources, const ShaderDefines& arg_defines = {}); //!< Splits text already in memory
+
+		std::string getFileTable() const; //!< "0: path, 1: path" for the last file processed. Matches the source numbers in driver errors
+		inline void clearCache() { m_fileCache.clear(); } //!< Forces every file to be read again, i.e. after editing a shader
+	private:
+		/**\ Per stage state while scanning */
+		struct StageState
+		{
+			std::vector<uint32_t> pastedOnce; //!< Files with #pragma once that are already in this stage
+		};
+
+		std::shared_ptr<const std::string> readFile(const std::string& arg_path); //!< Whole file, through the cache
+		uint32_t getFileIndex(const std::string& arg_path); //!< Source string number used in #line
+		void scan(const std::string& arg_text, uint32_t arg_fileIndex, const std::string& arg_directory, uint32_t arg_depth, Region& arg_region, ShaderSources& arg_sources);
+
+		std::unordered_map<std::string, std::shared_ptr<const std::string>> m_fileCache; //!< Path to contents, kept between shaders so shared includes are read once
+		std::vector<std::string> m_files; //!< Source string numbers for the current shader
+		std::array<StageState, Region::R_COMPUTE + 1> m_stages;
+		const ShaderDefines* m_defines = nullptr; //!< Defines for the current shader
+		bool m_failed = false; //!< Set when an include can't be opened
+
+		constexpr static uint32_t s_maxDepth = 16; //!< Guards against include cycles
+	};
+}
@@ -0,0 +1,105 @@
+/**\ file shaderProgramCache.h */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <initializer_list>
+
+#include "systems/hash.h"
+
+namespace Engine {
+
+	/**\ Class ProgramBinaryDriver
+	*	 The driver facing half of the program cache.
+	*	 Kept abstract so the cache keying, storage and eviction can be tested with a fake driver and no GPU.
+	*/
+	class ProgramBinaryDriver
+	{
+	public:
+		virtual ~ProgramBinaryDriver() = default;
+
+		virtual bool isSupported() const = 0; //!< False if the driver exposes no program binary formats
+		virtual std::string getSignature() const = 0; //!< Vendor, renderer and version. A driver update changes this and invalidates every binary
+		virtual bool getProgramBinary(uint32_t arg_program, uint32_t& arg_format, std::vector<unsigned char>& arg_binary) = 0; //!< Reads back a linked program
+		virtual bool loadProgramBinary(uint32_t arg_program, uint32_t arg_format, const std::vector<unsigned char>& arg_binary) = 0; //!< Returns false if the driver rejects the binary
+	};
+
+	/**\ Struct ShaderCacheStats
+	*	 Counters for the current run, logged at startup
+	*/
+	struct ShaderCacheStats
+	{
+		uint32_t hits = 0; //!< Programs restored from disk
+		uint32_t misses = 0; //!< Programs that had to be compiled from source
+		uint32_t rejected = 0; //!< Binaries the driver refused to load
+		uint32_t corrupt = 0; //!< Files that failed the header or checksum test
+		uint32_t stored = 0; //!< Binaries written this run
+		uint32_t evicted = 0; //!< Files removed to stay under the size limit
+	};
+
+	/**\ Class ShaderProgramCache
+	*	 Stores linked program binaries on disk, keyed by a hash of the preprocessed sources and the driver signature.
+	*	 Least recently used files are evicted once the cache grows beyond its byte limit.
+	*	 Corrupt or rejected entries are deleted, so the next run stores a fresh binary.
+	*/
+	class ShaderProgramCache
+	{
+	public:
+		ShaderProgramCache(const std::shared_ptr<ProgramBinaryDriver>& arg_driver, const std::string& arg_directory, uint64_t arg_maxBytes = 64 * 1024 * 1024);
+
+		uint64_t makeKey(std::initializer_list<const char*> arg_sources) const; //!< Hashes each source (in order) together with the driver signature
+
+		bool load(uint64_t arg_key, uint32_t arg_program); //!< Restores a program. Returns false on a miss, a corrupt file or a rejected binary
+		bool store(uint64_t arg_key, uint32_t arg_program); //!< Writes a freshly linked program to disk
+
+		inline bool isEnabled() const { return m_enabled; }
+		inline const ShaderCacheStats& getStats() const { return m_stats; }
+		inline uint64_t getTotalBytes() const { return m_totalBytes; }
+		inline uint32_t getEntryCount() const { return static_cast<uint32_t>(m_entries.size()); }
+
+		inline static std::shared_ptr<ShaderProgramCache> getInstance() { return s_instance; } //!< Cache used by the shaders, may be null
+		inline static void setInstance(const std::shared_ptr<ShaderProgramCache>& arg_cache) { s_instance = arg_cache; }
+	private:
+		struct Entry
+		{
+			uint64_t size; //!< Size of the file on disk
+			std::list<uint64_t>::iterator lruPosition; //!< Position in the use order
+		};
+
+		/**\ Header at the start of every cache file */
+		struct FileHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t key;
+			uint32_t format;
+			uint32_t size;
+			uint64_t checksum;
+		};
+
+		std::string getPath(uint64_t arg_key) const;
+		void scanDirectory(); //!< Builds the index from the files already on disk, oldest first
+		void touch(uint64_t arg_key); //!< Marks an entry as most recently used
+		void remove(uint64_t arg_key); //!< Deletes an entry and its file
+		void evict(); //!< Removes least recently used entries until under the byte limit
+
+		std::shared_ptr<ProgramBinaryDriver> m_driver;
+		std::string m_directory;
+		uint64_t m_maxBytes;
+		uint64_t m_totalBytes = 0;
+		uint64_t m_driverHash = Fnv1a::s_offsetBasis;
+		bool m_enabled = false;
+
+		std::unordered_map<uint64_t, Entry> m_entries; //!< Index of the files on disk
+		std::list<uint64_t> m_lru; //!< Keys from least to most recently used
+		ShaderCacheStats m_stats;
+
+		static std::shared_ptr<ShaderProgramCache> s_instance;
+		constexpr static uint32_t s_magic = 0x50475342; //!< "BSGP"
+		constexpr static uint32_t s_version = 1; //!< Bump when the file layout changes
+	};
+}
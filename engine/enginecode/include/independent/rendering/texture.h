@@ -10,7 +10,7 @@ namespace Engine {
 	public:
 		static Texture* create(const char* arg_file);
 		static Texture* create(uint32_t arg_width, uint32_t arg_height, uint32_t arg_channels, unsigned char* arg_data);
-		~Texture() = default;
+		virtual ~Texture() = default;
 
 		virtual inline uint32_t getID() = 0;
 		virtual glm::vec2 getSize() = 0;
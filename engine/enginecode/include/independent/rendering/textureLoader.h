@@ -0,0 +1,22 @@
+/** \file textureLoader.h
+*/
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "rendering/texture.h"
+#include "systems/task.h"
+
+namespace Engine {
+	/**\ Class TextureLoader
+	*	 Loads image files as task chains: read and decoded on the workers, then made into a texture on the render
+	*	 thread. A file that can't be read cancels the task, one that is read but won't decode gives the missing texture
+	*/
+	class TextureLoader
+	{
+	public:
+		static Task<std::shared_ptr<Texture>> load(const std::string& arg_path);
+		static std::shared_ptr<Texture> makeMissing(); //!< 1x1 magenta, stands in for a texture that couldn't be loaded
+	};
+}
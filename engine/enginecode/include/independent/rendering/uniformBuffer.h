@@ -6,6 +6,7 @@
 
 #include "bufferLayout.h"
 #include "shader.h"
+#include "systems/stringId.h"
 namespace Engine {
 	class UniformBuffer
 	{
@@ -14,13 +15,13 @@ namespace Engine {
 		virtual ~UniformBuffer() = default;
 
 		virtual void attachShaderBlock(const std::shared_ptr<Shader>& arg_shader, const char* arg_blockName) = 0;
-		virtual void uploadData(const char* arg_Name, void* arg_Data) = 0;
+		virtual void uploadData(StringId arg_Name, void* arg_Data) = 0; //!< A name not in the layout is reported and ignored
 
 		virtual uint32_t getRendererID() = 0;
 		virtual UniformBufferLayout getUBOLayout() = 0;
 	protected:
 		UniformBufferLayout m_UBLayout;
-		std::unordered_map<const char*, std::pair<uint32_t, uint32_t>> m_uniformCache; //!< Maps from name to its offset in size;
+		std::unordered_map<StringId, std::pair<uint32_t, uint32_t>> m_uniformCache; //!< Maps from name to its offset in size, by text rather than pointer
 		uint32_t m_blockNumber;  //<! Binding point on the GPU for the uniform block
 	};
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+/** \file deferredScheduler.h
+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Engine {
+	enum class WorkPriority { High, Normal, Low };
+
+	/**\ Struct DeferredSettings
+	*	 How much of each frame deferred work may have, and how long each priority can be put off
+	*/
+	struct DeferredSettings
+	{
+		uint32_t budgetMicroseconds = 2000; //!< Most a frame gives deferred work, less when the frame has less slack
+		uint32_t targetFrameMicroseconds = 16667; //!< The frame time slack is measured against, 0 uses the budget alone
+		uint32_t minItemsPerFrame = 1; //!< Run however little slack there is, so the queue always drains
+		uint32_t agingMicroseconds[3] = { 0, 50000, 500000 }; //!< By priority, how long an item waits before it is as urgent as a new high one
+	};
+
+	/**\ Struct DeferredStats
+	*	 What the last run() did
+	*/
+	struct DeferredStats
+	{
+		uint32_t pending = 0; //!< Left waiting afterwards
+		uint32_t executed = 0;
+		uint32_t forced = 0; //!< Run over the budget, for a missed deadline or the minimum a frame
+		uint64_t nanoseconds = 0; //!< Spent running items
+		uint64_t totalExecuted = 0; //!< Since the scheduler was made
+	};
+
+	/**\ Class DeferredScheduler
+	*	 Work that has to happen but not this frame, i.e. uploads, glyphs, cache writes, run in whatever time the frame
+	*	 has left. Each item is given a due time when it is posted: its deadline, or the post time plus its priority's
+	*	 aging, and run() takes items earliest due first until the budget is used. So a high priority item goes ahead
+	*	 of a low one posted at the same time, but a low one left long enough overtakes new high ones and can't starve.
+	*	 An item past a deadline it was given runs even with no budget left, and so do the first minItemsPerFrame.
+	*
+	*	 Items can be posted from any thread. run() is called by one thread, the main thread or the render thread from
+	*	 a recorded command, and the items run there. Time comes from timer::now, so tests can use a fake clock.
+	*/
+	class DeferredScheduler
+	{
+	public:
+		using Work = std::function<void()>;
+
+		DeferredScheduler(const DeferredSettings& arg_settings = DeferredSettings());
+
+		void post(Work&& arg_work, WorkPriority arg_priority = WorkPriority::Normal); //!< Runs when there is time, earliest due first
+		void post(Work&& arg_work, uint64_t arg_deadline); //!< Runs by the first run() after timer::now() reaches the deadline, budget or not
+
+		uint32_t run(uint64_t arg_budget); //!< Runs items for up to about arg_budget nanoseconds, returns how many ran
+		uint32_t runFrame(uint64_t arg_frameElapsed); //!< run() with the budget cut to the slack left after the frame's nanoseconds so far
+		void clear(); //!< Drops everything waiting without running it
+
+		inline void setSettings(const DeferredSettings& arg_settings) { std::lock_guard<std::mutex> lock(m_mutex); m_settings = arg_settings; }
+		inline DeferredSettings getSettings() const { std::lock_guard<std::mutex> lock(m_mutex); return m_settings; }
+		uint64_t getBudget(uint64_t arg_frameElapsed) const; //!< Nanoseconds runFrame() would give
+		uint32_t getPendingCount() const;
+		DeferredStats getStats() const; //!< The last run's, from any thread
+	private:
+		struct Item
+		{
+			uint64_t due; //!< Earliest runs first
+			uint64_t sequence; //!< Keeps items due together in posting order
+			Work work;
+
+			/**\ For a heap with the earliest due at the front */
+			inline bool operator<(const Item& arg_other) const { return due != arg_other.due ? due > arg_other.due : sequence > arg_other.sequence; }
+		};
+
+		void push(std::vector<Item>& arg_heap, Item&& arg_item); //!< m_mutex held
+		static Item pop(std::vector<Item>& arg_heap); //!< Takes the front, m_mutex held
+
+		DeferredSettings m_settings;
+		mutable std::mutex m_mutex; //!< Guards the settings, heap and stats, never held while an item runs
+		std::vector<Item> m_heap; //!< Posted by priority, due when aged
+		std::vector<Item> m_deadlines; //!< Posted with a deadline, apart so an overdue one is found however much is due before it
+		uint64_t m_sequence = 0;
+		DeferredStats m_stats;
+	};
+}
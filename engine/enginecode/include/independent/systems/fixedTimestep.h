@@ -0,0 +1,68 @@
+/** \file fixedTimestep.h
+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace Engine {
+	/**\ Class FixedTimestep
+	*	 Turns variable frame times into a whole number of fixed simulation ticks, so physics and gameplay cost and
+	*	 behave the same at any frame rate. Left over time is carried to the next frame and given out as getAlpha(),
+	*	 how far the frame is between the last two ticks, which the renderer interpolates with.
+	*	 A long frame (a hitch, a breakpoint) is capped at a number of catch up ticks and the rest is dropped,
+	*	 otherwise ticking could take longer than the frame did and never catch up.
+	*/
+	class FixedTimestep
+	{
+	public:
+		using Clock = std::function<uint64_t()>; //!< Nanoseconds from any fixed point. Tests pass a fake one
+
+		FixedTimestep(double arg_tickRate = 60.0, uint32_t arg_maxSteps = 5, const Clock& arg_clock = nullptr); //!< A null clock uses timer::now
+
+		uint32_t advance(); //!< Reads the clock, returns how many ticks to simulate this frame
+		/**\ Advances and calls arg_tick(step) for each tick */
+		template <typename F>
+		uint32_t advance(F&& arg_tick)
+		{
+			uint32_t ticks = advance();
+			for (uint32_t i = 0; i < ticks; i++) arg_tick(getStep());
+			return ticks;
+		}
+		void reset(); //!< Restarts the timing with nothing carried over, i.e. after loading
+
+		inline float getAlpha() const { return static_cast<float>(static_cast<double>(m_accumulator) / m_step); } //!< [0, 1) between the previous and current tick
+		inline double getStep() const { return m_step * 1e-9; } //!< Seconds per tick
+		inline double getFrameTime() const { return m_frameTime * 1e-9; } //!< Real seconds the last frame took
+		inline uint64_t getFrameTimeNanoseconds() const { return m_frameTime; } //!< Exactly as read from the clock, for recording
+		inline uint64_t getTickCount() const { return m_tickCount; }
+		inline double getDroppedTime() const { return m_droppedTime * 1e-9; } //!< Seconds thrown away by the catch up cap
+
+		void setTickRate(double arg_tickRate); //!< Ticks per second
+		void setClock(const Clock& arg_clock); //!< i.e. a replay's recorded time. Resets, as the new clock's times mean nothing against the old one's
+		inline void setMaxSteps(uint32_t arg_maxSteps) { m_maxSteps = arg_maxSteps; }
+	private:
+		/**\ Times are kept in whole nanoseconds so ticks add up exactly, floating point would lose one now and then */
+		Clock m_clock;
+		uint64_t m_step;
+		uint32_t m_maxSteps;
+		uint64_t m_lastTime;
+		uint64_t m_accumulator = 0; //!< Time not yet simulated, always less than a step after advance()
+		uint64_t m_frameTime = 0;
+		uint64_t m_droppedTime = 0;
+		uint64_t m_tickCount = 0;
+	};
+
+	/**\ Position and rotation of a simulated object, kept for the previous and current tick so frames can blend them */
+	struct SimTransform
+	{
+		glm::vec3 position = glm::vec3(0.f);
+		glm::quat rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+
+		glm::mat4 toMatrix() const; //!< Translation then rotation
+		static SimTransform interpolate(const SimTransform& arg_previous, const SimTransform& arg_current, float arg_alpha);
+	};
+}
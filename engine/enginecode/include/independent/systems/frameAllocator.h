@@ -0,0 +1,55 @@
+/** \file frameAllocator.h
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "systems/linearAllocator.h"
+
+namespace Engine {
+	/**\ Class FrameAllocator
+	*	 Memory for things that only live for a frame: scratch arrays, strings for the UI, data handed to the render thread.
+	*	 Allocating is a pointer bump and the whole frame is freed at once by the next beginFrame() that comes back round to it.
+	*
+	*	 Buffered like the render thread: memory from frame N stays valid until frame N + bufferCount begins,
+	*	 so a command recorded for the render thread can point into it. Two buffers match RenderThread's one frame lag,
+	*	 three allow for one more frame in flight.
+	*	 Main thread only. Jobs should use their own LinearAllocator, as DrawList does, to stay lock free.
+	*/
+	class FrameAllocator
+	{
+	public:
+		constexpr static uint32_t s_maxBuffers = 3;
+
+		static void setBufferCount(uint32_t arg_count); //!< 2 or 3, frees every buffer so only call it between frames
+		static void beginFrame(); //!< Moves to the next buffer and frees what it held
+		static void shutdown(); //!< Gives every buffer's blocks back to the heap, once the render thread has stopped
+
+		inline static void* allocate(size_t arg_size, size_t arg_alignment = alignof(std::max_align_t)) { return get().allocate(arg_size, arg_alignment); }
+		template <typename T, typename... Args>
+		static T* create(Args&&... arg_args) { return get().create<T>(std::forward<Args>(arg_args)...); }
+		static const char* format(const char* arg_format, ...); //!< printf into this frame's memory
+
+		inline static LinearAllocator& get() { return s_buffers[s_current]; } //!< This frame's buffer, i.e. for a ScopedArena
+		template <typename T>
+		inline static ArenaAllocator<T> getAdapter() { return ArenaAllocator<T>(get()); } //!< For a FrameVector or FrameString
+
+		inline static uint64_t getFrame() { return s_frame; }
+		inline static uint32_t getBufferCount() { return s_bufferCount; }
+		inline static size_t getBytesUsed() { return get().getBytesUsed(); } //!< This frame so far
+		static size_t getPeakBytesUsed(); //!< Most any frame has used
+		static size_t getCapacity(); //!< Across every buffer
+		static uint32_t getBlockCount(); //!< Across every buffer, only grows while the frames are getting bigger
+	private:
+		static LinearAllocator s_buffers[s_maxBuffers];
+		static uint32_t s_bufferCount;
+		static uint32_t s_current;
+		static uint64_t s_frame;
+	};
+
+	template <typename T>
+	using FrameVector = std::vector<T, ArenaAllocator<T>>; //!< Constructed with FrameAllocator::getAdapter<T>(), or any ArenaAllocator
+	using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+}
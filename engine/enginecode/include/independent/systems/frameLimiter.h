@@ -0,0 +1,41 @@
+/** \file frameLimiter.h
+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Engine {
+	/**\ Class FrameLimiter
+	*	 Holds frames to a target rate without vsync. Waiting sleeps until it is close to the deadline, then spins for
+	*	 the rest, as a sleep can wake a millisecond or more late. The spin threshold trades CPU for precision:
+	*	 raise it if getLastOvershoot() is often large, lower it to burn less.
+	*	 Deadlines advance by exactly one frame so small overshoots don't add up. A frame that runs more than a whole
+	*	 frame late starts the schedule again instead of trying to catch up.
+	*	 Time comes from timer::now, and the sleep can be swapped out, so it can be tested with a fake clock.
+	*/
+	class FrameLimiter
+	{
+	public:
+		using SleepFunc = std::function<void(uint64_t)>; //!< Sleeps for about this many nanoseconds
+
+		FrameLimiter(uint32_t arg_frameMicroseconds = 0, uint32_t arg_spinMicroseconds = 1500, const SleepFunc& arg_sleep = nullptr); //!< A zero frame time is off
+
+		uint64_t wait(); //!< Blocks until the next frame is due, returns the nanoseconds waited
+		inline void reset() { m_deadline = 0; } //!< Starts the schedule again from the next wait
+
+		void setTargetRate(double arg_framesPerSecond); //!< Zero turns the limiter off
+		inline void setFrameTime(uint32_t arg_microseconds) { m_frame = arg_microseconds * 1000ull; reset(); }
+		inline void setSpinThreshold(uint32_t arg_microseconds) { m_spin = arg_microseconds * 1000ull; } //!< How long before the deadline sleeping stops
+		inline uint32_t getFrameTime() const { return static_cast<uint32_t>(m_frame / 1000); } //!< Microseconds
+		inline uint32_t getSpinThreshold() const { return static_cast<uint32_t>(m_spin / 1000); } //!< Microseconds
+		inline bool isEnabled() const { return m_frame != 0; }
+		inline uint64_t getLastOvershoot() const { return m_overshoot; } //!< Nanoseconds the last wait returned after its deadline
+	private:
+		uint64_t m_frame; //!< Nanoseconds per frame
+		uint64_t m_spin;
+		SleepFunc m_sleep;
+		uint64_t m_deadline = 0; //!< When the current frame should end, 0 before the first wait
+		uint64_t m_overshoot = 0;
+	};
+}
@@ -0,0 +1,44 @@
+/** \file frameStats.h
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+	/**\ Class FrameStats
+	*	 Frame times over a rolling window of recent frames: average, percentiles and a histogram.
+	*	 A single frame's time is too noisy to show, and an average hides the stutters the high percentiles catch.
+	*	 The histogram is kept up to date as frames come and go, percentiles are worked out when asked for.
+	*/
+	class FrameStats
+	{
+	public:
+		FrameStats(uint32_t arg_windowSize = 240, uint32_t arg_bucketMicroseconds = 500, uint32_t arg_bucketCount = 100);
+
+		void addFrame(uint64_t arg_nanoseconds);
+		void clear();
+
+		uint64_t getPercentile(float arg_percent) const; //!< Nanoseconds, nearest rank. 0 with no frames
+		inline uint64_t getAverage() const { return m_count ? m_total / m_count : 0; } //!< Nanoseconds
+		inline float getFps() const { return m_total ? m_count * 1e9f / m_total : 0.f; } //!< From the average, not one frame
+		inline float getMilliseconds(float arg_percent) const { return getPercentile(arg_percent) * 1e-6f; }
+
+		inline const std::vector<uint32_t>& getHistogram() const { return m_histogram; } //!< Frames per bucket, the last also counts everything longer
+		inline uint32_t getBucketMicroseconds() const { return m_bucketMicroseconds; }
+		inline uint32_t getCount() const { return m_count; }
+	private:
+		uint32_t getBucket(uint64_t arg_nanoseconds) const;
+
+		std::vector<uint64_t> m_samples; //!< Ring buffer of the window
+		uint32_t m_next = 0;
+		uint32_t m_count = 0;
+		uint64_t m_total = 0;
+
+		uint32_t m_bucketMicroseconds;
+		std::vector<uint32_t> m_histogram;
+
+		mutable std::vector<uint64_t> m_sorted; //!< Sorted copy of the window, rebuilt on the first query after a change
+		mutable bool m_sortedValid = false;
+	};
+}
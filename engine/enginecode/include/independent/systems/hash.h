@@ -0,0 +1,33 @@
+/** \file hash.h
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Engine {
+	/**\ Class Fnv1a
+	*	 The engine's 64 bit FNV-1a, for names and for keying and checking data. Constexpr, so literals can be hashed at
+	*	 compile time. Passing one result as the seed of the next hashes several pieces as if they were one
+	*/
+	class Fnv1a
+	{
+	public:
+		constexpr static uint64_t s_offsetBasis = 14695981039346656037ull;
+		constexpr static uint64_t s_prime = 1099511628211ull;
+
+		constexpr static uint64_t hash(std::string_view arg_text, uint64_t arg_hash = s_offsetBasis)
+		{
+			for (char c : arg_text) {
+				arg_hash ^= static_cast<uint8_t>(c);
+				arg_hash *= s_prime;
+			}
+			return arg_hash;
+		}
+		inline static uint64_t hashBytes(const void* arg_data, size_t arg_size, uint64_t arg_hash = s_offsetBasis)
+		{
+			return hash(std::string_view(static_cast<const char*>(arg_data), arg_size), arg_hash);
+		}
+	};
+}
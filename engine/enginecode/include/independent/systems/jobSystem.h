@@ -0,0 +1,93 @@
+/** \file jobSystem.h
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "system.h"
+#include "workStealingDeque.h"
+
+namespace Engine {
+	struct Job; //!< A queued function, private to the job system
+
+	/**\ Class JobCounter
+	*	 Counts unfinished jobs. Jobs can be made to wait for a counter to reach zero,
+	*	 and jobSystem::wait runs other jobs until it does.
+	*	 A counter has to stay alive until it has been waited on, including one only used as a dependency.
+	*/
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		inline bool isDone() const { return m_count.load() == 0 && m_finishing.load() == 0; }
+		inline uint32_t getCount() const { return m_count.load(std::memory_order_acquire); }
+	private:
+		friend class jobSystem;
+		std::atomic<uint32_t> m_count{ 0 };
+		std::atomic<uint32_t> m_finishing{ 0 }; //!< Jobs still touching the counter after lowering it. The owner may destroy it once this is zero too
+		std::mutex m_waitersMutex;
+		std::vector<Job*> m_waiters; //!< Jobs that start once the count reaches zero
+	};
+
+	/**\ Class jobSystem
+	*	 Runs jobs on one thread per core. The thread that starts the system is worker 0 and runs jobs while it waits.
+	*	 Each worker has its own lock free deque, idle workers steal from the others.
+	*	 Jobs submitted from threads outside the system go through a shared queue.
+	*	 If the system isn't running jobs run straight away on the calling thread.
+	*/
+	class jobSystem : public System
+	{
+	public:
+		jobSystem(uint32_t arg_workerCount = 0); //!< Zero for one worker per core
+		~jobSystem();
+
+		void start(SystemSignal init = SystemSignal::None, ...);
+		void stop(SystemSignal init = SystemSignal::None, ...);
+
+		static void run(const std::function<void()>& arg_job, JobCounter* arg_counter = nullptr, JobCounter* arg_dependency = nullptr); //!< Queues a job. The counter is raised until it finishes, and it won't start until the dependency is done
+		static void wait(JobCounter& arg_counter); //!< Runs other jobs until the counter reaches zero
+		static bool help(); //!< Runs one queued job on the calling thread, for a thread polling for something jobs finish. False if there was none
+		static void parallelFor(uint32_t arg_count, uint32_t arg_batchSize, const std::function<void(uint32_t, uint32_t)>& arg_func); //!< Calls func(begin, end) over [0, count) in batches and waits. A batch size of 0 picks one
+
+		inline static uint32_t getWorkerCount() { return s_running ? static_cast<uint32_t>(s_workers.size()) : 1; }
+		inline static bool isRunning() { return s_running; }
+	private:
+		/**\ Per worker state, on its own cache lines */
+		struct Worker
+		{
+			WorkStealingDeque<Job> deque;
+			std::thread thread;
+			uint32_t randomState; //!< Picks the next victim to steal from
+		};
+
+		static void workerLoop(uint32_t arg_index);
+		static void submit(Job* arg_job); //!< Pushes a job that is ready to run
+		static Job* findJob(); //!< Own deque, then the shared queue, then the other workers
+		static void execute(Job* arg_job);
+		static void release(JobCounter& arg_counter); //!< Submits the jobs waiting on a counter that has reached zero
+		static void sleep(uint64_t arg_generation); //!< Blocks an idle worker until new work is submitted
+
+		uint32_t m_requestedWorkers;
+
+		static std::vector<std::unique_ptr<Worker>> s_workers;
+		static std::atomic<bool> s_running;
+
+		static std::mutex s_sharedMutex; //!< Guards the shared queue
+		static std::vector<Job*> s_shared; //!< Jobs from threads that aren't workers, or from a full deque
+
+		static std::mutex s_sleepMutex;
+		static std::condition_variable s_wake;
+		static std::atomic<uint64_t> s_workGeneration; //!< Bumped on every submit so a sleeping worker can tell it missed nothing
+		static std::atomic<uint32_t> s_sleeping;
+	};
+}
@@ -0,0 +1,30 @@
+/** \file latencyStats.h
+*/
+#pragma once
+
+#include "systems/frameStats.h"
+
+namespace Engine {
+	/**\ Struct LatencySettings
+	*	 Trades throughput for input latency, for games where reaction time matters
+	*/
+	struct LatencySettings
+	{
+		bool lowLatency = false; //!< Polls input after the frame limiter's wait rather than before it, so sleeping doesn't age it
+		bool waitForGpu = false; //!< Each present waits for the GPU and the next frame waits for the present, so no frames queue up
+	};
+
+	/**\ Struct LatencyStats
+	*	 The parts of input to screen latency the engine can see, over the same rolling window as the frame times.
+	*	 Scanout and the display aren't included, so this is a lower bound
+	*/
+	struct LatencyStats
+	{
+		FrameStats sampleToSubmit; //!< Input polled to the frame using it being handed to the render thread
+		FrameStats eventToSubmit; //!< The frame's oldest input event being queued to submit, for frames with input
+		FrameStats submitToPresent; //!< Handed to the render thread to its present returning, or the GPU finishing with waitForGpu
+
+		inline uint64_t getAverage() const { return sampleToSubmit.getAverage() + submitToPresent.getAverage(); } //!< Nanoseconds from sampling to present
+		inline void clear() { sampleToSubmit.clear(); eventToSubmit.clear(); submitToPresent.clear(); }
+	};
+}
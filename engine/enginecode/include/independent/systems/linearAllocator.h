@@ -0,0 +1,120 @@
+/** \file linearAllocator.h
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+	/**\ Class LinearAllocator
+	*	 Hands out memory by bumping a pointer through large blocks, and frees all of it at once with reset().
+	*	 Nothing is freed individually and destructors are not run, so it is meant for trivially destructible data.
+	*	 Not thread safe: give each thread its own, which is what makes allocating from it lock free.
+	*	 Blocks are kept across resets, so once it has grown to fit a frame it stops touching the heap.
+	*/
+	class LinearAllocator
+	{
+	public:
+		LinearAllocator(size_t arg_blockSize = 64 * 1024) : m_blockSize(arg_blockSize) {}
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		void* allocate(size_t arg_size, size_t arg_alignment = alignof(std::max_align_t)); //!< Never returns nullptr, a new block is added when needed
+
+		/**\ Allocates and constructs a T */
+		template <typename T, typename... Args>
+		T* create(Args&&... arg_args)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "LinearAllocator never runs destructors");
+			return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(arg_args)...);
+		}
+
+		void reset(); //!< Frees everything allocated so far
+		void release(); //!< As reset(), and gives the blocks back to the heap
+
+		/**\ A position to rewind to, freeing everything allocated after it. Used by ScopedArena */
+		struct Marker
+		{
+			size_t block;
+			size_t offset;
+			size_t bytesUsed;
+		};
+		inline Marker getMarker() const { return { m_currentBlock, m_offset, m_bytesUsed }; }
+		void rewind(const Marker& arg_marker);
+
+		inline size_t getBytesUsed() const { return m_bytesUsed; } //!< Since the last reset, including alignment padding
+		inline size_t getPeakBytesUsed() const { return m_peakBytesUsed; } //!< Most ever in use at once, what the blocks need to hold without spilling
+		inline size_t getCapacity() const { return m_capacity; } //!< Total size of the blocks
+		inline uint32_t getBlockCount() const { return static_cast<uint32_t>(m_blocks.size()); } //!< Every block is a heap allocation, this stops growing once warm
+	private:
+		struct Block
+		{
+			std::unique_ptr<unsigned char[]> data;
+			size_t size;
+		};
+
+		size_t m_blockSize;
+		std::vector<Block> m_blocks;
+		size_t m_currentBlock = 0; //!< Block being allocated from
+		size_t m_offset = 0; //!< Position in the current block
+		size_t m_bytesUsed = 0;
+		size_t m_peakBytesUsed = 0;
+		size_t m_capacity = 0;
+	};
+
+	/**\ Class ScopedArena
+	*	 Frees everything allocated from a LinearAllocator during its lifetime when it goes out of scope, so a
+	*	 function can use scratch memory without keeping it for the rest of the frame.
+	*	 Arenas on the same allocator have to be nested, the inner one ending first.
+	*/
+	class ScopedArena
+	{
+	public:
+		ScopedArena(LinearAllocator& arg_allocator) : m_allocator(arg_allocator), m_marker(arg_allocator.getMarker()) {}
+		~ScopedArena() { m_allocator.rewind(m_marker); }
+		ScopedArena(const ScopedArena&) = delete;
+		ScopedArena& operator=(const ScopedArena&) = delete;
+
+		inline void* allocate(size_t arg_size, size_t arg_alignment = alignof(std::max_align_t)) { return m_allocator.allocate(arg_size, arg_alignment); }
+		template <typename T, typename... Args>
+		T* create(Args&&... arg_args) { return m_allocator.create<T>(std::forward<Args>(arg_args)...); }
+
+		inline LinearAllocator& getAllocator() { return m_allocator; }
+	private:
+		LinearAllocator& m_allocator;
+		LinearAllocator::Marker m_marker;
+	};
+
+	/**\ Class ArenaAllocator
+	*	 Lets standard containers take their memory from a LinearAllocator, i.e. std::vector<T, ArenaAllocator<T>>.
+	*	 Deallocating does nothing, the memory comes back when the allocator is reset or rewound, so a container
+	*	 that grows leaves its old buffers behind until then. Reserve up front where the size is known.
+	*	 The container must not outlive the memory, and must not free its elements after a reset.
+	*/
+	template <typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator(LinearAllocator& arg_allocator) : m_allocator(&arg_allocator) {}
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U>& arg_other) : m_allocator(arg_other.getAllocator()) {}
+
+		inline T* allocate(size_t arg_count) { return static_cast<T*>(m_allocator->allocate(arg_count * sizeof(T), alignof(T))); }
+		inline void deallocate(T*, size_t) {}
+
+		inline LinearAllocator* getAllocator() const { return m_allocator; }
+		template <typename U>
+		inline bool operator==(const ArenaAllocator<U>& arg_other) const { return m_allocator == arg_other.getAllocator(); }
+		template <typename U>
+		inline bool operator!=(const ArenaAllocator<U>& arg_other) const { return m_allocator != arg_other.getAllocator(); }
+	private:
+		LinearAllocator* m_allocator;
+	};
+}
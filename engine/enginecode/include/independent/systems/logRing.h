@@ -0,0 +1,29 @@
+/** \file logRing.h
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <spdlog/spdlog.h>
+
+#include "systems/mpscRing.h"
+
+namespace Engine {
+	/**\ Struct LogRecord
+	*	 One message in the ring, formatted by the thread that logged it. Longer text is cut short
+	*/
+	struct alignas(64) LogRecord
+	{
+		constexpr static size_t s_textSize = 224;
+
+		std::atomic<uint64_t> sequence; //!< Ring bookkeeping, see MPSCRing
+		spdlog::log_clock::time_point time;
+		size_t threadId;
+		spdlog::level::level_enum level;
+		uint16_t length;
+		char text[s_textSize];
+	};
+
+	using LogRing = MPSCRing<LogRecord>; //!< Filled by the log calls, emptied by the writer thread
+}
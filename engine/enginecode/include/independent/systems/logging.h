@@ -4,19 +4,55 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
+#include <atomic>
+#include <exception>
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
 
 #include "system.h"
+#include "systems/logRing.h"
 
-
-
-/**
-\class Logging class for writitng to console
+/**\ Log calls below this level are compiled out: 0 trace, 1 debug, 2 info, 3 warn, 4 error, 5 critical.
+*	 Release builds keep warnings and above. Define it on the command line to choose
 */
+#ifndef NG_LOG_LEVEL
+#ifdef NG_RELEASE
+#define NG_LOG_LEVEL 3
+#else
+#define NG_LOG_LEVEL 1
+#endif
+#endif
+
 namespace Engine {
+	/**\ What a log call does when the ring is full */
+	enum class LogOverflow
+	{
+		Drop, //!< Counts it and returns, the writer reports how many went
+		Block //!< Waits for the writer to make room
+	};
+
+	/**\ Struct LogSettings
+	*	 Read by logging::start()
+	*/
+	struct LogSettings
+	{
+		bool console = true;
+		std::string filePath = "logs/engine.log"; //!< Empty for no file
+		size_t maxFileSize = 5 * 1024 * 1024; //!< Before the file is rotated
+		uint32_t maxFiles = 3; //!< Rotated files kept
+		uint32_t ringCapacity = 8192; //!< Messages waiting for the writer, 256 bytes each
+		LogOverflow overflow = LogOverflow::Drop;
+	};
+
+	/**
+	\class Logging class for writing to the console and a log file.
+	*	 A log call formats its message straight into a record in a lock free ring, without allocating or taking a lock,
+	*	 and a writer thread passes the records to the sinks. Messages longer than LogRecord::s_textSize are cut short.
+	*	 Calls made while the logger isn't running are dropped. A call counts itself in while it uses the ring, and stop()
+	*	 waits for those in flight before freeing it, so a thread still logging during shutdown loses its message, nothing worse.
+	*/
 	class logging : public System
 	{
 	public:
@@ -27,15 +63,60 @@ namespace Engine {
 		void log(const std::string& msg);
 		void log(const std::string& msg, const float& flt);
 
-		inline static std::shared_ptr<spdlog::logger> getLogger() { return s_logger; }
+		static void setSettings(const LogSettings& arg_settings) { s_settings = arg_settings; } //!< Takes effect at the next start()
+		static const LogSettings& getSettings() { return s_settings; }
+		static void setLevel(spdlog::level::level_enum arg_level) { s_level.store(arg_level, std::memory_order_relaxed); } //!< Runtime filter, on top of NG_LOG_LEVEL
+		static void flush(); //!< Waits until everything logged so far has been written out
+
+		inline static bool isRunning() { return s_running.load(std::memory_order_acquire); }
+		inline static bool shouldLog(spdlog::level::level_enum arg_level) { return arg_level >= s_level.load(std::memory_order_relaxed) && isRunning(); }
+		inline static uint64_t getDroppedCount() { return s_dropped.load(std::memory_order_relaxed); } //!< Since the program began
+
+		/**\ Logs text as it is */
+		static void write(spdlog::level::level_enum arg_level, std::string_view arg_text);
+
+		/**\ Logs a message formatted with fmt, i.e. write(spdlog::level::info, "{0} bodies", count) */
+		template <typename Arg, typename... Args>
+		static void write(spdlog::level::level_enum arg_level, const char* arg_format, const Arg& arg_arg, const Args&... arg_args)
+		{
+			if (!shouldLog(arg_level)) return;
+			uint64_t ticket;
+			LogRecord* record = claim(ticket);
+			if (!record) return;
+			try {
+				auto result = fmt::vformat_to_n(record->text, LogRecord::s_textSize, fmt::string_view(arg_format), fmt::make_format_args(arg_arg, arg_args...));
+				record->length = static_cast<uint16_t>(result.size < LogRecord::s_textSize ? result.size : LogRecord::s_textSize);
+			}
+			catch (const std::exception& e) {
+				record->length = 0;
+				append(*record, "Bad log format \"");
+				append(*record, arg_format);
+				append(*record, "\": ");
+				append(*record, e.what());
+			}
+			publish(*record, ticket, arg_level);
+		}
 	private:
-		static std::shared_ptr<spdlog::logger> s_logger;
+		static LogRecord* claim(uint64_t& arg_ticket); //!< Counts the call in and applies the overflow policy, nullptr (counted out) if the message is dropped
+		static void publish(LogRecord& arg_record, uint64_t arg_ticket, spdlog::level::level_enum arg_level); //!< Counts the call out
+		static void append(LogRecord& arg_record, std::string_view arg_text); //!< As much as fits
+
+		static LogSettings s_settings;
+		static std::unique_ptr<LogRing> s_ring;
+		static std::atomic<bool> s_running;
+		static std::atomic<uint32_t> s_inFlight; //!< Calls between claim() and publish(), or in flush()
+		static std::atomic<spdlog::level::level_enum> s_level;
+		static std::atomic<uint64_t> s_dropped;
 	};
 }
 
-#define LOG(...) Engine::logging::getLogger()->log(__VA_ARGS__)
-#define LOG_INFO(...) Engine::logging::getLogger()->info(__VA_ARGS__)
-#define LOG_WARN(...) Engine::logging::getLogger()->warn(__VA_ARGS__)
-#define LOG_ERROR(...) Engine::logging::getLogger()->error(__VA_ARGS__)
-#define LOG_CRITICAL(...) Engine::logging::getLogger()->critical(__VA_ARGS__)
-#define LOG_DEBUG(...) Engine::logging::getLogger()->debug(__VA_ARGS__)
+#define LOG(...) Engine::logging::write(__VA_ARGS__)
+
+/**\ Compiled out calls still type check their arguments but never evaluate them */
+#define NG_LOG_AT(level, ...) do { if (static_cast<int>(level) >= NG_LOG_LEVEL) Engine::logging::write(level, __VA_ARGS__); } while (0)
+
+#define LOG_DEBUG(...) NG_LOG_AT(spdlog::level::debug, __VA_ARGS__)
+#define LOG_INFO(...) NG_LOG_AT(spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN(...) NG_LOG_AT(spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERROR(...) NG_LOG_AT(spdlog::level::err, __VA_ARGS__)
+#define LOG_CRITICAL(...) NG_LOG_AT(spdlog::level::critical, __VA_ARGS__)
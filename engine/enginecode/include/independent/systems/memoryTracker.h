@@ -0,0 +1,98 @@
+/** \file memoryTracker.h
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**\ How much the global new and delete hooks track:
+*		0 no hooks, the stats all read zero
+*		1 live bytes, peak bytes and allocation counts per tag. A 16 byte header and a couple of adds to the thread's own counts per allocation
+*		2 as 1, plus every live allocation is listed with a callstack for the leak report
+*	 Defaults to 2 in debug builds and 1 otherwise. Define it on the command line to choose
+*/
+#ifndef NG_MEMORY_TRACKING
+#ifdef NG_DEBUG
+#define NG_MEMORY_TRACKING 2
+#else
+#define NG_MEMORY_TRACKING 1
+#endif
+#endif
+
+namespace Engine {
+	/**\ What an allocation is for. Each thread has a current tag, set with a MemoryTagScope */
+	enum class MemoryTag : uint8_t
+	{
+		General,
+		Rendering,
+		Physics,
+		Fonts,
+		Assets,
+		Events,
+		Logging,
+		Scene,
+		Count
+	};
+
+	/**\ Struct MemoryStats
+	*	 One tag's figures, or all of them together
+	*/
+	struct MemoryStats
+	{
+		uint64_t liveBytes = 0; //!< As asked for, not counting the tracker's header
+		uint64_t peakBytes = 0; //!< Most seen live when the stats were read or a frame began, a spike within a frame is missed
+		uint64_t liveAllocations = 0;
+		uint64_t allocations = 0; //!< Ever made
+		uint64_t frameAllocations = 0; //!< During the last whole frame, between the last two beginFrame() calls
+	};
+
+	/**\ Class MemoryTracker
+	*	 Counts every allocation in the program through global operator new and delete, under the tag of the thread
+	*	 that made it. C libraries that take an allocator (FreeType, ReactPhysics3D) are given allocate() and release().
+	*	 A free is counted against the tag it was allocated under, whichever thread frees it.
+	*	 Each thread counts into its own slot without locked instructions, reading the stats adds the slots up,
+	*	 so the stats and frame calls are for the main thread, once a frame or so.
+	*
+	*	 Steady state frames shouldn't allocate: getAllocationCount() before and after a stretch of frames is the check,
+	*	 and getStats().frameAllocations shows which system is to blame.
+	*	 With NG_MEMORY_TRACKING at 2, reportLeaks() logs everything allocated since markLeakCheck() that is still live.
+	*/
+	class MemoryTracker
+	{
+	public:
+		constexpr static uint32_t s_tagCount = static_cast<uint32_t>(MemoryTag::Count);
+		constexpr static uint32_t s_callstackDepth = 12;
+
+		inline static constexpr bool isEnabled() { return NG_MEMORY_TRACKING > 0; }
+		static const char* getTagName(MemoryTag arg_tag);
+
+		static MemoryTag getTag(); //!< The calling thread's current tag
+		static MemoryTag setTag(MemoryTag arg_tag); //!< Returns the tag it replaces
+
+		static void* allocate(size_t arg_size, MemoryTag arg_tag, size_t arg_alignment = 16); //!< Tracked like new, for C libraries. nullptr when out of memory
+		static void* reallocate(void* arg_memory, size_t arg_size); //!< Keeps the original tag
+		static void release(void* arg_memory); //!< Only for memory from allocate() or reallocate()
+
+		static void beginFrame(); //!< Closes the frame's allocation counts, main thread
+		static MemoryStats getStats(MemoryTag arg_tag);
+		static MemoryStats getTotal(); //!< Every tag together, the peak is of the total
+		static uint64_t getAllocationCount(); //!< Ever made, across every tag
+
+		static void markLeakCheck(); //!< Allocations from here on are reported if still live
+		static uint32_t reportLeaks(uint32_t arg_maxListed = 32); //!< Logs the leaks with their callstacks, returns how many there are. Only counts with NG_MEMORY_TRACKING at 2
+	};
+
+	/**\ Class MemoryTagScope
+	*	 Tags everything the calling thread allocates until it goes out of scope
+	*/
+	class MemoryTagScope
+	{
+	public:
+		MemoryTagScope(MemoryTag arg_tag) : m_previous(MemoryTracker::setTag(arg_tag)) {}
+		~MemoryTagScope() { MemoryTracker::setTag(m_previous); }
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+	private:
+		MemoryTag m_previous;
+	};
+}
@@ -0,0 +1,79 @@
+/** \file mpscRing.h
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Engine {
+	/**\ Class MPSCRing
+	*	 Bounded lock free queue of Records, for any number of producers and one consumer. A Record has a
+	*	 std::atomic<uint64_t> sequence member the ring uses and whatever else it likes.
+	*	 A producer claims a record with a compare and swap, writes into it in place and publishes it.
+	*	 Each record carries a sequence number saying whether it is free, being written or ready, so a slow producer
+	*	 only holds up the consumer, never the other producers.
+	*/
+	template <typename Record>
+	class MPSCRing
+	{
+	public:
+		/**\ Capacity is rounded up to a power of two */
+		MPSCRing(uint32_t arg_capacity)
+		{
+			uint64_t capacity = 2;
+			while (capacity < arg_capacity) capacity <<= 1;
+			m_records.reset(new Record[capacity]);
+			m_mask = capacity - 1;
+			for (uint64_t i = 0; i < capacity; i++) m_records[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		MPSCRing(const MPSCRing&) = delete;
+		MPSCRing& operator=(const MPSCRing&) = delete;
+
+		/**\ A record to write into, or nullptr when the ring is full */
+		inline Record* tryClaim(uint64_t& arg_ticket)
+		{
+			uint64_t position = m_claimed.load(std::memory_order_relaxed);
+			for (;;) {
+				Record& record = m_records[position & m_mask];
+				int64_t difference = static_cast<int64_t>(record.sequence.load(std::memory_order_acquire) - position);
+				if (difference == 0) {
+					if (m_claimed.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						arg_ticket = position;
+						return &record;
+					}
+				}
+				else if (difference < 0) return nullptr; //!< The consumer hasn't finished with it
+				else position = m_claimed.load(std::memory_order_relaxed);
+			}
+		}
+		inline void publish(Record& arg_record, uint64_t arg_ticket) { arg_record.sequence.store(arg_ticket + 1, std::memory_order_release); }
+
+		/**\ Consumer only. The oldest record if it has been published */
+		inline Record* front()
+		{
+			Record& record = m_records[m_released & m_mask];
+			return record.sequence.load(std::memory_order_acquire) == m_released + 1 ? &record : nullptr;
+		}
+		/**\ Consumer only. The record arg_offset places behind the oldest, if it has been published */
+		inline Record* peek(uint32_t arg_offset)
+		{
+			Record& record = m_records[(m_released + arg_offset) & m_mask];
+			return record.sequence.load(std::memory_order_acquire) == m_released + arg_offset + 1 ? &record : nullptr;
+		}
+		inline void popFront()
+		{
+			m_records[m_released & m_mask].sequence.store(m_released + m_mask + 1, std::memory_order_release);
+			m_released++;
+		}
+
+		inline uint32_t getCapacity() const { return static_cast<uint32_t>(m_mask + 1); }
+		inline uint64_t getClaimed() const { return m_claimed.load(std::memory_order_relaxed); } //!< Records ever claimed
+		inline uint64_t getReleased() const { return m_released; } //!< Records ever consumed, consumer only
+	private:
+		std::unique_ptr<Record[]> m_records;
+		uint64_t m_mask;
+		alignas(64) std::atomic<uint64_t> m_claimed{ 0 }; //!< Shared by the producers
+		alignas(64) uint64_t m_released = 0; //!< The consumer's
+	};
+}
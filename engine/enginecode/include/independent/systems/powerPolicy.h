@@ -0,0 +1,76 @@
+/** \file powerPolicy.h
+*/
+#pragma once
+
+#include <cstdint>
+
+#include "events/eventDispatchTable.h"
+#include "events/keyEvents.h"
+#include "events/mouseEvents.h"
+#include "events/windowEvents.h"
+
+namespace Engine {
+	enum class PowerState { Active, Background, Minimized }; //!< Focused, unfocused, or nothing on screen
+
+	/**\ Struct PowerSettings
+	*	 How hard the loop runs in each state. Rates are frames a second for the frame limiter, 0 leaves frames to vsync
+	*/
+	struct PowerSettings
+	{
+		double activeRate = 0.0;
+		double backgroundRate = 15.0; //!< Unfocused windows still draw, at a rate nobody notices
+		float waitTime = 0.05f; //!< Seconds to wait for events when there is nothing to draw. Keep it under the FixedTimestep's catch up cap
+		bool onDemand = false; //!< Draw only when markDirty() has been called or input came in, for tools
+	};
+
+	/**\ Struct FramePlan
+	*	 What the loop should do this frame
+	*/
+	struct FramePlan
+	{
+		bool render = true; //!< Draw and present. When false the frame is skipped but the simulation still ticks
+		double frameRate = 0.0; //!< For the frame limiter
+		float waitTime = 0.f; //!< Seconds to wait for events in place of polling, 0 polls
+		bool changed = false; //!< The state or settings changed since the last plan, so frameRate needs applying
+	};
+
+	/**\ Class PowerPolicy
+	*	 Throttles the loop when the window can't be seen or isn't being used. Its handlers follow focus and
+	*	 minimising, a resize to nothing, and beginFrame() turns that into a FramePlan:
+	*		Active		draws at activeRate
+	*		Background	draws at backgroundRate
+	*		Minimized	doesn't draw, and waits for events rather than spinning
+	*	 The simulation is left alone in every state, the FixedTimestep keeps it at its own rate whatever the frames do.
+	*	 In on demand mode a frame is only drawn after markDirty() or an input or window event, otherwise the loop
+	*	 waits for events. Main thread only.
+	*/
+	class PowerPolicy
+	{
+	public:
+		PowerPolicy(const PowerSettings& arg_settings = PowerSettings());
+
+		void addHandlers(EventDispatchTable& arg_table); //!< Ahead of handlers that handle these events. Never handles one itself
+		FramePlan beginFrame(); //!< The plan for this frame, which uses up any dirty mark when it draws
+
+		inline void markDirty() { m_dirty = true; } //!< Something on screen changed, on demand mode draws the next frame
+		void setSettings(const PowerSettings& arg_settings);
+		inline const PowerSettings& getSettings() const { return m_settings; }
+
+		PowerState getState() const;
+		inline uint64_t getSkippedFrames() const { return m_skipped; } //!< Frames not drawn, for showing the saving
+	private:
+		bool onWindowFocus(WindowFocusEvent& e);
+		bool onWindowLostFocus(WindowLostFocusEvent& e);
+		bool onWindowResize(WindowResizeEvent& e);
+		template <typename T>
+		bool onInput(T& e) { m_dirty = true; return false; }
+
+		PowerSettings m_settings;
+		bool m_focused = true;
+		bool m_minimized = false;
+		bool m_dirty = true; //!< The first frame is always drawn
+		bool m_changed = true;
+		PowerState m_lastState = PowerState::Active;
+		uint64_t m_skipped = 0;
+	};
+}
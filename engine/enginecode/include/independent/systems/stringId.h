@@ -0,0 +1,64 @@
+/** \file stringId.h
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "systems/hash.h"
+
+/**\ Whether StringId keeps the text of interned ids, for getText() and to catch two strings hashing the same.
+*	 Defaults to on in debug builds and off otherwise. Define it on the command line to choose
+*/
+#ifndef NG_STRING_TABLE
+#ifdef NG_DEBUG
+#define NG_STRING_TABLE 1
+#else
+#define NG_STRING_TABLE 0
+#endif
+#endif
+
+namespace Engine {
+	/**\ Class StringId
+	*	 A name as a 64 bit FNV-1a hash, so looking it up is an integer compare and two copies of the same text are
+	*	 always equal, where a const char* key only matches the same pointer. Made from a literal it can be hashed at
+	*	 compile time:
+	*		constexpr StringId s_view("u_view");
+	*	 and literals convert implicitly, so uploadData("u_view", ...) still reads as before.
+	*	 Runtime strings that should be found again by their text, i.e. layout names, go through intern()
+	*/
+	class StringId
+	{
+	public:
+		constexpr StringId() = default; //!< Invalid, matches nothing made from text
+		constexpr StringId(const char* arg_text) : m_hash(arg_text ? hash(arg_text) : 0) {} //!< Null is the invalid id
+		constexpr explicit StringId(std::string_view arg_text) : m_hash(hash(arg_text)) {}
+
+		static StringId intern(std::string_view arg_text); //!< The same hash, recorded in the string table. Thread safe
+		static uint32_t getCollisionCount(); //!< Different text interned with the same hash, always 0 without the string table
+		static void clearTable(); //!< Forgets the interned text, at shutdown once nothing will ask for it
+
+		constexpr static uint64_t hash(std::string_view arg_text) { return Fnv1a::hash(arg_text); }
+
+		const char* getText() const; //!< The interned text, or "?" if it wasn't interned or there is no string table
+		inline constexpr uint64_t getHash() const { return m_hash; }
+		inline constexpr bool isValid() const { return m_hash != 0; }
+
+		inline constexpr bool operator==(StringId arg_other) const { return m_hash == arg_other.m_hash; }
+		inline constexpr bool operator!=(StringId arg_other) const { return m_hash != arg_other.m_hash; }
+		inline constexpr bool operator<(StringId arg_other) const { return m_hash < arg_other.m_hash; }
+	private:
+		uint64_t m_hash = 0;
+	};
+}
+
+namespace std {
+	/**\ Already a hash, so used as it is */
+	template <>
+	struct hash<Engine::StringId>
+	{
+		inline size_t operator()(Engine::StringId arg_id) const { return static_cast<size_t>(arg_id.getHash()); }
+	};
+}
@@ -0,0 +1,268 @@
+/** \file task.h
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+	class DeferredScheduler;
+
+	enum class TaskThread
+	{
+		Worker, //!< A job system worker, for I/O and decoding
+		Main, //!< The main thread, in its deferred work
+		Render //!< The render thread, in its deferred work, with the graphics context current
+	};
+
+	/**\ Class TaskPool
+	*	 Where task states come from. They live from a step being queued until the last Task handle goes, across
+	*	 frames and threads, so rather than the frame allocator they get fixed size blocks from free lists that are
+	*	 kept once grown, until trim(). Thread safe. Blocks are counted under MemoryTag::Assets
+	*/
+	class TaskPool
+	{
+	public:
+		constexpr static size_t s_blockSize = 64; //!< Sizes are rounded up to a multiple of this
+		constexpr static size_t s_classCount = 8; //!< Bigger than s_blockSize * s_classCount goes to the heap
+
+		static void* allocate(size_t arg_size);
+		static void release(void* arg_memory, size_t arg_size);
+		static bool trim(); //!< Gives the blocks back if none are in use, returns whether it could
+		static uint32_t getLiveCount(); //!< Blocks handed out and not released
+		static size_t getCapacity(); //!< Bytes held by the pool, in use or free
+	};
+
+	/**\ Gives std::allocate_shared TaskPool's blocks */
+	template <typename T>
+	struct TaskAllocator
+	{
+		using value_type = T;
+		TaskAllocator() = default;
+		template <typename U> TaskAllocator(const TaskAllocator<U>&) {}
+		T* allocate(size_t arg_count) { return static_cast<T*>(TaskPool::allocate(arg_count * sizeof(T))); }
+		void deallocate(T* arg_memory, size_t arg_count) { TaskPool::release(arg_memory, arg_count * sizeof(T)); }
+		template <typename U> bool operator==(const TaskAllocator<U>&) const { return true; }
+		template <typename U> bool operator!=(const TaskAllocator<U>&) const { return false; }
+	};
+
+	/**\ Struct TaskState
+	*	 The result a Task is waiting for, shared by its handles and the step that finishes it
+	*/
+	template <typename T>
+	struct TaskState
+	{
+		using Value = std::conditional_t<std::is_void_v<T>, bool, T>; //!< A void task stores nothing of interest
+		enum class Status { Pending, Done, Cancelled };
+
+		TaskState(const std::shared_ptr<std::atomic<bool>>& arg_cancel) : cancel(arg_cancel) {}
+
+		/**\ Runs arg_func now if the task has finished, otherwise once it does, on the thread that finishes it */
+		void onFinished(std::function<void()>&& arg_func)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (status == Status::Pending) {
+					continuations.push_back(std::move(arg_func));
+					return;
+				}
+			}
+			arg_func();
+		}
+		void finish(Status arg_status, std::optional<Value>&& arg_value = std::nullopt)
+		{
+			std::vector<std::function<void()>> waiting;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				value = std::move(arg_value);
+				status = arg_status;
+				waiting.swap(continuations);
+			}
+			for (auto& continuation : waiting) continuation();
+		}
+		inline Status getStatus() const { std::lock_guard<std::mutex> lock(mutex); return status; }
+		inline bool isCancelRequested() const { return cancel->load(std::memory_order_relaxed); }
+
+		mutable std::mutex mutex;
+		Status status = Status::Pending;
+		std::optional<Value> value;
+		std::vector<std::function<void()>> continuations;
+		std::shared_ptr<std::atomic<bool>> cancel; //!< One flag for a whole chain of steps
+	};
+
+	template <typename T> class Task;
+
+	/**\ Class Tasks
+	*	 Starts tasks and moves steps between threads. Worker steps go to the job system, main and render thread steps
+	*	 to the DeferredSchedulers set by setQueues(), the application's, so they run in each frame's slack rather than
+	*	 stalling it. A worker step runs straight away on the posting thread when the job system is stopped. A main or
+	*	 render step posted with no queue set is a mistake, it is logged and dropped, leaving its task pending, unless
+	*	 setInline() has been called, which tests use to run chains on the posting thread.
+	*/
+	class Tasks
+	{
+	public:
+		static void setQueues(DeferredScheduler* arg_main, DeferredScheduler* arg_render);
+		static void setInline(bool arg_inline); //!< Main and render steps with no queue set run on the posting thread. For tests only
+		static void post(TaskThread arg_thread, std::function<void()>&& arg_step); //!< Runs a step on the thread
+
+		/**\ Runs arg_func on the thread and gives a Task for what it returns */
+		template <typename F>
+		static auto run(TaskThread arg_thread, F&& arg_func) -> Task<std::invoke_result_t<std::decay_t<F>&>>
+		{
+			using R = std::invoke_result_t<std::decay_t<F>&>;
+			auto state = makeState<R>(std::make_shared<std::atomic<bool>>(false));
+			post(arg_thread, [state, func = std::forward<F>(arg_func)]() mutable {
+				if (state->isCancelRequested()) state->finish(TaskState<R>::Status::Cancelled);
+				else fulfil(*state, func);
+			});
+			return Task<R>(state);
+		}
+
+		static Task<std::vector<unsigned char>> readFile(const std::string& arg_path); //!< On a worker. Cancelled if the file can't be read
+
+		/**\ A task for when every one of the tasks has finished, with their values in order. Cancelled if any of them is */
+		template <typename T>
+		static auto whenAll(const std::vector<Task<T>>& arg_tasks) -> Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>;
+		template <typename... T>
+		static Task<std::tuple<T...>> whenAll(const Task<T>&... arg_tasks);
+
+		template <typename T>
+		static std::shared_ptr<TaskState<T>> makeState(const std::shared_ptr<std::atomic<bool>>& arg_cancel)
+		{
+			return std::allocate_shared<TaskState<T>>(TaskAllocator<TaskState<T>>(), arg_cancel);
+		}
+
+		/**\ Calls arg_func and finishes the state with what it returns */
+		template <typename R, typename F, typename... Args>
+		static void fulfil(TaskState<R>& arg_state, F& arg_func, Args&... arg_args)
+		{
+			if constexpr (std::is_void_v<R>) {
+				arg_func(arg_args...);
+				arg_state.finish(TaskState<R>::Status::Done, true);
+			}
+			else arg_state.finish(TaskState<R>::Status::Done, arg_func(arg_args...));
+		}
+	private:
+		static DeferredScheduler* s_main;
+		static DeferredScheduler* s_render;
+		static std::atomic<bool> s_inline;
+	};
+
+	/**\ Class Task
+	*	 A value that will be ready later, and the steps to run once it is. A loading sequence is a chain of steps,
+	*	 each on the thread it needs:
+	*		Tasks::readFile(path)
+	*			.then(TaskThread::Worker, [](std::vector<unsigned char>& arg_file) { return decode(arg_file); })
+	*			.then(TaskThread::Render, [](Image& arg_image) { return upload(arg_image); });
+	*	 Nothing blocks: each step is queued when the one before finishes. A step is given the value by reference and
+	*	 may move from it when it is the only step continuing from that task.
+	*	 cancel() stops every step of the chain that hasn't started, they and the tasks after them finish cancelled.
+	*	 A step that is already running finishes. Steps shouldn't throw.
+	*/
+	template <typename T>
+	class Task
+	{
+	public:
+		Task() = default; //!< Invalid until assigned
+		explicit Task(const std::shared_ptr<TaskState<T>>& arg_state) : m_state(arg_state) {}
+
+		inline bool isValid() const { return m_state != nullptr; }
+		inline bool isReady() const { return m_state->getStatus() == TaskState<T>::Status::Done; }
+		inline bool isCancelled() const { return m_state->getStatus() == TaskState<T>::Status::Cancelled; }
+		inline bool isFinished() const { return m_state->getStatus() != TaskState<T>::Status::Pending; } //!< Ready or cancelled
+		inline void cancel() { m_state->cancel->store(true, std::memory_order_relaxed); }
+
+		/**\ The value, once isReady() */
+		template <typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+		U& get() const { return *m_state->value; }
+
+		/**\ Runs arg_func(value), or arg_func() for a void task, on the thread once this task is ready */
+		template <typename F>
+		auto then(TaskThread arg_thread, F&& arg_func) const
+		{
+			using R = typename StepResult<std::decay_t<F>, T>::Type;
+			auto next = Tasks::makeState<R>(m_state->cancel);
+			std::shared_ptr<TaskState<T>> previous = m_state;
+			m_state->onFinished([previous, next, arg_thread, func = std::forward<F>(arg_func)]() mutable {
+				if (previous->status == TaskState<T>::Status::Cancelled || next->isCancelRequested()) {
+					next->finish(TaskState<R>::Status::Cancelled);
+					return;
+				}
+				Tasks::post(arg_thread, [previous, next, func = std::move(func)]() mutable {
+					if (next->isCancelRequested()) next->finish(TaskState<R>::Status::Cancelled);
+					else if constexpr (std::is_void_v<T>) Tasks::fulfil(*next, func);
+					else Tasks::fulfil(*next, func, *previous->value);
+				});
+			});
+			return Task<R>(next);
+		}
+
+		inline const std::shared_ptr<TaskState<T>>& getState() const { return m_state; }
+	private:
+		template <typename F, typename V> struct StepResult { using Type = std::invoke_result_t<F&, V&>; };
+		template <typename F> struct StepResult<F, void> { using Type = std::invoke_result_t<F&>; };
+
+		std::shared_ptr<TaskState<T>> m_state;
+	};
+
+	template <typename T>
+	auto Tasks::whenAll(const std::vector<Task<T>>& arg_tasks) -> Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>
+	{
+		using R = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+		auto result = makeState<R>(std::make_shared<std::atomic<bool>>(false));
+		auto tasks = std::make_shared<std::vector<Task<T>>>(arg_tasks);
+		auto remaining = std::make_shared<std::atomic<size_t>>(arg_tasks.size());
+
+		/**\ The last to finish gathers the values, on whichever thread that is */
+		auto gather = [result, tasks]() {
+			for (const Task<T>& task : *tasks) {
+				if (task.isCancelled() || result->isCancelRequested()) {
+					result->finish(TaskState<R>::Status::Cancelled);
+					return;
+				}
+			}
+			if constexpr (std::is_void_v<T>) result->finish(TaskState<R>::Status::Done, true);
+			else {
+				std::vector<T> values;
+				values.reserve(tasks->size());
+				for (const Task<T>& task : *tasks) values.push_back(task.get());
+				result->finish(TaskState<R>::Status::Done, std::move(values));
+			}
+		};
+
+		if (arg_tasks.empty()) gather();
+		for (const Task<T>& task : arg_tasks) {
+			task.getState()->onFinished([remaining, gather]() { if (remaining->fetch_sub(1) == 1) gather(); });
+		}
+		return Task<R>(result);
+	}
+
+	template <typename... T>
+	Task<std::tuple<T...>> Tasks::whenAll(const Task<T>&... arg_tasks)
+	{
+		static_assert(sizeof...(T) > 0 && (!std::is_void_v<T> && ...), "Gather void tasks with the vector whenAll");
+		using R = std::tuple<T...>;
+		auto result = makeState<R>(std::make_shared<std::atomic<bool>>(false));
+		auto tasks = std::make_shared<std::tuple<Task<T>...>>(arg_tasks...);
+		auto remaining = std::make_shared<std::atomic<size_t>>(sizeof...(T));
+
+		auto gather = [result, tasks]() {
+			bool cancelled = result->isCancelRequested();
+			std::apply([&cancelled](const auto&... arg_each) { ((cancelled = cancelled || arg_each.isCancelled()), ...); }, *tasks);
+			if (cancelled) result->finish(TaskState<R>::Status::Cancelled);
+			else result->finish(TaskState<R>::Status::Done, std::apply([](const auto&... arg_each) { return R(arg_each.get()...); }, *tasks));
+		};
+		(arg_tasks.getState()->onFinished([remaining, gather]() { if (remaining->fetch_sub(1) == 1) gather(); }), ...);
+		return Task<R>(result);
+	}
+}
@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <chrono>
+#include <cstdint>
+#include <functional>
 
 
 #include "system.h"
@@ -10,14 +12,21 @@ namespace Engine {
 	class timer : public System
 	{
 	public:
+		using Clock = std::function<uint64_t()>; //!< Monotonic nanoseconds from any fixed point
+
 		timer();
 		~timer();
 
 		void start(SystemSignal init = SystemSignal::None, ...);
 		void stop(SystemSignal init = SystemSignal::None, ...);
 
+		static uint64_t now() { return s_clock ? s_clock() : steadyNow(); } //!< Monotonic nanoseconds, every engine timing goes through this
+		static void setClock(const Clock& arg_clock) { s_clock = arg_clock; } //!< Replaces the clock, i.e. with a fake one in tests. nullptr restores steady_clock
+		static uint64_t steadyNow() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
 		static void startFrameTimer();
 		static float getFrameTime();
+		static uint64_t getFrameTimeNanoseconds();
 
 		static void startMarkerTimer();
 		static float getMarkerTimer();
@@ -26,11 +35,12 @@ namespace Engine {
 		//float getTimeMilliseconds();
 		//float getTimeMicroseconds();
 	private:
-		static std::chrono::high_resolution_clock::time_point m_frameStart;
-		static std::chrono::high_resolution_clock::time_point m_markerStart;
+		static Clock s_clock;
+		static uint64_t m_frameStart;
+		static uint64_t m_markerStart;
 
 		/*std::chrono::high_resolution_clock::duration getTime() { return m_end - m_start; }
 		std::chrono::high_resolution_clock::time_point m_start;
 		std::chrono::high_resolution_clock::time_point m_end;*/
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,76 @@
+/** \file workStealingDeque.h
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+	/**\ Class WorkStealingDeque
+	*	 Fixed size Chase-Lev deque. The owning thread pushes and pops at the bottom, any other thread steals from the top.
+	*	 Only the last item can be contested, which is settled with a single compare and swap on top.
+	*	 Every operation is an atomic with explicit ordering (no standalone fences) so ThreadSanitizer can follow it.
+	*/
+	template <typename T>
+	class WorkStealingDeque
+	{
+	public:
+		WorkStealingDeque(uint32_t arg_capacity = 4096) : m_items(roundUp(arg_capacity)), m_mask(roundUp(arg_capacity) - 1) {}
+
+		/**\ Owner only. Returns false if the deque is full */
+		bool push(T* arg_item)
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			int64_t top = m_top.load(std::memory_order_acquire);
+			if (bottom - top > static_cast<int64_t>(m_mask)) return false;
+
+			m_items[bottom & m_mask].store(arg_item, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_release); //!< Publishes the item to thieves
+			return true;
+		}
+
+		/**\ Owner only. Takes the most recently pushed item, or nullptr */
+		T* pop()
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_seq_cst); //!< Has to be visible before top is read
+			int64_t top = m_top.load(std::memory_order_seq_cst);
+
+			if (top > bottom) { //!< Empty
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = m_items[bottom & m_mask].load(std::memory_order_relaxed);
+			if (top == bottom) { //!< Last item, race a thief for it
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) item = nullptr;
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return item;
+		}
+
+		/**\ Any thread. Takes the oldest item, or nullptr if empty or another thread won it */
+		T* steal()
+		{
+			int64_t top = m_top.load(std::memory_order_seq_cst);
+			int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+			if (top >= bottom) return nullptr;
+
+			T* item = m_items[top & m_mask].load(std::memory_order_acquire);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+			return item;
+		}
+
+		/**\ Approximate when other threads are working on it */
+		inline bool empty() const { return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed); }
+		inline uint32_t capacity() const { return m_mask + 1; }
+	private:
+		static uint32_t roundUp(uint32_t arg_value) { uint32_t size = 2; while (size < arg_value) size <<= 1; return size; }
+
+		alignas(64) std::atomic<int64_t> m_top{ 0 }; //!< Kept on separate cache lines, thieves write top and the owner writes bottom
+		alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+		std::vector<std::atomic<T*>> m_items;
+		uint32_t m_mask;
+	};
+}
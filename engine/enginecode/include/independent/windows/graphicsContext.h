@@ -13,4 +13,6 @@ class GraphicsContext
 public:
 	virtual void init() = 0; //!< Initialise the graphics context for the given windowing API
 	virtual void swapBuffers() = 0; //!< Swap the front and back buffers (Double buffering)
+	virtual void makeCurrent() = 0; //!< Binds the context to the calling thread
+	virtual void releaseCurrent() = 0; //!< Unbinds the context from the calling thread so another thread can take it
 };
\ No newline at end of file
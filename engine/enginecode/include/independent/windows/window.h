@@ -31,6 +31,7 @@ namespace Engine {
 		virtual void close() = 0;
 		virtual ~Window() {};
 		virtual void onUpdate(float timestep) = 0;
+		virtual void waitEvents(float timeout) = 0; //!< As onUpdate, but sleeps until an event comes or timeout seconds pass
 		virtual void onResize(unsigned int width, unsigned int height) = 0;
 		virtual void setVSync(bool VSync) = 0;
 		virtual void setEventCallback(const std::function<void(Event&)>& callback) = 0;
@@ -40,6 +41,8 @@ namespace Engine {
 		virtual bool isFullScreenMode() const = 0;
 		virtual bool isVSync() const = 0;
 
+		inline std::shared_ptr<GraphicsContext> getGraphicsContext() const { return m_graphicsContext; }
+
 		static Window* create(const WindowProperties& properties = WindowProperties());
 	protected:
 		std::shared_ptr<GraphicsContext> m_graphicsContext;
@@ -11,23 +11,64 @@
 #ifdef NG_PLATFORM_WINDOWS
 #include "platform/windows/GLFWWindowsSystem.h"
 #include "platform/windows/GLFWWindowImpl.h"
+#include "platform/OpenGL/OpenGLRenderBackend.h"
 #endif
+#include "platform/null/nullWindow.h"
+#include "platform/null/nullRenderBackend.h"
+#include "platform/null/nullResources.h"
+#include "rendering/renderAPI.h"
 #include "rendering/indexBuffer.h"
 #include "rendering/vertexBuffer.h"
 #include "rendering/vertexArray.h"
 #include "rendering/uniformBuffer.h"
 #include "rendering/shader.h"
+#include "rendering/shaderPermutations.h"
+#include "rendering/shaderProgramCache.h"
+#include "rendering/shaderCompilationService.h"
 #include "rendering/texture.h"
 #include "rendering/subTexture.h"
+#include "rendering/textureLoader.h"
 
 #include "rendering/renderer3D.h"	
 #include "rendering/renderer2D.h"
+#include "rendering/renderThread.h"
+
+#include "ecs/world.h"
+#include "ecs/sceneSystems.h"
 
 #include <string>
+#include <cstring>
+#include <limits>
+#include <thread>
 
 namespace Engine {
+	namespace {
+		/**\ ReactPhysics3D's own allocations, which use malloc rather than new, go through the tracker under the physics tag */
+		class PhysicsAllocator : public rp3d::MemoryAllocator
+		{
+		public:
+			void* allocate(size_t arg_size) override { return MemoryTracker::allocate(arg_size, MemoryTag::Physics); }
+			void release(void* arg_memory, size_t arg_size) override { MemoryTracker::release(arg_memory); }
+		};
+		PhysicsAllocator s_physicsAllocator;
+	}
 
 	Application* Application::s_instance = nullptr; //!< Single instance of application ensures only one can be open at a time
+	ApplicationProperties Application::s_properties;
+
+	ApplicationProperties ApplicationProperties::fromCommandLine(int argc, char** argv)
+	{
+		ApplicationProperties properties;
+		for (int i = 1; i < argc; i++) {
+			if (strcmp(argv[i], "--headless") == 0) properties.headless = true;
+			else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) properties.frameCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) properties.recordPath = argv[++i];
+			else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) properties.replayPath = argv[++i];
+			else if (strcmp(argv[i], "--low-latency") == 0) properties.latency.lowLatency = true;
+			else if (strcmp(argv[i], "--gpu-sync") == 0) properties.latency.waitForGpu = true;
+		}
+		return properties;
+	}
 
 	 /** Constructor for the application class
 	 *	 Involves initialising the different aspects of the application class:
@@ -48,22 +89,81 @@ namespace Engine {
 		*/
 		m_Log = std::make_shared<logging>();  
 		m_Log->start(); 
+		MemoryTracker::markLeakCheck(); //!< Anything the application allocates from here on should be gone by the end of the destructor
 
 		m_Timer = std::make_shared<timer>();
 		m_Timer->start();
 
-#ifdef NG_PLATFORM_WINDOWS //!< If the platform used is windows, we can use OpenGL as it is supported 
-		m_windowsSystem = std::make_shared<GLFWWindowsSystem>(); 
-		m_windowsSystem->start(); //!< Calls GLFWInit() from the GLFW library, this lets us use openGL
+		m_jobSystem = std::make_shared<jobSystem>(); //!< Started on this thread, which becomes worker 0 and helps out whenever it waits on a job
+		m_jobSystem->start();
 
 		WindowProperties winProps; //!< Generates the window properties such as height and width
-		m_Window = std::make_unique<GLFWWindowImpl>(winProps); //!< Using the window properties, create a windows implementation. This is an abstracted class that creates an openGL window
+#ifndef NG_PLATFORM_WINDOWS
+		s_properties.headless = true; //!< GLFW and OpenGL are only set up for windows
+#endif
+		if (s_properties.headless) {
+			/**\ No window system or GPU. Resources are null objects and the render thread draws into counters */
+			LOG_INFO("Running headless{0}", s_properties.frameCount ? " for " + std::to_string(s_properties.frameCount) + " frames" : std::string());
+			RenderAPI::setAPI(RenderAPI::API::None);
+			m_Window = std::make_unique<NullWindow>(winProps);
+			RenderThread::setBackend(std::make_shared<NullRenderBackend>(m_Window->getGraphicsContext()));
+		}
+#ifdef NG_PLATFORM_WINDOWS //!< If the platform used is windows, we can use OpenGL as it is supported 
+		else {
+			m_windowsSystem = std::make_shared<GLFWWindowsSystem>();
+			m_windowsSystem->start(); //!< Calls GLFWInit() from the GLFW library, this lets us use openGL
+
+			m_Window = std::make_unique<GLFWWindowImpl>(winProps); //!< Using the window properties, create a windows implementation. This is an abstracted class that creates an openGL window
+			RenderThread::setBackend(std::make_shared<OpenGLRenderBackend>(m_Window->getGraphicsContext()));
+		}
+#endif
+
+		setLatencySettings(s_properties.latency);
+		Tasks::setQueues(&m_deferredWork, &m_renderWork); //!< Task steps for the main and render threads run in the frames' slack
+
+		InputState::addHandlers(m_events); //!< First, so it sees every input event
+		m_powerPolicy.addHandlers(m_events); //!< Before the application's, which handle the window events
+
+		/**\ Key Events */
+		m_events.add<&Application::onKeyPressed>(this);
+		m_events.add<&Application::onKeyReleased>(this);
+
+		/**\ Mouse Events */
+		m_events.add<&Application::onMouseButtonPressed>(this);
+		m_events.add<&Application::onMouseButtonReleased>(this);
+		m_events.add<&Application::onMouseMoved>(this);
+		m_events.add<&Application::onMouseScrolled>(this);
+
+		/**\ Window Events */
+		m_events.add<&Application::onWindowClose>(this);
+		m_events.add<&Application::onWindowFocus>(this);
+		m_events.add<&Application::onWindowLostFocus>(this);
+		m_events.add<&Application::onWindowMoved>(this);
+		m_events.add<&Application::onWindowResize>(this);
+		m_eventQueue.pushLayer(m_events);
+
+		/**\ A replay's recorded time drives the simulation in place of the real clock */
+		if (!s_properties.replayPath.empty()) {
+			if (m_inputRecorder.startReplay(s_properties.replayPath)) {
+				LOG_INFO("Replaying input from {0}", s_properties.replayPath);
+				m_fixedTimestep.setClock([this]() { return m_inputRecorder.getTime(); });
+			}
+			else LOG_ERROR("Couldn't read input recording {0}", s_properties.replayPath);
+		}
+		else if (!s_properties.recordPath.empty()) {
+			if (m_inputRecorder.startRecording(s_properties.recordPath, m_Window->getWidth(), m_Window->getHeight())) {
+				LOG_INFO("Recording input to {0}", s_properties.recordPath);
+				m_eventQueue.pushLayer(m_inputRecorder.getLayer()); //!< On top, so it sees each input event before anything can handle it
+			}
+			else LOG_ERROR("Couldn't create input recording {0}", s_properties.recordPath);
+		}
 
 		/**\ Along with creating windows, opengl lets us handle user events */
 		m_Window->setEventCallback(std::bind(&Application::onEvent, this, std::placeholders::_1)); //!< Uses the onEvent function whenever opengl detects an event
 		InputPoller::setNativeWindow(m_Window->getNativeWindow());  //!< Refers which specific window we want the events to be polled at
-#endif
 
+		MemoryTagScope memoryTag(MemoryTag::Physics);
+		rp3d::MemoryManager::setBaseAllocator(&s_physicsAllocator); //!< Before the physics allocates anything, so it is all freed the same way
 		rp3d::Vector3 gravity = rp3d::Vector3(0.0, -0.1, 0.0);
 		m_worldInstance.reset(new rp3d::DynamicsWorld(gravity));
 	}
@@ -71,41 +171,52 @@ namespace Engine {
 	/**\ Very simple clean-up of the different systems used */
 	Application::~Application()
 	{
-		m_windowsSystem->stop();
-		m_windowsSystem.reset();
+		/**\ Released here rather than after the destructor, so the leak report only shows what really leaked */
+		m_worldInstance.reset();
+		Renderer3D::shutdown();
+		Renderer2D::shutdown();
+		ShaderCompilationService::setInstance(nullptr); //!< Made with the context, after the leak check was marked
+		ShaderProgramCache::setInstance(nullptr);
+		m_Window.reset();
+		RenderThread::setBackend(nullptr);
+
+		if (m_windowsSystem) { //!< Never started when headless
+			m_windowsSystem->stop();
+			m_windowsSystem.reset();
+		}
+
+		m_jobSystem->stop();
+		m_jobSystem.reset();
 
 		m_Timer->stop();
 		m_Timer.reset();
+
+		Tasks::setQueues(nullptr, nullptr);
+		if (!TaskPool::trim()) LOG_WARN("{0} tasks are still alive", TaskPool::getLiveCount());
+		FrameAllocator::shutdown();
+		StringId::clearTable();
+		MemoryTracker::reportLeaks(); //!< Debug builds only
 		
 		m_Log->stop();
 		m_Log.reset();
 	}
 
+	void Application::setLatencySettings(const LatencySettings& arg_settings)
+	{
+		m_latencySettings = arg_settings;
+		RenderThread::setGpuSync(arg_settings.waitForGpu);
+		m_latencyStats.clear(); //!< Numbers from before the change would only confuse the comparison
+	}
+
 	/** Used as the glfw event callback
-	*	 onEvent creates a temporary dispatcher that checks through the possible eventTypes and runs the bound function if it matches.
-	*	 This method is for functions that should happen every time a specific event occurs, such as window resizing and closing
+	*	 Events are queued while the window is polled and dispatched together straight after, through the queue's layers.
+	*	 The application's handlers are in m_events, added by the constructor.
+	*	 They are for functions that should happen every time a specific event occurs, such as window resizing and closing
 	*/
 	void Application::onEvent(Event & e)
 	{
-		EventDispatcher dispatcher(e); //!< Creating the dispatcher with reference to the event called
-		
-		/**\ Key Events */
-		dispatcher.dispatch<KeyPressedEvent>(std::bind(&Application::onKeyPressed, this, std::placeholders::_1));
-		dispatcher.dispatch<KeyReleasedEvent>(std::bind(&Application::onKeyReleased, this, std::placeholders::_1));
-
-		/**\ Mouse Events */
-		dispatcher.dispatch<MouseButtonPressedEvent>(std::bind(&Application::onMouseButtonPressed, this, std::placeholders::_1));
-		dispatcher.dispatch<MouseButtonReleasedEvent>(std::bind(&Application::onMouseButtonReleased, this, std::placeholders::_1));
-		dispatcher.dispatch<MouseMovedEvent>(std::bind(&Application::onMouseMoved, this, std::placeholders::_1));
-		dispatcher.dispatch<MouseScrolledEvent>(std::bind(&Application::onMouseScrolled, this, std::placeholders::_1));
-
-		/**\ Window Events */
-		dispatcher.dispatch<WindowCloseEvent>(std::bind(&Application::onWindowClose, this, std::placeholders::_1));
-		dispatcher.dispatch<WindowFocusEvent>(std::bind(&Application::onWindowFocus, this, std::placeholders::_1));
-		dispatcher.dispatch<WindowLostFocusEvent>(std::bind(&Application::onWindowLostFocus, this, std::placeholders::_1));
-		dispatcher.dispatch<WindowMovedEvent>(std::bind(&Application::onWindowMoved, this, std::placeholders::_1));
-		dispatcher.dispatch<WindowResizeEvent>(std::bind(&Application::onWindowResize, this, std::placeholders::_1));
-		
+		if (m_inputRecorder.isReplaying() && e.isInCategory(EventCategoryInput)) return; //!< The recording is the only input
+		if (!m_eventQueue.post(e)) LOG_WARN("Event queue full, dropped an event");
 	}
 	/**\ Functions the dispatcher calls depending on event type */
 	bool Application::onKeyPressed(KeyPressedEvent& e) { 
@@ -127,7 +238,6 @@ namespace Engine {
 		return true;
 	}
 	bool Application::onMouseMoved(MouseMovedEvent& e) { 
-		m_mousePosCurrent = glm::vec2(e.getPos().x, e.getPos().y); //!< Updates the current position every time the mouse is moved
 		//LOG_INFO("Mouse Moved: {0}x{1}", e.getPos().x, e.getPos().y);
 		return true; 
 	}
@@ -168,8 +278,18 @@ namespace Engine {
 	{
 #pragma region TEXTURES
 		/**	Implementing the abstracted OpenGL Textures	*/
-		std::shared_ptr<Texture> textureAtlas;
-		textureAtlas.reset(Texture::create("assets/textures/letterAndNumberCube(Dark).png")); //!< Creates a new texture using a png image from the filepath given. (I made a darker texture to hopefully show the phong lighting better)
+		MemoryTracker::setTag(MemoryTag::Assets); //!< Loading is tagged by what it loads, back to General for the game loop
+		/**\ Both files are read and decoded side by side on the workers. The render steps run here, this thread holds
+		*	 the context until the render thread starts, so this thread drains both queues until the textures are made
+		*/
+		Task<std::shared_ptr<Texture>> atlasLoad = TextureLoader::load("assets/textures/letterAndNumberCube(Dark).png"); //!< (I made a darker texture to hopefully show the phong lighting better)
+		Task<std::shared_ptr<Texture>> gearLoad = TextureLoader::load("assets/textures/gear.png");
+		while (!atlasLoad.isFinished() || !gearLoad.isFinished()) {
+			uint32_t ran = m_deferredWork.run(std::numeric_limits<uint64_t>::max()) + m_renderWork.run(std::numeric_limits<uint64_t>::max());
+			if (!ran && !jobSystem::help()) std::this_thread::yield();
+		}
+
+		std::shared_ptr<Texture> textureAtlas = atlasLoad.isReady() ? atlasLoad.get() : TextureLoader::makeMissing(); //!< Cancelled when the file couldn't be read
 		SubTexture letterTexture(textureAtlas, { 0.f, 0.f }, { 1.f, 0.5f }); //!< Finds the letter texture within the texture atlas using UV coordinates
 		SubTexture numberTexture(textureAtlas, { 0.f, 0.5f }, { 1.f, 1.f }); //!< Finds the number texture within the texture atlas using UV coordinates
 
@@ -177,8 +297,7 @@ namespace Engine {
 		unsigned char PxlColour[4] = { 155, 0, 55, 255 };
 		pyramidTex.reset(Texture::create(1, 1, 4, PxlColour));
 
-		std::shared_ptr<Texture> gearTexture;
-		gearTexture.reset(Texture::create("assets/textures/gear.png")); //!< Creates a new texture using a png image from the filepath given. (I made a darker texture to hopefully show the phong lighting better)
+		std::shared_ptr<Texture> gearTexture = gearLoad.isReady() ? gearLoad.get() : TextureLoader::makeMissing();
 #pragma endregion
 
 
@@ -265,6 +384,7 @@ namespace Engine {
 		};
 #pragma endregion
 #pragma region GL_BUFFERS
+		MemoryTracker::setTag(MemoryTag::Rendering);
 		/**	Implementing the abstracted frame buffers for OpenGL
 		*	Doesn't include any actual openGL library calls.
 		*	This means that other rendering libraries could be used in place of openGL in the future.
@@ -305,9 +425,12 @@ namespace Engine {
 		/**	Implemnting the abstracted OpenGL Shaders
 		*	Shader3D uses the Phong lighting model
 		*	Each shader object reads a text file and compiles it line by line into the OpenGL library shaders
+		*	Shader3D has a variant per material keyword set, the ones the scene uses are compiled here rather than on first draw
 		*/
-		std::shared_ptr<Shader> Shader3D;
-		Shader3D.reset(Shader::create("./assets/shaders/Shader3D.glsl"));
+		MemoryTracker::setTag(MemoryTag::Assets);
+		std::shared_ptr<ShaderPermutations> Shader3D;
+		Shader3D.reset(new ShaderPermutations("./assets/shaders/Shader3D.glsl", Material::getKeywords()));
+		Shader3D->warmUp({ Material::flag_tint, Material::flag_texture });
 
 #pragma endregion 
 #pragma region MATERIALS
@@ -316,6 +439,7 @@ namespace Engine {
 		*	Each material takes a texture, and a shader to be used when rendring.
 		*	Taking a shader lets us potentially use different lighting effects on different objects within the 3D world
 		*/
+		MemoryTracker::setTag(MemoryTag::Rendering);
 		std::shared_ptr<Material> pyramidMaterial;
 		pyramidMaterial.reset(new Material(Shader3D, { 1.f, 1.f, 1.f, 1.f }));
 
@@ -326,19 +450,26 @@ namespace Engine {
 		numberCubeMaterial.reset(new Material(Shader3D, textureAtlas));
 #pragma endregion
 #pragma region RENDERERS
-		/**\ Renderer3D */
+		/**\ Every startup shader is submitted before any of them is used, so they compile side by side.
+		*	 Waiting here (the end of loading) rather than at the first use of each one
+		*/
 		Renderer3D::init();
-		Renderer3D::uploadCamera(
-			Shader3D,
-			glm::lookAt(					//!< Camera view
-				glm::vec3(2.f, 2.f, 0.f),
-				glm::vec3(0.f, 0.f, -6.f),
-				glm::vec3(0.f, 1.f, 0.f)
-			),
-			glm::perspective(glm::radians(45.f), 1024.f / 800.f, 0.1f, 100.f) //!< Camera projection
+		Renderer2D::init();
+		if (auto compiler = ShaderCompilationService::getInstance()) {
+			compiler->waitAll();
+			for (auto& timing : compiler->getTimings())
+				LOG_INFO("Shader {0}: {1:.2f} ms{2}", timing.name, timing.milliseconds, timing.succeeded ? "" : " (failed)");
+		}
+
+		/**\ Renderer3D. The camera is kept here too, picking needs it */
+		const glm::mat4 cameraProjection = glm::perspective(glm::radians(45.f), 1024.f / 800.f, 0.1f, 100.f);
+		glm::mat4 cameraView = glm::lookAt(					//!< Camera view
+			glm::vec3(2.f, 2.f, 0.f),
+			glm::vec3(0.f, 0.f, -6.f),
+			glm::vec3(0.f, 1.f, 0.f)
 		);
+		Renderer3D::uploadCamera(cameraView, cameraProjection);
 		Renderer3D::uploadLights(
-			Shader3D,
 			glm::vec3(2.f, 1.f, -6.f),		//!< Lights position
 			glm::vec3(0.f, 0.f, 0.f),		//!< Lights view
 			glm::vec3(1.f, 1.f, 1.f),		//!< Lights colour
@@ -346,180 +477,262 @@ namespace Engine {
 		);
 
 		/**\ Renderer2D */
-		Renderer2D::init();
 		Renderer2D::uploadData(
 			glm::mat4(1.f),
 			glm::ortho(0.f, static_cast<float>(m_Window->getWidth()), static_cast<float>(m_Window->getHeight()), 0.f)
 		);
-#pragma endregion 
 
-		std::string fpsStr;
-		std::string camStr = std::string("Camera: Top-Right");
-
-		/**\ Setting the model locations */
-		glm::mat4 models[3];
-		models[0] = glm::translate(glm::mat4(1.0f), glm::vec3(-2.f, 0.f, -6.f));
-		models[1] = glm::translate(glm::mat4(1.0f), glm::vec3(0.f, 0.f, -6.f));
-		models[2] = glm::translate(glm::mat4(1.0f), glm::vec3(2.f, 0.f, -6.f));
+		/**\ Every startup shader has been built by now, so the cache counters cover the whole launch */
+		if (auto shaderCache = ShaderProgramCache::getInstance()) {
+			const ShaderCacheStats& cacheStats = shaderCache->getStats();
+			LOG_INFO("Shader cache: {0} hits, {1} misses ({2} rejected, {3} corrupt), {4} stored, {5} evicted",
+				cacheStats.hits, cacheStats.misses, cacheStats.rejected, cacheStats.corrupt, cacheStats.stored, cacheStats.evicted);
+		}
+#pragma endregion 
 
-		//glClearColor(1.f, 1.f, 1.f, 1.f);
-		glClearColor(1.f, 1.f, 1.f, 1.f);
+		const char* camStr = "Camera: Top-Right";
+
+		/**\ Setting up the scene. Simulated at the fixed tick rate, the matrices drawn are blended between the last two ticks */
+		MemoryTracker::setTag(MemoryTag::Scene);
+		World scene;
+		TransformComponent transform;
+		transform.current.position = glm::vec3(-2.f, 0.f, -6.f);
+		transform.previous = transform.current;
+		BoundsComponent unitBounds{ AABB(glm::vec3(-0.5f), glm::vec3(0.5f)) }; //!< Both meshes fit the unit cube
+		PickMeshComponent pyramidPick{ pyramidVertices, 8, pyramidIndices, 6 };
+		PickMeshComponent cubePick{ cubeVertices, 8, cubeIndices, 12 };
+		Entity pyramid = scene.create(transform, MeshComponent{ pyramidVAO.get() }, MaterialComponent{ pyramidMaterial.get() }, unitBounds, pyramidPick);
+		transform.current.position = glm::vec3(0.f, 0.f, -6.f);
+		transform.previous = transform.current;
+		Entity letterCube = scene.create(transform, MeshComponent{ cubeVAO.get() }, MaterialComponent{ letterCubeMaterial.get() }, unitBounds, cubePick);
+		transform.current.position = glm::vec3(2.f, 0.f, -6.f);
+		transform.previous = transform.current;
+		scene.create(transform, MeshComponent{ cubeVAO.get() }, MaterialComponent{ numberCubeMaterial.get() }, SpinComponent{ glm::normalize(glm::vec3(1.f, 1.f, 1.f)), 1.f }, unitBounds, cubePick);
+
+		DynamicBVH sceneBounds; //!< World boxes of everything with bounds, for picking
+		SceneSystems::updateBounds(scene, sceneBounds);
+		Entity selected = pyramid; //!< Turned by dragging with the left mouse button, clicking picks another
+
+		DrawList sceneDraws; //!< Filled on this thread, larger scenes can fill a list per job
+
+		RenderThread::record([](RenderBackend& arg_backend) { arg_backend.setClearColour({ 1.f, 1.f, 1.f, 1.f }); });
 		float elapsedTime = 0;
+		MemoryTracker::setTag(MemoryTag::General);
+
+		/**\ Loading is done, the context moves to the render thread and everything from here on is recorded.
+		*	 The render thread draws last frame while this one is being updated
+		*/
+		RenderThread::setAfterFrame([this]() { m_renderWork.runFrame(0); }); //!< The render thread's own frame time isn't known, so its budget alone
+		RenderThread::start(m_Window->getGraphicsContext());
+		m_fixedTimestep.reset(); //!< Loading time isn't simulated
+		uint32_t framesRun = 0;
+		uint64_t inputSampleTime = timer::now(); //!< When the input the frame uses was polled
+		uint64_t presentsSeen = RenderThread::getPresentCount();
 
 		/**	The main event loop for the application. Contains:
 		*	Event polling
 		*	Update functions
 		*/
 		while (m_Running) {
+			if (m_inputRecorder.isReplaying() && !m_inputRecorder.beginFrame()) break; //!< The recording has run out
 
 			timer::startFrameTimer();
+			FrameAllocator::beginFrame(); //!< Frees the frame before last, which the render thread has finished with
+			MemoryTracker::beginFrame(); //!< Last frame's allocation counts are ready to read
+			InputState::beginFrame(); //!< The input events dispatched at the end of last frame
+			FramePlan plan = m_powerPolicy.beginFrame(); //!< From the focus and size events dispatched with them
+			if (plan.changed) m_frameLimiter.setTargetRate(plan.frameRate);
 			float totalTimeElapsed = timer::getMarkerTimer();
 
-			if (InputPoller::isMouseButtonPressed(NG_MOUSE_BUTTON_1)) {
-				glm::vec2 mouseDelta = m_mousePosCurrent - m_mousePosStart;
-				if (mouseDelta.x != 0.f)
-					//for world coords: save current transform, set transform to (0,0,0), rotate, then transform back
-					models[0] = glm::rotate(models[0], elapsedTime * mouseDelta.x, glm::vec3(0.f, 1.f, 0.f));
-				if (mouseDelta.y != 0.f)
-					models[0] = glm::rotate(models[0], elapsedTime * -mouseDelta.y, glm::vec3(1.f, 0.f, 0.f));
+			if (auto compiler = ShaderCompilationService::getInstance()) RenderThread::record([compiler]() { compiler->update(); }); //!< Picks up shaders requested since loading, without waiting on them
+
+			if (InputState::wasMousePressed(NG_MOUSE_BUTTON_1)) {
+				glm::vec2 windowSize = m_inputRecorder.isReplaying() ? glm::vec2(m_inputRecorder.getWindowWidth(), m_inputRecorder.getWindowHeight()) : glm::vec2(m_Window->getWidth(), m_Window->getHeight()); //!< A replay picks what the recording did, whatever size this window is
+				Ray ray = Ray::fromScreen(InputState::getMousePosition(), windowSize, cameraView, cameraProjection);
+				Entity picked = SceneSystems::pick(scene, sceneBounds, ray);
+				if (!picked.isNull()) selected = picked;
 			}
-			models[2] = glm::rotate(models[2], elapsedTime, glm::vec3(1.f, 1.f, 1.f));
-			m_mousePosStart = m_mousePosCurrent;
+			glm::vec2 mouseDelta = InputState::isMouseDown(NG_MOUSE_BUTTON_1) ? InputState::getMouseDelta() : glm::vec2(0.f);
 			
-			if (InputPoller::isKeyPressed(NG_KEY_SPACE)) {
-				if (!m_spacePressed) {
-					switch (m_currentCamPos)
-					{
-					case 0:
-						Renderer3D::uploadCamera(
-							Shader3D,
-							glm::lookAt(					//!< Top-Left
-								glm::vec3(-3.f, 2.f, 0.f),
-								glm::vec3(0.f, 0.f, -6.f),
-								glm::vec3(0.f, 1.f, 0.f)
-							),
-							glm::perspective(glm::radians(45.f), 1024.f / 800.f, 0.1f, 100.f) //!< Camera projection
-						);
-						camStr = std::string("Camera: Top-Left");
-						m_currentCamPos++;
-						break;
-					case 1: 
-						Renderer3D::uploadCamera(
-							Shader3D,
-							glm::lookAt(					//!< Birds-Eye
-								glm::vec3(0.f, 6.f, -5.f),
-								glm::vec3(0.f, 0.f, -6.f),
-								glm::vec3(0.f, 1.f, 0.f)
-							),
-							glm::perspective(glm::radians(45.f), 1024.f / 800.f, 0.1f, 100.f) //!< Camera projection
-						);
-						camStr = std::string("Camera: Birds-Eye");
-						m_currentCamPos++;
-						break;
-					case 2:
-						Renderer3D::uploadCamera(
-							Shader3D,
-							glm::lookAt(					//!< Centre
-								glm::vec3(0.f, 0.f, 0.f),
-								glm::vec3(0.f, 0.f, -6.f),
-								glm::vec3(0.f, 1.f, 0.f)
-							),
-							glm::perspective(glm::radians(45.f), 1024.f / 800.f, 0.1f, 100.f) //!< Camera projection
-						);
-						camStr = std::string("Camera: Centre");
-						m_currentCamPos++;
-						break;
-					case 3:
-						Renderer3D::uploadCamera(
-							Shader3D,
-							glm::lookAt(					//!< Top-Right
-								glm::vec3(2.f, 2.f, 0.f),
-								glm::vec3(0.f, 0.f, -6.f),
-								glm::vec3(0.f, 1.f, 0.f)
-							),
-							glm::perspective(glm::radians(45.f), 1024.f / 800.f, 0.1f, 100.f) //!< Camera projection
-						);
-						camStr = std::string("Camera: Top-Right");
-						m_currentCamPos = 0;
-						break;
-					}
+			if (InputState::wasPressed(NG_KEY_SPACE)) {
+				switch (m_currentCamPos)
+				{
+				case 0:
+					cameraView = glm::lookAt(					//!< Top-Left
+						glm::vec3(-3.f, 2.f, 0.f),
+						glm::vec3(0.f, 0.f, -6.f),
+						glm::vec3(0.f, 1.f, 0.f)
+					);
+					Renderer3D::uploadCamera(cameraView, cameraProjection);
+					camStr = "Camera: Top-Left";
+					m_currentCamPos++;
+					break;
+				case 1: 
+					cameraView = glm::lookAt(					//!< Birds-Eye
+						glm::vec3(0.f, 6.f, -5.f),
+						glm::vec3(0.f, 0.f, -6.f),
+						glm::vec3(0.f, 1.f, 0.f)
+					);
+					Renderer3D::uploadCamera(cameraView, cameraProjection);
+					camStr = "Camera: Birds-Eye";
+					m_currentCamPos++;
+					break;
+				case 2:
+					cameraView = glm::lookAt(					//!< Centre
+						glm::vec3(0.f, 0.f, 0.f),
+						glm::vec3(0.f, 0.f, -6.f),
+						glm::vec3(0.f, 1.f, 0.f)
+					);
+					Renderer3D::uploadCamera(cameraView, cameraProjection);
+					camStr = "Camera: Centre";
+					m_currentCamPos++;
+					break;
+				case 3:
+					cameraView = glm::lookAt(					//!< Top-Right
+						glm::vec3(2.f, 2.f, 0.f),
+						glm::vec3(0.f, 0.f, -6.f),
+						glm::vec3(0.f, 1.f, 0.f)
+					);
+					Renderer3D::uploadCamera(cameraView, cameraProjection);
+					camStr = "Camera: Top-Right";
+					m_currentCamPos = 0;
+					break;
 				}
-				m_spacePressed = true;
 			}
-			else m_spacePressed = false;
 
-			if (InputPoller::isKeyPressed(NG_KEY_UP)) {
-				if (!m_directionKeyPressed[0]) {
-					LOG_INFO("UP");
-					models[1] = glm::translate(glm::mat4(1.0f), glm::vec3(0.f, 0.f, -6.5f));
-				}
-				m_directionKeyPressed[0] = true;
+			if (InputState::wasPressed(NG_KEY_UP)) {
+				LOG_INFO("UP");
+				scene.get<TransformComponent>(letterCube)->current.position = glm::vec3(0.f, 0.f, -6.5f);
 			}
-			else m_directionKeyPressed[0] = false;
-			if (InputPoller::isKeyPressed(NG_KEY_DOWN)) {
-				if (!m_directionKeyPressed[1]) {
-					LOG_INFO("DOWN");
-					models[1] = glm::translate(glm::mat4(1.0f), glm::vec3(0.f, 0.f, -5.5f));
-				}
-				m_directionKeyPressed[1] = true;
+			if (InputState::wasPressed(NG_KEY_DOWN)) {
+				LOG_INFO("DOWN");
+				scene.get<TransformComponent>(letterCube)->current.position = glm::vec3(0.f, 0.f, -5.5f);
 			}
-			else m_directionKeyPressed[1] = false;
-			if (InputPoller::isKeyPressed(NG_KEY_LEFT)) {
-				if (!m_directionKeyPressed[2]) {
-					LOG_INFO("LEFT");
-					models[1] = glm::translate(glm::mat4(1.0f), glm::vec3(-0.5f, 0.f, -6.f));
-				}
-				m_directionKeyPressed[2] = true;
+			if (InputState::wasPressed(NG_KEY_LEFT)) {
+				LOG_INFO("LEFT");
+				scene.get<TransformComponent>(letterCube)->current.position = glm::vec3(-0.5f, 0.f, -6.f);
 			}
-			else m_directionKeyPressed[2] = false;
-			if (InputPoller::isKeyPressed(NG_KEY_RIGHT)) {
-				if (!m_directionKeyPressed[3]) {
-					LOG_INFO("RIGHT");
-					models[1] = glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, 0.f, -6.f));
-				}
-				m_directionKeyPressed[3] = true;
+			if (InputState::wasPressed(NG_KEY_RIGHT)) {
+				LOG_INFO("RIGHT");
+				scene.get<TransformComponent>(letterCube)->current.position = glm::vec3(0.5f, 0.f, -6.f);
 			}
-			else m_directionKeyPressed[3] = false;
-			if (m_directionKeyPressed[0] == false && m_directionKeyPressed[1] == false && m_directionKeyPressed[2] == false && m_directionKeyPressed[3] == false)
-				models[1] = glm::translate(glm::mat4(1.0f), glm::vec3(0.f, 0.f, -6.f));
+			if (!InputState::isDown(NG_KEY_UP) && !InputState::isDown(NG_KEY_DOWN) && !InputState::isDown(NG_KEY_LEFT) && !InputState::isDown(NG_KEY_RIGHT))
+				scene.get<TransformComponent>(letterCube)->current.position = glm::vec3(0.f, 0.f, -6.f);
 			
 
-			/**\ Rendering the scene */
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			/**\ Simulation, a whole number of fixed ticks however long the frame took */
+			m_fixedTimestep.advance([&](double arg_step) {
+				float step = static_cast<float>(arg_step);
+				SceneSystems::storePrevious(scene);
+
+				/**\ The mouse movement for the frame is spread over its ticks */
+				SimTransform& selectedTransform = scene.get<TransformComponent>(selected)->current;
+				if (mouseDelta.x != 0.f) selectedTransform.rotation = selectedTransform.rotation * glm::angleAxis(step * mouseDelta.x, glm::vec3(0.f, 1.f, 0.f));
+				if (mouseDelta.y != 0.f) selectedTransform.rotation = selectedTransform.rotation * glm::angleAxis(step * -mouseDelta.y, glm::vec3(1.f, 0.f, 0.f));
+				SceneSystems::spin(scene, step);
+
+				{
+					MemoryTagScope memoryTag(MemoryTag::Physics);
+					m_worldInstance->update(step);
+				}
+				SceneSystems::syncRigidBodies(scene);
+			});
+			SceneSystems::updateBounds(scene, sceneBounds);
+
+			/**\ Rendering the scene, unless the window can't be seen or on demand drawing has nothing new */
+			if (plan.render) {
+				RenderThread::record([](RenderBackend& arg_backend) { arg_backend.clear(); });
 
-			Renderer3D::beginScene(); //!< Adds the depth testing
+				sceneDraws.begin();
+				SceneSystems::submitDraws(scene, sceneDraws, m_fixedTimestep.getAlpha());
 
-			Renderer3D::submit(pyramidVAO, pyramidMaterial, models[0]); 
-			Renderer3D::submit(cubeVAO, letterCubeMaterial, models[1]);
-			Renderer3D::submit(cubeVAO, numberCubeMaterial, models[2]);
+				Renderer3D::beginScene(); //!< Adds the depth testing
+				Renderer3D::submit(sceneDraws);
+				Renderer3D::endScene(); //!< The lists are merged and drawn here
 
-			Renderer3D::endScene();
 
+				Renderer2D::beginScene(true); //!< Removes the depth testing
 
-			Renderer2D::beginScene(true); //!< Removes the depth testing
 
+				Renderer2D::submitQuad(
+					Quad::create({50.f, 540.f }, { 15.f, 15.f }),
+					gearTexture,
+					{ 1.f, 1.f, 1.f, 1.f },
+					m_badgeRotation+=3.f
+				);
 
-			Renderer2D::submitQuad(
-				Quad::create({50.f, 540.f }, { 15.f, 15.f }),
-				gearTexture,
-				{ 1.f, 1.f, 1.f, 1.f },
-				m_badgeRotation+=3.f
-			);
+				/**\ Averaged over the last few seconds, with the 99th percentile to show stutter */
+				const char* fpsStr = FrameAllocator::format("fps: %d p99: %dms latency: %.1fms", static_cast<int>(m_frameStats.getFps()), static_cast<int>(m_frameStats.getMilliseconds(99.f)), m_latencyStats.getAverage() * 1e-6);
+				Renderer2D::submitText(fpsStr, { 100.f, 550.f }, { 0.f, 0.f, 0.f, 1.f });
 
-			Renderer2D::submitText(fpsStr.c_str(), { 100.f, 550.f }, { 0.f, 0.f, 0.f, 1.f });
+				Renderer2D::submitText(camStr, { 550.f, 550.f }, { 1.f, 0.f, 0.f, 1.f });
 
-			Renderer2D::submitText(camStr.c_str(), { 550.f, 550.f }, { 1.f, 0.f, 0.f, 1.f });
+				Renderer2D::endScene();
+			}
 
-			Renderer2D::endScene();
+			/**\ Deferred work in the slack, while the render thread may still be drawing last frame. The render thread's runs after each present */
+			m_deferredWork.runFrame(timer::getFrameTimeNanoseconds());
 
-			m_Window->onUpdate(elapsedTime);
+			if (plan.render) {
+				uint64_t submitTime = timer::now();
+				m_latencyStats.sampleToSubmit.addFrame(submitTime - inputSampleTime);
+				if (uint64_t eventTime = InputState::getSnapshot().eventTime) m_latencyStats.eventToSubmit.addFrame(submitTime - eventTime);
+				RenderThread::endFrame(); //!< Presents, and waits if the render thread is still on last frame
+			}
+			else RenderThread::skipFrame();
+			if (m_latencySettings.waitForGpu) RenderThread::waitForIdle(); //!< The frame just handed over is on screen before the next one's input is read
+			if (m_latencySettings.lowLatency) m_frameLimiter.wait(); //!< Sleeps before polling, so the input isn't as old
+
+			inputSampleTime = timer::now();
+			if (plan.waitTime > 0.f) m_Window->waitEvents(plan.waitTime); //!< Nothing to draw, so sleep until there is
+			else m_Window->onUpdate(elapsedTime); //!< Polls the window, queueing its events
+			{
+				MemoryTagScope memoryTag(MemoryTag::Events);
+				if (m_inputRecorder.isReplaying()) m_inputRecorder.sendEvents(m_eventQueue); //!< Where the recorded frame's input was dispatched
+				m_eventQueue.dispatch(); //!< Everything queued up to now, the frame's one event phase
+			}
+			m_inputRecorder.endFrame(m_fixedTimestep.getFrameTimeNanoseconds()); //!< Only when recording
+			if (!m_latencySettings.lowLatency) m_frameLimiter.wait(); //!< Only when a target rate is set, vsync paces the frames otherwise
+			if (RenderThread::getPresentCount() != presentsSeen) { //!< The render thread is a frame behind, this is the latest it has finished
+				presentsSeen = RenderThread::getPresentCount();
+				m_latencyStats.submitToPresent.addFrame(RenderThread::getPresentLatency());
+			}
 
 			elapsedTime = timer::getFrameTime();
+			m_frameStats.addFrame(timer::getFrameTimeNanoseconds());
 
-			fpsStr = std::string("fps: ") + std::to_string((int)(1 / elapsedTime));
 			//LOG_INFO("fps: {0}", 1.f / elapsedTime);
 
-			m_worldInstance->update(elapsedTime);
+			framesRun++;
+			if (s_properties.frameCount && framesRun >= s_properties.frameCount) m_Running = false;
+		}
+		/**\ Whatever work is still waiting is finished, rather than lost, i.e. cache writes */
+		RenderThread::record([this]() { m_renderWork.run(std::numeric_limits<uint64_t>::max()); });
+		m_deferredWork.run(std::numeric_limits<uint64_t>::max());
+		RenderThread::stop(); //!< The resources above are released on the way out, with the context back on this thread
+		RenderThread::setAfterFrame(nullptr);
+
+		if (m_inputRecorder.isRecording() || m_inputRecorder.isReplaying()) {
+			LOG_INFO("Input {0} {1} frames, {2} ticks", m_inputRecorder.isRecording() ? "recorded" : "replayed", m_inputRecorder.getFrameCount(), m_fixedTimestep.getTickCount());
+			m_inputRecorder.stop();
+		}
+
+		/**\ Printed rather than logged, so release builds, which compile info logging out, still give the numbers */
+		if (s_properties.headless) {
+			logging::flush(); //!< So the summary comes after what was logged before it
+			const NullRenderStats& stats = NullRenderStats::get();
+			fmt::print("Headless run: {0} frames, {1} ticks, last {2} frames {3:.3f} ms average {4:.3f} ms p99\n", framesRun, m_fixedTimestep.getTickCount(), m_frameStats.getCount(), m_frameStats.getAverage() * 1e-6, m_frameStats.getMilliseconds(99.f));
+			fmt::print("Latency{0}: input to submit {1:.3f} ms average {2:.3f} ms p99, submit to present {3:.3f} ms average {4:.3f} ms p99\n", m_latencySettings.lowLatency ? " (low latency)" : "",
+				m_latencyStats.sampleToSubmit.getAverage() * 1e-6, m_latencyStats.sampleToSubmit.getMilliseconds(99.f), m_latencyStats.submitToPresent.getAverage() * 1e-6, m_latencyStats.submitToPresent.getMilliseconds(99.f));
+			fmt::print("Null renderer: {0} draws, {1} indices, {2} state changes, {3} presents, {4} live resources, {5} unknown uniforms\n",
+				stats.drawCalls.load(), stats.indicesDrawn.load(), stats.stateChanges.load(), stats.presents.load(), stats.getLiveResources(), stats.unknownUniforms.load());
+			fmt::print("Deferred work: {0} run on the main thread, {1} on the render thread\n", m_deferredWork.getStats().totalExecuted, m_renderWork.getStats().totalExecuted);
+			fmt::print("Frame memory: {0} KB peak, {1} KB in {2} blocks\n", FrameAllocator::getPeakBytesUsed() / 1024, FrameAllocator::getCapacity() / 1024, FrameAllocator::getBlockCount());
+			for (uint32_t tag = 0; tag < MemoryTracker::s_tagCount; tag++) {
+				MemoryStats memory = MemoryTracker::getStats(static_cast<MemoryTag>(tag));
+				if (memory.allocations) fmt::print("Memory {0}: {1} KB live, {2} KB peak, {3} allocations, {4} last frame\n",
+					MemoryTracker::getTagName(static_cast<MemoryTag>(tag)), memory.liveBytes / 1024, memory.peakBytes / 1024, memory.allocations, memory.frameAllocations);
+			}
 		}
 	}
 }
\ No newline at end of file
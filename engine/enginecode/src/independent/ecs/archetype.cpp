@@ -0,0 +1,88 @@
+/** \file archetype.cpp */
+#include "engine_pch.h"
+#include "ecs/archetype.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <mutex>
+
+namespace Engine {
+	namespace
+	{
+		constexpr uint32_t s_cacheLine = 64;
+
+		inline uint32_t alignUp(uint32_t arg_value, uint32_t arg_alignment) { return (arg_value + arg_alignment - 1) & ~(arg_alignment - 1); }
+
+		std::mutex s_registryMutex;
+		std::vector<ComponentInfo> s_componentInfos;
+	}
+
+	ComponentID ComponentRegistry::registerType(uint32_t arg_size, uint32_t arg_alignment)
+	{
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		if (s_componentInfos.size() >= s_maxComponentTypes) throw std::length_error("Too many component types for the 64 bit mask");
+		s_componentInfos.push_back({ arg_size, arg_alignment });
+		return static_cast<ComponentID>(s_componentInfos.size() - 1);
+	}
+
+	ComponentInfo ComponentRegistry::getInfo(ComponentID arg_id)
+	{
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		return s_componentInfos[arg_id];
+	}
+
+	Archetype::Archetype(ComponentMask arg_mask, uint32_t arg_chunkBytes) : m_mask(arg_mask)
+	{
+		memset(m_columns, 0, sizeof(m_columns));
+		uint32_t rowBytes = sizeof(Entity);
+		for (ComponentID id = 0; id < s_maxComponentTypes; id++) {
+			if (!hasComponent(id)) continue;
+			m_columns[id] = static_cast<uint8_t>(m_types.size());
+			m_types.push_back(id);
+			m_sizes.push_back(ComponentRegistry::getInfo(id).size);
+			rowBytes += m_sizes.back();
+		}
+		m_offsets.resize(m_types.size());
+
+		/**\ As many rows as fit once every array is padded to a cache line. Always at least one, the chunk grows for very wide entities */
+		auto layout = [this](uint32_t arg_capacity) {
+			uint32_t offset = alignUp(sizeof(Entity) * arg_capacity, s_cacheLine);
+			for (size_t i = 0; i < m_types.size(); i++) {
+				m_offsets[i] = offset;
+				offset = alignUp(offset + m_sizes[i] * arg_capacity, s_cacheLine);
+			}
+			return offset;
+		};
+		m_chunkCapacity = std::max(arg_chunkBytes / rowBytes, 1u);
+		while (m_chunkCapacity > 1 && layout(m_chunkCapacity) > arg_chunkBytes) m_chunkCapacity--;
+		m_chunkBytes = layout(m_chunkCapacity);
+	}
+
+	uint32_t Archetype::addRow(Entity arg_entity)
+	{
+		uint32_t row = m_count;
+		if (row / m_chunkCapacity >= m_chunks.size()) {
+			Chunk chunk;
+			chunk.memory.reset(new unsigned char[m_chunkBytes + s_cacheLine]);
+			uintptr_t misalignment = reinterpret_cast<uintptr_t>(chunk.memory.get()) % s_cacheLine;
+			chunk.data = chunk.memory.get() + (misalignment ? s_cacheLine - misalignment : 0);
+			m_chunks.push_back(std::move(chunk));
+		}
+		m_count++;
+		reinterpret_cast<Entity*>(m_chunks[row / m_chunkCapacity].data)[row % m_chunkCapacity] = arg_entity;
+		return row;
+	}
+
+	Entity Archetype::removeRow(uint32_t arg_row)
+	{
+		uint32_t last = --m_count;
+		if (arg_row == last) return Entity();
+
+		/**\ Filling the gap with the last row keeps the chunks dense */
+		Entity moved = getEntity(last);
+		reinterpret_cast<Entity*>(m_chunks[arg_row / m_chunkCapacity].data)[arg_row % m_chunkCapacity] = moved;
+		for (ComponentID id : m_types) memcpy(getComponent(arg_row, id), getComponent(last, id), getComponentSize(id));
+		return moved;
+	}
+}
@@ -0,0 +1,72 @@
+/** \file sceneSystems.cpp */
+#include "engine_pch.h"
+#include "ecs/sceneSystems.h"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "physics/intersection.h"
+
+#include "reactphysics3d.h"
+
+namespace Engine {
+	void SceneSystems::storePrevious(World& arg_world)
+	{
+		arg_world.forEachChunk<TransformComponent>([](uint32_t arg_count, const Entity* arg_entities, TransformComponent* arg_transforms) {
+			for (uint32_t i = 0; i < arg_count; i++) arg_transforms[i].previous = arg_transforms[i].current;
+		});
+	}
+
+	void SceneSystems::spin(World& arg_world, float arg_step)
+	{
+		arg_world.parallelForEach<TransformComponent, SpinComponent>([arg_step](TransformComponent& arg_transform, SpinComponent& arg_spin) {
+			arg_transform.current.rotation = arg_transform.current.rotation * glm::angleAxis(arg_spin.speed * arg_step, arg_spin.axis);
+		});
+	}
+
+	void SceneSystems::syncRigidBodies(World& arg_world)
+	{
+		arg_world.forEach<TransformComponent, RigidBodyComponent>([](TransformComponent& arg_transform, RigidBodyComponent& arg_body) {
+			if (!arg_body.body) return;
+			const rp3d::Transform& transform = arg_body.body->getTransform();
+			const rp3d::Vector3& position = transform.getPosition();
+			const rp3d::Quaternion& orientation = transform.getOrientation();
+			arg_transform.current.position = glm::vec3(position.x, position.y, position.z);
+			arg_transform.current.rotation = glm::quat(orientation.w, orientation.x, orientation.y, orientation.z);
+		});
+	}
+
+	void SceneSystems::updateBounds(World& arg_world, DynamicBVH& arg_tree)
+	{
+		arg_world.forEachChunk<TransformComponent, BoundsComponent>([&arg_tree](uint32_t arg_count, const Entity* arg_entities, TransformComponent* arg_transforms, BoundsComponent* arg_bounds) {
+			for (uint32_t i = 0; i < arg_count; i++) {
+				AABB box = AABB::transform(arg_bounds[i].local, arg_transforms[i].current.toMatrix());
+				if (arg_bounds[i].proxy == DynamicBVH::s_null) arg_bounds[i].proxy = arg_tree.insert(box, arg_entities[i].toKey());
+				else arg_tree.move(arg_bounds[i].proxy, box);
+			}
+		});
+	}
+
+	Entity SceneSystems::pick(World& arg_world, const DynamicBVH& arg_tree, const Ray& arg_ray, float arg_maxDistance)
+	{
+		/**\ The ray is taken into each candidate's own space, the direction isn't renormalised so distances still compare */
+		RayHit hit = arg_tree.raycast(arg_ray, arg_maxDistance, [&arg_world](uint64_t arg_key, const Ray& arg_worldRay, float& arg_distance) {
+			Entity entity = Entity::fromKey(arg_key);
+			TransformComponent* transform = arg_world.get<TransformComponent>(entity);
+			if (!transform) return false;
+			Ray local = Ray::transform(arg_worldRay, glm::inverse(transform->current.toMatrix()));
+			if (PickMeshComponent* mesh = arg_world.get<PickMeshComponent>(entity))
+				return Intersection::rayTriangles(local, mesh->vertices, mesh->stride, mesh->indices, mesh->triangleCount, arg_distance);
+			BoundsComponent* bounds = arg_world.get<BoundsComponent>(entity);
+			return bounds && Intersection::rayBox(local, bounds->local, arg_distance);
+		});
+		return hit.isHit() ? Entity::fromKey(hit.userData) : Entity();
+	}
+
+	void SceneSystems::submitDraws(World& arg_world, DrawList& arg_drawList, float arg_alpha)
+	{
+		arg_world.forEach<TransformComponent, MeshComponent, MaterialComponent>([&](TransformComponent& arg_transform, MeshComponent& arg_mesh, MaterialComponent& arg_material) {
+			glm::mat4 model = SimTransform::interpolate(arg_transform.previous, arg_transform.current, arg_alpha).toMatrix();
+			arg_drawList.submit(*arg_mesh.geometry, *arg_material.material, model, arg_material.sortKey);
+		});
+	}
+}
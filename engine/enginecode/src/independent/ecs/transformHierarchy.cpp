@@ -0,0 +1,205 @@
+/** \file transformHierarchy.cpp */
+#include "engine_pch.h"
+#include "ecs/transformHierarchy.h"
+#include "systems/jobSystem.h"
+
+#include <atomic>
+
+namespace Engine {
+	TransformHierarchy::Node TransformHierarchy::create(Node arg_parent, const glm::vec3& arg_position, const glm::quat& arg_rotation, const glm::vec3& arg_scale)
+	{
+		Node node;
+		if (!m_freeNodes.empty()) {
+			node = m_freeNodes.back();
+			m_freeNodes.pop_back();
+			m_links[node] = Links();
+		}
+		else {
+			node = static_cast<Node>(m_links.size());
+			m_links.emplace_back();
+			m_indices.push_back(0);
+		}
+
+		/**\ Appended for now, moved into place when the order is rebuilt */
+		m_indices[node] = static_cast<uint32_t>(m_positions.size());
+		m_positions.push_back(arg_position);
+		m_rotations.push_back(arg_rotation);
+		m_scales.push_back(arg_scale);
+		m_worlds.emplace_back(1.f);
+		m_parents.push_back(-1);
+		m_subtreeSizes.push_back(1);
+		m_dirty.push_back(1);
+		m_changed.push_back(0);
+
+		link(node, arg_parent);
+		m_liveCount++;
+		m_orderStale = true;
+		return node;
+	}
+
+	void TransformHierarchy::destroy(Node arg_node)
+	{
+		unlink(arg_node);
+
+		/**\ Freeing the handles below it. Their array entries are dropped when the order is rebuilt */
+		std::vector<Node> stack = { arg_node };
+		while (!stack.empty()) {
+			Node node = stack.back();
+			stack.pop_back();
+			for (Node child = m_links[node].firstChild; child != s_null; child = m_links[child].nextSibling) stack.push_back(child);
+			m_links[node] = Links();
+			m_freeNodes.push_back(node);
+			m_liveCount--;
+		}
+		m_orderStale = true;
+	}
+
+	bool TransformHierarchy::setParent(Node arg_node, Node arg_parent)
+	{
+		for (Node ancestor = arg_parent; ancestor != s_null; ancestor = m_links[ancestor].parent) {
+			if (ancestor == arg_node) return false;
+		}
+		unlink(arg_node);
+		link(arg_node, arg_parent);
+		m_dirty[m_indices[arg_node]] = 1;
+		m_orderStale = true;
+		return true;
+	}
+
+	void TransformHierarchy::link(Node arg_node, Node arg_parent)
+	{
+		Node& first = arg_parent == s_null ? m_firstRoot : m_links[arg_parent].firstChild;
+		m_links[arg_node].parent = arg_parent;
+		m_links[arg_node].nextSibling = first;
+		first = arg_node;
+	}
+
+	void TransformHierarchy::unlink(Node arg_node)
+	{
+		Node parent = m_links[arg_node].parent;
+		Node* slot = parent == s_null ? &m_firstRoot : &m_links[parent].firstChild;
+		while (*slot != arg_node) slot = &m_links[*slot].nextSibling;
+		*slot = m_links[arg_node].nextSibling;
+		m_links[arg_node].parent = s_null;
+		m_links[arg_node].nextSibling = s_null;
+	}
+
+	void TransformHierarchy::rebuildOrder()
+	{
+		/**\ Depth first walk. Popping the last child pushed finishes its subtree before the next child, so subtrees stay contiguous */
+		std::vector<Node> order;
+		order.reserve(m_liveCount);
+		std::vector<Node> stack;
+		for (Node root = m_firstRoot; root != s_null; root = m_links[root].nextSibling) stack.push_back(root);
+		while (!stack.empty()) {
+			Node node = stack.back();
+			stack.pop_back();
+			order.push_back(node);
+			for (Node child = m_links[node].firstChild; child != s_null; child = m_links[child].nextSibling) stack.push_back(child);
+		}
+
+		uint32_t count = static_cast<uint32_t>(order.size());
+		std::vector<glm::vec3> positions(count);
+		std::vector<glm::quat> rotations(count);
+		std::vector<glm::vec3> scales(count);
+		std::vector<glm::mat4> worlds(count);
+		std::vector<int32_t> parents(count);
+		std::vector<uint8_t> dirty(count);
+		for (uint32_t i = 0; i < count; i++) {
+			Node node = order[i];
+			uint32_t old = m_indices[node];
+			positions[i] = m_positions[old];
+			rotations[i] = m_rotations[old];
+			scales[i] = m_scales[old];
+			worlds[i] = m_worlds[old];
+			dirty[i] = m_dirty[old];
+			m_indices[node] = i; //!< The parent is earlier in the order, so its index is already the new one
+			Node parent = m_links[node].parent;
+			parents[i] = parent == s_null ? -1 : static_cast<int32_t>(m_indices[parent]);
+		}
+		m_positions.swap(positions);
+		m_rotations.swap(rotations);
+		m_scales.swap(scales);
+		m_worlds.swap(worlds);
+		m_parents.swap(parents);
+		m_dirty.swap(dirty);
+		m_changed.assign(count, 0);
+
+		/**\ Children come after their parent, so walking backwards has every subtree complete before it's added to its parent */
+		m_subtreeSizes.assign(count, 1);
+		for (uint32_t i = count; i-- > 0;) {
+			if (m_parents[i] >= 0) m_subtreeSizes[m_parents[i]] += m_subtreeSizes[i];
+		}
+
+		m_serial.clear();
+		m_ranges.clear();
+		for (uint32_t root = 0; root < count; root += m_subtreeSizes[root]) split(root);
+		m_orderStale = false;
+	}
+
+	void TransformHierarchy::split(uint32_t arg_index)
+	{
+		/**\ Iterative, a long chain would be as deep as it is long */
+		std::vector<uint32_t> stack = { arg_index };
+		std::vector<uint32_t> children;
+		while (!stack.empty()) {
+			uint32_t index = stack.back();
+			stack.pop_back();
+			uint32_t size = m_subtreeSizes[index];
+			if (size <= m_grain) {
+				/**\ Small neighbouring subtrees share a job */
+				if (!m_ranges.empty() && m_ranges.back().end == index && index + size - m_ranges.back().begin <= m_grain) m_ranges.back().end = index + size;
+				else m_ranges.push_back({ index, index + size });
+				continue;
+			}
+
+			m_serial.push_back(index); //!< Popped before its children are pushed, so parents stay ahead in the list
+			children.clear();
+			for (uint32_t child = index + 1; child < index + size; child += m_subtreeSizes[child]) children.push_back(child);
+			stack.insert(stack.end(), children.rbegin(), children.rend()); //!< First child on top, so neighbouring ranges can merge
+		}
+	}
+
+	uint32_t TransformHierarchy::updateRange(uint32_t arg_begin, uint32_t arg_end)
+	{
+		uint32_t updated = 0;
+		for (uint32_t i = arg_begin; i < arg_end; i++) {
+			int32_t parent = m_parents[i];
+			uint8_t changed = m_dirty[i] | (parent >= 0 ? m_changed[parent] : 0);
+			m_changed[i] = changed;
+			if (!changed) continue;
+
+			/**\ Translation * rotation * scale, built directly rather than multiplying three matrices */
+			glm::mat4 local = glm::mat4_cast(m_rotations[i]);
+			local[0] *= m_scales[i].x;
+			local[1] *= m_scales[i].y;
+			local[2] *= m_scales[i].z;
+			local[3] = glm::vec4(m_positions[i], 1.f);
+
+			m_worlds[i] = parent >= 0 ? m_worlds[parent] * local : local;
+			m_dirty[i] = 0;
+			updated++;
+		}
+		return updated;
+	}
+
+	void TransformHierarchy::update()
+	{
+		if (m_orderStale) rebuildOrder();
+
+		uint32_t updated = 0;
+		for (uint32_t index : m_serial) updated += updateRange(index, index + 1);
+
+		if (m_ranges.size() == 1) updated += updateRange(m_ranges[0].begin, m_ranges[0].end);
+		else if (!m_ranges.empty()) {
+			std::atomic<uint32_t> parallelUpdated{ 0 };
+			jobSystem::parallelFor(static_cast<uint32_t>(m_ranges.size()), 1, [this, &parallelUpdated](uint32_t arg_begin, uint32_t arg_end) {
+				uint32_t count = 0;
+				for (uint32_t range = arg_begin; range < arg_end; range++) count += updateRange(m_ranges[range].begin, m_ranges[range].end);
+				parallelUpdated += count;
+			});
+			updated += parallelUpdated;
+		}
+		m_updatedCount = updated;
+	}
+}
@@ -0,0 +1,69 @@
+/** \file world.cpp */
+#include "engine_pch.h"
+#include "ecs/world.h"
+
+#include <cstring>
+
+namespace Engine {
+	Entity World::allocateEntity()
+	{
+		m_liveCount++;
+		if (!m_freeIndices.empty()) {
+			uint32_t index = m_freeIndices.back();
+			m_freeIndices.pop_back();
+			return { index, m_records[index].generation };
+		}
+		m_records.emplace_back();
+		return { static_cast<uint32_t>(m_records.size() - 1), m_records.back().generation };
+	}
+
+	void World::destroy(Entity arg_entity)
+	{
+		if (!isAlive(arg_entity)) return;
+		Record& record = m_records[arg_entity.index];
+		Entity moved = record.archetype->removeRow(record.row);
+		if (!moved.isNull()) m_records[moved.index].row = record.row;
+
+		record.archetype = nullptr;
+		if (++record.generation == 0) record.generation = 1; //!< Wrapped, 0 is the null generation
+		m_freeIndices.push_back(arg_entity.index);
+		m_liveCount--;
+	}
+
+	Archetype* World::getArchetype(ComponentMask arg_mask)
+	{
+		auto it = m_archetypeLookup.find(arg_mask);
+		if (it != m_archetypeLookup.end()) return it->second;
+
+		m_archetypes.push_back(std::make_unique<Archetype>(arg_mask, m_chunkBytes));
+		Archetype* archetype = m_archetypes.back().get();
+		m_archetypeLookup[arg_mask] = archetype;
+		return archetype;
+	}
+
+	Archetype* World::getNeighbour(Archetype* arg_archetype, ComponentID arg_id)
+	{
+		Archetype*& edge = arg_archetype->getEdge(arg_id);
+		if (!edge) {
+			edge = getArchetype(arg_archetype->getMask() ^ (ComponentMask(1) << arg_id));
+			edge->getEdge(arg_id) = arg_archetype; //!< The way back is the same component
+		}
+		return edge;
+	}
+
+	void World::move(Entity arg_entity, Archetype* arg_destination)
+	{
+		Record& record = m_records[arg_entity.index];
+		Archetype* source = record.archetype;
+		uint32_t row = arg_destination->addRow(arg_entity);
+
+		for (ComponentID id : source->getTypes()) {
+			if (arg_destination->hasComponent(id)) memcpy(arg_destination->getComponent(row, id), source->getComponent(record.row, id), source->getComponentSize(id));
+		}
+
+		Entity moved = source->removeRow(record.row);
+		if (!moved.isNull()) m_records[moved.index].row = record.row;
+		record.archetype = arg_destination;
+		record.row = row;
+	}
+}
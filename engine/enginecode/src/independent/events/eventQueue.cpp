@@ -0,0 +1,108 @@
+/**\ file eventQueue.cpp */
+#include "engine_pch.h"
+#include "events/eventQueue.h"
+#include "events/keyEvents.h"
+#include "events/mouseEvents.h"
+#include "events/windowEvents.h"
+
+namespace Engine {
+	namespace {
+		template <typename T> struct TypeTag { using Type = T; };
+
+		/**\ Calls arg_func with a TypeTag for the event class of arg_type, false for None */
+		template <typename F>
+		bool visitEventType(EventType arg_type, F&& arg_func)
+		{
+			switch (arg_type) {
+			case EventType::WindowClose: arg_func(TypeTag<WindowCloseEvent>{}); return true;
+			case EventType::WindowResize: arg_func(TypeTag<WindowResizeEvent>{}); return true;
+			case EventType::WindowFocus: arg_func(TypeTag<WindowFocusEvent>{}); return true;
+			case EventType::WindowLostFocus: arg_func(TypeTag<WindowLostFocusEvent>{}); return true;
+			case EventType::WindowMoved: arg_func(TypeTag<WindowMovedEvent>{}); return true;
+			case EventType::KeyPressed: arg_func(TypeTag<KeyPressedEvent>{}); return true;
+			case EventType::KeyReleased: arg_func(TypeTag<KeyReleasedEvent>{}); return true;
+			case EventType::KeyTyped: arg_func(TypeTag<KeyTypedEvent>{}); return true;
+			case EventType::MouseButtonPressed: arg_func(TypeTag<MouseButtonPressedEvent>{}); return true;
+			case EventType::MouseButtonReleased: arg_func(TypeTag<MouseButtonReleasedEvent>{}); return true;
+			case EventType::MouseMoved: arg_func(TypeTag<MouseMovedEvent>{}); return true;
+			case EventType::MouseScrolled: arg_func(TypeTag<MouseScrolledEvent>{}); return true;
+			default: return false;
+			}
+		}
+	}
+
+	Event& EventRecord::get()
+	{
+		Event* event = nullptr;
+		visitEventType(type, [this, &event](auto arg_tag) {
+			using T = typename decltype(arg_tag)::Type;
+			event = std::launder(reinterpret_cast<T*>(storage));
+		});
+		return *event;
+	}
+
+	EventQueue::EventQueue(uint32_t arg_capacity) : m_ring(arg_capacity)
+	{
+		setCoalesced(EventType::MouseMoved, true);
+		setCoalesced(EventType::WindowMoved, true);
+		setCoalesced(EventType::WindowResize, true);
+	}
+
+	bool EventQueue::post(const Event& arg_event)
+	{
+		bool posted = false;
+		visitEventType(arg_event.getEventType(), [this, &arg_event, &posted](auto arg_tag) {
+			using T = typename decltype(arg_tag)::Type;
+			posted = post(static_cast<const T&>(arg_event));
+		});
+		return posted;
+	}
+
+	uint32_t EventQueue::dispatch()
+	{
+		uint64_t end = m_ring.getClaimed(); //!< Anything posted from here on waits for the next call
+		uint32_t dispatched = 0;
+		while (m_ring.getReleased() < end) {
+			EventRecord* record = m_ring.front();
+			if (!record) break; //!< Still being posted, it goes next time with everything behind it
+
+			if (m_coalesced[static_cast<uint32_t>(record->type)] && m_ring.getReleased() + 1 < end) {
+				EventRecord* next = m_ring.peek(1);
+				if (next && next->type == record->type) {
+					m_ring.popFront(); //!< Superseded by the next
+					m_coalescedCount++;
+					continue;
+				}
+			}
+
+			send(record->get());
+			m_ring.popFront();
+			dispatched++;
+		}
+		return dispatched;
+	}
+
+	void EventQueue::send(Event& arg_event)
+	{
+		for (uint32_t i = m_layerCount; i > 0; i--) {
+			m_layers[i - 1]->dispatch(arg_event);
+			if (arg_event.handled()) break;
+		}
+	}
+
+	bool EventQueue::pushLayer(EventDispatchTable& arg_layer)
+	{
+		if (m_layerCount == s_maxLayers) return false;
+		m_layers[m_layerCount++] = &arg_layer;
+		return true;
+	}
+
+	void EventQueue::removeLayer(EventDispatchTable& arg_layer)
+	{
+		uint32_t kept = 0;
+		for (uint32_t i = 0; i < m_layerCount; i++) {
+			if (m_layers[i] != &arg_layer) m_layers[kept++] = m_layers[i];
+		}
+		m_layerCount = kept;
+	}
+}
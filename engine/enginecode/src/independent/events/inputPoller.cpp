@@ -21,7 +21,13 @@ namespace Engine {
 	}
 	void InputPoller::setNativeWindow(void* nativeWindow)
 	{
-		GLFWInputPoller::setCurrentWindow(reinterpret_cast<GLFWwindow*>(nativeWindow));
+		GLFWInputPoller::setCurrentWindow(reinterpret_cast<GLFWwindow*>(nativeWindow)); //!< nullptr when headless, nothing reads as pressed
 	}
+#else
+	/**\ No window system on this platform, only headless runs. Nothing is ever pressed */
+	bool InputPoller::isKeyPressed(int keyCode) { return false; }
+	bool InputPoller::isMouseButtonPressed(int mouseButton) { return false; }
+	glm::vec2 InputPoller::getMousePosition() { return { 0.0f, 0.0f }; }
+	void InputPoller::setNativeWindow(void* nativeWindow) {}
 #endif
 }
\ No newline at end of file
@@ -0,0 +1,242 @@
+/**\ file inputRecorder.cpp */
+#include "engine_pch.h"
+#include "events/inputRecorder.h"
+
+#include <cstring>
+
+#include "systems/logging.h"
+
+namespace Engine {
+	namespace {
+		struct FileHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t windowWidth; //!< When the recording began
+			uint32_t windowHeight;
+		};
+
+		/**\ Key codes can be negative, zigzag keeps small ones of either sign in one byte */
+		inline uint64_t toZigzag(int32_t arg_value) { return (static_cast<uint64_t>(static_cast<uint32_t>(arg_value)) << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(arg_value >> 31)); }
+		inline int32_t fromZigzag(uint64_t arg_value) { return static_cast<int32_t>(static_cast<uint32_t>(arg_value >> 1) ^ (0u - static_cast<uint32_t>(arg_value & 1))); }
+	}
+
+	InputRecorder::InputRecorder()
+	{
+		m_layer.add<&InputRecorder::onEvent<KeyPressedEvent>>(this);
+		m_layer.add<&InputRecorder::onEvent<KeyReleasedEvent>>(this);
+		m_layer.add<&InputRecorder::onEvent<KeyTypedEvent>>(this);
+		m_layer.add<&InputRecorder::onEvent<MouseButtonPressedEvent>>(this);
+		m_layer.add<&InputRecorder::onEvent<MouseButtonReleasedEvent>>(this);
+		m_layer.add<&InputRecorder::onEvent<MouseMovedEvent>>(this);
+		m_layer.add<&InputRecorder::onEvent<MouseScrolledEvent>>(this);
+		m_layer.add<&InputRecorder::onEvent<WindowResizeEvent>>(this);
+	}
+
+	InputRecorder::~InputRecorder()
+	{
+		stop();
+	}
+
+	bool InputRecorder::startRecording(const std::string& arg_path, uint32_t arg_windowWidth, uint32_t arg_windowHeight)
+	{
+		stop();
+		m_frameCount = 0;
+		m_path = arg_path;
+		m_file.open(arg_path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!m_file.is_open()) return false;
+
+		FileHeader header{ s_magic, s_version, arg_windowWidth, arg_windowHeight };
+		m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		m_mode = Mode::Record;
+		m_windowWidth = arg_windowWidth;
+		m_windowHeight = arg_windowHeight;
+		return checkWrite();
+	}
+
+	bool InputRecorder::startReplay(const std::string& arg_path)
+	{
+		stop();
+		m_frameCount = 0;
+		std::ifstream handle(arg_path, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!handle.is_open()) return false;
+
+		size_t size = static_cast<size_t>(handle.tellg());
+		FileHeader header;
+		if (size < sizeof(header)) return false;
+		handle.seekg(0);
+		m_buffer.resize(size);
+		if (!handle.read(reinterpret_cast<char*>(m_buffer.data()), size)) return false;
+
+		std::memcpy(&header, m_buffer.data(), sizeof(header));
+		if (header.magic != s_magic || header.version != s_version) {
+			m_buffer.clear();
+			return false;
+		}
+
+		m_read = sizeof(header);
+		m_mode = Mode::Replay;
+		m_windowWidth = header.windowWidth;
+		m_windowHeight = header.windowHeight;
+		return true;
+	}
+
+	void InputRecorder::stop()
+	{
+		if (m_file.is_open()) {
+			m_file.close(); //!< Writes out what is still buffered, which can fail too
+			if (m_file.fail()) LOG_ERROR("Couldn't finish the input recording {0}, it may be cut short", m_path);
+		}
+		m_file.clear();
+		m_mode = Mode::Off;
+		m_events.clear();
+		m_buffer.clear();
+		m_read = 0;
+		m_time = 0;
+	}
+
+	void InputRecorder::endFrame(uint64_t arg_frameTime)
+	{
+		if (m_mode != Mode::Record) return;
+
+		m_buffer.clear();
+		writeVarint(arg_frameTime);
+		writeVarint(m_events.size());
+		for (const StoredEvent& event : m_events) {
+			m_buffer.push_back(static_cast<unsigned char>(event.type));
+			switch (event.type) {
+			case EventType::KeyPressed:
+			case EventType::WindowResize:
+				writeVarint(toZigzag(event.code));
+				writeVarint(toZigzag(event.repeatCount));
+				break;
+			case EventType::MouseMoved:
+			case EventType::MouseScrolled:
+				writeFloat(event.x);
+				writeFloat(event.y);
+				break;
+			default:
+				writeVarint(toZigzag(event.code));
+				break;
+			}
+		}
+		m_events.clear();
+
+		m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+		if (checkWrite()) m_frameCount++;
+	}
+
+	bool InputRecorder::checkWrite()
+	{
+		if (m_file) return true;
+		LOG_ERROR("Couldn't write the input recording {0} at frame {1}, stopping the recording", m_path, m_frameCount);
+		m_file.close(); //!< Already reported, so stop() doesn't again
+		stop();
+		return false;
+	}
+
+	bool InputRecorder::beginFrame()
+	{
+		if (m_mode != Mode::Replay) return false;
+		m_events.clear();
+		if (m_read == m_buffer.size()) return false;
+
+		uint64_t frameTime, count;
+		bool valid = readVarint(frameTime) && readVarint(count);
+		for (uint64_t i = 0; valid && i < count; i++) {
+			if (m_read == m_buffer.size()) { valid = false; break; }
+			StoredEvent event{ static_cast<EventType>(m_buffer[m_read++]), 0, 0, 0.f, 0.f };
+			uint64_t code = 0, repeatCount = 0;
+			switch (event.type) {
+			case EventType::KeyPressed:
+			case EventType::WindowResize:
+				valid = readVarint(code) && readVarint(repeatCount);
+				break;
+			case EventType::MouseMoved:
+			case EventType::MouseScrolled:
+				valid = readFloat(event.x) && readFloat(event.y);
+				break;
+			case EventType::KeyReleased:
+			case EventType::KeyTyped:
+			case EventType::MouseButtonPressed:
+			case EventType::MouseButtonReleased:
+				valid = readVarint(code);
+				break;
+			default:
+				valid = false;
+				break;
+			}
+			event.code = fromZigzag(code);
+			event.repeatCount = fromZigzag(repeatCount);
+			m_events.push_back(event);
+		}
+
+		if (!valid) {
+			LOG_ERROR("Input recording is corrupt at frame {0}, stopping the replay", m_frameCount);
+			m_events.clear();
+			m_read = m_buffer.size();
+			return false;
+		}
+
+		m_time += frameTime;
+		m_frameCount++;
+		return true;
+	}
+
+	void InputRecorder::sendEvents(EventQueue& arg_queue)
+	{
+		for (const StoredEvent& event : m_events) {
+			switch (event.type) {
+			case EventType::KeyPressed: { KeyPressedEvent e(event.code, event.repeatCount); arg_queue.send(e); break; }
+			case EventType::KeyReleased: { KeyReleasedEvent e(event.code); arg_queue.send(e); break; }
+			case EventType::KeyTyped: { KeyTypedEvent e(event.code); arg_queue.send(e); break; }
+			case EventType::MouseButtonPressed: { MouseButtonPressedEvent e(event.code); arg_queue.send(e); break; }
+			case EventType::MouseButtonReleased: { MouseButtonReleasedEvent e(event.code); arg_queue.send(e); break; }
+			case EventType::MouseMoved: { MouseMovedEvent e(event.x, event.y); arg_queue.send(e); break; }
+			case EventType::MouseScrolled: { MouseScrolledEvent e(event.x, event.y); arg_queue.send(e); break; }
+			case EventType::WindowResize: //!< Not sent, the live window keeps its own size
+				m_windowWidth = static_cast<uint32_t>(event.code);
+				m_windowHeight = static_cast<uint32_t>(event.repeatCount);
+				break;
+			default: break;
+			}
+		}
+		m_events.clear();
+	}
+
+	void InputRecorder::writeVarint(uint64_t arg_value)
+	{
+		while (arg_value >= 0x80) {
+			m_buffer.push_back(static_cast<unsigned char>(arg_value | 0x80));
+			arg_value >>= 7;
+		}
+		m_buffer.push_back(static_cast<unsigned char>(arg_value));
+	}
+
+	void InputRecorder::writeFloat(float arg_value)
+	{
+		unsigned char bytes[sizeof(float)];
+		std::memcpy(bytes, &arg_value, sizeof(float)); //!< The exact bits, so replayed positions match to the last one
+		m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(float));
+	}
+
+	bool InputRecorder::readVarint(uint64_t& arg_value)
+	{
+		arg_value = 0;
+		for (uint32_t shift = 0; shift < 64; shift += 7) {
+			if (m_read == m_buffer.size()) return false;
+			unsigned char byte = m_buffer[m_read++];
+			arg_value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) return true;
+		}
+		return false;
+	}
+
+	bool InputRecorder::readFloat(float& arg_value)
+	{
+		if (m_buffer.size() - m_read < sizeof(float)) return false;
+		std::memcpy(&arg_value, m_buffer.data() + m_read, sizeof(float));
+		m_read += sizeof(float);
+		return true;
+	}
+}
@@ -0,0 +1,100 @@
+/**\ file inputState.cpp */
+#include "engine_pch.h"
+#include "events/inputState.h"
+
+namespace Engine {
+	InputSnapshot InputState::s_current;
+	InputSnapshot InputState::s_previous;
+	InputSnapshot InputState::s_next;
+	bool InputState::s_hasPosition = false;
+
+	void InputState::addHandlers(EventDispatchTable& arg_table)
+	{
+		arg_table.add<&InputState::onKeyPressed>();
+		arg_table.add<&InputState::onKeyReleased>();
+		arg_table.add<&InputState::onMouseButtonPressed>();
+		arg_table.add<&InputState::onMouseButtonReleased>();
+		arg_table.add<&InputState::onMouseMoved>();
+		arg_table.add<&InputState::onMouseScrolled>();
+	}
+
+	void InputState::beginFrame()
+	{
+		s_previous = s_current;
+		s_current = s_next;
+
+		/**\ Down carries over, the edges and deltas start again */
+		s_next.keysPressed.reset();
+		s_next.keysReleased.reset();
+		s_next.buttonsPressed.reset();
+		s_next.buttonsReleased.reset();
+		s_next.mouseDelta = glm::vec2(0.f);
+		s_next.scrollDelta = glm::vec2(0.f);
+		s_next.eventTime = 0;
+	}
+
+	void InputState::reset()
+	{
+		s_current = InputSnapshot();
+		s_previous = InputSnapshot();
+		s_next = InputSnapshot();
+		s_hasPosition = false;
+	}
+
+	bool InputState::onKeyPressed(KeyPressedEvent& e)
+	{
+		noteTime(e);
+		int key = e.GetKeyCode();
+		if (!inRange(key, InputSnapshot::s_keyCount)) return false;
+		if (!s_next.keysDown[key]) s_next.keysPressed.set(key); //!< Repeats aren't presses
+		s_next.keysDown.set(key);
+		return false;
+	}
+
+	bool InputState::onKeyReleased(KeyReleasedEvent& e)
+	{
+		noteTime(e);
+		int key = e.GetKeyCode();
+		if (!inRange(key, InputSnapshot::s_keyCount)) return false;
+		s_next.keysDown.reset(key);
+		s_next.keysReleased.set(key);
+		return false;
+	}
+
+	bool InputState::onMouseButtonPressed(MouseButtonPressedEvent& e)
+	{
+		noteTime(e);
+		int button = static_cast<int>(e.getButton());
+		if (!inRange(button, InputSnapshot::s_buttonCount)) return false;
+		if (!s_next.buttonsDown[button]) s_next.buttonsPressed.set(button);
+		s_next.buttonsDown.set(button);
+		return false;
+	}
+
+	bool InputState::onMouseButtonReleased(MouseButtonReleasedEvent& e)
+	{
+		noteTime(e);
+		int button = static_cast<int>(e.getButton());
+		if (!inRange(button, InputSnapshot::s_buttonCount)) return false;
+		s_next.buttonsDown.reset(button);
+		s_next.buttonsReleased.set(button);
+		return false;
+	}
+
+	bool InputState::onMouseMoved(MouseMovedEvent& e)
+	{
+		noteTime(e);
+		glm::vec2 position(e.getX(), e.getY());
+		if (s_hasPosition) s_next.mouseDelta += position - s_next.mousePosition;
+		s_next.mousePosition = position;
+		s_hasPosition = true;
+		return false;
+	}
+
+	bool InputState::onMouseScrolled(MouseScrolledEvent& e)
+	{
+		noteTime(e);
+		s_next.scrollDelta += glm::vec2(e.getXOffset(), e.getYOffset());
+		return false;
+	}
+}
@@ -0,0 +1,73 @@
+/** \file bounds.cpp */
+#include "engine_pch.h"
+#include "physics/bounds.h"
+
+namespace Engine {
+	AABB AABB::transform(const AABB& arg_box, const glm::mat4& arg_matrix)
+	{
+		/**\ The centre moves with the matrix, each world extent is the local extents through the absolute rotation and scale */
+		glm::vec3 centre = glm::vec3(arg_matrix * glm::vec4(arg_box.getCentre(), 1.f));
+		glm::vec3 extents = arg_box.getExtents();
+		glm::vec3 worldExtents(0.f);
+		for (int column = 0; column < 3; column++) {
+			glm::vec3 axis = glm::abs(glm::vec3(arg_matrix[column])) * extents[column];
+			worldExtents += axis;
+		}
+		return AABB(centre - worldExtents, centre + worldExtents);
+	}
+
+	Ray Ray::transform(const Ray& arg_ray, const glm::mat4& arg_matrix)
+	{
+		return Ray(glm::vec3(arg_matrix * glm::vec4(arg_ray.origin, 1.f)), glm::vec3(arg_matrix * glm::vec4(arg_ray.direction, 0.f)));
+	}
+
+	Ray Ray::fromScreen(const glm::vec2& arg_pixel, const glm::vec2& arg_screenSize, const glm::mat4& arg_view, const glm::mat4& arg_projection)
+	{
+		glm::vec2 ndc(arg_pixel.x / arg_screenSize.x * 2.f - 1.f, 1.f - arg_pixel.y / arg_screenSize.y * 2.f);
+		glm::mat4 inverse = glm::inverse(arg_projection * arg_view);
+		glm::vec4 nearPoint = inverse * glm::vec4(ndc.x, ndc.y, -1.f, 1.f);
+		glm::vec4 farPoint = inverse * glm::vec4(ndc.x, ndc.y, 1.f, 1.f);
+		glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+		glm::vec3 end = glm::vec3(farPoint) / farPoint.w;
+		return Ray(origin, glm::normalize(end - origin));
+	}
+
+	Frustum Frustum::fromMatrix(const glm::mat4& arg_viewProjection)
+	{
+		/**\ Each plane is the last row of the matrix plus or minus one of the others (Gribb and Hartmann) */
+		const glm::mat4& m = arg_viewProjection;
+		glm::vec4 rows[4];
+		for (int row = 0; row < 4; row++) rows[row] = glm::vec4(m[0][row], m[1][row], m[2][row], m[3][row]);
+
+		Frustum frustum;
+		for (int axis = 0; axis < 3; axis++) {
+			frustum.planes[axis * 2] = rows[3] + rows[axis];
+			frustum.planes[axis * 2 + 1] = rows[3] - rows[axis];
+		}
+		for (auto& plane : frustum.planes) plane = plane / glm::length(glm::vec3(plane));
+		return frustum;
+	}
+
+	Frustum::Result Frustum::test(const AABB& arg_box) const
+	{
+		glm::vec3 centre = arg_box.getCentre();
+		glm::vec3 extents = arg_box.getExtents();
+		Result result = Result::Inside;
+		for (const auto& plane : planes) {
+			glm::vec3 normal(plane);
+			float distance = glm::dot(normal, centre) + plane.w;
+			float radius = glm::dot(glm::abs(normal), extents); //!< Projected half size of the box onto the normal
+			if (distance < -radius) return Result::Outside;
+			if (distance < radius) result = Result::Intersects;
+		}
+		return result;
+	}
+
+	bool Frustum::test(const glm::vec3& arg_centre, float arg_radius) const
+	{
+		for (const auto& plane : planes) {
+			if (glm::dot(glm::vec3(plane), arg_centre) + plane.w < -arg_radius) return false;
+		}
+		return true;
+	}
+}
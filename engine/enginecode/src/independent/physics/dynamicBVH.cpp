@@ -0,0 +1,500 @@
+/** \file dynamicBVH.cpp */
+#include "engine_pch.h"
+#include "physics/dynamicBVH.h"
+#include "systems/jobSystem.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace Engine {
+	namespace {
+		const uint32_t s_binCount = 16; //!< Split candidates per axis when building
+		const uint32_t s_parallelBuildSize = 4096; //!< Subtrees at least this big build their two halves on different jobs
+	}
+
+	DynamicBVH::Proxy DynamicBVH::insert(const AABB& arg_box, uint64_t arg_userData)
+	{
+		Proxy proxy;
+		if (!m_freeProxies.empty()) {
+			proxy = m_freeProxies.back();
+			m_freeProxies.pop_back();
+		}
+		else {
+			proxy = static_cast<Proxy>(m_proxies.size());
+			m_proxies.emplace_back();
+		}
+
+		uint32_t leaf = allocateNode();
+		m_nodes[leaf].box = AABB::expand(arg_box, m_margin);
+		m_nodes[leaf].right = proxy;
+		m_proxies[proxy] = { arg_box, arg_userData, leaf };
+		insertLeaf(leaf);
+		m_proxyCount++;
+		return proxy;
+	}
+
+	void DynamicBVH::remove(Proxy arg_proxy)
+	{
+		uint32_t leaf = m_proxies[arg_proxy].node;
+		removeLeaf(leaf);
+		freeNode(leaf);
+		m_proxies[arg_proxy].node = s_null;
+		m_freeProxies.push_back(arg_proxy);
+		m_proxyCount--;
+	}
+
+	bool DynamicBVH::move(Proxy arg_proxy, const AABB& arg_box)
+	{
+		ProxyData& proxy = m_proxies[arg_proxy];
+		proxy.box = arg_box;
+		if (m_nodes[proxy.node].box.contains(arg_box)) return false;
+
+		removeLeaf(proxy.node);
+		m_nodes[proxy.node].box = AABB::expand(arg_box, m_margin);
+		insertLeaf(proxy.node);
+		return true;
+	}
+
+	void DynamicBVH::setBox(Proxy arg_proxy, const AABB& arg_box)
+	{
+		ProxyData& proxy = m_proxies[arg_proxy];
+		proxy.box = arg_box;
+		Node& leaf = m_nodes[proxy.node];
+		if (leaf.box.contains(arg_box)) return;
+		leaf.box = AABB::expand(arg_box, m_margin);
+		m_refitNeeded = true;
+	}
+
+	void DynamicBVH::refit()
+	{
+		if (!m_refitNeeded || m_root == s_null) return;
+		m_refitNeeded = false;
+
+		/**\ Children have to be done before their parent. After a rebuild the nodes are depth first, so backwards works,
+		*	 otherwise a depth first order is made first
+		*/
+		if (!m_preOrdered) {
+			m_refitOrder.clear();
+			m_refitOrder.push_back(m_root);
+			for (uint32_t i = 0; i < m_refitOrder.size(); i++) {
+				const Node& node = m_nodes[m_refitOrder[i]];
+				if (!node.isLeaf()) {
+					m_refitOrder.push_back(node.left);
+					m_refitOrder.push_back(node.right);
+				}
+			}
+		}
+
+		float parentArea = 0.f;
+		uint32_t count = m_preOrdered ? static_cast<uint32_t>(m_nodes.size()) : static_cast<uint32_t>(m_refitOrder.size());
+		for (uint32_t i = count; i-- > 0;) {
+			Node& node = m_nodes[m_preOrdered ? i : m_refitOrder[i]];
+			if (node.isLeaf()) continue;
+			node.box = AABB::merge(m_nodes[node.left].box, m_nodes[node.right].box);
+			parentArea += node.box.getSurfaceArea();
+		}
+
+		float rootArea = m_nodes[m_root].box.getSurfaceArea();
+		float cost = rootArea > 0.f ? parentArea / rootArea : 0.f;
+		if (cost > m_builtCost * m_rebuildRatio) rebuild();
+	}
+
+	void DynamicBVH::rebuild()
+	{
+		m_buildItems.clear();
+		AABB bounds;
+		AABB centres;
+		for (Proxy proxy = 0; proxy < m_proxies.size(); proxy++) {
+			uint32_t leaf = m_proxies[proxy].node;
+			if (leaf == s_null) continue;
+			const AABB& box = m_nodes[leaf].box;
+			glm::vec3 centre = box.getCentre();
+			m_buildItems.push_back({ box, centre, proxy });
+			bounds = AABB::merge(bounds, box);
+			centres = AABB::merge(centres, AABB(centre, centre));
+		}
+
+		m_freeNodes.clear();
+		m_refitNeeded = false;
+		m_rebuildCount++;
+		uint32_t count = static_cast<uint32_t>(m_buildItems.size());
+		if (!count) {
+			m_nodes.clear();
+			m_root = s_null;
+			m_builtCost = 0.f;
+			return;
+		}
+
+		m_nodes.resize(count * 2 - 1);
+		buildRange(0, count, 0, s_null, bounds, centres);
+		m_root = 0;
+		m_preOrdered = true;
+		m_builtCost = getCost();
+	}
+
+	void DynamicBVH::buildRange(uint32_t arg_begin, uint32_t arg_end, uint32_t arg_node, uint32_t arg_parent, const AABB& arg_bounds, const AABB& arg_centres)
+	{
+		Node& node = m_nodes[arg_node];
+		node.parent = arg_parent;
+		node.box = arg_bounds;
+		uint32_t count = arg_end - arg_begin;
+		if (count == 1) {
+			const BuildItem& item = m_buildItems[arg_begin];
+			node.left = s_null;
+			node.right = item.proxy;
+			m_proxies[item.proxy].node = arg_node;
+			return;
+		}
+
+		/**\ Split on the axis the centres spread furthest along */
+		glm::vec3 spread = arg_centres.max - arg_centres.min;
+		int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+		uint32_t middle;
+		AABB leftBounds, leftCentres, rightBounds, rightCentres;
+		if (spread[axis] > 0.f) {
+			/**\ Each item goes in a bin by its centre, then every boundary between bins is scored by the surface area heuristic */
+			struct Bin
+			{
+				AABB box;
+				AABB centres;
+				uint32_t count = 0;
+			};
+			Bin bins[s_binCount];
+			uint32_t binCount = std::min(s_binCount, count); //!< Small ranges aren't worth sixteen bins, most nodes are near the leaves
+			float scale = binCount * 0.9999f / spread[axis];
+			float start = arg_centres.min[axis];
+			auto binOf = [axis, scale, start](const BuildItem& arg_item) { return static_cast<uint32_t>((arg_item.centre[axis] - start) * scale); };
+			for (uint32_t i = arg_begin; i < arg_end; i++) {
+				const BuildItem& item = m_buildItems[i];
+				Bin& bin = bins[binOf(item)];
+				bin.box = AABB::merge(bin.box, item.box);
+				bin.centres = AABB::merge(bin.centres, AABB(item.centre, item.centre));
+				bin.count++;
+			}
+
+			float rightCosts[s_binCount];
+			AABB rightBox;
+			uint32_t rightCount = 0;
+			for (uint32_t bin = binCount - 1; bin > 0; bin--) {
+				rightBox = AABB::merge(rightBox, bins[bin].box);
+				rightCount += bins[bin].count;
+				rightCosts[bin] = rightCount ? rightBox.getSurfaceArea() * rightCount : 0.f;
+			}
+
+			float bestCost = FLT_MAX;
+			uint32_t bestSplit = 0;
+			AABB leftBox;
+			uint32_t leftCount = 0;
+			for (uint32_t split = 1; split < binCount; split++) {
+				leftBox = AABB::merge(leftBox, bins[split - 1].box);
+				leftCount += bins[split - 1].count;
+				if (!leftCount || leftCount == count) continue; //!< Both sides need something
+				float cost = leftBox.getSurfaceArea() * leftCount + rightCosts[split];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestSplit = split;
+				}
+			}
+
+			for (uint32_t bin = 0; bin < binCount; bin++) {
+				if (bin < bestSplit) {
+					leftBounds = AABB::merge(leftBounds, bins[bin].box);
+					leftCentres = AABB::merge(leftCentres, bins[bin].centres);
+				}
+				else {
+					rightBounds = AABB::merge(rightBounds, bins[bin].box);
+					rightCentres = AABB::merge(rightCentres, bins[bin].centres);
+				}
+			}
+			auto split = std::partition(m_buildItems.begin() + arg_begin, m_buildItems.begin() + arg_end, [&binOf, bestSplit](const BuildItem& arg_item) { return binOf(arg_item) < bestSplit; });
+			middle = static_cast<uint32_t>(split - m_buildItems.begin());
+		}
+		else {
+			/**\ Every centre in the same place, any split is as good as another */
+			middle = arg_begin + count / 2;
+			leftCentres = rightCentres = arg_centres;
+			for (uint32_t i = arg_begin; i < middle; i++) leftBounds = AABB::merge(leftBounds, m_buildItems[i].box);
+			for (uint32_t i = middle; i < arg_end; i++) rightBounds = AABB::merge(rightBounds, m_buildItems[i].box);
+		}
+
+		/**\ The left subtree takes the next 2 * left - 1 nodes, the right subtree the ones after */
+		uint32_t left = arg_node + 1;
+		uint32_t right = arg_node + 2 * (middle - arg_begin);
+		node.left = left;
+		node.right = right;
+		if (count >= s_parallelBuildSize && jobSystem::isRunning()) {
+			JobCounter counter;
+			jobSystem::run([&, arg_begin, middle, left, arg_node]() { buildRange(arg_begin, middle, left, arg_node, leftBounds, leftCentres); }, &counter);
+			buildRange(middle, arg_end, right, arg_node, rightBounds, rightCentres);
+			jobSystem::wait(counter);
+		}
+		else {
+			buildRange(arg_begin, middle, left, arg_node, leftBounds, leftCentres);
+			buildRange(middle, arg_end, right, arg_node, rightBounds, rightCentres);
+		}
+	}
+
+	float DynamicBVH::getCost() const
+	{
+		if (m_root == s_null) return 0.f;
+		float parentArea = 0.f;
+		Stack<uint32_t> stack;
+		stack.push(m_root);
+		while (!stack.empty()) {
+			const Node& node = m_nodes[stack.pop()];
+			if (node.isLeaf()) continue;
+			parentArea += node.box.getSurfaceArea();
+			stack.push(node.left);
+			stack.push(node.right);
+		}
+		float rootArea = m_nodes[m_root].box.getSurfaceArea();
+		return rootArea > 0.f ? parentArea / rootArea : 0.f;
+	}
+
+	uint32_t DynamicBVH::getHeight() const
+	{
+		if (m_root == s_null) return 0;
+		uint32_t height = 0;
+		std::vector<std::pair<uint32_t, uint32_t>> stack = { { m_root, 1 } };
+		while (!stack.empty()) {
+			auto current = stack.back();
+			stack.pop_back();
+			height = std::max(height, current.second);
+			const Node& node = m_nodes[current.first];
+			if (node.isLeaf()) continue;
+			stack.push_back({ node.left, current.second + 1 });
+			stack.push_back({ node.right, current.second + 1 });
+		}
+		return height;
+	}
+
+	uint32_t DynamicBVH::allocateNode()
+	{
+		m_preOrdered = false;
+		if (!m_freeNodes.empty()) {
+			uint32_t node = m_freeNodes.back();
+			m_freeNodes.pop_back();
+			m_nodes[node] = Node();
+			return node;
+		}
+		m_nodes.emplace_back();
+		return static_cast<uint32_t>(m_nodes.size() - 1);
+	}
+
+	void DynamicBVH::freeNode(uint32_t arg_node)
+	{
+		m_preOrdered = false;
+		m_nodes[arg_node] = Node();
+		m_freeNodes.push_back(arg_node);
+	}
+
+	void DynamicBVH::insertLeaf(uint32_t arg_leaf)
+	{
+		m_preOrdered = false;
+		if (m_root == s_null) {
+			m_root = arg_leaf;
+			m_nodes[arg_leaf].parent = s_null;
+			return;
+		}
+
+		/**\ Walks down to the cheapest sibling. Going down a child costs the growth of every box passed on the way */
+		const AABB leafBox = m_nodes[arg_leaf].box;
+		uint32_t index = m_root;
+		while (!m_nodes[index].isLeaf()) {
+			const Node& node = m_nodes[index];
+			float area = node.box.getSurfaceArea();
+			float combinedArea = AABB::merge(node.box, leafBox).getSurfaceArea();
+			float siblingCost = 2.f * combinedArea; //!< New parent here
+			float inheritedCost = 2.f * (combinedArea - area);
+
+			auto descendCost = [&](uint32_t arg_child) {
+				const Node& child = m_nodes[arg_child];
+				float merged = AABB::merge(child.box, leafBox).getSurfaceArea();
+				return (child.isLeaf() ? merged : merged - child.box.getSurfaceArea()) + inheritedCost;
+			};
+			float leftCost = descendCost(node.left);
+			float rightCost = descendCost(node.right);
+			if (siblingCost < leftCost && siblingCost < rightCost) break;
+			index = leftCost < rightCost ? node.left : node.right;
+		}
+
+		uint32_t sibling = index;
+		uint32_t oldParent = m_nodes[sibling].parent;
+		uint32_t newParent = allocateNode();
+		Node& parent = m_nodes[newParent];
+		parent.parent = oldParent;
+		parent.box = AABB::merge(leafBox, m_nodes[sibling].box);
+		parent.left = sibling;
+		parent.right = arg_leaf;
+		m_nodes[sibling].parent = newParent;
+		m_nodes[arg_leaf].parent = newParent;
+
+		if (oldParent == s_null) m_root = newParent;
+		else {
+			Node& grandparent = m_nodes[oldParent];
+			if (grandparent.left == sibling) grandparent.left = newParent;
+			else grandparent.right = newParent;
+		}
+		refitAncestors(oldParent);
+	}
+
+	void DynamicBVH::removeLeaf(uint32_t arg_leaf)
+	{
+		m_preOrdered = false;
+		if (arg_leaf == m_root) {
+			m_root = s_null;
+			return;
+		}
+
+		/**\ The sibling takes the parent's place */
+		uint32_t parent = m_nodes[arg_leaf].parent;
+		uint32_t grandparent = m_nodes[parent].parent;
+		uint32_t sibling = m_nodes[parent].left == arg_leaf ? m_nodes[parent].right : m_nodes[parent].left;
+		m_nodes[sibling].parent = grandparent;
+		if (grandparent == s_null) m_root = sibling;
+		else {
+			Node& node = m_nodes[grandparent];
+			if (node.left == parent) node.left = sibling;
+			else node.right = sibling;
+		}
+		freeNode(parent);
+		m_nodes[arg_leaf].parent = s_null;
+		refitAncestors(grandparent);
+	}
+
+	void DynamicBVH::refitAncestors(uint32_t arg_node)
+	{
+		for (uint32_t index = arg_node; index != s_null; index = m_nodes[index].parent) {
+			Node& node = m_nodes[index];
+			node.box = AABB::merge(m_nodes[node.left].box, m_nodes[node.right].box);
+		}
+	}
+
+	void DynamicBVH::addLeaves(uint32_t arg_node, std::vector<uint64_t>& arg_results) const
+	{
+		Stack<uint32_t> stack;
+		stack.push(arg_node);
+		while (!stack.empty()) {
+			const Node& node = m_nodes[stack.pop()];
+			if (node.isLeaf()) arg_results.push_back(m_proxies[node.right].userData);
+			else {
+				stack.push(node.left);
+				stack.push(node.right);
+			}
+		}
+	}
+
+	void DynamicBVH::queryBox(const AABB& arg_box, std::vector<uint64_t>& arg_results) const
+	{
+		if (m_root == s_null) return;
+		Stack<uint32_t> stack;
+		stack.push(m_root);
+		while (!stack.empty()) {
+			const Node& node = m_nodes[stack.pop()];
+			if (!node.box.overlaps(arg_box)) continue;
+			if (node.isLeaf()) {
+				const ProxyData& proxy = m_proxies[node.right];
+				if (proxy.box.overlaps(arg_box)) arg_results.push_back(proxy.userData);
+				continue;
+			}
+			stack.push(node.left);
+			stack.push(node.right);
+		}
+	}
+
+	void DynamicBVH::querySphere(const glm::vec3& arg_centre, float arg_radius, std::vector<uint64_t>& arg_results) const
+	{
+		if (m_root == s_null) return;
+		float radiusSquared = arg_radius * arg_radius;
+		Stack<uint32_t> stack;
+		stack.push(m_root);
+		while (!stack.empty()) {
+			const Node& node = m_nodes[stack.pop()];
+			if (node.box.getDistanceSquared(arg_centre) > radiusSquared) continue;
+			if (node.isLeaf()) {
+				const ProxyData& proxy = m_proxies[node.right];
+				if (proxy.box.getDistanceSquared(arg_centre) <= radiusSquared) arg_results.push_back(proxy.userData);
+				continue;
+			}
+			stack.push(node.left);
+			stack.push(node.right);
+		}
+	}
+
+	void DynamicBVH::queryFrustum(const Frustum& arg_frustum, std::vector<uint64_t>& arg_results) const
+	{
+		if (m_root == s_null) return;
+		Stack<uint32_t> stack;
+		stack.push(m_root);
+		while (!stack.empty()) {
+			uint32_t index = stack.pop();
+			const Node& node = m_nodes[index];
+			Frustum::Result result = arg_frustum.test(node.box);
+			if (result == Frustum::Result::Outside) continue;
+			if (result == Frustum::Result::Inside) {
+				addLeaves(index, arg_results); //!< Every object box is inside the leaf boxes, no more tests needed
+				continue;
+			}
+			if (node.isLeaf()) {
+				const ProxyData& proxy = m_proxies[node.right];
+				if (arg_frustum.test(proxy.box) != Frustum::Result::Outside) arg_results.push_back(proxy.userData);
+				continue;
+			}
+			stack.push(node.left);
+			stack.push(node.right);
+		}
+	}
+
+	void DynamicBVH::queryNearest(const glm::vec3& arg_point, uint32_t arg_count, std::vector<NearestHit>& arg_results) const
+	{
+		arg_results.clear();
+		if (m_root == s_null || !arg_count) return;
+
+		/**\ Best first: nodes come off the queue closest first, and the search stops when the next is further than the kth best so far */
+		using Candidate = std::pair<float, uint32_t>;
+		std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> nodes;
+		auto furthestFirst = [](const NearestHit& arg_a, const NearestHit& arg_b) { return arg_a.distanceSquared < arg_b.distanceSquared; };
+		nodes.push({ m_nodes[m_root].box.getDistanceSquared(arg_point), m_root });
+		while (!nodes.empty()) {
+			Candidate candidate = nodes.top();
+			nodes.pop();
+			if (arg_results.size() == arg_count && candidate.first >= arg_results.front().distanceSquared) break;
+
+			const Node& node = m_nodes[candidate.second];
+			if (node.isLeaf()) {
+				const ProxyData& proxy = m_proxies[node.right];
+				float distanceSquared = proxy.box.getDistanceSquared(arg_point);
+				if (arg_results.size() == arg_count) {
+					if (distanceSquared >= arg_results.front().distanceSquared) continue;
+					std::pop_heap(arg_results.begin(), arg_results.end(), furthestFirst);
+					arg_results.pop_back();
+				}
+				arg_results.push_back({ distanceSquared, proxy.userData, node.right });
+				std::push_heap(arg_results.begin(), arg_results.end(), furthestFirst);
+				continue;
+			}
+			nodes.push({ m_nodes[node.left].box.getDistanceSquared(arg_point), node.left });
+			nodes.push({ m_nodes[node.right].box.getDistanceSquared(arg_point), node.right });
+		}
+		std::sort_heap(arg_results.begin(), arg_results.end(), furthestFirst);
+	}
+
+	RayHit DynamicBVH::raycast(const Ray& arg_ray, float arg_maxDistance) const
+	{
+		return raycastLeaves(arg_ray, arg_maxDistance, [](const ProxyData& arg_proxy, const Ray& arg_leafRay, float& arg_distance) { return Intersection::rayBox(arg_leafRay, arg_proxy.box, arg_distance); });
+	}
+
+	void DynamicBVH::raycastBatch(const Ray* arg_rays, uint32_t arg_count, float arg_maxDistance, RayHit* arg_hits) const
+	{
+		jobSystem::parallelFor(arg_count, 64, [&](uint32_t arg_begin, uint32_t arg_end) {
+			for (uint32_t i = arg_begin; i < arg_end; i++) arg_hits[i] = raycast(arg_rays[i], arg_maxDistance);
+		});
+	}
+
+	void DynamicBVH::queryFrustumBatch(const Frustum* arg_frustums, uint32_t arg_count, std::vector<uint64_t>* arg_results) const
+	{
+		jobSystem::parallelFor(arg_count, 1, [&](uint32_t arg_begin, uint32_t arg_end) {
+			for (uint32_t i = arg_begin; i < arg_end; i++) queryFrustum(arg_frustums[i], arg_results[i]);
+		});
+	}
+}
@@ -0,0 +1,147 @@
+/** \file intersection.cpp */
+#include "engine_pch.h"
+#include "physics/intersection.h"
+
+#include <cmath>
+
+#ifdef NG_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Engine {
+	namespace {
+		const float s_parallelEpsilon = 1e-8f; //!< Below this the ray runs along the triangle's plane
+	}
+
+	bool Intersection::rayBox(const Ray& arg_ray, const AABB& arg_box, float& arg_distance)
+	{
+#ifdef NG_SSE
+		/**\ The fourth lane is set up so its slab is [0, distance], clamping the hit to the range wanted for free */
+		__m128 origin = _mm_setr_ps(arg_ray.origin.x, arg_ray.origin.y, arg_ray.origin.z, 0.f);
+		__m128 inverse = _mm_setr_ps(arg_ray.inverseDirection.x, arg_ray.inverseDirection.y, arg_ray.inverseDirection.z, 1.f);
+		__m128 boxMin = _mm_setr_ps(arg_box.min.x, arg_box.min.y, arg_box.min.z, 0.f);
+		__m128 boxMax = _mm_setr_ps(arg_box.max.x, arg_box.max.y, arg_box.max.z, arg_distance);
+
+		__m128 t1 = _mm_mul_ps(_mm_sub_ps(boxMin, origin), inverse);
+		__m128 t2 = _mm_mul_ps(_mm_sub_ps(boxMax, origin), inverse);
+		__m128 enter = _mm_min_ps(t1, t2);
+		__m128 exit = _mm_max_ps(t1, t2);
+
+		/**\ Largest entry and smallest exit across the lanes */
+		enter = _mm_max_ps(enter, _mm_shuffle_ps(enter, enter, _MM_SHUFFLE(1, 0, 3, 2)));
+		enter = _mm_max_ps(enter, _mm_shuffle_ps(enter, enter, _MM_SHUFFLE(2, 3, 0, 1)));
+		exit = _mm_min_ps(exit, _mm_shuffle_ps(exit, exit, _MM_SHUFFLE(1, 0, 3, 2)));
+		exit = _mm_min_ps(exit, _mm_shuffle_ps(exit, exit, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		if (!_mm_comile_ss(enter, exit)) return false;
+		arg_distance = _mm_cvtss_f32(enter);
+		return true;
+#else
+		float enter = 0.f;
+		float exit = arg_distance;
+		for (int axis = 0; axis < 3; axis++) {
+			float t1 = (arg_box.min[axis] - arg_ray.origin[axis]) * arg_ray.inverseDirection[axis];
+			float t2 = (arg_box.max[axis] - arg_ray.origin[axis]) * arg_ray.inverseDirection[axis];
+			enter = std::fmax(enter, std::fmin(t1, t2));
+			exit = std::fmin(exit, std::fmax(t1, t2));
+		}
+		if (enter > exit) return false;
+		arg_distance = enter;
+		return true;
+#endif
+	}
+
+	bool Intersection::rayTriangle(const Ray& arg_ray, const glm::vec3& arg_v0, const glm::vec3& arg_v1, const glm::vec3& arg_v2, float& arg_distance)
+	{
+		/**\ Moller-Trumbore */
+		glm::vec3 edge1 = arg_v1 - arg_v0;
+		glm::vec3 edge2 = arg_v2 - arg_v0;
+		glm::vec3 p = glm::cross(arg_ray.direction, edge2);
+		float determinant = glm::dot(edge1, p);
+		if (std::abs(determinant) < s_parallelEpsilon) return false;
+
+		float inverseDeterminant = 1.f / determinant;
+		glm::vec3 s = arg_ray.origin - arg_v0;
+		float u = glm::dot(s, p) * inverseDeterminant;
+		if (u < 0.f || u > 1.f) return false;
+		glm::vec3 q = glm::cross(s, edge1);
+		float v = glm::dot(arg_ray.direction, q) * inverseDeterminant;
+		if (v < 0.f || u + v > 1.f) return false;
+		float t = glm::dot(edge2, q) * inverseDeterminant;
+		if (t < 0.f || t > arg_distance) return false;
+
+		arg_distance = t;
+		return true;
+	}
+
+	bool Intersection::rayTriangles(const Ray& arg_ray, const float* arg_vertices, uint32_t arg_stride, const uint32_t* arg_indices, uint32_t arg_triangleCount, float& arg_distance)
+	{
+		bool hit = false;
+		uint32_t triangle = 0;
+#ifdef NG_SSE
+		/**\ Four triangles per pass, each register holds one component of the four */
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 epsilon = _mm_set1_ps(s_parallelEpsilon);
+		const __m128 signMask = _mm_set1_ps(-0.f);
+		const __m128 dx = _mm_set1_ps(arg_ray.direction.x), dy = _mm_set1_ps(arg_ray.direction.y), dz = _mm_set1_ps(arg_ray.direction.z);
+		const __m128 ox = _mm_set1_ps(arg_ray.origin.x), oy = _mm_set1_ps(arg_ray.origin.y), oz = _mm_set1_ps(arg_ray.origin.z);
+		__m128 best = _mm_set1_ps(arg_distance);
+
+		for (; triangle + 4 <= arg_triangleCount; triangle += 4) {
+			alignas(16) float corners[3][3][4]; //!< [corner][axis][triangle]
+			for (uint32_t lane = 0; lane < 4; lane++) {
+				for (uint32_t corner = 0; corner < 3; corner++) {
+					const float* position = arg_vertices + static_cast<size_t>(arg_indices[(triangle + lane) * 3 + corner]) * arg_stride;
+					for (uint32_t axis = 0; axis < 3; axis++) corners[corner][axis][lane] = position[axis];
+				}
+			}
+			__m128 v0x = _mm_load_ps(corners[0][0]), v0y = _mm_load_ps(corners[0][1]), v0z = _mm_load_ps(corners[0][2]);
+			__m128 e1x = _mm_sub_ps(_mm_load_ps(corners[1][0]), v0x), e1y = _mm_sub_ps(_mm_load_ps(corners[1][1]), v0y), e1z = _mm_sub_ps(_mm_load_ps(corners[1][2]), v0z);
+			__m128 e2x = _mm_sub_ps(_mm_load_ps(corners[2][0]), v0x), e2y = _mm_sub_ps(_mm_load_ps(corners[2][1]), v0y), e2z = _mm_sub_ps(_mm_load_ps(corners[2][2]), v0z);
+
+			/**\ p = direction x edge2, determinant = edge1 . p */
+			__m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+			__m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+			__m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+			__m128 determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+			__m128 valid = _mm_cmpgt_ps(_mm_andnot_ps(signMask, determinant), epsilon);
+			__m128 inverseDeterminant = _mm_div_ps(one, determinant);
+
+			__m128 sx = _mm_sub_ps(ox, v0x), sy = _mm_sub_ps(oy, v0y), sz = _mm_sub_ps(oz, v0z);
+			__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inverseDeterminant);
+
+			/**\ q = s x edge1 */
+			__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+			__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+			__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+			__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inverseDeterminant);
+			__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverseDeterminant);
+
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+			valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(t, zero));
+			valid = _mm_and_ps(valid, _mm_cmplt_ps(t, best));
+			if (!_mm_movemask_ps(valid)) continue;
+
+			/**\ Closest of the lanes that hit, spread to every lane as the new limit */
+			__m128 hits = _mm_or_ps(_mm_and_ps(valid, t), _mm_andnot_ps(valid, best));
+			hits = _mm_min_ps(hits, _mm_shuffle_ps(hits, hits, _MM_SHUFFLE(1, 0, 3, 2)));
+			hits = _mm_min_ps(hits, _mm_shuffle_ps(hits, hits, _MM_SHUFFLE(2, 3, 0, 1)));
+			best = hits;
+			hit = true;
+		}
+		arg_distance = _mm_cvtss_f32(best);
+#endif
+		/**\ The last few, or all of them without SSE */
+		for (; triangle < arg_triangleCount; triangle++) {
+			const uint32_t* corners = arg_indices + triangle * 3;
+			const float* v0 = arg_vertices + static_cast<size_t>(corners[0]) * arg_stride;
+			const float* v1 = arg_vertices + static_cast<size_t>(corners[1]) * arg_stride;
+			const float* v2 = arg_vertices + static_cast<size_t>(corners[2]) * arg_stride;
+			hit |= rayTriangle(arg_ray, glm::vec3(v0[0], v0[1], v0[2]), glm::vec3(v1[0], v1[1], v1[2]), glm::vec3(v2[0], v2[1], v2[2]), arg_distance);
+		}
+		return hit;
+	}
+}
@@ -3,6 +3,7 @@
 #include "engine_pch.h"
 #include <glad/glad.h>
 #include "platform/OpenGL/OpenGLIndexBuffer.h"
+#include "rendering/renderThread.h"
 
 namespace Engine
 {
@@ -15,6 +16,7 @@ namespace Engine
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
-		glDeleteBuffers(1, &m_OpenGL_ID);
+		uint32_t id = m_OpenGL_ID;
+		RenderThread::record([id]() { glDeleteBuffers(1, &id); }); //!< The context belongs to the render thread while it runs
 	}
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**\ file OpenGLProgramBinaryDriver.cpp */
+#include "engine_pch.h"
+#include "platform/OpenGL/OpenGLProgramBinaryDriver.h"
+#include <glad/glad.h>
+
+namespace Engine
+{
+	bool OpenGLProgramBinaryDriver::isSupported() const
+	{
+		GLint formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		return formats > 0;
+	}
+
+	std::string OpenGLProgramBinaryDriver::getSignature() const
+	{
+		std::string signature;
+		for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+			const GLubyte* value = glGetString(name);
+			if (value) signature += reinterpret_cast<const char*>(value);
+			signature += '\n';
+		}
+		return signature;
+	}
+
+	bool OpenGLProgramBinaryDriver::getProgramBinary(uint32_t arg_program, uint32_t& arg_format, std::vector<unsigned char>& arg_binary)
+	{
+		GLint length = 0;
+		glGetProgramiv(arg_program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0) return false;
+
+		arg_binary.resize(length);
+		GLenum format = 0;
+		glGetProgramBinary(arg_program, length, &length, &format, arg_binary.data());
+		arg_binary.resize(length);
+		arg_format = format;
+		return length > 0;
+	}
+
+	bool OpenGLProgramBinaryDriver::loadProgramBinary(uint32_t arg_program, uint32_t arg_format, const std::vector<unsigned char>& arg_binary)
+	{
+		glProgramBinary(arg_program, arg_format, arg_binary.data(), static_cast<GLsizei>(arg_binary.size()));
+
+		GLint isLinked = 0;
+		glGetProgramiv(arg_program, GL_LINK_STATUS, &isLinked); //!< Drivers reject binaries from older versions by failing the link
+		return isLinked == GL_TRUE;
+	}
+}
@@ -0,0 +1,65 @@
+/** \file OpenGLRenderBackend.cpp */
+#include "engine_pch.h"
+#include <glad/glad.h>
+#include "platform/OpenGL/OpenGLRenderBackend.h"
+#include "rendering/shader.h"
+#include "rendering/texture.h"
+#include "rendering/vertexArray.h"
+
+namespace Engine
+{
+	void OpenGLRenderBackend::setClearColour(const glm::vec4& arg_colour)
+	{
+		glClearColor(arg_colour.x, arg_colour.y, arg_colour.z, arg_colour.w);
+	}
+
+	void OpenGLRenderBackend::clear()
+	{
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
+
+	void OpenGLRenderBackend::setDepthTest(bool arg_enabled)
+	{
+		if (arg_enabled) glEnable(GL_DEPTH_TEST);
+		else glDisable(GL_DEPTH_TEST);
+	}
+
+	void OpenGLRenderBackend::setBlend(bool arg_enabled)
+	{
+		if (arg_enabled) {
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		}
+		else glDisable(GL_BLEND);
+	}
+
+	void OpenGLRenderBackend::useShader(Shader& arg_shader)
+	{
+		glUseProgram(arg_shader.getID());
+	}
+
+	void OpenGLRenderBackend::bindTexture(Texture& arg_texture)
+	{
+		glBindTexture(GL_TEXTURE_2D, arg_texture.getID());
+	}
+
+	void OpenGLRenderBackend::drawIndexed(VertexArray& arg_geometry, DrawMode arg_mode)
+	{
+		glBindVertexArray(arg_geometry.getID());
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arg_geometry.getIndexBuffer()->getID());
+		glDrawElements(arg_mode == DrawMode::Quads ? GL_QUADS : GL_TRIANGLES, arg_geometry.getDrawCount(), GL_UNSIGNED_INT, nullptr);
+	}
+
+	void OpenGLRenderBackend::present()
+	{
+		m_context->swapBuffers();
+	}
+
+	void OpenGLRenderBackend::waitForGpu()
+	{
+		/**\ A fence after the swap is signalled once the frame is done. The timeout stops a lost context hanging the render thread */
+		GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+		glDeleteSync(fence);
+	}
+}
@@ -1,157 +1,128 @@
 /**\ file OpenGLShader.cpp */
 #include "engine_pch.h"
 #include "platform/OpenGL/OpenGLShader.h"
+#include "rendering/renderThread.h"
 #include "systems/logging.h"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <vector>
 namespace Engine 
 {
-	/**\ Opens and reads the file*/
+	ShaderPreprocessor OpenGLShader::s_preprocessor;
+
+	/**\ Opens and reads the files. Each file is split into regions and only the matching stage is used */
 	OpenGLShader::OpenGLShader(const char* arg_VerFilepath, const char* arg_FragFilepath)
 	{
-		src[Region::R_VERTEX] = readFile(arg_VerFilepath, src)[Region::R_VERTEX];
-		src[Region::R_FRAGMENT] = readFile(arg_FragFilepath, src)[Region::R_FRAGMENT];
-		compileAndLink(src[Region::R_VERTEX].c_str(), src[Region::R_FRAGMENT].c_str()); //!< If both files have been read successfully, we can compile the Src strings (now containing the shader programs)
-
+		ShaderSources vertexSrc; //!< Strings to hold the body of text from each file
+		ShaderSources fragmentSrc;
+		bool read = s_preprocessor.process(arg_VerFilepath, vertexSrc);
+		std::string fileTable = s_preprocessor.getFileTable();
+		read = s_preprocessor.process(arg_FragFilepath, fragmentSrc) && read;
+		fileTable += " / " + s_preprocessor.getFileTable();
+		if (read) compileAndLink(std::string(arg_VerFilepath) + " + " + arg_FragFilepath, fileTable, vertexSrc[Region::R_VERTEX].c_str(), fragmentSrc[Region::R_FRAGMENT].c_str()); //!< If both files have been read successfully, we can compile the Src strings (now containing the shader programs)
 	}
-	OpenGLShader::OpenGLShader(const char* arg_Filepath)
+	OpenGLShader::OpenGLShader(const char* arg_Filepath, const ShaderDefines& arg_defines)
 	{
-		std::array<std::string, Region::R_COMPUTE + 1> src; //!< Strings to hold the body of text from each file
-		src = readFile(arg_Filepath, src); 
-		compileAndLink(src[Region::R_VERTEX].c_str(), src[Region::R_FRAGMENT].c_str()); //!< If both files have been read successfully, we can compile the Src strings (now containing the shader programs)
+		ShaderSources src; //!< Strings to hold the body of text from each region
+		bool read = s_preprocessor.process(arg_Filepath, src, arg_defines);
+
+		std::string name = arg_Filepath;
+		for (auto& define : arg_defines) name += " " + define;
+		if (read) compileAndLink(name, s_preprocessor.getFileTable(), src[Region::R_VERTEX].c_str(), src[Region::R_FRAGMENT].c_str()); //!< If the file has been read successfully, we can compile the Src strings (now containing the shader programs)
 	}
 
 	/** Cleaning up memory on application exit
 	*	Deletes the OpenGL shader programs
 	*/
 	OpenGLShader::~OpenGLShader() {
-		glDeleteProgram(m_OpenGL_ID);
+		RenderThread::record([service = m_service, job = m_job]() {
+			if (!service) return; //!< Nothing was created
+			uint32_t program = service->getProgram(job); //!< Zero, which GL ignores, if the compile failed and the program is already gone
+			service->release(job);
+			glDeleteProgram(program);
+		});
 	}
-	
-	std::array<std::string, Region::R_COMPUTE + 1> OpenGLShader::readFile(const char* arg_Filepath, std::array<std::string, Region::R_COMPUTE + 1> arg_FileSrc) //!< Reading the filepath
-	{
-		uint32_t currentRegion = Region::R_NONE;
-		std::string line; //!< String to hold a line of text from the file
 
-		std::fstream handle(arg_Filepath, std::ios::in); //!< Creates the file reader
-		if (handle.is_open()) { //!< If the file path is ok
-			while (std::getline(handle, line)) { //!< Loops through the file line by line, and accumulates it
-				if (line.find("#region Vertex") != std::string::npos) { currentRegion = Region::R_VERTEX; continue; } //!< Continue causes the loop to immediately jump to the next iteration of the loop
-				if (line.find("#region Fragment") != std::string::npos) { currentRegion = Region::R_FRAGMENT; continue; }
-				if (line.find("#region Geometry") != std::string::npos) { currentRegion = Region::R_GEOMETRY; continue; }
-				if (line.find("#region TessellationControl") != std::string::npos) { currentRegion = Region::R_TESSELLATIONCONTROL; continue; }
-				if (line.find("#region TessellationEvaluation") != std::string::npos) { currentRegion = Region::R_TESSELLATIONEVALUATION; continue; }
-				if (line.find("#region Compute") != std::string::npos) { currentRegion = Region::R_COMPUTE; continue; }
-				if (currentRegion != Region::R_NONE) arg_FileSrc[currentRegion] += (line + "\n");
-			} 
-			handle.close();
-		}
-		else {
-			LOG_ERROR("Could not open shader filepath: {0}", arg_Filepath); //!< Logs the error to console if the filepath can't be used
-		}
-		return arg_FileSrc;
-	}
-	void OpenGLShader::compileAndLink(const char* arg_VerShaderSrc, const char* arg_FragShaderSrc)
+	bool OpenGLShader::isReady()
 	{
+		if (!m_service) return false;
+		ShaderJobState state = m_service->poll(m_job);
+		if (state == ShaderJobState::Failed) m_OpenGL_ID = 0; //!< The compiler deleted the program
+		return state == ShaderJobState::Ready;
+	}
 
-		GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-
-		const GLchar* source = arg_VerShaderSrc;
-		glShaderSource(vertexShader, 1, &source, 0);
-		glCompileShader(vertexShader);
-
-		GLint isCompiled = 0;
-		glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &isCompiled);
-		if (isCompiled == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetShaderiv(vertexShader, GL_INFO_LOG_LENGTH, &maxLength);
-
-			std::vector<GLchar> infoLog(maxLength);
-			glGetShaderInfoLog(vertexShader, maxLength, &maxLength, &infoLog[0]);
-			LOG_ERROR("Shader compile error: {0}", std::string(infoLog.begin(), infoLog.end()));
-
-			glDeleteShader(vertexShader);
+	void OpenGLShader::compileAndLink(const std::string& arg_name, const std::string& arg_fileTable, const char* arg_VerShaderSrc, const char* arg_FragShaderSrc)
+	{
+		m_service = ShaderCompilationService::getInstance();
+		if (!m_service) {
+			LOG_ERROR("No shader compilation service, {0} not built", arg_name);
 			return;
 		}
+		m_job = m_service->submit(arg_name, arg_fileTable, arg_VerShaderSrc, arg_FragShaderSrc);
+		m_OpenGL_ID = m_service->getProgram(m_job);
+	}
 
-		GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-
-		source = arg_FragShaderSrc;
-		glShaderSource(fragmentShader, 1, &source, 0);
-		glCompileShader(fragmentShader);
-
-		glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &isCompiled);
-		if (isCompiled == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetShaderiv(fragmentShader, GL_INFO_LOG_LENGTH, &maxLength);
-
-			std::vector<GLchar> infoLog(maxLength);
-			glGetShaderInfoLog(fragmentShader, maxLength, &maxLength, &infoLog[0]);
-			LOG_ERROR("Shader compile error: {0}", std::string(infoLog.begin(), infoLog.end()));
-
-			glDeleteShader(fragmentShader);
-			glDeleteShader(vertexShader);
-
-			return;
+	int32_t OpenGLShader::getLocation(StringId arg_name)
+	{
+		if (!m_locationsRead) {
+			if (!isReady()) return -1;
+			readLocations();
 		}
+		auto location = m_locations.find(arg_name);
+		return location != m_locations.end() ? location->second : -1;
+	}
 
-		m_OpenGL_ID = glCreateProgram();
-		glAttachShader(m_OpenGL_ID, vertexShader);
-		glAttachShader(m_OpenGL_ID, fragmentShader);
-		glLinkProgram(m_OpenGL_ID);
-
-		GLint isLinked = 0;
-		glGetProgramiv(m_OpenGL_ID, GL_LINK_STATUS, (int*)&isLinked);
-		if (isLinked == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetProgramiv(m_OpenGL_ID, GL_INFO_LOG_LENGTH, &maxLength);
-
-			std::vector<GLchar> infoLog(maxLength);
-			glGetProgramInfoLog(m_OpenGL_ID, maxLength, &maxLength, &infoLog[0]);
-			LOG_ERROR("Shader linking error: {0}", std::string(infoLog.begin(), infoLog.end()));
-
-			glDeleteProgram(m_OpenGL_ID);
-			glDeleteShader(vertexShader);
-			glDeleteShader(fragmentShader);
-
-			return;
+	void OpenGLShader::readLocations()
+	{
+		m_locationsRead = true;
+		GLint count = 0;
+		GLint maxLength = 0;
+		glGetProgramiv(m_OpenGL_ID, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(m_OpenGL_ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+		std::vector<char> name(maxLength + 1);
+		for (GLint i = 0; i < count; i++) {
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_OpenGL_ID, i, maxLength + 1, &length, &size, &type, name.data());
+			int32_t location = glGetUniformLocation(m_OpenGL_ID, name.data());
+			if (location < 0) continue; //!< In a uniform block, uploaded through a UniformBuffer
+
+			std::string_view text(name.data(), length);
+			m_locations[StringId::intern(text)] = location;
+			if (text.size() > 3 && text.substr(text.size() - 3) == "[0]") m_locations[StringId::intern(text.substr(0, text.size() - 3))] = location; //!< Arrays by their name alone too, as glGetUniformLocation allows
 		}
-
-		glDetachShader(m_OpenGL_ID, vertexShader);
-		glDetachShader(m_OpenGL_ID, fragmentShader);
 	}
 
-	void OpenGLShader::uploadInt(const char* arg_Name, int arg_Value)
+	void OpenGLShader::uploadInt(StringId arg_Name, int arg_Value)
 	{
-		uint32_t uniformLocation = glGetUniformLocation(m_OpenGL_ID, arg_Name);
+		int32_t uniformLocation = getLocation(arg_Name);
 		glUniform1i(uniformLocation, arg_Value);
 	}
-	void OpenGLShader::uploadFloat(const char* arg_Name, float arg_Value)
+	void OpenGLShader::uploadFloat(StringId arg_Name, float arg_Value)
 	{
-		uint32_t uniformLocation = glGetUniformLocation(m_OpenGL_ID, arg_Name);
+		int32_t uniformLocation = getLocation(arg_Name);
 		glUniform1f(uniformLocation, arg_Value);
 	}
-	void OpenGLShader::uploadFloat2(const char* arg_Name, const glm::vec2& arg_Value)
+	void OpenGLShader::uploadFloat2(StringId arg_Name, const glm::vec2& arg_Value)
 	{
-		uint32_t uniformLocation = glGetUniformLocation(m_OpenGL_ID, arg_Name);
+		int32_t uniformLocation = getLocation(arg_Name);
 		glUniform2f(uniformLocation, arg_Value.x, arg_Value.y);
 	}
-	void OpenGLShader::uploadFloat3(const char* arg_Name, const glm::vec3& arg_Value)
+	void OpenGLShader::uploadFloat3(StringId arg_Name, const glm::vec3& arg_Value)
 	{
-		uint32_t uniformLocation = glGetUniformLocation(m_OpenGL_ID, arg_Name);
+		int32_t uniformLocation = getLocation(arg_Name);
 		glUniform3f(uniformLocation, arg_Value.x, arg_Value.y, arg_Value.z);
 	}
-	void OpenGLShader::uploadFloat4(const char* arg_Name, const glm::vec4& arg_Value)
+	void OpenGLShader::uploadFloat4(StringId arg_Name, const glm::vec4& arg_Value)
 	{
-		uint32_t uniformLocation = glGetUniformLocation(m_OpenGL_ID, arg_Name);
+		int32_t uniformLocation = getLocation(arg_Name);
 		glUniform4f(uniformLocation, arg_Value.x, arg_Value.y, arg_Value.z, arg_Value.w); //Error with renderer2d
 	}
-	void OpenGLShader::uploadMat4(const char* arg_Name, const glm::mat4& arg_Value)
+	void OpenGLShader::uploadMat4(StringId arg_Name, const glm::mat4& arg_Value)
 	{
-		uint32_t uniformLocation = glGetUniformLocation(m_OpenGL_ID, arg_Name);
+		int32_t uniformLocation = getLocation(arg_Name);
 		glUniformMatrix4fv(uniformLocation, 1, GL_FALSE, glm::value_ptr(arg_Value)); 
 	}
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+/**\ file OpenGLShaderCompiler.cpp */
+#include "engine_pch.h"
+#include "platform/OpenGL/OpenGLShaderCompiler.h"
+#include "platform/OpenGL/OpenGLProgramBinaryDriver.h"
+#include "systems/logging.h"
+#include <glad/glad.h>
+
+#include <cstring>
+
+/**\ GL_KHR_parallel_shader_compile isn't in the glad build, so the tokens and entry point are declared here */
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+namespace Engine
+{
+	namespace
+	{
+		bool hasExtension(const char* arg_name)
+		{
+			GLint count = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+			for (GLint i = 0; i < count; i++) {
+				const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+				if (extension && strcmp(extension, arg_name) == 0) return true;
+			}
+			return false;
+		}
+	}
+
+	OpenGLShaderCompiler::OpenGLShaderCompiler(LoadProc arg_loadProc)
+	{
+		if (!arg_loadProc || !hasExtension("GL_KHR_parallel_shader_compile")) {
+			LOG_INFO("Parallel shader compile: not supported, programs are finished one a frame instead");
+			return;
+		}
+
+		auto maxShaderCompilerThreads = reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(arg_loadProc("glMaxShaderCompilerThreadsKHR"));
+		if (maxShaderCompilerThreads) maxShaderCompilerThreads(0xFFFFFFFF); //!< Lets the driver pick the number of threads
+		m_parallel = true;
+		LOG_INFO("Parallel shader compile: enabled");
+	}
+
+	/**\ Returns the program cache, creating it the first time a shader is built (a context is current by then) */
+	ShaderProgramCache& OpenGLShaderCompiler::getProgramCache()
+	{
+		if (!ShaderProgramCache::getInstance()) {
+			ShaderProgramCache::setInstance(std::make_shared<ShaderProgramCache>(std::make_shared<OpenGLProgramBinaryDriver>(), "./cache/shaders/"));
+		}
+		return *ShaderProgramCache::getInstance();
+	}
+
+	uint32_t OpenGLShaderCompiler::begin(const std::string& arg_name, const std::string& arg_sourceTable, const char* arg_vertexSrc, const char* arg_fragmentSrc)
+	{
+		Pending pending;
+		pending.name = arg_name;
+		pending.sourceTable = arg_sourceTable;
+
+		/**\ Trying the binary cache before compiling anything */
+		ShaderProgramCache& cache = getProgramCache();
+		pending.cacheKey = cache.makeKey({ arg_vertexSrc, arg_fragmentSrc });
+
+		GLuint program = glCreateProgram();
+		if (!cache.load(pending.cacheKey, program)) {
+			pending.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+			glShaderSource(pending.vertexShader, 1, &arg_vertexSrc, 0);
+			glCompileShader(pending.vertexShader);
+
+			pending.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+			glShaderSource(pending.fragmentShader, 1, &arg_fragmentSrc, 0);
+			glCompileShader(pending.fragmentShader);
+
+			/**\ Linking straight away, a failed compile shows up as a failed link and is reported in finish() */
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); //!< Lets the driver keep the binary for the cache
+			glAttachShader(program, pending.vertexShader);
+			glAttachShader(program, pending.fragmentShader);
+			glLinkProgram(program);
+		}
+
+		m_pending[program] = pending;
+		return program;
+	}
+
+	bool OpenGLShaderCompiler::isComplete(uint32_t arg_program)
+	{
+		auto it = m_pending.find(arg_program);
+		if (it == m_pending.end() || !it->second.vertexShader) return true; //!< Restored from the cache
+		if (!m_parallel) return false; //!< Can't ask without blocking, the service finishes it in update()
+
+		GLint complete = GL_FALSE;
+		glGetProgramiv(arg_program, GL_COMPLETION_STATUS_KHR, &complete);
+		return complete == GL_TRUE;
+	}
+
+	bool OpenGLShaderCompiler::checkShader(uint32_t arg_shader, const Pending& arg_pending)
+	{
+		GLint isCompiled = 0;
+		glGetShaderiv(arg_shader, GL_COMPILE_STATUS, &isCompiled);
+		if (isCompiled == GL_TRUE) return true;
+
+		GLint maxLength = 0;
+		glGetShaderiv(arg_shader, GL_INFO_LOG_LENGTH, &maxLength);
+
+		std::vector<GLchar> infoLog(maxLength + 1);
+		glGetShaderInfoLog(arg_shader, maxLength, &maxLength, &infoLog[0]);
+		LOG_ERROR("Shader compile error in {0}: {1}", arg_pending.name, std::string(infoLog.begin(), infoLog.begin() + maxLength));
+		LOG_ERROR("Shader sources: {0}", arg_pending.sourceTable);
+		return false;
+	}
+
+	bool OpenGLShaderCompiler::finish(uint32_t arg_program)
+	{
+		auto it = m_pending.find(arg_program);
+		if (it == m_pending.end()) return false;
+		Pending pending = it->second;
+		m_pending.erase(it);
+
+		if (!pending.vertexShader) return true; //!< Restored from the cache, already checked by glProgramBinary
+
+		bool compiled = checkShader(pending.vertexShader, pending);
+		compiled = checkShader(pending.fragmentShader, pending) && compiled;
+
+		GLint isLinked = 0;
+		glGetProgramiv(arg_program, GL_LINK_STATUS, (int*)&isLinked);
+		if (compiled && isLinked == GL_FALSE)
+		{
+			GLint maxLength = 0;
+			glGetProgramiv(arg_program, GL_INFO_LOG_LENGTH, &maxLength);
+
+			std::vector<GLchar> infoLog(maxLength + 1);
+			glGetProgramInfoLog(arg_program, maxLength, &maxLength, &infoLog[0]);
+			LOG_ERROR("Shader linking error in {0}: {1}", pending.name, std::string(infoLog.begin(), infoLog.begin() + maxLength));
+			LOG_ERROR("Shader sources: {0}", pending.sourceTable);
+		}
+
+		glDetachShader(arg_program, pending.vertexShader);
+		glDetachShader(arg_program, pending.fragmentShader);
+		glDeleteShader(pending.vertexShader);
+		glDeleteShader(pending.fragmentShader);
+
+		if (!compiled || isLinked == GL_FALSE) {
+			glDeleteProgram(arg_program); //!< Nothing can use it, the service forgets the handle
+			return false;
+		}
+
+		getProgramCache().store(pending.cacheKey, arg_program);
+		return true;
+	}
+
+	void OpenGLShaderCompiler::discard(uint32_t arg_program)
+	{
+		auto it = m_pending.find(arg_program);
+		if (it == m_pending.end()) return;
+
+		glDeleteShader(it->second.vertexShader); //!< Zero is ignored
+		glDeleteShader(it->second.fragmentShader);
+		m_pending.erase(it);
+	}
+}
@@ -1,6 +1,7 @@
 /**\ file OpenGLTexture.cpp */
 #include "engine_pch.h"
 #include "platform/OpenGL/OpenGLTexture.h"
+#include "rendering/renderThread.h"
 #include <glad/glad.h>
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -30,7 +31,8 @@ namespace Engine {
 
 	OpenGLTexture::~OpenGLTexture()
 	{
-		glDeleteTextures(1, &m_OpenGL_ID);
+		uint32_t id = m_OpenGL_ID;
+		RenderThread::record([id]() { glDeleteTextures(1, &id); });
 	}
 
 	void OpenGLTexture::init(uint32_t arg_width, uint32_t arg_height, uint32_t arg_channels, unsigned char* arg_data)
@@ -1,6 +1,8 @@
 /**\ file OpenGLUniformBuffer.cpp */
 #include "engine_pch.h"
 #include "platform/OpenGL/OpenGLUniformBuffer.h"
+#include "rendering/renderThread.h"
+#include "systems/logging.h"
 #include <glad/glad.h>
 
 namespace Engine {
@@ -20,13 +22,14 @@ namespace Engine {
 		*/
 		for (auto& element : m_UBLayout)
 		{
-			m_uniformCache[element.m_name] = std::pair<uint32_t, uint32_t>(element.m_offset, element.m_size);
+			m_uniformCache[StringId::intern(element.m_name)] = std::pair<uint32_t, uint32_t>(element.m_offset, element.m_size);
 		}
 	}
 
 	OpenGLUniformBuffer::~OpenGLUniformBuffer()
 	{
-		glDeleteBuffers(1, &m_OpenGL_ID);
+		uint32_t id = m_OpenGL_ID;
+		RenderThread::record([id]() { glDeleteBuffers(1, &id); });
 	}
 	void OpenGLUniformBuffer::attachShaderBlock(const std::shared_ptr<Shader>& arg_shader, const char* arg_blockName)
 	{
@@ -37,10 +40,16 @@ namespace Engine {
 		uint32_t blockIndex = glGetUniformBlockIndex(arg_shader->getID(), arg_blockName);
 		glUniformBlockBinding(arg_shader->getID(), blockIndex, m_blockNumber);
 	}
-	void OpenGLUniformBuffer::uploadData(const char* arg_Name, void* arg_Data)
+	void OpenGLUniformBuffer::uploadData(StringId arg_Name, void* arg_Data)
 	{
+		auto uniform = m_uniformCache.find(arg_Name);
+		if (uniform == m_uniformCache.end()) {
+			LOG_ERROR("Uniform buffer {0} has no {1}", m_blockNumber, arg_Name.getText());
+			m_uniformCache[arg_Name] = std::pair<uint32_t, uint32_t>(0, 0); //!< Reported once, then written with no size
+			return;
+		}
+
 		/**\ Allocates data sizes in the memory */
-		auto& pair = m_uniformCache[arg_Name]; // Possibly upload raw data instead of cache. Args: offset, size, data
-		glBufferSubData(GL_UNIFORM_BUFFER, pair.first, pair.second, arg_Data); //!< 
+		glBufferSubData(GL_UNIFORM_BUFFER, uniform->second.first, uniform->second.second, arg_Data); //!< Args: offset, size, data
 	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "engine_pch.h"
 #include <glad/glad.h>
 #include "platform/OpenGL/OpenGLVertexArray.h"
+#include "rendering/renderThread.h"
 
 namespace Engine
 {
@@ -31,7 +32,8 @@ namespace Engine
 	}
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
-		glDeleteVertexArrays(1, &m_OpenGL_ID);
+		uint32_t id = m_OpenGL_ID;
+		RenderThread::record([id]() { glDeleteVertexArrays(1, &id); });
 	}
 
 	void OpenGLVertexArray::addVertexBuffer(const std::shared_ptr<VertexBuffer>& arg_vertexBuffer)
@@ -3,6 +3,7 @@
 #include "engine_pch.h"
 #include <glad/glad.h>
 #include "platform/OpenGL/OpenGLVertexBuffer.h"
+#include "rendering/renderThread.h"
 
 namespace Engine
 {
@@ -15,7 +16,8 @@ namespace Engine
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
-		glDeleteBuffers(1, &m_OpenGL_ID);
+		uint32_t id = m_OpenGL_ID;
+		RenderThread::record([id]() { glDeleteBuffers(1, &id); });
 	}
 	void OpenGLVertexBuffer::edit(void* arg_vertices, uint32_t arg_size, uint32_t arg_offset)
 	{
@@ -0,0 +1,50 @@
+/** \file nullRenderBackend.cpp */
+#include "engine_pch.h"
+#include "platform/null/nullRenderBackend.h"
+#include "platform/null/nullResources.h"
+
+namespace Engine
+{
+	void NullRenderBackend::setClearColour(const glm::vec4& arg_colour)
+	{
+		NullRenderStats::get().stateChanges++;
+	}
+
+	void NullRenderBackend::clear()
+	{
+		NullRenderStats::get().clears++;
+	}
+
+	void NullRenderBackend::setDepthTest(bool arg_enabled)
+	{
+		NullRenderStats::get().stateChanges++;
+	}
+
+	void NullRenderBackend::setBlend(bool arg_enabled)
+	{
+		NullRenderStats::get().stateChanges++;
+	}
+
+	void NullRenderBackend::useShader(Shader& arg_shader)
+	{
+		NullRenderStats::get().stateChanges++;
+	}
+
+	void NullRenderBackend::bindTexture(Texture& arg_texture)
+	{
+		NullRenderStats::get().stateChanges++;
+	}
+
+	void NullRenderBackend::drawIndexed(VertexArray& arg_geometry, DrawMode arg_mode)
+	{
+		NullRenderStats& stats = NullRenderStats::get();
+		stats.drawCalls++;
+		stats.indicesDrawn += arg_geometry.getDrawCount();
+	}
+
+	void NullRenderBackend::present()
+	{
+		NullRenderStats::get().presents++;
+		if (m_context) m_context->swapBuffers();
+	}
+}
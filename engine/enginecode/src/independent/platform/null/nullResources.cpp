@@ -0,0 +1,178 @@
+/** \file nullResources.cpp */
+#include "engine_pch.h"
+#include "platform/null/nullResources.h"
+#include "stb_image.h"
+
+#include "systems/logging.h"
+namespace Engine
+{
+	namespace
+	{
+		std::atomic<uint32_t> s_nextID{ 1 }; //!< 0 is "no object" in GL, so the null IDs start above it
+
+		inline uint32_t makeID()
+		{
+			NullRenderStats::get().created++;
+			return s_nextID++;
+		}
+	}
+
+	NullRenderStats& NullRenderStats::get()
+	{
+		static NullRenderStats s_stats;
+		return s_stats;
+	}
+
+	void NullRenderStats::resetCalls()
+	{
+		created = 0;
+		textureEdits = 0;
+		bufferEdits = 0;
+		shaderUploads = 0;
+		uniformUploads = 0;
+		unknownUniforms = 0;
+		blockBinds = 0;
+		stateChanges = 0;
+		clears = 0;
+		drawCalls = 0;
+		indicesDrawn = 0;
+		presents = 0;
+	}
+
+	int32_t NullRenderStats::getLiveResources() const
+	{
+		return liveTextures + liveShaders + liveVertexBuffers + liveIndexBuffers + liveVertexArrays + liveUniformBuffers;
+	}
+
+	/**\ Texture */
+	NullTexture::NullTexture(const char* arg_file) : m_ID(makeID()), m_size(1.f, 1.f), m_channels(4)
+	{
+		int width, height, channels;
+		if (stbi_info(arg_file, &width, &height, &channels)) {
+			m_size = glm::vec2(static_cast<float>(width), static_cast<float>(height));
+			m_channels = channels;
+		}
+		else LOG_ERROR("Could not read texture: {0}", arg_file);
+		NullRenderStats::get().liveTextures++;
+	}
+
+	NullTexture::NullTexture(uint32_t arg_width, uint32_t arg_height, uint32_t arg_channels, unsigned char* arg_data) :
+		m_ID(makeID()),
+		m_size(static_cast<float>(arg_width), static_cast<float>(arg_height)),
+		m_channels(arg_channels)
+	{
+		NullRenderStats::get().liveTextures++;
+	}
+
+	NullTexture::~NullTexture()
+	{
+		NullRenderStats::get().liveTextures--;
+	}
+
+	void NullTexture::edit(glm::vec2 arg_offset, glm::vec2 arg_size, uint32_t arg_channels, unsigned char* arg_data)
+	{
+		NullRenderStats::get().textureEdits++;
+	}
+
+	/**\ Shader */
+	NullShader::NullShader(const char* arg_VerFilepath, const char* arg_FragFilepath) : m_ID(makeID()), m_name(arg_VerFilepath)
+	{
+		NullRenderStats::get().liveShaders++;
+	}
+
+	NullShader::NullShader(const char* arg_Filepath, const ShaderDefines& arg_defines) : m_ID(makeID()), m_name(arg_Filepath)
+	{
+		for (auto& define : arg_defines) m_name += " " + define;
+		NullRenderStats::get().liveShaders++;
+	}
+
+	NullShader::~NullShader()
+	{
+		NullRenderStats::get().liveShaders--;
+	}
+
+	void NullShader::uploadInt(StringId arg_Name, int arg_Value) { NullRenderStats::get().shaderUploads++; }
+	void NullShader::uploadFloat(StringId arg_Name, float arg_Value) { NullRenderStats::get().shaderUploads++; }
+	void NullShader::uploadFloat2(StringId arg_Name, const glm::vec2& arg_Value) { NullRenderStats::get().shaderUploads++; }
+	void NullShader::uploadFloat3(StringId arg_Name, const glm::vec3& arg_Value) { NullRenderStats::get().shaderUploads++; }
+	void NullShader::uploadFloat4(StringId arg_Name, const glm::vec4& arg_Value) { NullRenderStats::get().shaderUploads++; }
+	void NullShader::uploadMat4(StringId arg_Name, const glm::mat4& arg_Value) { NullRenderStats::get().shaderUploads++; }
+
+	/**\ Vertex buffer */
+	NullVertexBuffer::NullVertexBuffer(void* arg_vertices, uint32_t arg_size, const VertexBufferLayout& arg_layout) :
+		m_ID(makeID()),
+		m_size(arg_size),
+		m_layout(arg_layout)
+	{
+		NullRenderStats::get().liveVertexBuffers++;
+	}
+
+	NullVertexBuffer::~NullVertexBuffer()
+	{
+		NullRenderStats::get().liveVertexBuffers--;
+	}
+
+	void NullVertexBuffer::edit(void* arg_vertices, uint32_t arg_size, uint32_t arg_offset)
+	{
+		if (arg_offset + arg_size > m_size) LOG_ERROR("Vertex buffer edit past the end: {0} + {1} > {2}", arg_offset, arg_size, m_size); //!< glBufferSubData would fail
+		NullRenderStats::get().bufferEdits++;
+	}
+
+	/**\ Index buffer */
+	NullIndexBuffer::NullIndexBuffer(uint32_t* arg_indices, uint32_t arg_count) : m_ID(makeID()), m_count(arg_count)
+	{
+		NullRenderStats::get().liveIndexBuffers++;
+	}
+
+	NullIndexBuffer::~NullIndexBuffer()
+	{
+		NullRenderStats::get().liveIndexBuffers--;
+	}
+
+	/**\ Vertex array */
+	NullVertexArray::NullVertexArray() : m_ID(makeID())
+	{
+		NullRenderStats::get().liveVertexArrays++;
+	}
+
+	NullVertexArray::~NullVertexArray()
+	{
+		NullRenderStats::get().liveVertexArrays--;
+	}
+
+	void NullVertexArray::addVertexBuffer(const std::shared_ptr<VertexBuffer>& arg_vertexBuffer)
+	{
+		m_vertexBuffers.push_back(arg_vertexBuffer);
+	}
+
+	void NullVertexArray::setIndexBuffer(const std::shared_ptr<IndexBuffer>& arg_indexBuffer)
+	{
+		m_indexBuffer = arg_indexBuffer;
+	}
+
+	/**\ Uniform buffer */
+	NullUniformBuffer::NullUniformBuffer(const UniformBufferLayout& arg_layout) : m_ID(makeID())
+	{
+		m_UBLayout = arg_layout;
+		m_blockNumber = 0;
+		for (auto& element : m_UBLayout) m_uniformCache[StringId::intern(element.m_name)] = std::pair<uint32_t, uint32_t>(element.m_offset, element.m_size);
+		NullRenderStats::get().liveUniformBuffers++;
+	}
+
+	NullUniformBuffer::~NullUniformBuffer()
+	{
+		NullRenderStats::get().liveUniformBuffers--;
+	}
+
+	void NullUniformBuffer::attachShaderBlock(const std::shared_ptr<Shader>& arg_shader, const char* arg_blockName)
+	{
+		NullRenderStats::get().blockBinds++;
+	}
+
+	void NullUniformBuffer::uploadData(StringId arg_Name, void* arg_Data)
+	{
+		NullRenderStats& stats = NullRenderStats::get();
+		stats.uniformUploads++;
+		if (m_uniformCache.find(arg_Name) == m_uniformCache.end()) stats.unknownUniforms++;
+	}
+}
@@ -0,0 +1,44 @@
+/** \file nullWindow.cpp */
+#include "engine_pch.h"
+#include "platform/null/nullWindow.h"
+#include "events/windowEvents.h"
+
+#include <chrono>
+#include <thread>
+
+namespace Engine {
+	NullWindow::NullWindow(const WindowProperties& properties)
+	{
+		init(properties);
+	}
+
+	void NullWindow::init(const WindowProperties& properties)
+	{
+		m_properties = properties;
+		m_graphicsContext.reset(new NullGraphicsContext());
+		m_graphicsContext->init();
+	}
+
+	void NullWindow::waitEvents(float timeout)
+	{
+		std::this_thread::sleep_for(std::chrono::duration<float>(timeout));
+	}
+
+	void NullWindow::onResize(unsigned int width, unsigned int height)
+	{
+		m_properties.m_width = width;
+		m_properties.m_height = height;
+		if (m_callback) {
+			WindowResizeEvent resizeEvent(width, height);
+			m_callback(resizeEvent);
+		}
+	}
+
+	void NullWindow::close()
+	{
+		if (m_callback) {
+			WindowCloseEvent closeEvent;
+			m_callback(closeEvent);
+		}
+	}
+}
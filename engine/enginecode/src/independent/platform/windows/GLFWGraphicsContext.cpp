@@ -7,6 +7,7 @@
 
 #include "systems/logging.h"
 #include "platform/windows/GLFWGraphicsContext.h"
+#include "platform/OpenGL/OpenGLShaderCompiler.h"
 
 namespace Engine {
 	void GLFWGraphicsContext::init()
@@ -43,10 +44,23 @@ namespace Engine {
 				break;
 			}
 		},nullptr);
+
+		/**\ Shaders compile through the service from here on. The loader is needed for the parallel compile extension */
+		ShaderCompilationService::setInstance(std::make_shared<ShaderCompilationService>(std::make_shared<OpenGLShaderCompiler>(reinterpret_cast<OpenGLShaderCompiler::LoadProc>(glfwGetProcAddress))));
 	}
 
 	void GLFWGraphicsContext::swapBuffers()
 	{
 		glfwSwapBuffers(m_window);
 	}
+
+	void GLFWGraphicsContext::makeCurrent()
+	{
+		glfwMakeContextCurrent(m_window);
+	}
+
+	void GLFWGraphicsContext::releaseCurrent()
+	{
+		glfwMakeContextCurrent(nullptr);
+	}
 }
\ No newline at end of file
@@ -95,15 +95,15 @@ namespace Engine {
 			callback(closeEvent); 
 		});
 
-		glfwSetCursorEnterCallback(m_Window, [](GLFWwindow* win, int entered)
+		glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* win, int focused) //!< Keyboard focus, not the cursor being over the window
 		{
 			std::function<void(Event&)>& callback = *static_cast<std::function<void(Event&)>*>(glfwGetWindowUserPointer(win));
 
-			if (entered == 1) {
+			if (focused == GLFW_TRUE) {
 				WindowFocusEvent focusEvent;
 				callback(focusEvent);
 			}
-			else if (entered == 0) {
+			else {
 				WindowLostFocusEvent lostFocusEvent;
 				callback(lostFocusEvent);
 			}
@@ -133,9 +133,11 @@ namespace Engine {
 	}
 
 	void GLFWWindowImpl::onUpdate(float timestep) {
-		glfwPollEvents();
-		m_graphicsContext->swapBuffers();
-		//glfwSwapBuffers(m_Window);
+		glfwPollEvents(); //!< Buffers are swapped by the render backend when it presents a frame
+	}
+
+	void GLFWWindowImpl::waitEvents(float timeout) {
+		glfwWaitEventsTimeout(timeout);
 	}
 
 	void GLFWWindowImpl::setVSync(bool VSync) {
@@ -0,0 +1,38 @@
+/**\ file drawList.cpp */
+#include "engine_pch.h"
+#include "rendering/drawList.h"
+
+#include <algorithm>
+
+namespace Engine {
+	void DrawList::begin()
+	{
+		m_current ^= 1; //!< The other buffer may still be drawing last frame
+		Buffer& buffer = m_buffers[m_current];
+		size_t lastCount = buffer.items.size();
+		buffer.memory.reset();
+		buffer.items = FrameVector<DrawItem*>(ArenaAllocator<DrawItem*>(buffer.memory)); //!< The old array was in the memory just reset
+		buffer.items.reserve(lastCount); //!< Sized like two frames ago, so growing rarely leaves copies behind
+	}
+
+	void DrawQueue::add(const FrameVector<DrawItem*>& arg_items, uint32_t arg_listKey)
+	{
+		uint64_t listKey = static_cast<uint64_t>(arg_listKey) << 32;
+		for (DrawItem* item : arg_items) m_entries.push_back({ listKey | item->key, static_cast<uint32_t>(m_entries.size()), item });
+	}
+
+	void DrawQueue::sort()
+	{
+		std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) {
+			return a.key != b.key ? a.key < b.key : a.sequence < b.sequence;
+		});
+		m_sorted.clear();
+		for (auto& entry : m_entries) m_sorted.push_back(entry.item);
+	}
+
+	void DrawQueue::clear()
+	{
+		m_entries.clear();
+		m_sorted.clear();
+	}
+}
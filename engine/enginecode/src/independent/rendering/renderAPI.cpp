@@ -7,6 +7,7 @@
 #include "rendering/vertexArray.h"
 #include "rendering/shader.h"
 #include "rendering/texture.h"
+#include "rendering/renderThread.h"
 
 #include "platform/OpenGL/OpenGLUniformBuffer.h"
 #include "platform/OpenGL/OpenGLIndexBuffer.h"
@@ -14,6 +15,7 @@
 #include "platform/OpenGL/OpenGLVertexArray.h"
 #include "platform/OpenGL/OpenGLShader.h"
 #include "platform/OpenGL/OpenGLTexture.h"
+#include "platform/null/nullResources.h"
 
 #include "systems/logging.h"
 namespace Engine {
@@ -24,10 +26,10 @@ namespace Engine {
 		switch (RenderAPI::getAPI())
 		{
 		case RenderAPI::API::None:
-			LOG_ERROR("No rendering API: Not supported");
+			return new NullTexture(arg_file); //!< Headless, nothing is made on the GPU so there is no need to go through the render thread
 			break;
 		case RenderAPI::API::OpenGL:
-			return new OpenGLTexture(arg_file);
+			return RenderThread::invoke([&]() { return new OpenGLTexture(arg_file); }); //!< GL objects are made on the thread that owns the context
 			break;
 		case RenderAPI::API::Direct3d:
 			LOG_ERROR("Direct3d rendering API: Not supported");
@@ -36,6 +38,7 @@ namespace Engine {
 			LOG_ERROR("Vulkan rendering API: Not supported");
 			break;
 		}
+		return nullptr;
 	}
 
 	Texture* Texture::create(uint32_t arg_width, uint32_t arg_height, uint32_t arg_channels, unsigned char* arg_data)
@@ -43,10 +46,10 @@ namespace Engine {
 		switch (RenderAPI::getAPI())
 		{
 		case RenderAPI::API::None:
-			LOG_ERROR("No rendering API: Not supported");
+			return new NullTexture(arg_width, arg_height, arg_channels, arg_data);
 			break;
 		case RenderAPI::API::OpenGL:
-			return new OpenGLTexture(arg_width, arg_height, arg_channels, arg_data);
+			return RenderThread::invoke([&]() { return new OpenGLTexture(arg_width, arg_height, arg_channels, arg_data); });
 			break;
 		case RenderAPI::API::Direct3d:
 			LOG_ERROR("Direct3d rendering API: Not supported");
@@ -55,6 +58,7 @@ namespace Engine {
 			LOG_ERROR("Vulkan rendering API: Not supported");
 			break;
 		}
+		return nullptr;
 	}
 
 	UniformBuffer* UniformBuffer::create(const UniformBufferLayout& arg_layout)
@@ -62,10 +66,10 @@ namespace Engine {
 		switch (RenderAPI::getAPI())
 		{
 		case RenderAPI::API::None:
-			LOG_ERROR("No rendering API: Not supported");
+			return new NullUniformBuffer(arg_layout);
 			break;
 		case RenderAPI::API::OpenGL:
-			return new OpenGLUniformBuffer(arg_layout);
+			return RenderThread::invoke([&]() { return new OpenGLUniformBuffer(arg_layout); });
 			break;
 		case RenderAPI::API::Direct3d:
 			LOG_ERROR("Direct3d rendering API: Not supported");
@@ -74,6 +78,7 @@ namespace Engine {
 			LOG_ERROR("Vulkan rendering API: Not supported");
 			break;
 		}
+		return nullptr;
 	}
 
 	IndexBuffer* IndexBuffer::create(uint32_t* arg_indices, uint32_t arg_count)
@@ -81,10 +86,10 @@ namespace Engine {
 		switch (RenderAPI::getAPI())
 		{
 		case RenderAPI::API::None:
-			LOG_ERROR("No rendering API: Not supported");
+			return new NullIndexBuffer(arg_indices, arg_count);
 			break;
 		case RenderAPI::API::OpenGL:
-			return new OpenGLIndexBuffer(arg_indices, arg_count);
+			return RenderThread::invoke([&]() { return new OpenGLIndexBuffer(arg_indices, arg_count); });
 			break;
 		case RenderAPI::API::Direct3d:
 			LOG_ERROR("Direct3d rendering API: Not supported");
@@ -93,6 +98,7 @@ namespace Engine {
 			LOG_ERROR("Vulkan rendering API: Not supported");
 			break;
 		}
+		return nullptr;
 	}
 
 	VertexBuffer* VertexBuffer::create(void* arg_vertices, uint32_t arg_size, const VertexBufferLayout& arg_layout)
@@ -100,10 +106,10 @@ namespace Engine {
 		switch (RenderAPI::getAPI())
 		{
 		case RenderAPI::API::None:
-			LOG_ERROR("No rendering API: Not supported");
+			return new NullVertexBuffer(arg_vertices, arg_size, arg_layout);
 			break;
 		case RenderAPI::API::OpenGL:
-			return new OpenGLVertexBuffer(arg_vertices, arg_size, arg_layout);
+			return RenderThread::invoke([&]() { return new OpenGLVertexBuffer(arg_vertices, arg_size, arg_layout); });
 			break;
 		case RenderAPI::API::Direct3d:
 			LOG_ERROR("Direct3d rendering API: Not supported");
@@ -112,6 +118,7 @@ namespace Engine {
 			LOG_ERROR("Vulkan rendering API: Not supported");
 			break;
 		}
+		return nullptr;
 	}
 
 	VertexArray* VertexArray::create()
@@ -119,10 +126,10 @@ namespace Engine {
 		switch (RenderAPI::getAPI())
 		{
 		case RenderAPI::API::None:
-			LOG_ERROR("No rendering API: Not supported");
+			return new NullVertexArray();
 			break;
 		case RenderAPI::API::OpenGL:
-			return new OpenGLVertexArray();
+			return RenderThread::invoke([&]() { return new OpenGLVertexArray(); });
 			break;
 		case RenderAPI::API::Direct3d:
 			LOG_ERROR("Direct3d rendering API: Not supported");
@@ -131,6 +138,7 @@ namespace Engine {
 			LOG_ERROR("Vulkan rendering API: Not supported");
 			break;
 		}
+		return nullptr;
 	}
 	/**\ API AGNOSTIC SHADER */
 	Shader* Shader::create(const char* arg_VerFilepath, const char* arg_FragFilepath)
@@ -138,10 +146,10 @@ namespace Engine {
 		switch (RenderAPI::getAPI())
 		{
 		case RenderAPI::API::None:
-			LOG_ERROR("No rendering API: Not supported");
+			return new NullShader(arg_VerFilepath, arg_FragFilepath);
 			break;
 		case RenderAPI::API::OpenGL:
-			return new OpenGLShader(arg_VerFilepath, arg_FragFilepath); 
+			return RenderThread::invoke([&]() { return new OpenGLShader(arg_VerFilepath, arg_FragFilepath); });
 			break;
 		case RenderAPI::API::Direct3d:
 			LOG_ERROR("Direct3d rendering API: Not supported");
@@ -150,16 +158,17 @@ namespace Engine {
 			LOG_ERROR("Vulkan rendering API: Not supported");
 			break;
 		}
+		return nullptr;
 	}
-	Shader* Shader::create(const char* arg_Filepath)
+	Shader* Shader::create(const char* arg_Filepath, const ShaderDefines& arg_defines)
 	{
 		switch (RenderAPI::getAPI())
 		{
 		case RenderAPI::API::None:
-			LOG_ERROR("No rendering API: Not supported");
+			return new NullShader(arg_Filepath, arg_defines);
 			break;
 		case RenderAPI::API::OpenGL:
-			return new OpenGLShader(arg_Filepath);
+			return RenderThread::invoke([&]() { return new OpenGLShader(arg_Filepath, arg_defines); });
 			break;
 		case RenderAPI::API::Direct3d:
 			LOG_ERROR("Direct3d rendering API: Not supported");
@@ -168,5 +177,6 @@ namespace Engine {
 			LOG_ERROR("Vulkan rendering API: Not supported");
 			break;
 		}
+		return nullptr;
 	}
 }
\ No newline at end of file
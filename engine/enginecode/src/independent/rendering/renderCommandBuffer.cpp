@@ -0,0 +1,52 @@
+/**\ file renderCommandBuffer.cpp */
+#include "engine_pch.h"
+#include "rendering/renderCommandBuffer.h"
+
+#include <algorithm>
+
+namespace Engine {
+	void* RenderCommandBuffer::allocate(size_t arg_size)
+	{
+		/**\ Moving on to the next block with room, only adding one when none of the existing blocks fit */
+		while (m_currentBlock < m_blocks.size() && m_blocks[m_currentBlock].used + arg_size > m_blocks[m_currentBlock].size) {
+			m_currentBlock++;
+		}
+		if (m_currentBlock == m_blocks.size()) {
+			size_t size = std::max<size_t>(m_blockSize, arg_size);
+			m_blocks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[size]), size, 0 });
+		}
+
+		Block& block = m_blocks[m_currentBlock];
+		void* memory = block.data.get() + block.used;
+		block.used += arg_size;
+		return memory;
+	}
+
+	template <typename Visit>
+	void RenderCommandBuffer::forEach(Visit arg_visit)
+	{
+		for (auto& block : m_blocks) {
+			for (size_t offset = 0; offset < block.used;) {
+				Header* header = reinterpret_cast<Header*>(block.data.get() + offset);
+				arg_visit(*header, block.data.get() + offset + s_headerSize);
+				offset += header->size;
+			}
+			block.used = 0;
+		}
+		m_currentBlock = 0;
+		m_count = 0;
+	}
+
+	void RenderCommandBuffer::execute(RenderBackend& arg_backend)
+	{
+		forEach([&arg_backend](Header& arg_header, void* arg_payload) {
+			arg_header.execute(arg_payload, arg_backend);
+			arg_header.destroy(arg_payload); //!< Straight away, so captured resources are freed on this thread
+		});
+	}
+
+	void RenderCommandBuffer::clear()
+	{
+		forEach([](Header& arg_header, void* arg_payload) { arg_header.destroy(arg_payload); });
+	}
+}
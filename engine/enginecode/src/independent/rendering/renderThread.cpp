@@ -0,0 +1,141 @@
+/**\ file renderThread.cpp */
+#include "engine_pch.h"
+#include "rendering/renderThread.h"
+#include "systems/memoryTracker.h"
+#include "systems/timer.h"
+
+namespace Engine {
+	std::shared_ptr<RenderBackend> RenderThread::s_backend = nullptr;
+	std::shared_ptr<GraphicsContext> RenderThread::s_context = nullptr;
+	std::thread RenderThread::s_thread;
+	bool RenderThread::s_running = false;
+	thread_local bool RenderThread::s_isRenderThread = false;
+	RenderCommandBuffer RenderThread::s_frames[2];
+	uint32_t RenderThread::s_recording = 0;
+	std::mutex RenderThread::s_mutex;
+	std::condition_variable RenderThread::s_signal;
+	bool RenderThread::s_framePending = false;
+	bool RenderThread::s_stopping = false;
+	std::vector<std::function<void()>> RenderThread::s_tasks;
+	std::function<void()> RenderThread::s_afterFrame;
+	std::atomic<uint64_t> RenderThread::s_framesDrawn{ 0 };
+	std::atomic<bool> RenderThread::s_gpuSync{ false };
+	uint64_t RenderThread::s_submitTimes[2] = { 0, 0 };
+	std::atomic<uint64_t> RenderThread::s_presentLatency{ 0 };
+	std::atomic<uint64_t> RenderThread::s_presents{ 0 };
+
+	void RenderThread::start(const std::shared_ptr<GraphicsContext>& arg_context)
+	{
+		if (s_running) return;
+
+		s_context = arg_context;
+		s_context->releaseCurrent(); //!< A context can only be current on one thread
+		s_stopping = false;
+		s_framePending = false;
+		s_recording = 0;
+		s_running = true;
+		s_thread = std::thread(threadLoop, s_context);
+	}
+
+	void RenderThread::stop()
+	{
+		if (!s_running) return;
+
+		submit(); //!< Whatever was recorded since the last frame, i.e. resources released during shutdown
+		{
+			std::unique_lock<std::mutex> lock(s_mutex);
+			s_signal.wait(lock, []() { return !s_framePending; });
+			s_stopping = true;
+		}
+		s_signal.notify_all();
+		s_thread.join();
+
+		s_running = false;
+		s_context->makeCurrent();
+		s_context = nullptr;
+	}
+
+	void RenderThread::endFrame()
+	{
+		uint32_t frame = s_recording;
+		s_submitTimes[frame] = timer::now(); //!< Includes the wait for the previous frame below, that is queueing latency too
+		record([frame](RenderBackend& arg_backend) {
+			arg_backend.present();
+			if (s_gpuSync) arg_backend.waitForGpu();
+			s_presentLatency = timer::now() - s_submitTimes[frame];
+			s_presents++;
+		});
+		if (s_running) submit();
+		else if (s_afterFrame) s_afterFrame();
+	}
+
+	void RenderThread::skipFrame()
+	{
+		if (s_running) submit(); //!< Commands already recorded, i.e. shader compiles, still run
+		else if (s_afterFrame) s_afterFrame();
+	}
+
+	void RenderThread::waitForIdle()
+	{
+		if (!s_running) return;
+		std::unique_lock<std::mutex> lock(s_mutex);
+		s_signal.wait(lock, []() { return !s_framePending; });
+	}
+
+	void RenderThread::submit()
+	{
+		std::unique_lock<std::mutex> lock(s_mutex);
+		s_signal.wait(lock, []() { return !s_framePending; }); //!< The one frame of latency
+		s_framePending = true;
+		s_recording ^= 1;
+		lock.unlock();
+		s_signal.notify_all();
+	}
+
+	void RenderThread::post(std::function<void()>&& arg_task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			s_tasks.push_back(std::move(arg_task));
+		}
+		s_signal.notify_all();
+	}
+
+	void RenderThread::threadLoop(std::shared_ptr<GraphicsContext> arg_context)
+	{
+		s_isRenderThread = true;
+		MemoryTracker::setTag(MemoryTag::Rendering); //!< Everything this thread allocates is for drawing
+		arg_context->makeCurrent();
+
+		std::vector<std::function<void()>> tasks;
+		while (true) {
+			bool drawFrame;
+			uint32_t frame;
+			{
+				std::unique_lock<std::mutex> lock(s_mutex);
+				s_signal.wait(lock, []() { return s_framePending || !s_tasks.empty() || s_stopping; });
+				if (!s_framePending && s_tasks.empty() && s_stopping) break;
+
+				tasks.swap(s_tasks);
+				drawFrame = s_framePending;
+				frame = s_recording ^ 1; //!< The main thread only flips this while no frame is pending
+			}
+
+			for (auto& task : tasks) task(); //!< Before the frame, its commands may use what the tasks create
+			tasks.clear();
+
+			if (drawFrame) {
+				s_frames[frame].execute(*s_backend);
+				{
+					std::lock_guard<std::mutex> lock(s_mutex);
+					s_framePending = false;
+					s_framesDrawn++;
+				}
+				s_signal.notify_all();
+				if (s_afterFrame) s_afterFrame(); //!< The main thread is free to hand over the next frame meanwhile
+			}
+		}
+
+		arg_context->releaseCurrent();
+	}
+}
@@ -2,11 +2,34 @@
 
 #include "engine_pch.h"
 #include "rendering/renderer2D.h"
+#include "rendering/renderThread.h"
+#include "systems/frameAllocator.h"
+#include "systems/memoryTracker.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include "freetype/ftmodapi.h"
 
 namespace Engine {
+	namespace {
+		/**\ FreeType allocates with these rather than malloc, so its memory shows up under the fonts tag */
+		void* fontAllocate(FT_Memory, long arg_size) { return MemoryTracker::allocate(static_cast<size_t>(arg_size), MemoryTag::Fonts); }
+		void fontFree(FT_Memory, void* arg_block) { MemoryTracker::release(arg_block); }
+		void* fontReallocate(FT_Memory, long, long arg_size, void* arg_block) { return MemoryTracker::reallocate(arg_block, static_cast<size_t>(arg_size)); }
+		FT_MemoryRec_ s_fontMemory = { nullptr, fontAllocate, fontFree, fontReallocate };
+
+		/**\ Uniform names, hashed at compile time */
+		constexpr StringId s_model("u_model");
+		constexpr StringId s_texData("u_texData");
+		constexpr StringId s_tint("u_tint");
+		constexpr StringId s_view("u_view");
+		constexpr StringId s_projection("u_projection");
+	}
+
 	std::shared_ptr<Renderer2D::InternalData> Renderer2D::s_data = nullptr;
+	void Renderer2D::shutdown()
+	{
+		s_data.reset();
+	}
 	void Renderer2D::init()
 	{
 		s_data.reset(new InternalData);
@@ -45,7 +68,10 @@ namespace Engine {
 		s_data->glyphBuffer.reset(static_cast<unsigned char*>(malloc(s_data->glyphBufferSize))); //!< Manually allocate memory
 
 		const char* fontFilepath = "./assets/fonts/arial.ttf";
-		if (FT_Init_FreeType(&s_data->ftLibrary)) LOG_ERROR("Error: Init Freetype in Renderer2D");
+		/**\ FT_Init_FreeType with the tracked allocator */
+		if (FT_New_Library(&s_fontMemory, &s_data->ftLibrary)) LOG_ERROR("Error: Init Freetype in Renderer2D");
+		FT_Add_Default_Modules(s_data->ftLibrary);
+		FT_Set_Default_Properties(s_data->ftLibrary);
 		if (FT_New_Face(s_data->ftLibrary, fontFilepath, 0, &s_data->fontFace)) LOG_ERROR("Error: Could not load font: {0}", fontFilepath);
 		if (FT_Set_Pixel_Sizes(s_data->fontFace, 0, s_data->fontSize)) LOG_ERROR("Error: Could not set font size: {0}", s_data->fontSize);
 		s_data->fontTexture.reset(Texture::create(s_data->glyphBufferDimensions.x, s_data->glyphBufferDimensions.y, s_data->glyphChannels, nullptr));
@@ -56,20 +82,20 @@ namespace Engine {
 	}
 	void Renderer2D::uploadData(glm::mat4 arg_view, glm::mat4 arg_projection)
 	{
-		s_data->uniformBuffer.reset(UniformBuffer::create(s_data->UBLayout));
-		s_data->uniformBuffer->attachShaderBlock(s_data->shader, "b_uniforms"); //!< Updating the camera UBO with the position of camera uniforms within the shader
+		RenderThread::record([arg_view, arg_projection]() mutable {
+			s_data->uniformBuffer.reset(UniformBuffer::create(s_data->UBLayout));
+			s_data->uniformBuffer->attachShaderBlock(s_data->shader, "b_uniforms"); //!< Updating the camera UBO with the position of camera uniforms within the shader
 
-		s_data->uniformBuffer->uploadData("u_view", glm::value_ptr(arg_view));
-		s_data->uniformBuffer->uploadData("u_projection", glm::value_ptr(arg_projection));
+			s_data->uniformBuffer->uploadData(s_view, glm::value_ptr(arg_view));
+			s_data->uniformBuffer->uploadData(s_projection, glm::value_ptr(arg_projection));
+		});
 	}
 	void Renderer2D::beginScene(bool arg_blend)
 	{
-		glDisable(GL_DEPTH_TEST);
-		if (arg_blend) {
-			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		}
-		else glDisable(GL_BLEND);
+		RenderThread::record([arg_blend](RenderBackend& arg_backend) {
+			arg_backend.setDepthTest(false);
+			arg_backend.setBlend(arg_blend);
+		});
 	}
 	void Renderer2D::submitQuad(
 		const Quad& arg_quad, 
@@ -77,24 +103,21 @@ namespace Engine {
 		const glm::vec4& arg_tint /*= s_data->defaultTint*/, 
 		float arg_angle /*= s_data->defaultAngle*/
 	){
-		glUseProgram(s_data->shader->getID());
-
-		glBindTexture(GL_TEXTURE_2D, arg_texture->getID());
 		//glm::rotate(mat, angle, axis(Z) )
-		s_data->model = glm::translate(glm::mat4(1.f), arg_quad.m_translate);
-		s_data->model = glm::rotate(s_data->model, glm::radians(arg_angle), { 0.f, 0.f, 1.f });
-		s_data->model = glm::scale(s_data->model, arg_quad.m_scale); // needs friend class renderer2d for m_translate and m_scale
-		s_data->shader->uploadMat4("u_model", s_data->model);
-		s_data->shader->uploadInt("u_texData", 0);
-		s_data->shader->uploadFloat4("u_tint", arg_tint);
+		glm::mat4 model = glm::translate(glm::mat4(1.f), arg_quad.m_translate);
+		model = glm::rotate(model, glm::radians(arg_angle), { 0.f, 0.f, 1.f });
+		model = glm::scale(model, arg_quad.m_scale); // needs friend class renderer2d for m_translate and m_scale
 
+		RenderThread::record([model, arg_texture, arg_tint](RenderBackend& arg_backend) {
+			arg_backend.useShader(*s_data->shader);
+			arg_backend.bindTexture(*arg_texture);
 
-		
-		glBindVertexArray(s_data->vertexArray->getID());
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_data->vertexArray->getIndexBuffer()->getID());
-		
+			s_data->shader->uploadMat4(s_model, model);
+			s_data->shader->uploadInt(s_texData, 0);
+			s_data->shader->uploadFloat4(s_tint, arg_tint);
 
-		glDrawElements(GL_QUADS, s_data->vertexArray->getDrawCount(), GL_UNSIGNED_INT, nullptr);
+			arg_backend.drawIndexed(*s_data->vertexArray, DrawMode::Quads);
+		});
 	}
 	void Renderer2D::submitChar(char arg_character, const glm::vec2& arg_position, float& arg_advance, const glm::vec4 arg_tint)
 	{
@@ -118,13 +141,20 @@ namespace Engine {
 	}
 	void Renderer2D::submitText(const char* arg_text, const glm::vec2& arg_position, const glm::vec4 arg_tint)
 	{
-		uint32_t length = strlen(arg_text);
-		glm::vec2 position = arg_position;
-		float advance = 0.f;
-		for (int i = 0; i < length; i++) {
-			submitChar(arg_text[i], position, advance, arg_tint);
-			position.x += advance;
-		}
+		/**\ The glyphs are rasterised into the font texture, so the whole string is one command on the render thread.
+		*	 The text is copied into frame memory, which lasts until the render thread has drawn the frame
+		*/
+		size_t length = strlen(arg_text) + 1;
+		char* text = static_cast<char*>(FrameAllocator::allocate(length, 1));
+		memcpy(text, arg_text, length);
+		RenderThread::record([text, arg_position, arg_tint]() {
+			glm::vec2 position = arg_position;
+			float advance = 0.f;
+			for (const char* character = text; *character; character++) {
+				submitChar(*character, position, advance, arg_tint);
+				position.x += advance;
+			}
+		});
 	}
 	void Renderer2D::RtoRGBA(unsigned char* arg_Rbuffer, uint32_t arg_width, uint32_t arg_height)
 	{
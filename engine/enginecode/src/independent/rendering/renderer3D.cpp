@@ -2,66 +2,116 @@
 
 #include "engine_pch.h"
 #include "rendering/renderer3D.h"
-
-#include <glad/glad.h>
+#include "rendering/renderThread.h"
 
 namespace Engine {
 	std::shared_ptr<Renderer3D::InternalData> Renderer3D::s_data = nullptr;
+
+	/**\ Uniform names, hashed at compile time */
+	namespace {
+		constexpr StringId s_model("u_model");
+		constexpr StringId s_materialTint("u_materialTint");
+		constexpr StringId s_view("u_view");
+		constexpr StringId s_projection("u_projection");
+		constexpr StringId s_lightPos("u_lightPos");
+		constexpr StringId s_viewPos("u_viewPos");
+		constexpr StringId s_lightColour("u_lightColour");
+		constexpr StringId s_tint("u_tint");
+	}
+
+	/**\ Per material state, one function for each combination of flags.
+	*	 The variants without a texture or tint have them compiled out, so there is nothing to bind or upload.
+	*/
+	namespace {
+		void applyNothing(const Material& arg_material, RenderBackend& arg_backend) {}
+		void applyTexture(const Material& arg_material, RenderBackend& arg_backend) { arg_backend.bindTexture(*arg_material.getTexture()); }
+		void applyTint(const Material& arg_material, RenderBackend& arg_backend) { arg_material.getShader()->uploadFloat4(s_materialTint, arg_material.getTint()); }
+		void applyTextureAndTint(const Material& arg_material, RenderBackend& arg_backend) { applyTexture(arg_material, arg_backend); applyTint(arg_material, arg_backend); }
+	}
+
+	Material::ApplyFunc Material::getApplyFunc(uint32_t arg_flags)
+	{
+		static const ApplyFunc applyFuncs[] = { applyNothing, applyTexture, applyTint, applyTextureAndTint }; //!< Indexed by flag_texture | flag_tint
+		return applyFuncs[arg_flags & (flag_texture | flag_tint)];
+	}
+
 	// UBOs in init()
 	void Renderer3D::init()
 	{
 		s_data.reset(new InternalData);
-		s_data->defaultTexture.reset(Texture::create(1, 1, 4, s_data->PxlColour));
-		s_data->defaultTint = { 1.f, 1.f, 1.f, 1.f };
 	}
-	void Renderer3D::uploadCamera(const std::shared_ptr<Shader> arg_shader, glm::mat4 arg_view, glm::mat4 arg_projection) {
-		s_data->cameraUBO.reset(UniformBuffer::create(s_data->cameraLayout));
-		s_data->cameraUBO->attachShaderBlock(arg_shader, "b_camera"); //!< Updating the camera UBO with the position of camera uniforms within the shader
+	void Renderer3D::shutdown()
+	{
+		s_data.reset();
+	}
+	void Renderer3D::uploadCamera(glm::mat4 arg_view, glm::mat4 arg_projection) {
+		RenderThread::record([arg_view, arg_projection]() mutable { //!< mutable as uploadData takes non const pointers
+			s_data->cameraUBO.reset(UniformBuffer::create(s_data->cameraLayout));
+			s_data->blockGeneration++; //!< A new binding point, every shader is attached again at its next draw
 
-		s_data->cameraUBO->uploadData("u_view", glm::value_ptr(arg_view));
-		s_data->cameraUBO->uploadData("u_projection", glm::value_ptr(arg_projection));
+			s_data->cameraUBO->uploadData(s_view, glm::value_ptr(arg_view));
+			s_data->cameraUBO->uploadData(s_projection, glm::value_ptr(arg_projection));
+		});
 	}
-	void Renderer3D::uploadLights(const std::shared_ptr<Shader> arg_shader, glm::vec3 arg_position, glm::vec3 arg_view, glm::vec3 arg_colour, glm::vec4 arg_tint) {
-		s_data->lightsUBO.reset(UniformBuffer::create(s_data->lightsLayout));
-		s_data->lightsUBO->attachShaderBlock(arg_shader, "b_lights"); //!< Updating the lights UBO with the position of lights uniforms within the shader
-		
-		s_data->lightsUBO->uploadData("u_lightsPos", glm::value_ptr(arg_position));	//!< Uploading the position
-		s_data->lightsUBO->uploadData("u_viewPos", glm::value_ptr(arg_view));		//!< Uploading the view position
-		s_data->lightsUBO->uploadData("u_lightColour", glm::value_ptr(arg_colour));	//!< Uploading the colour
-		s_data->lightsUBO->uploadData("u_tint", glm::value_ptr(arg_tint));			//!< Uploading the tint
+	void Renderer3D::uploadLights(glm::vec3 arg_position, glm::vec3 arg_view, glm::vec3 arg_colour, glm::vec4 arg_tint) {
+		RenderThread::record([arg_position, arg_view, arg_colour, arg_tint]() mutable {
+			s_data->lightsUBO.reset(UniformBuffer::create(s_data->lightsLayout));
+			s_data->blockGeneration++;
+
+			s_data->lightsUBO->uploadData(s_lightPos, glm::value_ptr(arg_position));	//!< Uploading the position
+			s_data->lightsUBO->uploadData(s_viewPos, glm::value_ptr(arg_view));		//!< Uploading the view position
+			s_data->lightsUBO->uploadData(s_lightColour, glm::value_ptr(arg_colour));	//!< Uploading the colour
+			s_data->lightsUBO->uploadData(s_tint, glm::value_ptr(arg_tint));			//!< Uploading the tint
+		});
+	}
+	void Renderer3D::bindBlocks(const std::shared_ptr<Shader>& arg_shader)
+	{
+		InternalData::BoundBlocks& bound = s_data->boundBlocks[arg_shader.get()];
+		if (bound.generation == s_data->blockGeneration && !bound.shader.expired()) return;
+
+		bound.shader = arg_shader;
+		bound.generation = s_data->blockGeneration;
+		if (s_data->cameraUBO) s_data->cameraUBO->attachShaderBlock(arg_shader, "b_camera");
+		if (s_data->lightsUBO) s_data->lightsUBO->attachShaderBlock(arg_shader, "b_lights");
 	}
 
 
 	void Renderer3D::beginScene()
 	{
-		glEnable(GL_DEPTH_TEST);
-		glDisable(GL_BLEND);
+		RenderThread::record([](RenderBackend& arg_backend) {
+			arg_backend.setDepthTest(true);
+			arg_backend.setBlend(false);
+		});
 	}
 	void Renderer3D::submit(const std::shared_ptr<VertexArray>& arg_geometry, const std::shared_ptr<Material> arg_material, const glm::mat4& arg_model)
 	{
-		//Could be API agnostic, put bind commands in abstracted buffers
-
-		//Bind shader
-		glUseProgram(arg_material->getShader()->getID());
-		
-		//Apply Uniforms
-		arg_material->getShader()->uploadMat4("u_model", arg_model);
-
-		if(arg_material->isFlagSet(Material::flag_texture)) glBindTexture(GL_TEXTURE_2D, arg_material->getTexture()->getID());
-		else glBindTexture(GL_TEXTURE_2D, s_data->defaultTexture->getID());
-		arg_material->getShader()->uploadInt("u_textData", 0);
-
-		//Might not have to include this (UBOs)
-		if(arg_material->isFlagSet(Material::flag_tint)) arg_material->getShader()->uploadFloat4("u_tint", arg_material->getTint());
-		else arg_material->getShader()->uploadFloat4("u_tint", s_data->defaultTint);
-		
-		//Bind geometry (VAO and IBO)
-		glBindVertexArray(arg_geometry->getID());
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arg_geometry->getIndexBuffer()->getID());
-		//Submit draw call
-		glDrawElements(GL_TRIANGLES, arg_geometry->getDrawCount(), GL_UNSIGNED_INT, nullptr);
+		RenderThread::record([arg_geometry, arg_material, arg_model](RenderBackend& arg_backend) {
+			draw(*arg_geometry, *arg_material, arg_model, arg_backend);
+		});
+	}
+	void Renderer3D::submit(const DrawList& arg_list)
+	{
+		RenderThread::record([items = &arg_list.getItems(), listKey = arg_list.getListKey()]() { s_data->drawQueue.add(*items, listKey); });
 	}
 	void Renderer3D::endScene()
 	{
+		RenderThread::record([](RenderBackend& arg_backend) {
+			s_data->drawQueue.sort();
+			for (DrawItem* item : s_data->drawQueue.getItems()) draw(*item->geometry, *item->material, item->model, arg_backend);
+			s_data->drawQueue.clear();
+		});
+	}
+	void Renderer3D::draw(VertexArray& arg_geometry, const Material& arg_material, const glm::mat4& arg_model, RenderBackend& arg_backend)
+	{
+		if (!arg_material.getShader()->isReady()) return; //!< Variant still compiling, drawn from the frame it is ready
+
+		bindBlocks(arg_material.getShader()); //!< Only ready programs get here, so attaching never waits on a compile
+		arg_backend.useShader(*arg_material.getShader());
+
+		//Apply Uniforms
+		arg_material.getShader()->uploadMat4(s_model, arg_model);
+		arg_material.apply(arg_backend); //!< Texture and tint, chosen when the material was made
+
+		arg_backend.drawIndexed(arg_geometry);
 	}
-}	
\ No newline at end of file
+}
\ No newline at end of file
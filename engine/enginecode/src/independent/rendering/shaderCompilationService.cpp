@@ -0,0 +1,95 @@
+/**\ file shaderCompilationService.cpp */
+#include "engine_pch.h"
+#include "rendering/shaderCompilationService.h"
+
+namespace Engine {
+	std::shared_ptr<ShaderCompilationService> ShaderCompilationService::s_instance = nullptr;
+
+	ShaderCompilationService::JobID ShaderCompilationService::submit(const std::string& arg_name, const std::string& arg_sourceTable, const char* arg_vertexSrc, const char* arg_fragmentSrc)
+	{
+		JobID id = m_nextJob++;
+		Job& job = m_jobs[id];
+		job.name = arg_name;
+		job.state = ShaderJobState::Pending;
+		job.submitted = std::chrono::steady_clock::now();
+		job.program = m_compiler->begin(arg_name, arg_sourceTable, arg_vertexSrc, arg_fragmentSrc);
+		m_pending++;
+		return id;
+	}
+
+	uint32_t ShaderCompilationService::getProgram(JobID arg_job) const
+	{
+		auto it = m_jobs.find(arg_job);
+		return it != m_jobs.end() ? it->second.program : 0;
+	}
+
+	ShaderJobState ShaderCompilationService::poll(JobID arg_job)
+	{
+		auto it = m_jobs.find(arg_job);
+		if (it == m_jobs.end()) return ShaderJobState::Failed;
+
+		Job& job = it->second;
+		if (job.state == ShaderJobState::Pending && m_compiler->isComplete(job.program)) complete(job);
+		return job.state;
+	}
+
+	ShaderJobState ShaderCompilationService::wait(JobID arg_job)
+	{
+		auto it = m_jobs.find(arg_job);
+		if (it == m_jobs.end()) return ShaderJobState::Failed;
+
+		Job& job = it->second;
+		if (job.state == ShaderJobState::Pending) complete(job);
+		return job.state;
+	}
+
+	void ShaderCompilationService::release(JobID arg_job)
+	{
+		auto it = m_jobs.find(arg_job);
+		if (it == m_jobs.end()) return;
+
+		if (it->second.state == ShaderJobState::Pending) {
+			m_compiler->discard(it->second.program);
+			m_pending--;
+		}
+		m_jobs.erase(it);
+	}
+
+	void ShaderCompilationService::update()
+	{
+		if (!m_pending) return;
+		Job* oldest = nullptr;
+		JobID oldestID = 0;
+		for (auto& job : m_jobs) {
+			if (job.second.state != ShaderJobState::Pending) continue;
+			if (m_compiler->isComplete(job.second.program)) complete(job.second);
+			else if (job.second.framesWaited++ >= s_framesBeforeFinish && (!oldest || job.first < oldestID)) {
+				oldest = &job.second;
+				oldestID = job.first;
+			}
+		}
+
+		/**\ A parallel driver reports its own jobs, the others have to be finished at some point and this is the least bad */
+		if (oldest && !m_compiler->isParallel()) complete(*oldest);
+	}
+
+	void ShaderCompilationService::waitAll()
+	{
+		/**\ Finishing in submission order, by the time the first is done the rest have had the same time to compile */
+		for (JobID id = 1; id < m_nextJob && m_pending; id++) {
+			auto it = m_jobs.find(id);
+			if (it != m_jobs.end() && it->second.state == ShaderJobState::Pending) complete(it->second);
+		}
+	}
+
+	void ShaderCompilationService::complete(Job& arg_job)
+	{
+		bool succeeded = m_compiler->finish(arg_job.program);
+		arg_job.state = succeeded ? ShaderJobState::Ready : ShaderJobState::Failed;
+		if (!succeeded) arg_job.program = 0; //!< Already deleted, the name may be reused
+		m_pending--;
+
+		std::chrono::duration<float, std::milli> time = std::chrono::steady_clock::now() - arg_job.submitted;
+		m_timings.push_back({ arg_job.name, time.count(), succeeded });
+	}
+}
@@ -0,0 +1,52 @@
+/**\ file shaderPermutations.cpp */
+#include "engine_pch.h"
+#include "rendering/shaderPermutations.h"
+
+#include <algorithm>
+
+namespace Engine {
+	ShaderPermutations::ShaderPermutations(const char* arg_filepath, const std::vector<std::string>& arg_keywords, const CreateFunc& arg_create) :
+		m_filepath(arg_filepath),
+		m_keywords(arg_keywords),
+		m_validMask(arg_keywords.size() >= 32 ? 0xFFFFFFFF : (1u << arg_keywords.size()) - 1),
+		m_create(arg_create)
+	{
+		if (!m_create) m_create = [](const char* arg_path, const ShaderDefines& arg_defines) { return Shader::create(arg_path, arg_defines); };
+	}
+
+	std::shared_ptr<Shader> ShaderPermutations::getVariant(uint32_t arg_keywordMask)
+	{
+		arg_keywordMask &= m_validMask;
+
+		auto it = m_variants.find(arg_keywordMask);
+		if (it != m_variants.end()) return it->second;
+
+		std::shared_ptr<Shader> variant(m_create(m_filepath.c_str(), getDefines(arg_keywordMask)));
+		m_variants[arg_keywordMask] = variant;
+		return variant;
+	}
+
+	void ShaderPermutations::warmUp(std::initializer_list<uint32_t> arg_keywordMasks)
+	{
+		for (uint32_t mask : arg_keywordMasks) getVariant(mask);
+	}
+
+	ShaderDefines ShaderPermutations::getDefines(uint32_t arg_keywordMask) const
+	{
+		ShaderDefines defines;
+		for (size_t i = 0; i < m_keywords.size() && i < 32; i++) {
+			if (arg_keywordMask & (1u << i)) defines.push_back(m_keywords[i]);
+		}
+		return defines;
+	}
+
+	std::vector<std::shared_ptr<Shader>> ShaderPermutations::getCompiledVariants() const
+	{
+		std::vector<std::pair<uint32_t, std::shared_ptr<Shader>>> sorted(m_variants.begin(), m_variants.end());
+		std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		std::vector<std::shared_ptr<Shader>> variants;
+		for (auto& variant : sorted) variants.push_back(variant.second);
+		return variants;
+	}
+}
@@ -0,0 +1,192 @@
+/**\ file shaderPreprocessor.cpp */
+#include "engine_pch.h"
+#include "rendering/shaderPreprocessor.h"
+#include "systems/logging.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Engine
+{
+	namespace
+	{
+		/**\ Region names as written after #region, in Region order */
+		const char* s_regionNames[] = { "Vertex", "Fragment", "Geometry", "TessellationControl", "TessellationEvaluation", "Compute" };
+
+		inline const char* skipSpaces(const char* arg_cursor, const char* arg_end)
+		{
+			while (arg_cursor < arg_end && (*arg_cursor == ' ' || *arg_cursor == '\t')) arg_cursor++;
+			return arg_cursor;
+		}
+
+		/**\ Returns the position after arg_word if the text starts with it, otherwise nullptr */
+		inline const char* match(const char* arg_cursor, const char* arg_end, const char* arg_word)
+		{
+			size_t length = strlen(arg_word);
+			if (static_cast<size_t>(arg_end - arg_cursor) < length || memcmp(arg_cursor, arg_word, length) != 0) return nullptr;
+			return arg_cursor + length;
+		}
+
+		inline void appendLineDirective(std::string& arg_out, uint32_t arg_line, uint32_t arg_file)
+		{
+			char directive[32];
+			int length = snprintf(directive, sizeof(directive), "#line %u %u\n", arg_line, arg_file);
+			arg_out.append(directive, length);
+		}
+	}
+
+	bool ShaderPreprocessor::process(const char* arg_filepath, ShaderSources& arg_sources, const ShaderDefines& arg_defines)
+	{
+		std::string path = std::filesystem::path(arg_filepath).lexically_normal().generic_string();
+		std::shared_ptr<const std::string> text = readFile(path);
+		if (!text) {
+			LOG_ERROR("Could not open shader filepath: {0}", arg_filepath); //!< Logs the error to console if the filepath can't be used
+			return false;
+		}
+		return processSource(path, *text, arg_sources, arg_defines);
+	}
+
+	bool ShaderPreprocessor::processSource(const std::string& arg_name, const std::string& arg_text, ShaderSources& arg_sources, const ShaderDefines& arg_defines)
+	{
+		m_defines = &arg_defines;
+		m_files.clear();
+		m_failed = false;
+		for (auto& stage : m_stages) stage.pastedOnce.clear();
+		for (auto& source : arg_sources) {
+			source.clear();
+			source.reserve(arg_text.size()); //!< A stage can't be much bigger than the file unless it pulls in includes
+		}
+
+		Region region = Region::R_NONE;
+		std::string directory = std::filesystem::path(arg_name).parent_path().generic_string();
+		scan(arg_text, getFileIndex(arg_name), directory, 0, region, arg_sources);
+		m_defines = nullptr;
+		return !m_failed;
+	}
+
+	std::string ShaderPreprocessor::getFileTable() const
+	{
+		std::string table;
+		for (size_t i = 0; i < m_files.size(); i++) {
+			if (i) table += ", ";
+			table += std::to_string(i) + ": " + m_files[i];
+		}
+		return table;
+	}
+
+	std::shared_ptr<const std::string> ShaderPreprocessor::readFile(const std::string& arg_path)
+	{
+		auto cached = m_fileCache.find(arg_path);
+		if (cached != m_fileCache.end()) return cached->second;
+
+		/**\ Reading the whole file with one call rather than line by line */
+		std::ifstream handle(arg_path, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!handle.is_open()) return nullptr;
+
+		auto text = std::make_shared<std::string>(static_cast<size_t>(handle.tellg()), '\0');
+		handle.seekg(0);
+		handle.read(&(*text)[0], text->size());
+
+		m_fileCache[arg_path] = text;
+		return text;
+	}
+
+	uint32_t ShaderPreprocessor::getFileIndex(const std::string& arg_path)
+	{
+		auto it = std::find(m_files.begin(), m_files.end(), arg_path);
+		if (it != m_files.end()) return static_cast<uint32_t>(it - m_files.begin());
+		m_files.push_back(arg_path);
+		return static_cast<uint32_t>(m_files.size() - 1);
+	}
+
+	/**\ Single pass over the text. Only lines starting with '#' are looked at more closely,
+	*	 every other line is copied straight into the current stage.
+	*/
+	void ShaderPreprocessor::scan(const std::string& arg_text, uint32_t arg_fileIndex, const std::string& arg_directory, uint32_t arg_depth, Region& arg_region, ShaderSources& arg_sources)
+	{
+		const char* cursor = arg_text.data();
+		const char* end = cursor + arg_text.size();
+		uint32_t lineNumber = 1;
+
+		for (; cursor < end; lineNumber++) {
+			const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+			if (!lineEnd) lineEnd = end;
+			const char* next = lineEnd < end ? lineEnd + 1 : end;
+			const char* lineStart = cursor;
+			cursor = next;
+
+			const char* directive = skipSpaces(lineStart, lineEnd);
+			if (directive < lineEnd && *directive == '#') {
+				directive = skipSpaces(directive + 1, lineEnd);
+
+				if (const char* name = match(directive, lineEnd, "region")) {
+					name = skipSpaces(name, lineEnd);
+					arg_region = Region::R_NONE;
+					for (int32_t i = 0; i <= Region::R_COMPUTE; i++) {
+						const char* nameEnd = match(name, lineEnd, s_regionNames[i]);
+						if (nameEnd && (nameEnd == lineEnd || isspace(static_cast<unsigned char>(*nameEnd)))) { arg_region = static_cast<Region>(i); break; }
+					}
+					continue;
+				}
+
+				if (arg_region != Region::R_NONE) {
+					std::string& out = arg_sources[arg_region];
+
+					if (const char* include = match(directive, lineEnd, "include")) {
+						const char* pathStart = static_cast<const char*>(memchr(include, '"', lineEnd - include));
+						const char* pathEnd = pathStart ? static_cast<const char*>(memchr(pathStart + 1, '"', lineEnd - pathStart - 1)) : nullptr;
+						if (!pathEnd || arg_depth >= s_maxDepth) {
+							LOG_ERROR("Bad #include in {0} line {1}", m_files[arg_fileIndex], lineNumber);
+							m_failed = true;
+							continue;
+						}
+
+						std::string path = (std::filesystem::path(arg_directory) / std::string(pathStart + 1, pathEnd)).lexically_normal().generic_string();
+						std::shared_ptr<const std::string> text = readFile(path);
+						if (!text) {
+							LOG_ERROR("Could not open shader include: {0}", path);
+							m_failed = true;
+							continue;
+						}
+
+						uint32_t includeIndex = getFileIndex(path);
+						auto& pastedOnce = m_stages[arg_region].pastedOnce;
+						if (std::find(pastedOnce.begin(), pastedOnce.end(), includeIndex) != pastedOnce.end()) continue;
+						if (text->find("#pragma once") != std::string::npos) pastedOnce.push_back(includeIndex);
+
+						appendLineDirective(out, 1, includeIndex);
+						scan(*text, includeIndex, std::filesystem::path(path).parent_path().generic_string(), arg_depth + 1, arg_region, arg_sources);
+						appendLineDirective(out, lineNumber + 1, arg_fileIndex);
+						continue;
+					}
+
+					if (match(directive, lineEnd, "pragma once")) { //!< Already handled above, GLSL doesn't know it
+						out += '\n'; //!< Keeps the line numbers in step with the file
+						continue;
+					}
+
+					if (match(directive, lineEnd, "version")) {
+						out.append(lineStart, next - lineStart);
+						if (lineEnd == end) out += '\n';
+						for (auto& define : *m_defines) {
+							out += "#define ";
+							out += define;
+							out += '\n';
+						}
+						appendLineDirective(out, lineNumber + 1, arg_fileIndex); //!< #line can only follow #version
+						continue;
+					}
+				}
+			}
+
+			if (arg_region != Region::R_NONE) {
+				std::string& out = arg_sources[arg_region];
+				out.append(lineStart, next - lineStart);
+				if (lineEnd == end) out += '\n'; //!< Last line of a file without a trailing newline
+			}
+		}
+	}
+}
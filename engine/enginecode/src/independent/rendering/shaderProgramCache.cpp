@@ -0,0 +1,192 @@
+/**\ file shaderProgramCache.cpp */
+#include "engine_pch.h"
+#include "rendering/shaderProgramCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Engine {
+	std::shared_ptr<ShaderProgramCache> ShaderProgramCache::s_instance = nullptr;
+
+	ShaderProgramCache::ShaderProgramCache(const std::shared_ptr<ProgramBinaryDriver>& arg_driver, const std::string& arg_directory, uint64_t arg_maxBytes) :
+		m_driver(arg_driver),
+		m_directory(arg_directory),
+		m_maxBytes(arg_maxBytes)
+	{
+		if (!m_driver || !m_driver->isSupported()) return; //!< Leave the cache disabled, every load is a miss
+
+		std::string signature = m_driver->getSignature();
+		m_driverHash = Fnv1a::hashBytes(signature.data(), signature.size());
+
+		std::error_code error;
+		std::filesystem::create_directories(m_directory, error);
+		if (error) return;
+
+		m_enabled = true;
+		scanDirectory();
+		evict();
+	}
+
+	uint64_t ShaderProgramCache::makeKey(std::initializer_list<const char*> arg_sources) const
+	{
+		uint64_t hash = m_driverHash;
+		for (const char* source : arg_sources) {
+			if (source) hash = Fnv1a::hashBytes(source, strlen(source), hash);
+			hash = Fnv1a::hashBytes("", 1, hash); //!< Separator, so moving text between stages changes the key
+		}
+		return hash;
+	}
+
+	std::string ShaderProgramCache::getPath(uint64_t arg_key) const
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(arg_key));
+		return (std::filesystem::path(m_directory) / name).string();
+	}
+
+	void ShaderProgramCache::scanDirectory()
+	{
+		struct Found { uint64_t key; uint64_t size; std::filesystem::file_time_type time; };
+		std::vector<Found> found;
+
+		std::error_code error;
+		for (auto& file : std::filesystem::directory_iterator(m_directory, error)) {
+			if (!file.is_regular_file() || file.path().extension() != ".bin") continue;
+
+			std::string stem = file.path().stem().string();
+			if (stem.size() != 16) continue;
+			char* end = nullptr;
+			uint64_t key = strtoull(stem.c_str(), &end, 16);
+			if (*end != '\0') continue;
+
+			found.push_back({ key, file.file_size(error), file.last_write_time(error) });
+		}
+
+		std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.time < b.time; });
+		for (auto& file : found) {
+			m_lru.push_back(file.key);
+			m_entries[file.key] = { file.size, std::prev(m_lru.end()) };
+			m_totalBytes += file.size;
+		}
+	}
+
+	bool ShaderProgramCache::load(uint64_t arg_key, uint32_t arg_program)
+	{
+		auto it = m_entries.find(arg_key);
+		if (!m_enabled || it == m_entries.end()) {
+			m_stats.misses++;
+			return false;
+		}
+
+		/**\ Reading and validating the file. Anything unexpected counts as corruption and the file is dropped */
+		FileHeader header;
+		std::vector<unsigned char> binary;
+		bool valid = false;
+		std::ifstream handle(getPath(arg_key), std::ios::in | std::ios::binary);
+		if (handle.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+			if (header.magic == s_magic && header.version == s_version && header.key == arg_key && header.size + sizeof(header) == it->second.size) {
+				binary.resize(header.size);
+				if (handle.read(reinterpret_cast<char*>(binary.data()), header.size)) {
+					valid = Fnv1a::hashBytes(binary.data(), binary.size()) == header.checksum;
+				}
+			}
+		}
+		handle.close();
+
+		if (!valid) {
+			m_stats.corrupt++;
+			m_stats.misses++;
+			remove(arg_key);
+			return false;
+		}
+
+		if (!m_driver->loadProgramBinary(arg_program, header.format, binary)) {
+			m_stats.rejected++;
+			m_stats.misses++;
+			remove(arg_key);
+			return false;
+		}
+
+		m_stats.hits++;
+		touch(arg_key);
+		return true;
+	}
+
+	bool ShaderProgramCache::store(uint64_t arg_key, uint32_t arg_program)
+	{
+		if (!m_enabled) return false;
+
+		FileHeader header;
+		std::vector<unsigned char> binary;
+		if (!m_driver->getProgramBinary(arg_program, header.format, binary) || binary.empty()) return false;
+
+		header.magic = s_magic;
+		header.version = s_version;
+		header.key = arg_key;
+		header.size = static_cast<uint32_t>(binary.size());
+		header.checksum = Fnv1a::hashBytes(binary.data(), binary.size());
+
+		/**\ Writing to a temporary file first so a crash can never leave a half written entry under the real name */
+		std::string path = getPath(arg_key);
+		std::string tempPath = path + ".tmp";
+		{
+			std::ofstream handle(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!handle.is_open()) return false;
+			handle.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			handle.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+			if (!handle) return false;
+		}
+
+		if (m_entries.count(arg_key)) remove(arg_key);
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, path, error);
+		if (error) {
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		uint64_t size = sizeof(header) + binary.size();
+		m_lru.push_back(arg_key);
+		m_entries[arg_key] = { size, std::prev(m_lru.end()) };
+		m_totalBytes += size;
+		m_stats.stored++;
+
+		evict();
+		return true;
+	}
+
+	void ShaderProgramCache::touch(uint64_t arg_key)
+	{
+		auto& entry = m_entries[arg_key];
+		m_lru.splice(m_lru.end(), m_lru, entry.lruPosition); //!< Iterators stay valid when splicing
+
+		/**\ Updating the write time so the use order survives to the next run */
+		std::error_code error;
+		std::filesystem::last_write_time(getPath(arg_key), std::filesystem::file_time_type::clock::now(), error);
+	}
+
+	void ShaderProgramCache::remove(uint64_t arg_key)
+	{
+		auto it = m_entries.find(arg_key);
+		if (it == m_entries.end()) return;
+
+		m_totalBytes -= it->second.size;
+		m_lru.erase(it->second.lruPosition);
+		m_entries.erase(it);
+
+		std::error_code error;
+		std::filesystem::remove(getPath(arg_key), error);
+	}
+
+	void ShaderProgramCache::evict()
+	{
+		while (m_totalBytes > m_maxBytes && m_lru.size() > 1) { //!< Never evicts the entry that was just used
+			remove(m_lru.front());
+			m_stats.evicted++;
+		}
+	}
+}
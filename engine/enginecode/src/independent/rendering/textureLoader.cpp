@@ -0,0 +1,50 @@
+/** \file textureLoader.cpp
+*/
+#include "engine_pch.h"
+#include "rendering/textureLoader.h"
+
+#include <vector>
+
+#include "stb_image.h"
+
+#include "systems/logging.h"
+
+namespace Engine {
+	namespace {
+		/**\ An image decoded on a worker, waiting for the render thread to make a texture of it. No pixels if it didn't decode */
+		struct DecodedImage
+		{
+			std::shared_ptr<unsigned char> pixels; //!< Freed with stbi_image_free
+			uint32_t width = 0;
+			uint32_t height = 0;
+			uint32_t channels = 0;
+		};
+	}
+
+	Task<std::shared_ptr<Texture>> TextureLoader::load(const std::string& arg_path)
+	{
+		return Tasks::readFile(arg_path)
+			.then(TaskThread::Worker, [arg_path](std::vector<unsigned char>& arg_file) {
+				DecodedImage image;
+				int width, height, channels;
+				image.pixels.reset(stbi_load_from_memory(arg_file.data(), static_cast<int>(arg_file.size()), &width, &height, &channels, 0), stbi_image_free);
+				if (image.pixels) {
+					image.width = static_cast<uint32_t>(width);
+					image.height = static_cast<uint32_t>(height);
+					image.channels = static_cast<uint32_t>(channels);
+				}
+				else LOG_ERROR("Could not decode texture: {0}", arg_path);
+				return image;
+			})
+			.then(TaskThread::Render, [](DecodedImage& arg_image) {
+				if (!arg_image.pixels) return makeMissing();
+				return std::shared_ptr<Texture>(Texture::create(arg_image.width, arg_image.height, arg_image.channels, arg_image.pixels.get()));
+			});
+	}
+
+	std::shared_ptr<Texture> TextureLoader::makeMissing()
+	{
+		unsigned char magenta[4] = { 255, 0, 255, 255 };
+		return std::shared_ptr<Texture>(Texture::create(1, 1, 4, magenta));
+	}
+}
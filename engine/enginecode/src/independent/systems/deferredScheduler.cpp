@@ -0,0 +1,113 @@
+/** \file deferredScheduler.cpp
+*/
+#include "engine_pch.h"
+#include "systems/deferredScheduler.h"
+
+#include <algorithm>
+
+#include "systems/timer.h"
+
+namespace Engine {
+	DeferredScheduler::DeferredScheduler(const DeferredSettings& arg_settings) : m_settings(arg_settings)
+	{
+	}
+
+	void DeferredScheduler::post(Work&& arg_work, WorkPriority arg_priority)
+	{
+		uint64_t now = timer::now();
+		std::lock_guard<std::mutex> lock(m_mutex); //!< setSettings() may be called from another thread
+		uint64_t aging = m_settings.agingMicroseconds[static_cast<uint32_t>(arg_priority)] * 1000ull;
+		push(m_heap, { now + aging, 0, std::move(arg_work) });
+	}
+
+	void DeferredScheduler::post(Work&& arg_work, uint64_t arg_deadline)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		push(m_deadlines, { arg_deadline, 0, std::move(arg_work) });
+	}
+
+	void DeferredScheduler::push(std::vector<Item>& arg_heap, Item&& arg_item)
+	{
+		arg_item.sequence = m_sequence++; //!< Shared by both heaps, so ties between them keep posting order
+		arg_heap.push_back(std::move(arg_item));
+		std::push_heap(arg_heap.begin(), arg_heap.end());
+	}
+
+	DeferredScheduler::Item DeferredScheduler::pop(std::vector<Item>& arg_heap)
+	{
+		std::pop_heap(arg_heap.begin(), arg_heap.end());
+		Item item = std::move(arg_heap.back());
+		arg_heap.pop_back();
+		return item;
+	}
+
+	uint32_t DeferredScheduler::run(uint64_t arg_budget)
+	{
+		DeferredStats stats;
+		uint64_t start = timer::now();
+		uint64_t now = start;
+		while (true) {
+			Item item;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_heap.empty() && m_deadlines.empty()) break;
+
+				bool inBudget = now - start < arg_budget;
+				bool overdue = !m_deadlines.empty() && m_deadlines.front().due <= now;
+				if (!inBudget && !overdue && stats.executed >= m_settings.minItemsPerFrame) break;
+				if (!inBudget) stats.forced++;
+
+				/**\ Earliest due of the two fronts, except that over budget an overdue deadline goes first */
+				bool deadline = m_heap.empty() || (!m_deadlines.empty() && (m_heap.front() < m_deadlines.front() || (!inBudget && overdue)));
+				item = pop(deadline ? m_deadlines : m_heap);
+			}
+
+			item.work(); //!< Without the lock, so it can post more work
+			stats.executed++;
+			now = timer::now();
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		stats.pending = static_cast<uint32_t>(m_heap.size() + m_deadlines.size());
+		stats.nanoseconds = now - start;
+		stats.totalExecuted = m_stats.totalExecuted + stats.executed;
+		m_stats = stats;
+		return stats.executed;
+	}
+
+	uint32_t DeferredScheduler::runFrame(uint64_t arg_frameElapsed)
+	{
+		return run(getBudget(arg_frameElapsed));
+	}
+
+	uint64_t DeferredScheduler::getBudget(uint64_t arg_frameElapsed) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		uint64_t budget = m_settings.budgetMicroseconds * 1000ull;
+		if (m_settings.targetFrameMicroseconds) {
+			uint64_t target = m_settings.targetFrameMicroseconds * 1000ull;
+			budget = std::min(budget, target > arg_frameElapsed ? target - arg_frameElapsed : 0); //!< A frame already over its target gets nothing
+		}
+		return budget;
+	}
+
+	void DeferredScheduler::clear()
+	{
+		std::vector<Item> dropped, droppedDeadlines; //!< Destroyed after the lock is released, in case a capture posts from its destructor
+		std::lock_guard<std::mutex> lock(m_mutex);
+		dropped.swap(m_heap);
+		droppedDeadlines.swap(m_deadlines);
+	}
+
+	uint32_t DeferredScheduler::getPendingCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return static_cast<uint32_t>(m_heap.size() + m_deadlines.size());
+	}
+
+	DeferredStats DeferredScheduler::getStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_stats;
+	}
+}
@@ -0,0 +1,69 @@
+/** \file fixedTimestep.cpp
+*/
+#include "engine_pch.h"
+#include "systems/fixedTimestep.h"
+
+#include "systems/timer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Engine {
+	FixedTimestep::FixedTimestep(double arg_tickRate, uint32_t arg_maxSteps, const Clock& arg_clock) :
+		m_clock(arg_clock ? arg_clock : Clock(timer::now)),
+		m_step(static_cast<uint64_t>(1e9 / arg_tickRate + 0.5)),
+		m_maxSteps(arg_maxSteps)
+	{
+		m_lastTime = m_clock();
+	}
+
+	uint32_t FixedTimestep::advance()
+	{
+		uint64_t now = m_clock();
+		m_frameTime = now - m_lastTime;
+		m_lastTime = now;
+		m_accumulator += m_frameTime;
+
+		uint64_t ticks = m_accumulator / m_step;
+		if (ticks > m_maxSteps) {
+			m_droppedTime += (ticks - m_maxSteps) * m_step; //!< The partial tick left over is kept
+			m_accumulator -= (ticks - m_maxSteps) * m_step;
+			ticks = m_maxSteps;
+		}
+		m_accumulator -= ticks * m_step;
+		m_tickCount += ticks;
+		return static_cast<uint32_t>(ticks);
+	}
+
+	void FixedTimestep::reset()
+	{
+		m_lastTime = m_clock();
+		m_accumulator = 0;
+		m_frameTime = 0;
+	}
+
+	void FixedTimestep::setTickRate(double arg_tickRate)
+	{
+		double alpha = static_cast<double>(m_accumulator) / m_step;
+		m_step = static_cast<uint64_t>(1e9 / arg_tickRate + 0.5);
+		m_accumulator = static_cast<uint64_t>(alpha * m_step); //!< Keeps the frame at the same point between ticks
+	}
+
+	void FixedTimestep::setClock(const Clock& arg_clock)
+	{
+		m_clock = arg_clock ? arg_clock : Clock(timer::now);
+		reset();
+	}
+
+	glm::mat4 SimTransform::toMatrix() const
+	{
+		return glm::translate(glm::mat4(1.f), position) * glm::mat4_cast(rotation);
+	}
+
+	SimTransform SimTransform::interpolate(const SimTransform& arg_previous, const SimTransform& arg_current, float arg_alpha)
+	{
+		SimTransform result;
+		result.position = glm::mix(arg_previous.position, arg_current.position, arg_alpha);
+		result.rotation = glm::slerp(arg_previous.rotation, arg_current.rotation, arg_alpha);
+		return result;
+	}
+}
@@ -0,0 +1,75 @@
+/** \file frameAllocator.cpp
+*/
+#include "engine_pch.h"
+#include "systems/frameAllocator.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace Engine {
+	LinearAllocator FrameAllocator::s_buffers[s_maxBuffers] = { LinearAllocator(256 * 1024), LinearAllocator(256 * 1024), LinearAllocator(256 * 1024) };
+	uint32_t FrameAllocator::s_bufferCount = 2;
+	uint32_t FrameAllocator::s_current = 0;
+	uint64_t FrameAllocator::s_frame = 0;
+
+	void FrameAllocator::setBufferCount(uint32_t arg_count)
+	{
+		s_bufferCount = std::min(std::max(arg_count, 2u), s_maxBuffers);
+		for (auto& buffer : s_buffers) buffer.reset();
+		s_current = 0;
+	}
+
+	void FrameAllocator::beginFrame()
+	{
+		s_current = (s_current + 1) % s_bufferCount;
+		s_buffers[s_current].reset(); //!< Last used bufferCount frames ago, the render thread has finished with it
+		s_frame++;
+	}
+
+	void FrameAllocator::shutdown()
+	{
+		for (auto& buffer : s_buffers) buffer.release();
+		s_current = 0;
+	}
+
+	const char* FrameAllocator::format(const char* arg_format, ...)
+	{
+		/**\ Written onto the stack first so the text takes exactly what it needs, only long text is formatted twice */
+		char local[256];
+		va_list args;
+		va_start(args, arg_format);
+		va_list copy;
+		va_copy(copy, args);
+		int length = std::max(std::vsnprintf(local, sizeof(local), arg_format, copy), 0);
+		va_end(copy);
+
+		char* text = static_cast<char*>(allocate(static_cast<size_t>(length) + 1, 1));
+		if (length < static_cast<int>(sizeof(local))) memcpy(text, local, static_cast<size_t>(length) + 1);
+		else std::vsnprintf(text, static_cast<size_t>(length) + 1, arg_format, args);
+		va_end(args);
+		return text;
+	}
+
+	size_t FrameAllocator::getPeakBytesUsed()
+	{
+		size_t peak = 0;
+		for (auto& buffer : s_buffers) peak = std::max(peak, buffer.getPeakBytesUsed());
+		return peak;
+	}
+
+	size_t FrameAllocator::getCapacity()
+	{
+		size_t capacity = 0;
+		for (auto& buffer : s_buffers) capacity += buffer.getCapacity();
+		return capacity;
+	}
+
+	uint32_t FrameAllocator::getBlockCount()
+	{
+		uint32_t blocks = 0;
+		for (auto& buffer : s_buffers) blocks += buffer.getBlockCount();
+		return blocks;
+	}
+}
@@ -0,0 +1,47 @@
+/** \file frameLimiter.cpp
+*/
+#include "engine_pch.h"
+#include "systems/frameLimiter.h"
+#include "systems/timer.h"
+
+#include <thread>
+
+namespace Engine {
+	FrameLimiter::FrameLimiter(uint32_t arg_frameMicroseconds, uint32_t arg_spinMicroseconds, const SleepFunc& arg_sleep) :
+		m_frame(arg_frameMicroseconds * 1000ull),
+		m_spin(arg_spinMicroseconds * 1000ull),
+		m_sleep(arg_sleep)
+	{
+		if (!m_sleep) m_sleep = [](uint64_t arg_nanoseconds) { std::this_thread::sleep_for(std::chrono::nanoseconds(arg_nanoseconds)); };
+	}
+
+	void FrameLimiter::setTargetRate(double arg_framesPerSecond)
+	{
+		m_frame = arg_framesPerSecond > 0.0 ? static_cast<uint64_t>(1e9 / arg_framesPerSecond + 0.5) : 0;
+		reset();
+	}
+
+	uint64_t FrameLimiter::wait()
+	{
+		if (!m_frame) return 0;
+
+		uint64_t start = timer::now();
+		if (m_deadline == 0 || start > m_deadline + m_frame) { //!< First frame, or too far behind to catch up
+			m_deadline = start + m_frame;
+			m_overshoot = 0;
+			return 0;
+		}
+
+		if (m_deadline > start + m_spin) m_sleep(m_deadline - start - m_spin);
+
+		uint64_t now = timer::now();
+		while (now < m_deadline) {
+			std::this_thread::yield();
+			now = timer::now();
+		}
+
+		m_overshoot = now - m_deadline;
+		m_deadline += m_frame;
+		return now - start;
+	}
+}
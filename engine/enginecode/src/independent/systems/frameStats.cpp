@@ -0,0 +1,60 @@
+/** \file frameStats.cpp
+*/
+#include "engine_pch.h"
+#include "systems/frameStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+	FrameStats::FrameStats(uint32_t arg_windowSize, uint32_t arg_bucketMicroseconds, uint32_t arg_bucketCount) :
+		m_samples(arg_windowSize),
+		m_bucketMicroseconds(arg_bucketMicroseconds),
+		m_histogram(arg_bucketCount)
+	{
+		m_sorted.reserve(arg_windowSize);
+	}
+
+	void FrameStats::addFrame(uint64_t arg_nanoseconds)
+	{
+		if (m_count == m_samples.size()) { //!< Full, the oldest frame leaves the window
+			uint64_t oldest = m_samples[m_next];
+			m_total -= oldest;
+			m_histogram[getBucket(oldest)]--;
+		}
+		else m_count++;
+
+		m_samples[m_next] = arg_nanoseconds;
+		m_next = (m_next + 1) % m_samples.size();
+		m_total += arg_nanoseconds;
+		m_histogram[getBucket(arg_nanoseconds)]++;
+		m_sortedValid = false;
+	}
+
+	void FrameStats::clear()
+	{
+		m_next = 0;
+		m_count = 0;
+		m_total = 0;
+		std::fill(m_histogram.begin(), m_histogram.end(), 0);
+		m_sortedValid = false;
+	}
+
+	uint64_t FrameStats::getPercentile(float arg_percent) const
+	{
+		if (!m_count) return 0;
+		if (!m_sortedValid) {
+			m_sorted.assign(m_samples.begin(), m_samples.begin() + m_count); //!< Order doesn't matter, so the ring's unused tail is all that's skipped
+			std::sort(m_sorted.begin(), m_sorted.end());
+			m_sortedValid = true;
+		}
+		uint32_t rank = static_cast<uint32_t>(std::ceil(arg_percent / 100.f * m_count));
+		return m_sorted[std::min(std::max(rank, 1u), m_count) - 1];
+	}
+
+	uint32_t FrameStats::getBucket(uint64_t arg_nanoseconds) const
+	{
+		uint64_t bucket = arg_nanoseconds / (m_bucketMicroseconds * 1000ull);
+		return static_cast<uint32_t>(std::min<uint64_t>(bucket, m_histogram.size() - 1));
+	}
+}
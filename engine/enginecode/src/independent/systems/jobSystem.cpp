@@ -0,0 +1,226 @@
+/** \file jobSystem.cpp
+*/
+#include "engine_pch.h"
+#include "systems/jobSystem.h"
+
+#include <algorithm>
+
+namespace Engine {
+	/**\ A queued function, and the counter it lowers when it has run */
+	struct Job
+	{
+		std::function<void()> func;
+		JobCounter* counter;
+	};
+
+	namespace {
+		thread_local int32_t t_workerIndex = -1; //!< Index into s_workers, -1 on threads the job system doesn't own
+		constexpr uint32_t s_spinsBeforeSleep = 64; //!< Failed searches before an idle worker sleeps
+	}
+
+	std::vector<std::unique_ptr<jobSystem::Worker>> jobSystem::s_workers;
+	std::atomic<bool> jobSystem::s_running{ false };
+	std::mutex jobSystem::s_sharedMutex;
+	std::vector<Job*> jobSystem::s_shared;
+	std::mutex jobSystem::s_sleepMutex;
+	std::condition_variable jobSystem::s_wake;
+	std::atomic<uint64_t> jobSystem::s_workGeneration{ 0 };
+	std::atomic<uint32_t> jobSystem::s_sleeping{ 0 };
+
+	jobSystem::jobSystem(uint32_t arg_workerCount) : m_requestedWorkers(arg_workerCount)
+	{
+	}
+
+	jobSystem::~jobSystem()
+	{
+		if (s_running) stop();
+	}
+
+	void jobSystem::start(SystemSignal init, ...)
+	{
+		if (s_running) return;
+
+		uint32_t count = m_requestedWorkers ? m_requestedWorkers : std::max(1u, std::thread::hardware_concurrency());
+		s_workers.clear();
+		for (uint32_t i = 0; i < count; i++) {
+			s_workers.push_back(std::make_unique<Worker>());
+			s_workers.back()->randomState = 0x9E3779B9u * (i + 1);
+		}
+
+		t_workerIndex = 0; //!< The starting thread is worker 0
+		s_running = true;
+		for (uint32_t i = 1; i < count; i++) s_workers[i]->thread = std::thread(workerLoop, i);
+	}
+
+	void jobSystem::stop(SystemSignal init, ...)
+	{
+		if (!s_running) return;
+
+		/**\ Finishing everything already queued, then letting the workers go */
+		while (Job* job = findJob()) execute(job);
+
+		{
+			std::lock_guard<std::mutex> lock(s_sleepMutex);
+			s_running = false;
+			s_workGeneration++;
+		}
+		s_wake.notify_all();
+		for (uint32_t i = 1; i < s_workers.size(); i++) s_workers[i]->thread.join();
+
+		while (Job* job = findJob()) execute(job); //!< Anything submitted by the last jobs to run
+		t_workerIndex = -1;
+		s_workers.clear();
+	}
+
+	void jobSystem::run(const std::function<void()>& arg_job, JobCounter* arg_counter, JobCounter* arg_dependency)
+	{
+		if (!s_running) {
+			if (arg_dependency) wait(*arg_dependency);
+			arg_job();
+			return;
+		}
+
+		if (arg_counter) arg_counter->m_count.fetch_add(1, std::memory_order_relaxed);
+		Job* job = new Job{ arg_job, arg_counter };
+
+		if (arg_dependency) {
+			std::lock_guard<std::mutex> lock(arg_dependency->m_waitersMutex);
+			if (arg_dependency->m_count.load() != 0) { //!< Checked under the lock, release() takes it after the count reaches zero
+				arg_dependency->m_waiters.push_back(job);
+				return;
+			}
+		}
+		submit(job);
+	}
+
+	void jobSystem::wait(JobCounter& arg_counter)
+	{
+		while (!arg_counter.isDone()) {
+			if (Job* job = findJob()) execute(job);
+			else std::this_thread::yield();
+		}
+	}
+
+	bool jobSystem::help()
+	{
+		if (!s_running) return false;
+		Job* job = findJob();
+		if (job) execute(job);
+		return job != nullptr;
+	}
+
+	void jobSystem::parallelFor(uint32_t arg_count, uint32_t arg_batchSize, const std::function<void(uint32_t, uint32_t)>& arg_func)
+	{
+		if (!arg_count) return;
+		if (!arg_batchSize) arg_batchSize = std::max(1u, arg_count / (getWorkerCount() * 4)); //!< A few batches per worker leaves room to balance
+
+		JobCounter counter;
+		for (uint32_t begin = arg_batchSize; begin < arg_count; begin += arg_batchSize) {
+			uint32_t end = std::min(arg_count, begin + arg_batchSize);
+			run([&arg_func, begin, end]() { arg_func(begin, end); }, &counter);
+		}
+		arg_func(0, std::min(arg_count, arg_batchSize)); //!< The first batch runs here rather than waiting idle
+		wait(counter);
+	}
+
+	void jobSystem::submit(Job* arg_job)
+	{
+		bool pushed = t_workerIndex >= 0 && s_workers[t_workerIndex]->deque.push(arg_job);
+		if (!pushed) {
+			std::lock_guard<std::mutex> lock(s_sharedMutex);
+			s_shared.push_back(arg_job);
+		}
+
+		s_workGeneration.fetch_add(1); //!< Sequentially consistent with the sleeper's count and check, one of the two always sees the other
+		if (s_sleeping.load()) {
+			{ std::lock_guard<std::mutex> lock(s_sleepMutex); } //!< A worker between checking the generation and waiting holds this, so it can't miss the notify
+			s_wake.notify_one();
+		}
+	}
+
+	Job* jobSystem::findJob()
+	{
+		if (t_workerIndex >= 0) {
+			if (Job* job = s_workers[t_workerIndex]->deque.pop()) return job;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_sharedMutex);
+			if (!s_shared.empty()) {
+				Job* job = s_shared.back();
+				s_shared.pop_back();
+				return job;
+			}
+		}
+
+		/**\ Stealing, starting from a random worker so thieves spread out */
+		uint32_t count = static_cast<uint32_t>(s_workers.size());
+		if (count < 2 && t_workerIndex >= 0) return nullptr;
+		uint32_t start = 0;
+		if (t_workerIndex >= 0) {
+			uint32_t& state = s_workers[t_workerIndex]->randomState;
+			state ^= state << 13; state ^= state >> 17; state ^= state << 5; //!< xorshift32
+			start = state;
+		}
+		for (uint32_t i = 0; i < count; i++) {
+			uint32_t victim = (start + i) % count;
+			if (static_cast<int32_t>(victim) == t_workerIndex) continue;
+			if (Job* job = s_workers[victim]->deque.steal()) return job;
+		}
+		return nullptr;
+	}
+
+	void jobSystem::execute(Job* arg_job)
+	{
+		arg_job->func();
+		JobCounter* counter = arg_job->counter;
+		delete arg_job;
+
+		if (counter) {
+			counter->m_finishing.fetch_add(1);
+			if (counter->m_count.fetch_sub(1) == 1) release(*counter);
+			counter->m_finishing.fetch_sub(1); //!< Last access, a waiting thread can return as soon as this lands
+		}
+	}
+
+	void jobSystem::release(JobCounter& arg_counter)
+	{
+		std::vector<Job*> waiters;
+		{
+			std::lock_guard<std::mutex> lock(arg_counter.m_waitersMutex);
+			waiters.swap(arg_counter.m_waiters);
+		}
+		for (Job* job : waiters) submit(job);
+	}
+
+	void jobSystem::sleep(uint64_t arg_generation)
+	{
+		std::unique_lock<std::mutex> lock(s_sleepMutex);
+		s_sleeping++;
+		s_wake.wait(lock, [arg_generation]() { return s_workGeneration.load() != arg_generation || !s_running; });
+		s_sleeping--;
+	}
+
+	void jobSystem::workerLoop(uint32_t arg_index)
+	{
+		t_workerIndex = static_cast<int32_t>(arg_index);
+
+		uint32_t idleSpins = 0;
+		while (true) {
+			uint64_t generation = s_workGeneration.load(std::memory_order_acquire); //!< Read before searching, so work submitted during the search wakes us
+			if (Job* job = findJob()) {
+				execute(job);
+				idleSpins = 0;
+				continue;
+			}
+			if (!s_running) break;
+
+			if (++idleSpins < s_spinsBeforeSleep) std::this_thread::yield();
+			else {
+				sleep(generation);
+				idleSpins = 0;
+			}
+		}
+		t_workerIndex = -1;
+	}
+}
@@ -0,0 +1,54 @@
+/** \file linearAllocator.cpp
+*/
+#include "engine_pch.h"
+#include "systems/linearAllocator.h"
+
+namespace Engine {
+	void* LinearAllocator::allocate(size_t arg_size, size_t arg_alignment)
+	{
+		while (m_currentBlock < m_blocks.size()) {
+			Block& block = m_blocks[m_currentBlock];
+			uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+			uintptr_t aligned = (base + m_offset + arg_alignment - 1) & ~(static_cast<uintptr_t>(arg_alignment) - 1);
+			size_t end = static_cast<size_t>(aligned - base) + arg_size;
+			if (end <= block.size) {
+				m_bytesUsed += end - m_offset;
+				if (m_bytesUsed > m_peakBytesUsed) m_peakBytesUsed = m_bytesUsed;
+				m_offset = end;
+				return reinterpret_cast<void*>(aligned);
+			}
+			m_currentBlock++; //!< The rest of this block is wasted until the next reset
+			m_offset = 0;
+		}
+
+		/**\ Out of blocks. Oversized requests get a block of their own */
+		size_t size = arg_size + arg_alignment > m_blockSize ? arg_size + arg_alignment : m_blockSize;
+		m_blocks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[size]), size });
+		m_currentBlock = m_blocks.size() - 1;
+		m_capacity += size;
+		m_offset = 0;
+		return allocate(arg_size, arg_alignment);
+	}
+
+	void LinearAllocator::reset()
+	{
+		m_currentBlock = 0;
+		m_offset = 0;
+		m_bytesUsed = 0;
+	}
+
+	void LinearAllocator::release()
+	{
+		reset();
+		m_blocks.clear();
+		m_blocks.shrink_to_fit();
+		m_capacity = 0;
+	}
+
+	void LinearAllocator::rewind(const Marker& arg_marker)
+	{
+		m_currentBlock = arg_marker.block;
+		m_offset = arg_marker.offset;
+		m_bytesUsed = arg_marker.bytesUsed;
+	}
+}
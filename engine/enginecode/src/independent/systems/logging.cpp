@@ -1,9 +1,58 @@
 #include "engine_pch.h"
 #include "systems/logging.h"
+#include "systems/memoryTracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <spdlog/details/os.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/sinks/rotating_file_sink.h>
 
 namespace Engine {
-	std::shared_ptr<spdlog::logger> logging::s_logger;
-	
+	LogSettings logging::s_settings;
+	std::unique_ptr<LogRing> logging::s_ring;
+	std::atomic<bool> logging::s_running{ false };
+	std::atomic<uint32_t> logging::s_inFlight{ 0 };
+	std::atomic<spdlog::level::level_enum> logging::s_level{ spdlog::level::info };
+	std::atomic<uint64_t> logging::s_dropped{ 0 };
+
+	namespace {
+		/**\ The writer thread's, apart from the wake up */
+		std::thread s_writer;
+		std::vector<spdlog::sink_ptr> s_sinks;
+		uint64_t s_droppedReported = 0;
+
+		/**\ The writer sleeps when the ring is empty and wakes every s_idleWait to write what has come in. Waking it
+		*	 costs the log call a system call, and on a busy core a switch to the writer, so a call only does so for an
+		*	 error or when the ring is half full. A wake up lost to the race between its check and its wait only delays the output
+		*/
+		std::mutex s_wakeMutex;
+		std::condition_variable s_wake;
+		std::atomic<bool> s_writerIdle{ false };
+		std::atomic<bool> s_writerStop{ false }; //!< Set once no call can reach the ring, so the writer drains it and ends
+		std::atomic<uint64_t> s_flushed{ 0 }; //!< Records written and flushed
+		constexpr auto s_idleWait = std::chrono::milliseconds(20);
+
+		void writeToSinks(spdlog::level::level_enum arg_level, spdlog::log_clock::time_point arg_time, size_t arg_threadId, std::string_view arg_text)
+		{
+			spdlog::details::log_msg message(spdlog::source_loc{}, "Engine", arg_level, spdlog::string_view_t(arg_text.data(), arg_text.size()));
+			message.time = arg_time;
+			message.thread_id = arg_threadId;
+			for (auto& sink : s_sinks) sink->log(message);
+		}
+
+		void flushSinks()
+		{
+			for (auto& sink : s_sinks) sink->flush();
+		}
+	}
+
 	logging::logging()
 	{
 
@@ -15,25 +64,151 @@ namespace Engine {
 
 	void logging::start(SystemSignal init, ...)
 	{
-		s_logger = spdlog::stdout_color_mt("console");
-		spdlog::set_pattern("%^[%T] %n: %v%$");
+		MemoryTagScope memoryTag(MemoryTag::Logging);
+		std::string fileError;
+		if (s_settings.console) {
+			s_sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_st>());
+			s_sinks.back()->set_pattern("%^[%T] %n: %v%$");
+		}
+		if (!s_settings.filePath.empty()) {
+			try {
+				s_sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_st>(s_settings.filePath, s_settings.maxFileSize, s_settings.maxFiles));
+				s_sinks.back()->set_pattern("[%Y-%m-%d %T.%e] [%t] %l: %v");
+			}
+			catch (const std::exception& e) {
+				fileError = e.what();
+			}
+		}
 
-		s_logger->info("Logger Started.");
+		s_ring = std::make_unique<LogRing>(s_settings.ringCapacity);
+		s_flushed.store(0, std::memory_order_relaxed);
+		s_writerStop.store(false, std::memory_order_relaxed);
+		s_running.store(true, std::memory_order_release);
+		s_writer = std::thread([]() {
+			MemoryTracker::setTag(MemoryTag::Logging);
+			for (;;) {
+				bool wrote = false;
+				while (LogRecord* record = s_ring->front()) {
+					writeToSinks(record->level, record->time, record->threadId, std::string_view(record->text, record->length));
+					s_ring->popFront();
+					wrote = true;
+				}
+
+				uint64_t dropped = s_dropped.load(std::memory_order_relaxed);
+				if (dropped != s_droppedReported) {
+					char text[64];
+					int length = snprintf(text, sizeof(text), "%llu log messages dropped, the ring was full", static_cast<unsigned long long>(dropped - s_droppedReported));
+					writeToSinks(spdlog::level::warn, spdlog::log_clock::now(), spdlog::details::os::thread_id(), std::string_view(text, static_cast<size_t>(length)));
+					s_droppedReported = dropped;
+					wrote = true;
+				}
+
+				if (wrote) {
+					flushSinks();
+					s_flushed.store(s_ring->getReleased(), std::memory_order_release);
+					continue; //!< More may have come in while writing
+				}
+				if (s_writerStop.load(std::memory_order_acquire)) break;
+
+				std::unique_lock<std::mutex> lock(s_wakeMutex);
+				s_writerIdle.store(true);
+				if (!s_ring->front() && !s_writerStop.load()) s_wake.wait_for(lock, s_idleWait);
+				s_writerIdle.store(false, std::memory_order_relaxed);
+			}
+		});
+
+		if (!fileError.empty()) write(spdlog::level::warn, "Couldn't open the log file {0}: {1}", s_settings.filePath, fileError);
+		write(spdlog::level::info, "Logger Started.");
 	}
 	void logging::stop(SystemSignal init, ...)
 	{
-		s_logger->info("Logger Stopped.");
-		s_logger.reset();
+		if (!isRunning()) return;
+		write(spdlog::level::info, "Logger Stopped.");
+		s_running.store(false); //!< Sequentially consistent with the count in claim(), so a call either sees this or is waited for
+		while (s_inFlight.load() != 0) {
+			s_wake.notify_one(); //!< A blocked call needs the writer to make room
+			std::this_thread::yield();
+		}
+
+		s_writerStop.store(true, std::memory_order_release);
+		s_wake.notify_one();
+		s_writer.join(); //!< Writes out whatever is left first
+		s_ring.reset();
+		s_sinks.clear();
+	}
+
+	void logging::flush()
+	{
+		s_inFlight.fetch_add(1);
+		if (isRunning()) {
+			uint64_t target = s_ring->getClaimed();
+			while (s_flushed.load(std::memory_order_acquire) < target) {
+				s_wake.notify_one();
+				std::this_thread::yield();
+			}
+		}
+		s_inFlight.fetch_sub(1, std::memory_order_release);
 	}
 
 	void logging::log(const std::string& msg)
 	{
-		s_logger->log(spdlog::level::info, msg);
+		write(spdlog::level::info, msg);
 	}
 	void logging::log(const std::string& msg, const float& flt)
 	{
-		s_logger->log(spdlog::level::info, msg);
-		s_logger->log(spdlog::level::info, flt);
+		write(spdlog::level::info, msg);
+		write(spdlog::level::info, "{0}", flt);
+	}
+
+	void logging::write(spdlog::level::level_enum arg_level, std::string_view arg_text)
+	{
+		if (!shouldLog(arg_level)) return;
+		uint64_t ticket;
+		LogRecord* record = claim(ticket);
+		if (!record) return;
+		record->length = 0;
+		append(*record, arg_text);
+		publish(*record, ticket, arg_level);
+	}
+
+	LogRecord* logging::claim(uint64_t& arg_ticket)
+	{
+		s_inFlight.fetch_add(1);
+		if (!s_running.load()) { //!< Stopped since shouldLog(), the ring may be going
+			s_inFlight.fetch_sub(1, std::memory_order_release);
+			return nullptr;
+		}
+
+		LogRecord* record = s_ring->tryClaim(arg_ticket);
+		while (!record) {
+			if (s_settings.overflow == LogOverflow::Drop || !isRunning()) {
+				s_dropped.fetch_add(1, std::memory_order_relaxed);
+				s_inFlight.fetch_sub(1, std::memory_order_release);
+				return nullptr;
+			}
+			s_wake.notify_one();
+			std::this_thread::yield();
+			record = s_ring->tryClaim(arg_ticket);
+		}
+		record->time = spdlog::log_clock::now();
+		record->threadId = spdlog::details::os::thread_id();
+		return record;
+	}
+
+	void logging::publish(LogRecord& arg_record, uint64_t arg_ticket, spdlog::level::level_enum arg_level)
+	{
+		arg_record.level = arg_level;
+		s_ring->publish(arg_record, arg_ticket);
+		bool urgent = arg_level >= spdlog::level::err || arg_ticket - s_flushed.load(std::memory_order_relaxed) >= s_ring->getCapacity() / 2;
+		s_inFlight.fetch_sub(1, std::memory_order_release);
+		if (urgent && s_writerIdle.load(std::memory_order_relaxed)) s_wake.notify_one();
+	}
+
+	void logging::append(LogRecord& arg_record, std::string_view arg_text)
+	{
+		size_t length = std::min(arg_text.size(), LogRecord::s_textSize - arg_record.length);
+		memcpy(arg_record.text + arg_record.length, arg_text.data(), length);
+		arg_record.length = static_cast<uint16_t>(arg_record.length + length);
 	}
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,409 @@
+/** \file memoryTracker.cpp
+*/
+#include "engine_pch.h"
+#include "systems/memoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "systems/logging.h"
+
+#if NG_MEMORY_TRACKING > 1
+#ifdef NG_PLATFORM_WINDOWS
+#include <windows.h>
+#include <dbghelp.h>
+#pragma comment(lib, "Dbghelp.lib")
+#else
+#include <execinfo.h>
+#endif
+#endif
+
+namespace Engine {
+	namespace {
+		/**\ Counts kept by one thread. Only the owner writes them, so they are plain loads and stores rather than
+		*	 locked adds, and readers add up every thread's. A free is taken off the freeing thread's counts, so
+		*	 one thread's live bytes can go negative, the sum is what matters
+		*/
+		struct alignas(64) ThreadCounters
+		{
+			std::atomic<int64_t> liveBytes[MemoryTracker::s_tagCount];
+			std::atomic<uint64_t> allocations[MemoryTracker::s_tagCount];
+			std::atomic<uint64_t> releases[MemoryTracker::s_tagCount];
+		};
+
+		/**\ Threads past the last slot share the overflow one, which has to use locked adds */
+		constexpr uint32_t s_slotCount = 256;
+		constexpr uint32_t s_overflowSlot = s_slotCount;
+		constexpr uint32_t s_noSlot = 0xFFFFFFFF;
+
+		/**\ Everything is constant initialised, so allocations made before main are counted safely */
+		ThreadCounters s_slots[s_slotCount + 1] = {};
+		std::atomic<uint32_t> s_slotsUsed{ 0 };
+		thread_local uint32_t s_slot = s_noSlot;
+		thread_local MemoryTag s_tag = MemoryTag::General;
+
+		/**\ Read side, main thread only */
+		struct TagHistory
+		{
+			uint64_t peakBytes = 0; //!< Sampled, see MemoryTracker::getStats
+			uint64_t frameStart = 0; //!< Allocations when the frame began
+			uint64_t lastFrame = 0;
+		};
+		TagHistory s_history[MemoryTracker::s_tagCount + 1]; //!< The last is the total
+
+		/**\ Just before every tracked allocation */
+		struct alignas(16) Header
+		{
+#if NG_MEMORY_TRACKING > 1
+			Header* previous;
+			Header* next;
+			void* callstack[MemoryTracker::s_callstackDepth];
+			uint32_t depth;
+			uint64_t sequence; //!< Order it was made in, for the leak check
+#endif
+			uint64_t size;
+			uint32_t offset; //!< From the start of the block malloc gave, which is what gets freed
+			MemoryTag tag;
+		};
+
+#if NG_MEMORY_TRACKING > 1
+		/**\ Every live allocation, for the leak report. A spin lock as it has to work before any constructor has run */
+		std::atomic_flag s_liveLock = ATOMIC_FLAG_INIT;
+		Header* s_live = nullptr;
+		std::atomic<uint64_t> s_sequence{ 0 };
+		uint64_t s_leakMark = 0;
+		thread_local bool s_capturing = false; //!< Capturing a callstack can allocate the first time
+
+		void lockLive() { while (s_liveLock.test_and_set(std::memory_order_acquire)) {} }
+		void unlockLive() { s_liveLock.clear(std::memory_order_release); }
+#endif
+
+		inline void add(std::atomic<int64_t>& arg_counter, int64_t arg_value, bool arg_shared)
+		{
+			if (arg_shared) arg_counter.fetch_add(arg_value, std::memory_order_relaxed);
+			else arg_counter.store(arg_counter.load(std::memory_order_relaxed) + arg_value, std::memory_order_relaxed);
+		}
+		inline void add(std::atomic<uint64_t>& arg_counter, uint64_t arg_value, bool arg_shared)
+		{
+			if (arg_shared) arg_counter.fetch_add(arg_value, std::memory_order_relaxed);
+			else arg_counter.store(arg_counter.load(std::memory_order_relaxed) + arg_value, std::memory_order_relaxed);
+		}
+
+		/**\ The calling thread's counters, a slot is taken on its first allocation */
+		inline ThreadCounters& getCounters(bool& arg_shared)
+		{
+			if (s_slot == s_noSlot) {
+				uint32_t slot = s_slotsUsed.fetch_add(1, std::memory_order_relaxed);
+				s_slot = slot < s_slotCount ? slot : s_overflowSlot;
+			}
+			arg_shared = s_slot == s_overflowSlot;
+			return s_slots[s_slot];
+		}
+
+		void count(MemoryTag arg_tag, uint64_t arg_size)
+		{
+			bool shared;
+			ThreadCounters& counters = getCounters(shared);
+			uint32_t tag = static_cast<uint32_t>(arg_tag);
+			add(counters.liveBytes[tag], static_cast<int64_t>(arg_size), shared);
+			add(counters.allocations[tag], 1, shared);
+		}
+
+		void uncount(MemoryTag arg_tag, uint64_t arg_size)
+		{
+			bool shared;
+			ThreadCounters& counters = getCounters(shared);
+			uint32_t tag = static_cast<uint32_t>(arg_tag);
+			add(counters.liveBytes[tag], -static_cast<int64_t>(arg_size), shared);
+			add(counters.releases[tag], 1, shared);
+		}
+
+		void* trackedAllocate(size_t arg_size, size_t arg_alignment, MemoryTag arg_tag)
+		{
+			/**\ malloc's own alignment is enough unless more is asked for, then the block is padded to line the memory up */
+			size_t padding = arg_alignment > alignof(std::max_align_t) ? arg_alignment - alignof(std::max_align_t) : 0;
+			unsigned char* block = static_cast<unsigned char*>(std::malloc(arg_size + sizeof(Header) + padding));
+			if (!block) return nullptr;
+			uintptr_t start = reinterpret_cast<uintptr_t>(block) + sizeof(Header);
+			unsigned char* memory = reinterpret_cast<unsigned char*>((start + arg_alignment - 1) & ~(static_cast<uintptr_t>(arg_alignment) - 1));
+
+			Header* header = reinterpret_cast<Header*>(memory) - 1;
+			header->size = arg_size;
+			header->offset = static_cast<uint32_t>(memory - block);
+			header->tag = arg_tag;
+			count(arg_tag, arg_size);
+
+#if NG_MEMORY_TRACKING > 1
+			header->depth = 0;
+			if (!s_capturing) {
+				s_capturing = true;
+#ifdef NG_PLATFORM_WINDOWS
+				header->depth = CaptureStackBackTrace(2, MemoryTracker::s_callstackDepth, header->callstack, nullptr);
+#else
+				void* frames[MemoryTracker::s_callstackDepth + 2]; //!< The first two are this and operator new
+				int depth = backtrace(frames, MemoryTracker::s_callstackDepth + 2);
+				header->depth = depth > 2 ? static_cast<uint32_t>(depth - 2) : 0;
+				memcpy(header->callstack, frames + 2, sizeof(void*) * header->depth);
+#endif
+				s_capturing = false;
+			}
+			header->sequence = s_sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+			header->previous = nullptr;
+			lockLive();
+			header->next = s_live;
+			if (s_live) s_live->previous = header;
+			s_live = header;
+			unlockLive();
+#endif
+			return memory;
+		}
+
+		void trackedRelease(void* arg_memory)
+		{
+			if (!arg_memory) return;
+			Header* header = static_cast<Header*>(arg_memory) - 1;
+			uncount(header->tag, header->size);
+
+#if NG_MEMORY_TRACKING > 1
+			lockLive();
+			if (header->previous) header->previous->next = header->next;
+			else s_live = header->next;
+			if (header->next) header->next->previous = header->previous;
+			unlockLive();
+#endif
+			std::free(static_cast<unsigned char*>(arg_memory) - header->offset);
+		}
+
+		/**\ Adds up every thread's counts for a tag, or for all of them with the tag count */
+		MemoryStats sumStats(uint32_t arg_tag)
+		{
+			uint32_t first = arg_tag < MemoryTracker::s_tagCount ? arg_tag : 0;
+			uint32_t last = arg_tag < MemoryTracker::s_tagCount ? arg_tag + 1 : MemoryTracker::s_tagCount;
+			uint32_t slots = std::min(s_slotsUsed.load(std::memory_order_relaxed), s_slotCount);
+
+			int64_t live = 0;
+			uint64_t releases = 0;
+			MemoryStats stats;
+			auto addSlot = [&](const ThreadCounters& arg_counters) {
+				for (uint32_t tag = first; tag < last; tag++) {
+					live += arg_counters.liveBytes[tag].load(std::memory_order_relaxed);
+					stats.allocations += arg_counters.allocations[tag].load(std::memory_order_relaxed);
+					releases += arg_counters.releases[tag].load(std::memory_order_relaxed);
+				}
+			};
+			for (uint32_t slot = 0; slot < slots; slot++) addSlot(s_slots[slot]);
+			addSlot(s_slots[s_overflowSlot]);
+
+			stats.liveBytes = live > 0 ? static_cast<uint64_t>(live) : 0;
+			stats.liveAllocations = stats.allocations > releases ? stats.allocations - releases : 0;
+
+			TagHistory& history = s_history[arg_tag];
+			history.peakBytes = std::max(history.peakBytes, stats.liveBytes);
+			stats.peakBytes = history.peakBytes;
+			stats.frameAllocations = history.lastFrame;
+			return stats;
+		}
+	}
+
+	const char* MemoryTracker::getTagName(MemoryTag arg_tag)
+	{
+		switch (arg_tag)
+		{
+		case MemoryTag::General: return "General";
+		case MemoryTag::Rendering: return "Rendering";
+		case MemoryTag::Physics: return "Physics";
+		case MemoryTag::Fonts: return "Fonts";
+		case MemoryTag::Assets: return "Assets";
+		case MemoryTag::Events: return "Events";
+		case MemoryTag::Logging: return "Logging";
+		case MemoryTag::Scene: return "Scene";
+		default: return "Unknown";
+		}
+	}
+
+	MemoryTag MemoryTracker::getTag() { return s_tag; }
+
+	MemoryTag MemoryTracker::setTag(MemoryTag arg_tag)
+	{
+		MemoryTag previous = s_tag;
+		s_tag = arg_tag;
+		return previous;
+	}
+
+	void* MemoryTracker::allocate(size_t arg_size, MemoryTag arg_tag, size_t arg_alignment)
+	{
+#if NG_MEMORY_TRACKING > 0
+		return trackedAllocate(arg_size, arg_alignment, arg_tag);
+#else
+		return std::malloc(arg_size);
+#endif
+	}
+
+	void* MemoryTracker::reallocate(void* arg_memory, size_t arg_size)
+	{
+#if NG_MEMORY_TRACKING > 0
+		if (!arg_memory) return trackedAllocate(arg_size, alignof(std::max_align_t), s_tag);
+		Header* header = static_cast<Header*>(arg_memory) - 1;
+		void* memory = trackedAllocate(arg_size, alignof(std::max_align_t), header->tag);
+		if (memory) {
+			memcpy(memory, arg_memory, header->size < arg_size ? header->size : arg_size);
+			trackedRelease(arg_memory);
+		}
+		return memory;
+#else
+		return std::realloc(arg_memory, arg_size);
+#endif
+	}
+
+	void MemoryTracker::release(void* arg_memory)
+	{
+#if NG_MEMORY_TRACKING > 0
+		trackedRelease(arg_memory);
+#else
+		std::free(arg_memory);
+#endif
+	}
+
+	void MemoryTracker::beginFrame()
+	{
+		for (uint32_t tag = 0; tag <= s_tagCount; tag++) {
+			uint64_t allocations = sumStats(tag).allocations; //!< Samples the peak too
+			TagHistory& history = s_history[tag];
+			history.lastFrame = allocations - history.frameStart;
+			history.frameStart = allocations;
+		}
+	}
+
+	MemoryStats MemoryTracker::getStats(MemoryTag arg_tag) { return sumStats(static_cast<uint32_t>(arg_tag)); }
+	MemoryStats MemoryTracker::getTotal() { return sumStats(s_tagCount); }
+
+	uint64_t MemoryTracker::getAllocationCount()
+	{
+		uint64_t allocations = 0;
+		uint32_t slots = std::min(s_slotsUsed.load(std::memory_order_relaxed), s_slotCount);
+		for (uint32_t slot = 0; slot < slots; slot++) {
+			for (auto& count : s_slots[slot].allocations) allocations += count.load(std::memory_order_relaxed);
+		}
+		for (auto& count : s_slots[s_overflowSlot].allocations) allocations += count.load(std::memory_order_relaxed);
+		return allocations;
+	}
+
+	void MemoryTracker::markLeakCheck()
+	{
+#if NG_MEMORY_TRACKING > 1
+		s_leakMark = s_sequence.load();
+#endif
+	}
+
+	uint32_t MemoryTracker::reportLeaks(uint32_t arg_maxListed)
+	{
+#if NG_MEMORY_TRACKING > 1
+		struct Leak
+		{
+			uint64_t size;
+			MemoryTag tag;
+			uint32_t depth;
+			void* callstack[s_callstackDepth];
+		};
+		/**\ Made before the list is locked, as allocating takes the lock. Anything from here on isn't a leak */
+		uint64_t end = s_sequence.load();
+		std::vector<Leak> listed;
+		listed.reserve(arg_maxListed);
+		uint32_t leakCount = 0;
+		uint64_t leakBytes[s_tagCount] = {};
+
+		lockLive();
+		for (Header* header = s_live; header; header = header->next) {
+			if (header->sequence <= s_leakMark || header->sequence > end) continue;
+			leakCount++;
+			leakBytes[static_cast<uint32_t>(header->tag)] += header->size;
+			if (listed.size() < arg_maxListed) {
+				Leak leak{ header->size, header->tag, header->depth, {} };
+				memcpy(leak.callstack, header->callstack, sizeof(void*) * header->depth);
+				listed.push_back(leak);
+			}
+		}
+		unlockLive();
+
+		if (!leakCount || !logging::isRunning()) return leakCount;
+		LOG_WARN("Memory leaks: {0} allocations still live", leakCount);
+		for (uint32_t tag = 0; tag < s_tagCount; tag++) {
+			if (leakBytes[tag]) LOG_WARN("  {0}: {1} bytes", getTagName(static_cast<MemoryTag>(tag)), leakBytes[tag]);
+		}
+
+#ifdef NG_PLATFORM_WINDOWS
+		HANDLE process = GetCurrentProcess();
+		SymSetOptions(SYMOPT_LOAD_LINES | SYMOPT_UNDNAME);
+		SymInitialize(process, nullptr, TRUE);
+#endif
+		for (auto& leak : listed) {
+			LOG_WARN("{0} bytes ({1}) allocated at:", leak.size, getTagName(leak.tag));
+#ifdef NG_PLATFORM_WINDOWS
+			alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + 256];
+			SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+			for (uint32_t frame = 0; frame < leak.depth; frame++) {
+				memset(buffer, 0, sizeof(buffer));
+				symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+				symbol->MaxNameLen = 255;
+				DWORD64 address = reinterpret_cast<DWORD64>(leak.callstack[frame]);
+				IMAGEHLP_LINE64 line = { sizeof(IMAGEHLP_LINE64) };
+				DWORD displacement = 0;
+				if (!SymFromAddr(process, address, nullptr, symbol)) LOG_WARN("    {0}", leak.callstack[frame]);
+				else if (SymGetLineFromAddr64(process, address, &displacement, &line)) LOG_WARN("    {0} {1}:{2}", symbol->Name, line.FileName, line.LineNumber);
+				else LOG_WARN("    {0}", symbol->Name);
+			}
+#else
+			char** symbols = backtrace_symbols(leak.callstack, static_cast<int>(leak.depth));
+			for (uint32_t frame = 0; frame < leak.depth; frame++) LOG_WARN("    {0}", symbols ? symbols[frame] : "?");
+			std::free(symbols);
+#endif
+		}
+#ifdef NG_PLATFORM_WINDOWS
+		SymCleanup(process);
+#endif
+		if (leakCount > listed.size()) LOG_WARN("...and {0} more", leakCount - listed.size());
+		return leakCount;
+#else
+		return 0;
+#endif
+	}
+}
+
+#if NG_MEMORY_TRACKING > 0
+/**\ Every form of new and delete goes through the tracker. The array and nothrow forms are spelled out too,
+*	 as not every standard library routes them through the plain ones
+*/
+void* operator new(size_t arg_size)
+{
+	if (void* memory = Engine::trackedAllocate(arg_size, alignof(std::max_align_t), Engine::s_tag)) return memory;
+	throw std::bad_alloc();
+}
+void* operator new[](size_t arg_size) { return operator new(arg_size); }
+void* operator new(size_t arg_size, const std::nothrow_t&) noexcept { return Engine::trackedAllocate(arg_size, alignof(std::max_align_t), Engine::s_tag); }
+void* operator new[](size_t arg_size, const std::nothrow_t&) noexcept { return Engine::trackedAllocate(arg_size, alignof(std::max_align_t), Engine::s_tag); }
+void* operator new(size_t arg_size, std::align_val_t arg_alignment)
+{
+	if (void* memory = Engine::trackedAllocate(arg_size, static_cast<size_t>(arg_alignment), Engine::s_tag)) return memory;
+	throw std::bad_alloc();
+}
+void* operator new[](size_t arg_size, std::align_val_t arg_alignment) { return operator new(arg_size, arg_alignment); }
+void* operator new(size_t arg_size, std::align_val_t arg_alignment, const std::nothrow_t&) noexcept { return Engine::trackedAllocate(arg_size, static_cast<size_t>(arg_alignment), Engine::s_tag); }
+void* operator new[](size_t arg_size, std::align_val_t arg_alignment, const std::nothrow_t&) noexcept { return Engine::trackedAllocate(arg_size, static_cast<size_t>(arg_alignment), Engine::s_tag); }
+
+void operator delete(void* arg_memory) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete[](void* arg_memory) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete(void* arg_memory, size_t) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete[](void* arg_memory, size_t) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete(void* arg_memory, const std::nothrow_t&) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete[](void* arg_memory, const std::nothrow_t&) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete(void* arg_memory, std::align_val_t) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete[](void* arg_memory, std::align_val_t) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete(void* arg_memory, size_t, std::align_val_t) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete[](void* arg_memory, size_t, std::align_val_t) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete(void* arg_memory, std::align_val_t, const std::nothrow_t&) noexcept { Engine::trackedRelease(arg_memory); }
+void operator delete[](void* arg_memory, std::align_val_t, const std::nothrow_t&) noexcept { Engine::trackedRelease(arg_memory); }
+#endif
@@ -0,0 +1,88 @@
+/** \file powerPolicy.cpp
+*/
+#include "engine_pch.h"
+#include "systems/powerPolicy.h"
+
+namespace Engine {
+	PowerPolicy::PowerPolicy(const PowerSettings& arg_settings) : m_settings(arg_settings)
+	{
+	}
+
+	void PowerPolicy::addHandlers(EventDispatchTable& arg_table)
+	{
+		arg_table.add<&PowerPolicy::onWindowFocus>(this);
+		arg_table.add<&PowerPolicy::onWindowLostFocus>(this);
+		arg_table.add<&PowerPolicy::onWindowResize>(this);
+
+		/**\ Input might change what is drawn, which only matters on demand */
+		arg_table.add<&PowerPolicy::onInput<KeyPressedEvent>>(this);
+		arg_table.add<&PowerPolicy::onInput<KeyReleasedEvent>>(this);
+		arg_table.add<&PowerPolicy::onInput<MouseButtonPressedEvent>>(this);
+		arg_table.add<&PowerPolicy::onInput<MouseButtonReleasedEvent>>(this);
+		arg_table.add<&PowerPolicy::onInput<MouseMovedEvent>>(this);
+		arg_table.add<&PowerPolicy::onInput<MouseScrolledEvent>>(this);
+	}
+
+	FramePlan PowerPolicy::beginFrame()
+	{
+		PowerState state = getState();
+		FramePlan plan;
+		plan.changed = m_changed || state != m_lastState;
+		m_changed = false;
+		m_lastState = state;
+
+		switch (state) {
+		case PowerState::Active:
+			plan.frameRate = m_settings.activeRate;
+			plan.render = !m_settings.onDemand || m_dirty;
+			break;
+		case PowerState::Background:
+			plan.frameRate = m_settings.backgroundRate;
+			plan.render = !m_settings.onDemand || m_dirty;
+			break;
+		case PowerState::Minimized:
+			plan.render = false; //!< Dirty is kept for when the window comes back
+			break;
+		}
+
+		if (plan.render) m_dirty = false;
+		else {
+			plan.waitTime = m_settings.waitTime;
+			m_skipped++;
+		}
+		return plan;
+	}
+
+	void PowerPolicy::setSettings(const PowerSettings& arg_settings)
+	{
+		m_settings = arg_settings;
+		m_changed = true;
+		m_dirty = true;
+	}
+
+	PowerState PowerPolicy::getState() const
+	{
+		if (m_minimized) return PowerState::Minimized;
+		return m_focused ? PowerState::Active : PowerState::Background;
+	}
+
+	bool PowerPolicy::onWindowFocus(WindowFocusEvent& e)
+	{
+		m_focused = true;
+		m_dirty = true;
+		return false;
+	}
+
+	bool PowerPolicy::onWindowLostFocus(WindowLostFocusEvent& e)
+	{
+		m_focused = false;
+		return false;
+	}
+
+	bool PowerPolicy::onWindowResize(WindowResizeEvent& e)
+	{
+		m_minimized = e.getWidth() <= 0 || e.getHeight() <= 0; //!< What minimising sends
+		m_dirty = true;
+		return false;
+	}
+}
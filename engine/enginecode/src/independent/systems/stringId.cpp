@@ -0,0 +1,62 @@
+/** \file stringId.cpp
+*/
+#include "engine_pch.h"
+#include "systems/stringId.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "systems/logging.h"
+
+namespace Engine {
+#if NG_STRING_TABLE
+	namespace {
+		std::mutex s_tableMutex; //!< Guards the table and count
+		std::unordered_map<uint64_t, std::string> s_table; //!< Hash to text. Never shrinks, so the text pointers stay valid
+		uint32_t s_collisions = 0;
+	}
+#endif
+
+	StringId StringId::intern(std::string_view arg_text)
+	{
+		StringId id(arg_text);
+#if NG_STRING_TABLE
+		std::lock_guard<std::mutex> lock(s_tableMutex);
+		auto entry = s_table.try_emplace(id.m_hash, arg_text);
+		if (!entry.second && entry.first->second != arg_text) {
+			s_collisions++;
+			LOG_ERROR("StringId collision: \"{0}\" and \"{1}\" both hash to {2:x}", entry.first->second, std::string(arg_text), id.m_hash);
+		}
+#endif
+		return id;
+	}
+
+	uint32_t StringId::getCollisionCount()
+	{
+#if NG_STRING_TABLE
+		std::lock_guard<std::mutex> lock(s_tableMutex);
+		return s_collisions;
+#else
+		return 0;
+#endif
+	}
+
+	void StringId::clearTable()
+	{
+#if NG_STRING_TABLE
+		std::lock_guard<std::mutex> lock(s_tableMutex);
+		std::unordered_map<uint64_t, std::string>().swap(s_table); //!< Swapped rather than cleared, so the buckets go too
+#endif
+	}
+
+	const char* StringId::getText() const
+	{
+#if NG_STRING_TABLE
+		std::lock_guard<std::mutex> lock(s_tableMutex);
+		auto entry = s_table.find(m_hash);
+		if (entry != s_table.end()) return entry->second.c_str();
+#endif
+		return "?";
+	}
+}
@@ -0,0 +1,151 @@
+/** \file task.cpp
+*/
+#include "engine_pch.h"
+#include "systems/task.h"
+
+#include <fstream>
+#include <iterator>
+
+#include "systems/deferredScheduler.h"
+#include "systems/jobSystem.h"
+#include "systems/logging.h"
+#include "systems/memoryTracker.h"
+
+namespace Engine {
+	namespace {
+		constexpr uint32_t s_blocksPerChunk = 64; //!< Blocks of one size grown at a time
+
+		/**\ A free block holds the link to the next */
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		std::mutex s_poolMutex; //!< Guards everything below
+		FreeBlock* s_free[TaskPool::s_classCount] = {}; //!< By size class
+		std::vector<void*> s_chunks;
+		size_t s_capacity = 0;
+		uint32_t s_live = 0;
+	}
+
+	DeferredScheduler* Tasks::s_main = nullptr;
+	DeferredScheduler* Tasks::s_render = nullptr;
+	std::atomic<bool> Tasks::s_inline = false;
+
+	void* TaskPool::allocate(size_t arg_size)
+	{
+		size_t index = (arg_size + s_blockSize - 1) / s_blockSize - 1;
+		if (arg_size == 0 || index >= s_classCount) return MemoryTracker::allocate(arg_size, MemoryTag::Assets, s_blockSize);
+
+		std::lock_guard<std::mutex> lock(s_poolMutex);
+		if (!s_free[index]) {
+			size_t blockSize = (index + 1) * s_blockSize;
+			char* chunk = static_cast<char*>(MemoryTracker::allocate(blockSize * s_blocksPerChunk, MemoryTag::Assets, s_blockSize));
+			if (!chunk) return nullptr;
+			s_chunks.push_back(chunk);
+			s_capacity += blockSize * s_blocksPerChunk;
+			for (uint32_t i = s_blocksPerChunk; i > 0; i--) {
+				FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+				block->next = s_free[index];
+				s_free[index] = block;
+			}
+		}
+
+		FreeBlock* block = s_free[index];
+		s_free[index] = block->next;
+		s_live++;
+		return block;
+	}
+
+	void TaskPool::release(void* arg_memory, size_t arg_size)
+	{
+		size_t index = (arg_size + s_blockSize - 1) / s_blockSize - 1;
+		if (arg_size == 0 || index >= s_classCount) {
+			MemoryTracker::release(arg_memory);
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(s_poolMutex);
+		FreeBlock* block = static_cast<FreeBlock*>(arg_memory);
+		block->next = s_free[index];
+		s_free[index] = block;
+		s_live--;
+	}
+
+	bool TaskPool::trim()
+	{
+		std::lock_guard<std::mutex> lock(s_poolMutex);
+		if (s_live) return false;
+
+		for (void* chunk : s_chunks) MemoryTracker::release(chunk);
+		s_chunks.clear();
+		s_chunks.shrink_to_fit();
+		for (FreeBlock*& list : s_free) list = nullptr;
+		s_capacity = 0;
+		return true;
+	}
+
+	uint32_t TaskPool::getLiveCount()
+	{
+		std::lock_guard<std::mutex> lock(s_poolMutex);
+		return s_live;
+	}
+
+	size_t TaskPool::getCapacity()
+	{
+		std::lock_guard<std::mutex> lock(s_poolMutex);
+		return s_capacity;
+	}
+
+	void Tasks::setQueues(DeferredScheduler* arg_main, DeferredScheduler* arg_render)
+	{
+		s_main = arg_main;
+		s_render = arg_render;
+	}
+
+	void Tasks::setInline(bool arg_inline)
+	{
+		s_inline.store(arg_inline, std::memory_order_relaxed);
+	}
+
+	void Tasks::post(TaskThread arg_thread, std::function<void()>&& arg_step)
+	{
+		DeferredScheduler* queue = nullptr;
+		switch (arg_thread) {
+		case TaskThread::Worker:
+			jobSystem::run(arg_step); //!< Inline when the job system isn't running
+			return;
+		case TaskThread::Main:
+			queue = s_main;
+			break;
+		case TaskThread::Render:
+			queue = s_render;
+			break;
+		}
+
+		if (queue) queue->post(std::move(arg_step), WorkPriority::High); //!< Something is waiting on every step
+		else if (s_inline.load(std::memory_order_relaxed)) arg_step();
+		else LOG_ERROR("A {0} task step was posted with no queue set, it is dropped", arg_thread == TaskThread::Main ? "main" : "render");
+	}
+
+	Task<std::vector<unsigned char>> Tasks::readFile(const std::string& arg_path)
+	{
+		using State = TaskState<std::vector<unsigned char>>;
+		auto state = makeState<std::vector<unsigned char>>(std::make_shared<std::atomic<bool>>(false));
+		post(TaskThread::Worker, [state, arg_path]() {
+			if (state->isCancelRequested()) {
+				state->finish(State::Status::Cancelled);
+				return;
+			}
+
+			std::ifstream file(arg_path, std::ios::binary);
+			if (!file) {
+				LOG_ERROR("Could not read {0}", arg_path);
+				state->finish(State::Status::Cancelled);
+				return;
+			}
+			state->finish(State::Status::Done, std::vector<unsigned char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+		});
+		return Task<std::vector<unsigned char>>(state);
+	}
+}
@@ -2,8 +2,9 @@
 #include "systems/timer.h"
 
 namespace Engine {
-	std::chrono::high_resolution_clock::time_point timer::m_frameStart;
-	std::chrono::high_resolution_clock::time_point timer::m_markerStart;
+	timer::Clock timer::s_clock = nullptr;
+	uint64_t timer::m_frameStart = 0;
+	uint64_t timer::m_markerStart = 0;
 	
 	timer::timer()
 	{
@@ -25,24 +26,27 @@ namespace Engine {
 
 	void timer::startFrameTimer()
 	{
-		m_frameStart = std::chrono::high_resolution_clock::now();
+		m_frameStart = now();
 	}
 
 	float timer::getFrameTime()
 	{
-		std::chrono::duration<float> timePassed = std::chrono::high_resolution_clock::now() - m_frameStart;
-		return timePassed.count();
+		return static_cast<float>(getFrameTimeNanoseconds() * 1e-9);
+	}
+
+	uint64_t timer::getFrameTimeNanoseconds()
+	{
+		return now() - m_frameStart;
 	}
 
 	void timer::startMarkerTimer()
 	{
-		m_markerStart = std::chrono::high_resolution_clock::now();
+		m_markerStart = now();
 	}
 
 	float timer::getMarkerTimer()
 	{
-		std::chrono::duration<float> timePassed = std::chrono::high_resolution_clock::now() - m_markerStart;
-		return timePassed.count();
+		return static_cast<float>((now() - m_markerStart) * 1e-9);
 	}
 
 	/*float timer::getTimeSeconds()
@@ -0,0 +1,98 @@
+/** \file benchmark.h
+*	A small timing harness for the engine benchmarks.
+*	BENCHMARK(name) registers a function and main runs every registered benchmark, or only those containing argv[1].
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <initializer_list>
+
+namespace Bench {
+
+	/**\ Class State
+	*	 Passed to every benchmark. The timed part is the body of a while (state.keepRunning()) loop
+	*/
+	class State
+	{
+	public:
+		State(int64_t arg_arg, double arg_minSeconds) : m_arg(arg_arg), m_minSeconds(arg_minSeconds) {}
+
+		/**\ Returns true until the loop has run for at least the minimum time */
+		inline bool keepRunning()
+		{
+			auto now = std::chrono::steady_clock::now();
+			if (m_iterations == 0) m_start = now;
+			m_elapsed = std::chrono::duration<double>(now - m_start).count();
+			if (m_elapsed >= m_minSeconds && m_iterations > 0) return false;
+			m_iterations++;
+			return true;
+		}
+
+		inline int64_t getArg() const { return m_arg; } //!< Argument for benchmarks registered with BENCHMARK_ARGS
+		inline void setItemsPerIteration(uint64_t arg_items) { m_items = arg_items; } //!< Reported as items per second
+		inline void setBytesPerIteration(uint64_t arg_bytes) { m_bytes = arg_bytes; } //!< Reported as MB per second
+		inline void setLabel(const std::string& arg_label) { m_label = arg_label; } //!< Extra text printed after the timings
+		inline void fail(const std::string& arg_reason) { m_failed = true; m_label = arg_reason; } //!< Marks the run as failed, main returns non zero
+
+		inline uint64_t getIterations() const { return m_iterations; }
+		inline double getSeconds() const { return m_elapsed; }
+		inline uint64_t getItems() const { return m_items; }
+		inline uint64_t getBytes() const { return m_bytes; }
+		inline const std::string& getLabel() const { return m_label; }
+		inline bool failed() const { return m_failed; }
+	private:
+		int64_t m_arg;
+		double m_minSeconds;
+		uint64_t m_iterations = 0;
+		double m_elapsed = 0.0;
+		uint64_t m_items = 0;
+		uint64_t m_bytes = 0;
+		bool m_failed = false;
+		std::string m_label;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	using BenchmarkFunc = void(*)(State&);
+
+	struct Benchmark
+	{
+		const char* name;
+		BenchmarkFunc func;
+		std::vector<int64_t> args; //!< One run per argument, or a single run with 0
+	};
+
+	inline std::vector<Benchmark>& getRegistry() { static std::vector<Benchmark> registry; return registry; }
+
+	struct Registrar
+	{
+		Registrar(const char* arg_name, BenchmarkFunc arg_func, std::initializer_list<int64_t> arg_args = {}) { getRegistry().push_back({ arg_name, arg_func, arg_args }); }
+	};
+
+	/**\ Stops the optimiser from removing a computation whose result is otherwise unused */
+	template <typename T>
+	inline void doNotOptimize(const T& arg_value)
+	{
+#if defined(_MSC_VER)
+		static const void* volatile s_sink;
+		s_sink = &arg_value;
+#else
+		asm volatile("" : : "r,m"(arg_value) : "memory");
+#endif
+	}
+
+	int runAll(const char* arg_filter, double arg_minSeconds); //!< Runs the registered benchmarks and prints one line each. Returns the number of failures
+}
+
+#define BENCHMARK(name) \
+	static void name(Bench::State& state); \
+	static Bench::Registrar name##_registrar(#name, name); \
+	static void name(Bench::State& state)
+
+#define BENCHMARK_ARGS(name, ...) \
+	static void name(Bench::State& state); \
+	static Bench::Registrar name##_registrar(#name, name, { __VA_ARGS__ }); \
+	static void name(Bench::State& state)
@@ -0,0 +1,84 @@
+/**\ file drawListBenchmark.cpp
+*	 Draw submission across threads into per thread lists, and the merge at endScene
+*/
+#include "benchmark.h"
+#include "systems/jobSystem.h"
+#include "rendering/drawList.h"
+#include "rendering/renderer3D.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+	const uint32_t s_drawCount = 128 * 1024;
+
+	/**\ Geometry that is never drawn, only pointed at */
+	class BenchVertexArray : public Engine::VertexArray
+	{
+	public:
+		void addVertexBuffer(const std::shared_ptr<Engine::VertexBuffer>& vertexBuffer) override {}
+		void setIndexBuffer(const std::shared_ptr<Engine::IndexBuffer>& indexBuffer) override {}
+		uint32_t getID() const override { return 0; }
+		uint32_t getDrawCount() const override { return 0; }
+		std::shared_ptr<Engine::IndexBuffer> getIndexBuffer() const override { return nullptr; }
+	};
+
+	/**\ Fills a list with its share of the draws, as a job per region would */
+	void fillList(Engine::DrawList& arg_list, Engine::VertexArray& arg_geometry, Engine::Material& arg_material, uint32_t arg_begin, uint32_t arg_end)
+	{
+		arg_list.begin();
+		for (uint32_t i = arg_begin; i < arg_end; i++) {
+			glm::mat4 model(1.f);
+			model[3] = glm::vec4(static_cast<float>(i), 0.f, -6.f, 1.f);
+			arg_list.submit(arg_geometry, arg_material, model, i & 7);
+		}
+	}
+}
+
+/**\ One list per worker, items/s should scale with the argument up to the core count */
+BENCHMARK_ARGS(DrawList_SubmitScaling, 1, 2, 4, 8)
+{
+	uint32_t threads = static_cast<uint32_t>(state.getArg());
+	Engine::jobSystem jobs(threads);
+	jobs.start();
+
+	BenchVertexArray geometry;
+	Engine::Material material(std::shared_ptr<Engine::Shader>(nullptr));
+	std::vector<std::unique_ptr<Engine::DrawList>> lists;
+	for (uint32_t i = 0; i < threads; i++) lists.emplace_back(new Engine::DrawList(i));
+
+	uint32_t share = s_drawCount / threads;
+	while (state.keepRunning()) {
+		Engine::JobCounter counter;
+		for (uint32_t i = 0; i < threads; i++) {
+			Engine::jobSystem::run([&, i]() { fillList(*lists[i], geometry, material, i * share, (i + 1) * share); }, &counter);
+		}
+		Engine::jobSystem::wait(counter);
+		Bench::doNotOptimize(lists[0]->getCount());
+	}
+	state.setItemsPerIteration(share * threads);
+	jobs.stop();
+}
+
+/**\ Merging four lists into one sorted stream, the render thread's share of the work */
+BENCHMARK(DrawList_Merge)
+{
+	BenchVertexArray geometry;
+	Engine::Material material(std::shared_ptr<Engine::Shader>(nullptr));
+	std::vector<std::unique_ptr<Engine::DrawList>> lists;
+	uint32_t share = s_drawCount / 4;
+	for (uint32_t i = 0; i < 4; i++) {
+		lists.emplace_back(new Engine::DrawList(3 - i));
+		fillList(*lists[i], geometry, material, i * share, (i + 1) * share);
+	}
+
+	Engine::DrawQueue queue;
+	while (state.keepRunning()) {
+		for (auto& list : lists) queue.add(list->getItems(), list->getListKey());
+		queue.sort();
+		Bench::doNotOptimize(queue.getItems().data());
+		queue.clear();
+	}
+	state.setItemsPerIteration(s_drawCount);
+}
@@ -0,0 +1,259 @@
+/**\ file dynamicBVHBenchmark.cpp
+*	 Keeping a tree over 100,000 moving boxes up to date, and the queries run on it, against brute force where there is one
+*/
+#include "benchmark.h"
+#include "physics/dynamicBVH.h"
+#include "physics/intersection.h"
+#include "systems/jobSystem.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <vector>
+
+namespace
+{
+	const uint32_t s_objectCount = 100000;
+	const float s_worldSize = 1000.f;
+
+	using Engine::AABB;
+	using Engine::Ray;
+
+	/**\ Same numbers every run */
+	struct Random
+	{
+		uint32_t seed = 12345;
+		float next() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) * (1.f / 16777216.f); }
+		glm::vec3 point() { return glm::vec3(next(), next(), next()) * s_worldSize; }
+	};
+
+	std::vector<AABB> makeBoxes(Random& arg_random)
+	{
+		std::vector<AABB> boxes;
+		for (uint32_t i = 0; i < s_objectCount; i++) {
+			glm::vec3 centre = arg_random.point();
+			glm::vec3 extents = glm::vec3(0.5f + arg_random.next() * 2.f);
+			boxes.push_back(AABB(centre - extents, centre + extents));
+		}
+		return boxes;
+	}
+
+	void fillTree(Engine::DynamicBVH& arg_tree, const std::vector<AABB>& arg_boxes, std::vector<Engine::DynamicBVH::Proxy>& arg_proxies)
+	{
+		for (uint32_t i = 0; i < arg_boxes.size(); i++) arg_proxies.push_back(arg_tree.insert(arg_boxes[i], i));
+		arg_tree.rebuild();
+	}
+
+	Engine::Frustum makeCamera()
+	{
+		glm::mat4 view = glm::lookAt(glm::vec3(500.f, 500.f, -50.f), glm::vec3(500.f, 500.f, 500.f), glm::vec3(0.f, 1.f, 0.f));
+		return Engine::Frustum::fromMatrix(glm::perspective(glm::radians(45.f), 1024.f / 800.f, 0.1f, 400.f) * view);
+	}
+
+	/**\ Every box nudged along by a little, like a frame of movement */
+	void nudge(std::vector<AABB>& arg_boxes, float arg_amount)
+	{
+		for (uint32_t i = 0; i < arg_boxes.size(); i++) {
+			glm::vec3 offset(arg_amount * ((i & 1) ? 1.f : -1.f), 0.f, arg_amount * ((i & 2) ? 1.f : -1.f));
+			arg_boxes[i] = AABB(arg_boxes[i].min + offset, arg_boxes[i].max + offset);
+		}
+	}
+}
+
+/**\ From scratch every frame, the top levels spread over the job system */
+BENCHMARK_ARGS(BVH_Rebuild, 1, 2, 4)
+{
+	Engine::jobSystem jobs(static_cast<uint32_t>(state.getArg()));
+	jobs.start();
+	{
+		Random random;
+		std::vector<AABB> boxes = makeBoxes(random);
+		std::vector<Engine::DynamicBVH::Proxy> proxies;
+		Engine::DynamicBVH tree;
+		fillTree(tree, boxes, proxies);
+
+		while (state.keepRunning()) {
+			tree.rebuild();
+			Bench::doNotOptimize(tree);
+		}
+	}
+	jobs.stop();
+	state.setItemsPerIteration(s_objectCount);
+}
+
+/**\ Everything moves every frame: leaves grown in place and one pass over the parents */
+BENCHMARK(BVH_AllMoving_Refit)
+{
+	Random random;
+	std::vector<AABB> boxes = makeBoxes(random);
+	std::vector<Engine::DynamicBVH::Proxy> proxies;
+	Engine::DynamicBVH tree;
+	fillTree(tree, boxes, proxies);
+
+	while (state.keepRunning()) {
+		nudge(boxes, 0.05f);
+		for (uint32_t i = 0; i < s_objectCount; i++) tree.setBox(proxies[i], boxes[i]);
+		tree.refit();
+		Bench::doNotOptimize(tree);
+	}
+	Bench::doNotOptimize(tree.getRebuildCount());
+	state.setItemsPerIteration(s_objectCount);
+}
+
+/**\ The same movement through move(), reinserting whatever leaves its margin */
+BENCHMARK(BVH_AllMoving_Reinsert)
+{
+	Random random;
+	std::vector<AABB> boxes = makeBoxes(random);
+	std::vector<Engine::DynamicBVH::Proxy> proxies;
+	Engine::DynamicBVH tree;
+	fillTree(tree, boxes, proxies);
+
+	while (state.keepRunning()) {
+		nudge(boxes, 0.05f);
+		for (uint32_t i = 0; i < s_objectCount; i++) tree.move(proxies[i], boxes[i]);
+		Bench::doNotOptimize(tree);
+	}
+	state.setItemsPerIteration(s_objectCount);
+}
+
+/**\ Baseline for culling, every box against the six planes */
+BENCHMARK(BVH_Frustum_BruteForce)
+{
+	Random random;
+	std::vector<AABB> boxes = makeBoxes(random);
+	Engine::Frustum frustum = makeCamera();
+	std::vector<uint64_t> visible;
+
+	while (state.keepRunning()) {
+		visible.clear();
+		for (uint32_t i = 0; i < s_objectCount; i++) {
+			if (frustum.test(boxes[i]) != Engine::Frustum::Result::Outside) visible.push_back(i);
+		}
+		Bench::doNotOptimize(visible.size());
+	}
+	state.setItemsPerIteration(s_objectCount);
+}
+
+BENCHMARK(BVH_Frustum_Tree)
+{
+	Random random;
+	std::vector<AABB> boxes = makeBoxes(random);
+	std::vector<Engine::DynamicBVH::Proxy> proxies;
+	Engine::DynamicBVH tree;
+	fillTree(tree, boxes, proxies);
+	Engine::Frustum frustum = makeCamera();
+	std::vector<uint64_t> visible;
+
+	while (state.keepRunning()) {
+		visible.clear();
+		tree.queryFrustum(frustum, visible);
+		Bench::doNotOptimize(visible.size());
+	}
+	state.setItemsPerIteration(s_objectCount);
+}
+
+/**\ Picking rays from random points, closest box */
+BENCHMARK(BVH_Raycast)
+{
+	Random random;
+	std::vector<AABB> boxes = makeBoxes(random);
+	std::vector<Engine::DynamicBVH::Proxy> proxies;
+	Engine::DynamicBVH tree;
+	fillTree(tree, boxes, proxies);
+	std::vector<Ray> rays;
+	for (int i = 0; i < 1000; i++) rays.push_back(Ray(random.point(), glm::normalize(random.point() - glm::vec3(s_worldSize * 0.5f))));
+
+	while (state.keepRunning()) {
+		for (const Ray& ray : rays) Bench::doNotOptimize(tree.raycast(ray, s_worldSize));
+	}
+	state.setItemsPerIteration(rays.size());
+}
+
+/**\ The same rays as a batch over the job system */
+BENCHMARK_ARGS(BVH_RaycastBatch, 1, 2, 4)
+{
+	Engine::jobSystem jobs(static_cast<uint32_t>(state.getArg()));
+	jobs.start();
+	{
+		Random random;
+		std::vector<AABB> boxes = makeBoxes(random);
+		std::vector<Engine::DynamicBVH::Proxy> proxies;
+		Engine::DynamicBVH tree;
+		fillTree(tree, boxes, proxies);
+		std::vector<Ray> rays;
+		for (int i = 0; i < 1000; i++) rays.push_back(Ray(random.point(), glm::normalize(random.point() - glm::vec3(s_worldSize * 0.5f))));
+		std::vector<Engine::RayHit> hits(rays.size());
+
+		while (state.keepRunning()) {
+			tree.raycastBatch(rays.data(), static_cast<uint32_t>(rays.size()), s_worldSize, hits.data());
+			Bench::doNotOptimize(hits.back());
+		}
+	}
+	jobs.stop();
+	state.setItemsPerIteration(1000);
+}
+
+BENCHMARK(BVH_Sphere)
+{
+	Random random;
+	std::vector<AABB> boxes = makeBoxes(random);
+	std::vector<Engine::DynamicBVH::Proxy> proxies;
+	Engine::DynamicBVH tree;
+	fillTree(tree, boxes, proxies);
+	std::vector<uint64_t> found;
+
+	while (state.keepRunning()) {
+		for (int i = 0; i < 100; i++) {
+			found.clear();
+			tree.querySphere(random.point(), 20.f, found);
+			Bench::doNotOptimize(found.size());
+		}
+	}
+	state.setItemsPerIteration(100);
+}
+
+BENCHMARK(BVH_Nearest8)
+{
+	Random random;
+	std::vector<AABB> boxes = makeBoxes(random);
+	std::vector<Engine::DynamicBVH::Proxy> proxies;
+	Engine::DynamicBVH tree;
+	fillTree(tree, boxes, proxies);
+	std::vector<Engine::NearestHit> nearest;
+
+	while (state.keepRunning()) {
+		for (int i = 0; i < 100; i++) {
+			tree.queryNearest(random.point(), 8, nearest);
+			Bench::doNotOptimize(nearest.front());
+		}
+	}
+	state.setItemsPerIteration(100);
+}
+
+/**\ A 1000 triangle mesh, four at a time against one at a time */
+BENCHMARK_ARGS(Intersection_RayTriangles, 0, 1)
+{
+	Random random;
+	std::vector<float> vertices;
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < 3000; i++) {
+		glm::vec3 point = random.point() * 0.01f;
+		vertices.insert(vertices.end(), { point.x, point.y, point.z });
+		indices.push_back(i);
+	}
+	Ray ray(glm::vec3(5.f, 5.f, -10.f), glm::vec3(0.f, 0.f, 1.f));
+	bool wide = state.getArg() == 1;
+
+	while (state.keepRunning()) {
+		float distance = 100.f;
+		if (wide) Engine::Intersection::rayTriangles(ray, vertices.data(), 3, indices.data(), 1000, distance);
+		else {
+			for (uint32_t t = 0; t < 1000; t++) {
+				const float* v = vertices.data() + t * 9;
+				Engine::Intersection::rayTriangle(ray, glm::vec3(v[0], v[1], v[2]), glm::vec3(v[3], v[4], v[5]), glm::vec3(v[6], v[7], v[8]), distance);
+			}
+		}
+		Bench::doNotOptimize(distance);
+	}
+	state.setItemsPerIteration(1000);
+}
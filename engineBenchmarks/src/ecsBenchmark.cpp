@@ -0,0 +1,139 @@
+/**\ file ecsBenchmark.cpp
+*	 Iterating a million scene objects through the archetype World, against the same data as an array of structs
+*/
+#include "benchmark.h"
+#include "ecs/world.h"
+#include "systems/jobSystem.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+	const uint32_t s_entityCount = 1000000;
+	const float s_step = 1.f / 60.f;
+
+	/**\ A typical scene object held in one struct, 128 bytes, of which the update below uses 24 */
+	struct GameObject
+	{
+		glm::vec3 position;
+		glm::quat rotation;
+		glm::vec3 scale;
+		glm::vec3 velocity;
+		void* geometry;
+		void* material;
+		void* body;
+		uint32_t flags;
+		char name[44];
+	};
+
+	/**\ The same data split into components */
+	struct Position { glm::vec3 value; };
+	struct Velocity { glm::vec3 value; };
+	struct Rotation { glm::quat value; };
+	struct Scale { glm::vec3 value; };
+	struct RenderLink { void* geometry; void* material; };
+	struct BodyLink { void* body; uint32_t flags; };
+	struct Name { char text[44]; };
+
+	void fillWorld(Engine::World& arg_world)
+	{
+		for (uint32_t i = 0; i < s_entityCount; i++) {
+			float f = static_cast<float>(i);
+			arg_world.create(Position{ glm::vec3(f, 0.f, 0.f) }, Velocity{ glm::vec3(1.f, f * 0.001f, 0.f) }, Rotation{ glm::quat(1.f, 0.f, 0.f, 0.f) },
+				Scale{ glm::vec3(1.f) }, RenderLink{ nullptr, nullptr }, BodyLink{ nullptr, 0 }, Name{});
+		}
+	}
+
+	float sumX(Engine::World& arg_world)
+	{
+		float total = 0.f;
+		arg_world.forEach<Position>([&](Position& arg_position) { total += arg_position.value.x; });
+		return total;
+	}
+}
+
+/**\ Baseline, every object's cache lines come through to read 24 bytes */
+BENCHMARK(ECS_Integrate_ArrayOfStructs)
+{
+	std::vector<GameObject> objects(s_entityCount);
+	for (uint32_t i = 0; i < s_entityCount; i++) {
+		float f = static_cast<float>(i);
+		objects[i].position = glm::vec3(f, 0.f, 0.f);
+		objects[i].velocity = glm::vec3(1.f, f * 0.001f, 0.f);
+	}
+
+	while (state.keepRunning()) {
+		for (auto& object : objects) object.position += object.velocity * s_step;
+		Bench::doNotOptimize(objects[s_entityCount / 2].position);
+	}
+	state.setItemsPerIteration(s_entityCount);
+}
+
+/**\ Chunk arrays handed to the loop directly, only the position and velocity arrays are read */
+BENCHMARK(ECS_Integrate_Chunks)
+{
+	Engine::World world;
+	fillWorld(world);
+
+	while (state.keepRunning()) {
+		world.forEachChunk<Position, Velocity>([](uint32_t arg_count, const Engine::Entity* arg_entities, Position* arg_positions, Velocity* arg_velocities) {
+			for (uint32_t i = 0; i < arg_count; i++) arg_positions[i].value += arg_velocities[i].value * s_step;
+		});
+		Bench::doNotOptimize(world);
+	}
+	Bench::doNotOptimize(sumX(world));
+	state.setItemsPerIteration(s_entityCount);
+}
+
+/**\ Per entity callback over the same chunks */
+BENCHMARK(ECS_Integrate_ForEach)
+{
+	Engine::World world;
+	fillWorld(world);
+
+	while (state.keepRunning()) {
+		world.forEach<Position, Velocity>([](Position& arg_position, Velocity& arg_velocity) { arg_position.value += arg_velocity.value * s_step; });
+		Bench::doNotOptimize(world);
+	}
+	Bench::doNotOptimize(sumX(world));
+	state.setItemsPerIteration(s_entityCount);
+}
+
+/**\ Chunks spread over the job system, should scale with the argument up to the core count */
+BENCHMARK_ARGS(ECS_Integrate_Parallel, 1, 2, 4, 8)
+{
+	Engine::jobSystem jobs(static_cast<uint32_t>(state.getArg()));
+	jobs.start();
+	{
+		Engine::World world;
+		fillWorld(world);
+
+		while (state.keepRunning()) {
+			world.parallelForEach<Position, Velocity>([](Position& arg_position, Velocity& arg_velocity) { arg_position.value += arg_velocity.value * s_step; }, 8);
+			Bench::doNotOptimize(world);
+		}
+		Bench::doNotOptimize(sumX(world));
+	}
+	jobs.stop();
+	state.setItemsPerIteration(s_entityCount);
+}
+
+/**\ Structural changes, each add and remove moves the entity to another archetype */
+BENCHMARK(ECS_AddRemoveComponent)
+{
+	const uint32_t count = 100000;
+	Engine::World world;
+	std::vector<Engine::Entity> entities;
+	for (uint32_t i = 0; i < count; i++) entities.push_back(world.create(Position{ glm::vec3(0.f) }, Velocity{ glm::vec3(0.f) }));
+
+	while (state.keepRunning()) {
+		for (auto entity : entities) world.add(entity, Scale{ glm::vec3(2.f) });
+		for (auto entity : entities) world.remove<Scale>(entity);
+	}
+	Bench::doNotOptimize(world.getCount());
+	state.setItemsPerIteration(count * 2);
+}
@@ -0,0 +1,96 @@
+/**\ file eventDispatchBenchmark.cpp
+*	 Cost of dispatching an event to the application's eleven handlers, the per event EventDispatcher and std::bind
+*	 that Application::onEvent used against the EventDispatchTable it fills once
+*/
+#include "benchmark.h"
+
+#include <functional>
+
+#include "events/eventDispatcher.h"
+#include "events/eventDispatchTable.h"
+#include "events/keyEvents.h"
+#include "events/mouseEvents.h"
+#include "events/windowEvents.h"
+
+namespace
+{
+	/**\ Stands in for Application, its handlers do as little as the application's */
+	struct Handlers
+	{
+		uint32_t calls = 0;
+		float mouseX = 0.f;
+
+		bool onKeyPressed(Engine::KeyPressedEvent& e) { calls++; return true; }
+		bool onKeyReleased(Engine::KeyReleasedEvent& e) { calls++; return true; }
+		bool onMouseButtonPressed(Engine::MouseButtonPressedEvent& e) { calls++; return true; }
+		bool onMouseButtonReleased(Engine::MouseButtonReleasedEvent& e) { calls++; return true; }
+		bool onMouseMoved(Engine::MouseMovedEvent& e) { calls++; mouseX = e.getX(); return true; }
+		bool onMouseScrolled(Engine::MouseScrolledEvent& e) { calls++; return true; }
+		bool onWindowClose(Engine::WindowCloseEvent& e) { calls++; return true; }
+		bool onWindowFocus(Engine::WindowFocusEvent& e) { calls++; return true; }
+		bool onWindowLostFocus(Engine::WindowLostFocusEvent& e) { calls++; return true; }
+		bool onWindowMoved(Engine::WindowMovedEvent& e) { calls++; return true; }
+		bool onWindowResize(Engine::WindowResizeEvent& e) { calls++; return true; }
+	};
+
+	/**\ Mostly mouse movement, as a window gets */
+	struct EventStream
+	{
+		Engine::MouseMovedEvent moved{ 100.f, 150.f };
+		Engine::KeyPressedEvent key{ 55, 0 };
+		Engine::MouseButtonPressedEvent button{ 1 };
+		Engine::WindowResizeEvent resize{ 1024, 720 };
+		Engine::Event* events[8] = { &moved, &moved, &moved, &key, &moved, &moved, &button, &resize };
+	};
+}
+
+/**\ What Application::onEvent did: a dispatcher and eleven std::functions for every event */
+BENCHMARK(Events_EventDispatcher)
+{
+	Handlers handlers;
+	EventStream stream;
+	Handlers* owner = &handlers;
+	while (state.keepRunning()) {
+		for (Engine::Event* e : stream.events) {
+			Engine::EventDispatcher dispatcher(*e);
+			dispatcher.dispatch<Engine::KeyPressedEvent>(std::bind(&Handlers::onKeyPressed, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::KeyReleasedEvent>(std::bind(&Handlers::onKeyReleased, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::MouseButtonPressedEvent>(std::bind(&Handlers::onMouseButtonPressed, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::MouseButtonReleasedEvent>(std::bind(&Handlers::onMouseButtonReleased, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::MouseMovedEvent>(std::bind(&Handlers::onMouseMoved, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::MouseScrolledEvent>(std::bind(&Handlers::onMouseScrolled, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::WindowCloseEvent>(std::bind(&Handlers::onWindowClose, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::WindowFocusEvent>(std::bind(&Handlers::onWindowFocus, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::WindowLostFocusEvent>(std::bind(&Handlers::onWindowLostFocus, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::WindowMovedEvent>(std::bind(&Handlers::onWindowMoved, owner, std::placeholders::_1));
+			dispatcher.dispatch<Engine::WindowResizeEvent>(std::bind(&Handlers::onWindowResize, owner, std::placeholders::_1));
+		}
+		Bench::doNotOptimize(handlers.calls);
+	}
+	state.setItemsPerIteration(8);
+}
+
+/**\ The same handlers added to a table once */
+BENCHMARK(Events_DispatchTable)
+{
+	Handlers handlers;
+	EventStream stream;
+	Engine::EventDispatchTable table;
+	table.add<&Handlers::onKeyPressed>(&handlers);
+	table.add<&Handlers::onKeyReleased>(&handlers);
+	table.add<&Handlers::onMouseButtonPressed>(&handlers);
+	table.add<&Handlers::onMouseButtonReleased>(&handlers);
+	table.add<&Handlers::onMouseMoved>(&handlers);
+	table.add<&Handlers::onMouseScrolled>(&handlers);
+	table.add<&Handlers::onWindowClose>(&handlers);
+	table.add<&Handlers::onWindowFocus>(&handlers);
+	table.add<&Handlers::onWindowLostFocus>(&handlers);
+	table.add<&Handlers::onWindowMoved>(&handlers);
+	table.add<&Handlers::onWindowResize>(&handlers);
+
+	while (state.keepRunning()) {
+		for (Engine::Event* e : stream.events) table.dispatch(*e);
+		Bench::doNotOptimize(handlers.calls);
+	}
+	state.setItemsPerIteration(8);
+}
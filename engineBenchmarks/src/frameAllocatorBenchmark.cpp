@@ -0,0 +1,71 @@
+/**\ file frameAllocatorBenchmark.cpp
+*	 Transient per frame allocations from the heap against the frame allocator
+*/
+#include "benchmark.h"
+#include "systems/frameAllocator.h"
+#include "systems/memoryTracker.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+	const uint32_t s_arrayCount = 64; //!< Scratch arrays a frame makes
+	const uint32_t s_arraySize = 32;
+}
+
+/**\ Scratch arrays with the general heap, the baseline */
+BENCHMARK(Frame_Arrays_Heap)
+{
+	while (state.keepRunning()) {
+		for (uint32_t i = 0; i < s_arrayCount; i++) {
+			std::vector<float> scratch;
+			scratch.reserve(s_arraySize);
+			for (uint32_t j = 0; j < s_arraySize; j++) scratch.push_back(static_cast<float>(j));
+			Bench::doNotOptimize(scratch.data());
+		}
+	}
+	state.setItemsPerIteration(s_arrayCount);
+}
+
+/**\ The same arrays from frame memory, freed all at once by the next frame. Fails if a frame touches the heap once warm */
+BENCHMARK(Frame_Arrays_FrameAllocator)
+{
+	auto frame = []() {
+		Engine::FrameAllocator::beginFrame();
+		for (uint32_t i = 0; i < s_arrayCount; i++) {
+			Engine::FrameVector<float> scratch(Engine::FrameAllocator::getAdapter<float>());
+			scratch.reserve(s_arraySize);
+			for (uint32_t j = 0; j < s_arraySize; j++) scratch.push_back(static_cast<float>(j));
+			Bench::doNotOptimize(scratch.data());
+		}
+	};
+	for (uint32_t i = 0; i < Engine::FrameAllocator::s_maxBuffers; i++) frame(); //!< Every buffer has its blocks
+
+	uint64_t allocations = Engine::MemoryTracker::getAllocationCount();
+	while (state.keepRunning()) frame();
+	if (Engine::MemoryTracker::getAllocationCount() != allocations) state.fail("allocated in the steady state");
+	state.setItemsPerIteration(s_arrayCount);
+}
+
+/**\ The fps line as it was built before, with std::to_string and concatenation */
+BENCHMARK(Frame_Text_ToString)
+{
+	int fps = 0;
+	while (state.keepRunning()) {
+		std::string text = std::string("fps: ") + std::to_string(60 + (fps++ & 3)) + " p99: " + std::to_string(16) + "ms";
+		Bench::doNotOptimize(text.data());
+	}
+	state.setItemsPerIteration(1);
+}
+
+BENCHMARK(Frame_Text_Format)
+{
+	int fps = 0;
+	while (state.keepRunning()) {
+		Engine::FrameAllocator::beginFrame();
+		const char* text = Engine::FrameAllocator::format("fps: %d p99: %dms", 60 + (fps++ & 3), 16);
+		Bench::doNotOptimize(text);
+	}
+	state.setItemsPerIteration(1);
+}
@@ -0,0 +1,46 @@
+/**\ file jobSystemBenchmark.cpp
+*	 Job system scaling with the worker count, and the cost of a job
+*/
+#include "benchmark.h"
+#include "systems/jobSystem.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	const uint32_t s_elementCount = 1 << 20;
+}
+
+/**\ A compute heavy loop split across the workers, items/s should scale with the argument up to the core count */
+BENCHMARK_ARGS(JobSystem_ParallelForScaling, 1, 2, 4, 8, 16)
+{
+	Engine::jobSystem jobs(static_cast<uint32_t>(state.getArg()));
+	jobs.start();
+
+	std::vector<float> data(s_elementCount, 1.5f);
+	while (state.keepRunning()) {
+		Engine::jobSystem::parallelFor(s_elementCount, 4096, [&data](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++) data[i] = std::sqrt(data[i] * data[i] + 1.f) * 0.5f + std::sin(data[i]);
+		});
+		Bench::doNotOptimize(data.data());
+	}
+	state.setItemsPerIteration(s_elementCount);
+	jobs.stop();
+}
+
+/**\ Empty jobs, so the time is all queueing, stealing and counter overhead */
+BENCHMARK_ARGS(JobSystem_EmptyJobs, 1, 4)
+{
+	Engine::jobSystem jobs(static_cast<uint32_t>(state.getArg()));
+	jobs.start();
+
+	const uint32_t jobCount = 10000;
+	while (state.keepRunning()) {
+		Engine::JobCounter counter;
+		for (uint32_t i = 0; i < jobCount; i++) Engine::jobSystem::run([]() {}, &counter);
+		Engine::jobSystem::wait(counter);
+	}
+	state.setItemsPerIteration(jobCount);
+	jobs.stop();
+}
@@ -0,0 +1,70 @@
+/**\ file loggingBenchmark.cpp
+*	 What a log call costs the thread making it, writing on the calling thread as the old logger did against the ring and writer thread.
+*	 Both write to a file so the console isn't flooded. Each iteration is a burst of messages, as a busy frame might log, then waits
+*	 for them to reach the file. The time per iteration covers the lot, the label is the time spent in the log calls alone
+*/
+#include "benchmark.h"
+#include "systems/logging.h"
+
+#include <chrono>
+#include <cstdio>
+#include <spdlog/sinks/basic_file_sink.h>
+
+namespace
+{
+	const uint32_t s_burst = 16; //!< Messages a frame logs
+
+	void setCallSiteLabel(Bench::State& state, double arg_callSeconds)
+	{
+		char label[64];
+		snprintf(label, sizeof(label), "%.1f ns a call", arg_callSeconds * 1e9 / static_cast<double>(state.getIterations() * s_burst));
+		state.setLabel(label);
+	}
+}
+
+/**\ A synchronous spdlog logger, the message is formatted and written before the call returns */
+BENCHMARK(Log_Synchronous)
+{
+	auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("logs/benchmarkSynchronous.log", true);
+	sink->set_pattern("[%Y-%m-%d %T.%e] [%t] %l: %v");
+	spdlog::logger logger("Synchronous", sink);
+
+	double callSeconds = 0.0;
+	uint32_t body = 0;
+	while (state.keepRunning()) {
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < s_burst; i++, body++) logger.info("Bodies {0} and {1} have collided", body, body + 1);
+		callSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		logger.flush();
+	}
+	state.setItemsPerIteration(s_burst);
+	setCallSiteLabel(state, callSeconds);
+}
+
+/**\ The engine's logger, the message is formatted into the ring and the writer thread does the rest. Calls write() as LOG_INFO is compiled out of release builds */
+BENCHMARK(Log_Asynchronous)
+{
+	Engine::LogSettings previous = Engine::logging::getSettings();
+	Engine::LogSettings settings;
+	settings.console = false;
+	settings.filePath = "logs/benchmarkAsynchronous.log";
+	settings.overflow = Engine::LogOverflow::Block;
+	Engine::logging::setSettings(settings);
+	Engine::logging logger;
+	logger.start();
+
+	double callSeconds = 0.0;
+	uint32_t body = 0;
+	while (state.keepRunning()) {
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < s_burst; i++, body++) Engine::logging::write(spdlog::level::info, "Bodies {0} and {1} have collided", body, body + 1);
+		callSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		Engine::logging::flush();
+	}
+	state.setItemsPerIteration(s_burst);
+	setCallSiteLabel(state, callSeconds);
+
+	logger.stop();
+	Engine::logging::setSettings(previous);
+	if (Engine::logging::getDroppedCount()) state.fail("dropped messages");
+}
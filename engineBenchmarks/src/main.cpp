@@ -0,0 +1,42 @@
+#include "benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace Bench {
+	int runAll(const char* arg_filter, double arg_minSeconds)
+	{
+		int failures = 0;
+		printf("%-48s %12s %14s %16s %12s\n", "Benchmark", "Iterations", "ns/iteration", "items/s", "MB/s");
+		for (auto& benchmark : getRegistry()) {
+			if (arg_filter && !strstr(benchmark.name, arg_filter)) continue;
+
+			std::vector<int64_t> args = benchmark.args.empty() ? std::vector<int64_t>{ 0 } : benchmark.args;
+			for (int64_t arg : args) {
+				State state(arg, arg_minSeconds);
+				benchmark.func(state);
+
+				std::string name = benchmark.name;
+				if (!benchmark.args.empty()) name += "/" + std::to_string(arg);
+
+				double iterations = static_cast<double>(state.getIterations() ? state.getIterations() : 1);
+				double seconds = state.getSeconds() > 0.0 ? state.getSeconds() : 1e-9;
+				printf("%-48s %12llu %14.1f", name.c_str(), static_cast<unsigned long long>(state.getIterations()), seconds * 1e9 / iterations);
+				if (state.getItems()) printf(" %16.0f", state.getItems() * iterations / seconds); else printf(" %16s", "-");
+				if (state.getBytes()) printf(" %12.1f", state.getBytes() * iterations / seconds / (1024.0 * 1024.0)); else printf(" %12s", "-");
+				printf("  %s%s\n", state.failed() ? "FAILED " : "", state.getLabel().c_str());
+
+				if (state.failed()) failures++;
+			}
+		}
+		return failures;
+	}
+}
+
+/**\ Usage: EngineBenchmarks [filter] [minimum seconds per benchmark] */
+int main(int argc, char** argv)
+{
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+	double minSeconds = argc > 2 ? atof(argv[2]) : 0.5;
+	return Bench::runAll(filter, minSeconds);
+}
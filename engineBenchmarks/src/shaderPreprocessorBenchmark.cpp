@@ -0,0 +1,87 @@
+/**\ file shaderPreprocessorBenchmark.cpp
+*	 Shader file parse throughput, ShaderPreprocessor against the old line by line reader
+*/
+#include "benchmark.h"
+#include "rendering/shaderPreprocessor.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+	/**\ Writes a large two stage shader with a shared include into the temp directory, returns its path */
+	std::string writeShader()
+	{
+		std::filesystem::path directory = std::filesystem::temp_directory_path() / "engineBenchmarks" / "shaders";
+		std::filesystem::create_directories(directory / "include");
+
+		std::ofstream include(directory / "include" / "common.glsl");
+		include << "#pragma once\n";
+		for (int i = 0; i < 200; i++) include << "uniform vec4 u_common" << i << "; // shared uniform block padding\n";
+
+		std::ofstream shader(directory / "shader.glsl");
+		const char* stages[] = { "Vertex", "Fragment" };
+		for (auto stage : stages) {
+			shader << "#region " << stage << "\n\n#version 440 core\n#include \"include/common.glsl\"\n";
+			for (int i = 0; i < 2000; i++) shader << "\tvec4 value" << i << " = u_common" << (i % 200) << " * vec4(0.5, 0.25, 0.125, 1.0);\n";
+		}
+		return (directory / "shader.glsl").string();
+	}
+
+	/**\ The reader OpenGLShader used before the preprocessor: getline with a find per region name */
+	std::array<std::string, 6> legacyRead(const char* arg_Filepath)
+	{
+		std::array<std::string, 6> src;
+		int32_t currentRegion = -1;
+		std::string line;
+		std::fstream handle(arg_Filepath, std::ios::in);
+		while (std::getline(handle, line)) {
+			if (line.find("#region Vertex") != std::string::npos) { currentRegion = 0; continue; }
+			if (line.find("#region Fragment") != std::string::npos) { currentRegion = 1; continue; }
+			if (line.find("#region Geometry") != std::string::npos) { currentRegion = 2; continue; }
+			if (line.find("#region TessellationControl") != std::string::npos) { currentRegion = 3; continue; }
+			if (line.find("#region TessellationEvaluation") != std::string::npos) { currentRegion = 4; continue; }
+			if (line.find("#region Compute") != std::string::npos) { currentRegion = 5; continue; }
+			if (currentRegion != -1) src[currentRegion] += (line + "\n");
+		}
+		return src;
+	}
+
+	const std::string& getShaderPath() { static std::string path = writeShader(); return path; }
+}
+
+BENCHMARK(ShaderPreprocessor_Cached)
+{
+	Engine::ShaderPreprocessor preprocessor;
+	Engine::ShaderSources sources;
+	if (!preprocessor.process(getShaderPath().c_str(), sources)) { state.fail("could not read shader"); return; }
+
+	while (state.keepRunning()) {
+		preprocessor.process(getShaderPath().c_str(), sources);
+		Bench::doNotOptimize(sources);
+	}
+	state.setBytesPerIteration(std::filesystem::file_size(getShaderPath()));
+}
+
+BENCHMARK(ShaderPreprocessor_Uncached)
+{
+	Engine::ShaderPreprocessor preprocessor;
+	Engine::ShaderSources sources;
+
+	while (state.keepRunning()) {
+		preprocessor.clearCache(); //!< Includes the file read, as on the first load of a shader
+		preprocessor.process(getShaderPath().c_str(), sources);
+		Bench::doNotOptimize(sources);
+	}
+	state.setBytesPerIteration(std::filesystem::file_size(getShaderPath()));
+}
+
+BENCHMARK(ShaderPreprocessor_LegacyGetline)
+{
+	while (state.keepRunning()) {
+		auto sources = legacyRead(getShaderPath().c_str());
+		Bench::doNotOptimize(sources);
+	}
+	state.setBytesPerIteration(std::filesystem::file_size(getShaderPath()));
+}
@@ -0,0 +1,77 @@
+/**\ file stringIdBenchmark.cpp
+*	 Uniform name lookups as the renderer makes them: std::string keys, the const char* keys UniformBuffer had, and StringId
+*/
+#include "benchmark.h"
+#include "systems/stringId.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+	/**\ The names a frame uploads, camera and lights buffers then the per draw shader uniforms */
+	const char* const s_names[] = { "u_view", "u_projection", "u_lightPos", "u_viewPos", "u_lightColour", "u_tint", "u_model", "u_materialTint" };
+	constexpr size_t s_nameCount = sizeof(s_names) / sizeof(s_names[0]);
+
+	constexpr Engine::StringId s_ids[] = { "u_view", "u_projection", "u_lightPos", "u_viewPos", "u_lightColour", "u_tint", "u_model", "u_materialTint" };
+
+	template <typename Key>
+	std::unordered_map<Key, std::pair<uint32_t, uint32_t>> makeCache(const Key* arg_keys)
+	{
+		std::unordered_map<Key, std::pair<uint32_t, uint32_t>> cache;
+		for (uint32_t i = 0; i < s_nameCount; i++) cache[arg_keys[i]] = { i * 16, 16 };
+		return cache;
+	}
+}
+
+/**\ A std::string keyed map looked up with literals, building a string for each lookup */
+BENCHMARK(StringId_StringMap)
+{
+	std::string keys[s_nameCount];
+	for (size_t i = 0; i < s_nameCount; i++) keys[i] = s_names[i];
+	auto cache = makeCache(keys);
+	uint32_t sum = 0;
+	while (state.keepRunning()) {
+		for (const char* name : s_names) sum += cache.find(name)->second.first;
+	}
+	Bench::doNotOptimize(sum);
+	state.setItemsPerIteration(s_nameCount);
+}
+
+/**\ What UniformBuffer had: fast, but only finds the same pointer, so an equal string from elsewhere misses */
+BENCHMARK(StringId_PointerMap)
+{
+	auto cache = makeCache(s_names);
+	uint32_t sum = 0;
+	while (state.keepRunning()) {
+		for (const char* name : s_names) sum += cache.find(name)->second.first;
+	}
+	Bench::doNotOptimize(sum);
+	state.setItemsPerIteration(s_nameCount);
+}
+
+/**\ Ids hashed at compile time, as the renderers hold them */
+BENCHMARK(StringId_IdMap)
+{
+	auto cache = makeCache(s_ids);
+	uint32_t sum = 0;
+	while (state.keepRunning()) {
+		for (Engine::StringId id : s_ids) sum += cache.find(id)->second.first;
+	}
+	Bench::doNotOptimize(sum);
+	state.setItemsPerIteration(s_nameCount);
+}
+
+/**\ Ids hashed as they are looked up, for names that only arrive at runtime */
+BENCHMARK(StringId_IdMapRuntimeHash)
+{
+	auto cache = makeCache(s_ids);
+	const char* const* volatile names = s_names; //!< Hides the literals, so the hashes can't be folded
+	uint32_t sum = 0;
+	while (state.keepRunning()) {
+		for (size_t i = 0; i < s_nameCount; i++) sum += cache.find(Engine::StringId(names[i]))->second.first;
+	}
+	Bench::doNotOptimize(sum);
+	state.setItemsPerIteration(s_nameCount);
+}
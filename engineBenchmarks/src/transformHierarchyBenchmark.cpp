@@ -0,0 +1,165 @@
+/**\ file transformHierarchyBenchmark.cpp
+*	 World matrix updates for wide and deep hierarchies of 100,000 nodes, with nothing, one subtree or everything moving
+*/
+#include "benchmark.h"
+#include "ecs/transformHierarchy.h"
+#include "systems/jobSystem.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <vector>
+
+namespace
+{
+	const uint32_t s_nodeCount = 100000;
+
+	using Hierarchy = Engine::TransformHierarchy;
+
+	/**\ 1000 roots with 99 children each, like a scene of props */
+	std::vector<Hierarchy::Node> buildWide(Hierarchy& arg_hierarchy)
+	{
+		std::vector<Hierarchy::Node> roots;
+		for (uint32_t root = 0; root < s_nodeCount / 100; root++) {
+			roots.push_back(arg_hierarchy.create(Hierarchy::s_null, glm::vec3(static_cast<float>(root), 0.f, 0.f)));
+			for (uint32_t child = 0; child < 99; child++) arg_hierarchy.create(roots.back(), glm::vec3(0.f, static_cast<float>(child), 0.f));
+		}
+		return roots;
+	}
+
+	/**\ 100 chains 1000 nodes deep, like long skeletons or attachment chains */
+	std::vector<Hierarchy::Node> buildDeep(Hierarchy& arg_hierarchy)
+	{
+		std::vector<Hierarchy::Node> roots;
+		for (uint32_t chain = 0; chain < s_nodeCount / 1000; chain++) {
+			roots.push_back(arg_hierarchy.create(Hierarchy::s_null, glm::vec3(static_cast<float>(chain), 0.f, 0.f)));
+			Hierarchy::Node parent = roots.back();
+			for (uint32_t link = 1; link < 1000; link++) parent = arg_hierarchy.create(parent, glm::vec3(0.f, 0.01f, 0.f), glm::angleAxis(0.001f, glm::vec3(0.f, 0.f, 1.f)));
+		}
+		return roots;
+	}
+
+	/**\ What updates cost without dirty flags or the flat order: every node, parent first, from a node list */
+	struct NaiveNode
+	{
+		glm::vec3 position;
+		glm::quat rotation;
+		glm::vec3 scale;
+		glm::mat4 world;
+		std::vector<uint32_t> children;
+	};
+
+	void naiveUpdate(std::vector<NaiveNode>& arg_nodes, uint32_t arg_node, const glm::mat4& arg_parent)
+	{
+		NaiveNode& node = arg_nodes[arg_node];
+		node.world = arg_parent * glm::translate(glm::mat4(1.f), node.position) * glm::mat4_cast(node.rotation) * glm::scale(glm::mat4(1.f), node.scale);
+		for (uint32_t child : node.children) naiveUpdate(arg_nodes, child, node.world);
+	}
+}
+
+/**\ Baseline, every matrix recomputed every frame by walking the tree */
+BENCHMARK(Hierarchy_Wide_RecomputeAll)
+{
+	std::vector<NaiveNode> nodes;
+	std::vector<uint32_t> roots;
+	for (uint32_t root = 0; root < s_nodeCount / 100; root++) {
+		roots.push_back(static_cast<uint32_t>(nodes.size()));
+		nodes.push_back({ glm::vec3(static_cast<float>(root), 0.f, 0.f), glm::quat(1.f, 0.f, 0.f, 0.f), glm::vec3(1.f), glm::mat4(1.f), {} });
+		for (uint32_t child = 0; child < 99; child++) {
+			nodes[roots.back()].children.push_back(static_cast<uint32_t>(nodes.size()));
+			nodes.push_back({ glm::vec3(0.f, static_cast<float>(child), 0.f), glm::quat(1.f, 0.f, 0.f, 0.f), glm::vec3(1.f), glm::mat4(1.f), {} });
+		}
+	}
+
+	while (state.keepRunning()) {
+		for (uint32_t root : roots) naiveUpdate(nodes, root, glm::mat4(1.f));
+		Bench::doNotOptimize(nodes[s_nodeCount / 2].world);
+	}
+	state.setItemsPerIteration(s_nodeCount);
+}
+
+/**\ Everything moves each frame, the flat arrays against the baseline above */
+BENCHMARK(Hierarchy_Wide_AllDirty)
+{
+	Hierarchy hierarchy;
+	std::vector<Hierarchy::Node> roots = buildWide(hierarchy);
+	hierarchy.update();
+
+	float angle = 0.f;
+	while (state.keepRunning()) {
+		angle += 0.01f;
+		for (Hierarchy::Node root : roots) hierarchy.setRotation(root, glm::angleAxis(angle, glm::vec3(0.f, 1.f, 0.f)));
+		hierarchy.update();
+		Bench::doNotOptimize(hierarchy.getUpdatedCount());
+	}
+	state.setItemsPerIteration(s_nodeCount);
+}
+
+/**\ One prop of a thousand moves, the rest is skipped on its dirty byte */
+BENCHMARK(Hierarchy_Wide_OneDirty)
+{
+	Hierarchy hierarchy;
+	std::vector<Hierarchy::Node> roots = buildWide(hierarchy);
+	hierarchy.update();
+
+	float angle = 0.f;
+	while (state.keepRunning()) {
+		angle += 0.01f;
+		hierarchy.setRotation(roots[roots.size() / 2], glm::angleAxis(angle, glm::vec3(0.f, 1.f, 0.f)));
+		hierarchy.update();
+		Bench::doNotOptimize(hierarchy.getUpdatedCount());
+	}
+	state.setItemsPerIteration(s_nodeCount);
+}
+
+/**\ Nothing moves, the floor cost of a static scene */
+BENCHMARK(Hierarchy_Wide_Static)
+{
+	Hierarchy hierarchy;
+	buildWide(hierarchy);
+	hierarchy.update();
+
+	while (state.keepRunning()) {
+		hierarchy.update();
+		Bench::doNotOptimize(hierarchy.getUpdatedCount());
+	}
+	state.setItemsPerIteration(s_nodeCount);
+}
+
+/**\ Chains longer than the grain, their top parts run serially and the tails split into jobs */
+BENCHMARK(Hierarchy_Deep_AllDirty)
+{
+	Hierarchy hierarchy;
+	std::vector<Hierarchy::Node> roots = buildDeep(hierarchy);
+	hierarchy.update();
+
+	float angle = 0.f;
+	while (state.keepRunning()) {
+		angle += 0.01f;
+		for (Hierarchy::Node root : roots) hierarchy.setRotation(root, glm::angleAxis(angle, glm::vec3(0.f, 1.f, 0.f)));
+		hierarchy.update();
+		Bench::doNotOptimize(hierarchy.getUpdatedCount());
+	}
+	state.setItemsPerIteration(s_nodeCount);
+}
+
+/**\ Independent subtrees over the job system, should scale with the argument up to the core count */
+BENCHMARK_ARGS(Hierarchy_Wide_AllDirty_Parallel, 1, 2, 4, 8)
+{
+	Engine::jobSystem jobs(static_cast<uint32_t>(state.getArg()));
+	jobs.start();
+	{
+		Hierarchy hierarchy;
+		std::vector<Hierarchy::Node> roots = buildWide(hierarchy);
+		hierarchy.update();
+
+		float angle = 0.f;
+		while (state.keepRunning()) {
+			angle += 0.01f;
+			for (Hierarchy::Node root : roots) hierarchy.setRotation(root, glm::angleAxis(angle, glm::vec3(0.f, 1.f, 0.f)));
+			hierarchy.update();
+			Bench::doNotOptimize(hierarchy.getUpdatedCount());
+		}
+	}
+	jobs.stop();
+	state.setItemsPerIteration(s_nodeCount);
+}
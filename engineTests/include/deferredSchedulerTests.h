@@ -0,0 +1,24 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "systems/deferredScheduler.h"
+#include "systems/timer.h"
+
+/**\ A scheduler on a fake clock. Items take the time the test gives them and write down that they ran */
+class DeferredSchedulerTest : public ::testing::Test
+{
+protected:
+	void SetUp() override { Engine::timer::setClock([this]() { return now; }); }
+	void TearDown() override { Engine::timer::setClock(nullptr); }
+
+	Engine::DeferredScheduler::Work item(const std::string& arg_name, uint64_t arg_cost = 100000)
+	{
+		return [this, arg_name, arg_cost]() { ran.push_back(arg_name); now += arg_cost; };
+	}
+
+	uint64_t now = 1000000000;
+	std::vector<std::string> ran;
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "systems/linearAllocator.h"
+#include "rendering/drawList.h"
+#include "rendering/renderer3D.h"
+
+/**\ Geometry that is never drawn, only pointed at */
+class FakeVertexArray : public Engine::VertexArray
+{
+public:
+	void addVertexBuffer(const std::shared_ptr<Engine::VertexBuffer>& vertexBuffer) override {}
+	void setIndexBuffer(const std::shared_ptr<Engine::IndexBuffer>& indexBuffer) override {}
+	uint32_t getID() const override { return 0; }
+	uint32_t getDrawCount() const override { return 0; }
+	std::shared_ptr<Engine::IndexBuffer> getIndexBuffer() const override { return nullptr; }
+};
+
+/**\ The model's x translation is used to tag each draw */
+inline glm::mat4 taggedModel(float arg_tag)
+{
+	glm::mat4 model(1.f);
+	model[3][0] = arg_tag;
+	return model;
+}
+inline float getTag(const Engine::DrawItem* arg_item) { return arg_item->model[3][0]; }
@@ -0,0 +1,93 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "physics/dynamicBVH.h"
+#include "physics/intersection.h"
+#include "systems/jobSystem.h"
+
+using Engine::AABB;
+using Engine::Ray;
+using Engine::RayHit;
+using Engine::NearestHit;
+
+/**\ Random boxes in a 100 unit cube, kept alongside the tree so every query can be checked by brute force */
+
+class DynamicBVHTest : public ::testing::Test
+{
+protected:
+	float random() //!< [0, 1), the same sequence every run
+	{
+		m_seed = m_seed * 1664525u + 1013904223u;
+		return (m_seed >> 8) * (1.f / 16777216.f);
+	}
+	AABB randomBox()
+	{
+		glm::vec3 centre(random() * 100.f, random() * 100.f, random() * 100.f);
+		glm::vec3 extents(0.1f + random(), 0.1f + random(), 0.1f + random());
+		return AABB(centre - extents, centre + extents);
+	}
+	void fill(uint32_t arg_count)
+	{
+		for (uint32_t i = 0; i < arg_count; i++) {
+			boxes.push_back(randomBox());
+			proxies.push_back(tree.insert(boxes.back(), i));
+		}
+	}
+	static std::vector<uint64_t> sorted(std::vector<uint64_t> arg_values)
+	{
+		std::sort(arg_values.begin(), arg_values.end());
+		return arg_values;
+	}
+	/**\ Every query type against brute force over the boxes */
+	void checkQueries()
+	{
+		for (int query = 0; query < 20; query++) {
+			AABB region = AABB::expand(randomBox(), 5.f);
+			std::vector<uint64_t> found, expected;
+			tree.queryBox(region, found);
+			for (uint32_t i = 0; i < boxes.size(); i++) if (boxes[i].overlaps(region)) expected.push_back(i);
+			ASSERT_EQ(sorted(found), expected);
+
+			glm::vec3 centre = region.getCentre();
+			found.clear();
+			expected.clear();
+			tree.querySphere(centre, 8.f, found);
+			for (uint32_t i = 0; i < boxes.size(); i++) if (boxes[i].getDistanceSquared(centre) <= 64.f) expected.push_back(i);
+			ASSERT_EQ(sorted(found), expected);
+
+			std::vector<NearestHit> nearest;
+			tree.queryNearest(centre, 5, nearest);
+			std::vector<float> distances;
+			for (const AABB& box : boxes) distances.push_back(box.getDistanceSquared(centre));
+			std::sort(distances.begin(), distances.end());
+			ASSERT_EQ(nearest.size(), 5u);
+			for (uint32_t i = 0; i < 5; i++) EXPECT_FLOAT_EQ(nearest[i].distanceSquared, distances[i]);
+
+			Ray ray(centre, glm::normalize(glm::vec3(random() - 0.5f, random() - 0.5f, random() - 0.5f)));
+			RayHit hit = tree.raycast(ray, 200.f);
+			float closest = 200.f;
+			bool any = false;
+			for (const AABB& box : boxes) {
+				float distance = closest;
+				if (Engine::Intersection::rayBox(ray, box, distance)) {
+					closest = distance;
+					any = true;
+				}
+			}
+			ASSERT_EQ(hit.isHit(), any);
+			if (any) { EXPECT_FLOAT_EQ(hit.distance, closest); }
+		}
+	}
+
+	Engine::DynamicBVH tree;
+	std::vector<AABB> boxes; //!< By user data
+	std::vector<Engine::DynamicBVH::Proxy> proxies;
+private:
+	uint32_t m_seed = 12345;
+};
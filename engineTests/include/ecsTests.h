@@ -0,0 +1,20 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include "ecs/world.h"
+
+/**\ Small components for the tests */
+struct Position
+{
+	float x, y, z;
+};
+
+struct Velocity
+{
+	float x, y, z;
+};
+
+struct Health
+{
+	int32_t value;
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "events/eventQueue.h"
+#include "events/keyEvents.h"
+#include "events/mouseEvents.h"
+#include "events/windowEvents.h"
+
+/**\ Keeps the time on the last key it saw */
+inline uint64_t s_lastStamp = 0;
+inline bool stampOf(Engine::KeyPressedEvent& e) { s_lastStamp = e.getTime(); return false; }
+
+/**\ Records what a layer was given */
+struct QueueLayer
+{
+	std::vector<int> keys;
+	std::vector<float> moves;
+	int clicks = 0;
+	int resizes = 0;
+	bool handleKeys = true;
+	Engine::EventQueue* postTo = nullptr; //!< Posts a key from its click handler
+
+	bool onKeyPressed(Engine::KeyPressedEvent& e) { keys.push_back(e.GetKeyCode()); return handleKeys; }
+	bool onMouseMoved(Engine::MouseMovedEvent& e) { moves.push_back(e.getX()); return true; }
+	bool onMouseButtonPressed(Engine::MouseButtonPressedEvent& e) { clicks++; if (postTo) postTo->post(Engine::KeyPressedEvent(99, 0)); return true; }
+	bool onWindowResize(Engine::WindowResizeEvent& e) { resizes++; return true; }
+
+	void addTo(Engine::EventDispatchTable& arg_table)
+	{
+		arg_table.add<&QueueLayer::onKeyPressed>(this);
+		arg_table.add<&QueueLayer::onMouseMoved>(this);
+		arg_table.add<&QueueLayer::onMouseButtonPressed>(this);
+		arg_table.add<&QueueLayer::onWindowResize>(this);
+	}
+};
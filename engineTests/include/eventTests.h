@@ -3,6 +3,7 @@
 
 #include "events/event.h"
 #include "events/eventDispatcher.h"
+#include "events/eventDispatchTable.h"
 #include "events/keyEvents.h"
 #include "events/mouseEvents.h"
 #include "events/windowEvents.h"
@@ -34,4 +35,15 @@ Engine::MouseMovedEvent mme(MouPosX, MouPosY);
 Engine::MouseScrolledEvent mse(offsetX, offsetY);
 
 bool OnResizeTrue(Engine::WindowResizeEvent& e) { return true; }
-bool OnResizeFalse(Engine::WindowResizeEvent& e) { return false; }
\ No newline at end of file
+bool OnResizeFalse(Engine::WindowResizeEvent& e) { return false; }
+
+/**\ Counts what the dispatch table calls it with */
+struct EventCounter
+{
+	int resizes = 0;
+	int closes = 0;
+	int moves = 0;
+	bool onResize(Engine::WindowResizeEvent& e) { resizes++; return true; }
+	bool onClose(Engine::WindowCloseEvent& e) { closes++; return false; }
+	bool onMouseMoved(Engine::MouseMovedEvent& e) { moves++; return true; }
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include "systems/fixedTimestep.h"
+
+/**\ A FixedTimestep on a clock the test moves by hand */
+class FixedTimestepTest : public ::testing::Test
+{
+protected:
+	uint64_t now = 100000000000; //!< Nanoseconds
+	Engine::FixedTimestep timestep{ 50.0, 4, [this]() { return now; } }; //!< 20 ms ticks
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "systems/linearAllocator.h"
+#include "systems/frameAllocator.h"
+#include "systems/memoryTracker.h"
+#include "rendering/drawList.h"
+#include "rendering/renderer3D.h"
+#include "nullBackendTests.h"
+
+/**\ Headless frames, with the frame allocator back to its defaults afterwards */
+class FrameLoopTest : public NullBackendTest
+{
+protected:
+	void TearDown() override
+	{
+		NullBackendTest::TearDown();
+		Engine::FrameAllocator::setBufferCount(2);
+	}
+};
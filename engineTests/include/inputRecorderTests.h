@@ -0,0 +1,78 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "events/inputRecorder.h"
+#include "events/inputState.h"
+#include "events/codes.h"
+#include "systems/fixedTimestep.h"
+
+/**\ Writes down each input event it is sent, with the frame it came in */
+struct QueueCapture
+{
+	std::vector<std::string> log;
+	int frames = 0;
+
+	template <typename... Args>
+	bool add(const char* arg_name, Args... arg_values)
+	{
+		std::ostringstream line;
+		line << arg_name;
+		((line << ' ' << arg_values), ...);
+		line << " @" << frames;
+		log.push_back(line.str());
+		return true;
+	}
+	bool onKeyPressed(Engine::KeyPressedEvent& e) { return add("key", e.GetKeyCode(), e.GetRepeatCount()); }
+	bool onKeyReleased(Engine::KeyReleasedEvent& e) { return add("release", e.GetKeyCode()); }
+	bool onMouseButtonPressed(Engine::MouseButtonPressedEvent& e) { return add("button", e.getButton()); }
+	bool onMouseMoved(Engine::MouseMovedEvent& e) { return add("move", e.getX(), e.getY()); }
+	bool onMouseScrolled(Engine::MouseScrolledEvent& e) { return add("scroll", e.getXOffset(), e.getYOffset()); }
+
+	void addTo(Engine::EventDispatchTable& arg_table)
+	{
+		arg_table.add<&QueueCapture::onKeyPressed>(this);
+		arg_table.add<&QueueCapture::onKeyReleased>(this);
+		arg_table.add<&QueueCapture::onMouseButtonPressed>(this);
+		arg_table.add<&QueueCapture::onMouseMoved>(this);
+		arg_table.add<&QueueCapture::onMouseScrolled>(this);
+	}
+};
+
+/**\ A recorder and a queue with the input handlers as its bottom layer, as the application has them */
+class InputRecorderTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		Engine::InputState::reset();
+		Engine::InputState::addHandlers(m_table);
+		m_queue.pushLayer(m_table);
+	}
+	void TearDown() override
+	{
+		m_recorder.stop();
+		Engine::InputState::reset();
+		std::error_code error;
+		std::filesystem::remove(m_path, error);
+	}
+
+	/**\ Posts the frame's events, dispatches them and ends the frame, keeping the snapshot the next frame will see */
+	void recordFrame(std::initializer_list<const Engine::Event*> arg_events, uint64_t arg_frameTime)
+	{
+		for (const Engine::Event* e : arg_events) m_queue.post(*e);
+		Engine::InputState::beginFrame();
+		m_queue.dispatch();
+		m_recorder.endFrame(arg_frameTime);
+	}
+
+	const std::string m_path = (std::filesystem::temp_directory_path() / "engineTestsInput.rec").string();
+	Engine::InputRecorder m_recorder;
+	Engine::EventQueue m_queue{ 64 };
+	Engine::EventDispatchTable m_table;
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include "events/inputState.h"
+#include "events/codes.h"
+
+/**\ A handler added after the input handlers */
+inline bool s_laterSawKey = false;
+inline bool laterOnKey(Engine::KeyPressedEvent& e) { s_laterSawKey = true; return true; }
+
+/**\ A table with the input handlers in, and nothing down before or after each test */
+class InputStateTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		Engine::InputState::reset();
+		Engine::InputState::addHandlers(m_table);
+	}
+	void TearDown() override { Engine::InputState::reset(); }
+
+	template <typename T>
+	void send(T arg_event) { m_table.dispatch(arg_event); }
+
+	Engine::EventDispatchTable m_table;
+};
@@ -0,0 +1,19 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "systems/jobSystem.h"
+#include "systems/workStealingDeque.h"
+
+/**\ Starts the job system for one test and stops it afterwards */
+class JobSystemTest : public ::testing::Test
+{
+protected:
+	void SetUp() override { jobs.start(); }
+	void TearDown() override { jobs.stop(); }
+
+	Engine::jobSystem jobs{ 4 };
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "systems/logging.h"
+
+/**\ Starts the logger writing only to a file of its own, and puts the settings back afterwards */
+class LoggingTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		m_previous = Engine::logging::getSettings();
+		m_path = ::testing::TempDir() + "loggingTest.log";
+		std::remove(m_path.c_str());
+	}
+	void TearDown() override
+	{
+		m_logger.stop();
+		Engine::logging::setSettings(m_previous);
+		std::remove(m_path.c_str());
+	}
+
+	void start(uint32_t arg_ringCapacity, Engine::LogOverflow arg_overflow)
+	{
+		Engine::LogSettings settings;
+		settings.console = false;
+		settings.filePath = m_path;
+		settings.ringCapacity = arg_ringCapacity;
+		settings.overflow = arg_overflow;
+		Engine::logging::setSettings(settings);
+		m_logger.start();
+	}
+
+	std::vector<std::string> readLines()
+	{
+		std::vector<std::string> lines;
+		std::ifstream file(m_path);
+		std::string line;
+		while (std::getline(file, line)) lines.push_back(line);
+		return lines;
+	}
+
+	Engine::logging m_logger;
+	Engine::LogSettings m_previous;
+	std::string m_path;
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "systems/memoryTracker.h"
+
+/**\ Over aligned, so new goes through the aligned form */
+struct alignas(64) CacheLine
+{
+	uint8_t bytes[64];
+};
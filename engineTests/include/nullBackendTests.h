@@ -0,0 +1,40 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+
+#include "events/event.h"
+#include "rendering/renderAPI.h"
+#include "rendering/renderer3D.h"
+#include "rendering/renderThread.h"
+#include "rendering/textureLoader.h"
+#include "systems/deferredScheduler.h"
+#include "platform/null/nullResources.h"
+#include "platform/null/nullRenderBackend.h"
+#include "platform/null/nullWindow.h"
+
+/**\ Factories switched to the null API and a null window's context for the render thread, as a headless Application has them */
+class NullBackendTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		Engine::RenderAPI::setAPI(Engine::RenderAPI::API::None);
+		Engine::RenderThread::setBackend(std::make_shared<Engine::NullRenderBackend>(window.getGraphicsContext()));
+		stats.resetCalls();
+		liveAtStart = stats.getLiveResources();
+	}
+	void TearDown() override
+	{
+		Engine::RenderThread::stop();
+		Engine::RenderThread::setBackend(nullptr);
+		Engine::RenderAPI::setAPI(Engine::RenderAPI::API::OpenGL);
+	}
+
+	Engine::NullWindow window{ Engine::WindowProperties("Headless", 1024, 800) };
+	Engine::NullRenderStats& stats = Engine::NullRenderStats::get();
+	int32_t liveAtStart = 0;
+};
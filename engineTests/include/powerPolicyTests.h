@@ -0,0 +1,26 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include "systems/powerPolicy.h"
+
+/**\ A policy in a table, fed the window events a real window would send */
+class PowerPolicyTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		Engine::PowerSettings settings;
+		settings.activeRate = 0.0;
+		settings.backgroundRate = 10.0;
+		settings.waitTime = 0.05f;
+		m_policy.setSettings(settings);
+		m_policy.addHandlers(m_table);
+		m_policy.beginFrame(); //!< The first plan always reports a change
+	}
+
+	template <typename T>
+	void send(T arg_event) { m_table.dispatch(arg_event); }
+
+	Engine::PowerPolicy m_policy;
+	Engine::EventDispatchTable m_table;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rendering/renderCommandBuffer.h"
+#include "rendering/renderThread.h"
+
+/**\ Writes down each call instead of drawing, so command order can be checked without a GPU */
+class RecordingRenderBackend : public Engine::RenderBackend
+{
+public:
+	void setClearColour(const glm::vec4& arg_colour) override { log("setClearColour"); }
+	void clear() override { log("clear"); }
+	void setDepthTest(bool arg_enabled) override { log(arg_enabled ? "depthOn" : "depthOff"); }
+	void setBlend(bool arg_enabled) override { log(arg_enabled ? "blendOn" : "blendOff"); }
+	void useShader(Engine::Shader& arg_shader) override { log("useShader"); }
+	void bindTexture(Engine::Texture& arg_texture) override { log("bindTexture"); }
+	void drawIndexed(Engine::VertexArray& arg_geometry, Engine::DrawMode arg_mode) override { log("drawIndexed"); }
+	void present() override { log("present"); }
+	void waitForGpu() override { log("waitForGpu"); }
+
+	void log(const std::string& arg_call)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		calls.push_back(arg_call);
+		threads.push_back(std::this_thread::get_id());
+	}
+
+	std::mutex mutex;
+	std::vector<std::string> calls;
+	std::vector<std::thread::id> threads;
+};
+
+/**\ Context with nothing to bind, counts how often it moves between threads */
+class FakeGraphicsContext : public GraphicsContext
+{
+public:
+	void init() override {}
+	void swapBuffers() override {}
+	void makeCurrent() override { madeCurrent++; }
+	void releaseCurrent() override { released++; }
+
+	std::atomic<int> madeCurrent{ 0 };
+	std::atomic<int> released{ 0 };
+};
+
+/**\ Gives the render thread a recording backend for one test */
+class RenderThreadTest : public ::testing::Test
+{
+protected:
+	void SetUp() override { Engine::RenderThread::setBackend(backend); }
+	void TearDown() override
+	{
+		Engine::RenderThread::stop();
+		Engine::RenderThread::setBackend(nullptr);
+		Engine::RenderThread::setGpuSync(false);
+	}
+
+	std::shared_ptr<RecordingRenderBackend> backend = std::make_shared<RecordingRenderBackend>();
+	std::shared_ptr<FakeGraphicsContext> context = std::make_shared<FakeGraphicsContext>();
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "rendering/shaderProgramCache.h"
+
+/**\ Fake driver. A program's "binary" is its id written out as bytes */
+class FakeProgramBinaryDriver : public Engine::ProgramBinaryDriver
+{
+public:
+	bool supported = true;
+	bool rejectAll = false;
+	std::string signature = "FakeVendor\nFakeRenderer\n4.6\n";
+	uint32_t lastLoaded = 0;
+	uint32_t binarySize = 64;
+
+	bool isSupported() const override { return supported; }
+	std::string getSignature() const override { return signature; }
+	bool getProgramBinary(uint32_t arg_program, uint32_t& arg_format, std::vector<unsigned char>& arg_binary) override
+	{
+		arg_format = 0x1234;
+		arg_binary.assign(binarySize, static_cast<unsigned char>(arg_program));
+		return true;
+	}
+	bool loadProgramBinary(uint32_t arg_program, uint32_t arg_format, const std::vector<unsigned char>& arg_binary) override
+	{
+		if (rejectAll || arg_format != 0x1234 || arg_binary.empty()) return false;
+		lastLoaded = arg_binary[0];
+		return true;
+	}
+};
+
+const std::string cacheDirectory = (std::filesystem::temp_directory_path() / "engineTestsShaderCache").string();
+
+void clearCacheDirectory()
+{
+	std::error_code error;
+	std::filesystem::remove_all(cacheDirectory, error);
+}
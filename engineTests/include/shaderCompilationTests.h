@@ -0,0 +1,28 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "rendering/shaderCompilationService.h"
+
+/**\ Fake compiler. Programs complete when the test says so, and fail if their source is "bad" */
+class FakeShaderCompiler : public Engine::ShaderCompiler
+{
+public:
+	bool parallel = true;
+	uint32_t nextProgram = 10;
+	std::set<uint32_t> completed; //!< Programs the "driver" has finished
+	std::set<uint32_t> failing;
+	std::vector<uint32_t> finished; //!< Order finish() was called in
+	std::vector<uint32_t> discarded;
+
+	bool isParallel() const override { return parallel; }
+	uint32_t begin(const std::string& arg_name, const std::string& arg_sourceTable, const char* arg_vertexSrc, const char* arg_fragmentSrc) override
+	{
+		if (std::string(arg_vertexSrc) == "bad") failing.insert(nextProgram);
+		return nextProgram++;
+	}
+	bool isComplete(uint32_t arg_program) override { return parallel && completed.count(arg_program); }
+	bool finish(uint32_t arg_program) override { finished.push_back(arg_program); return !failing.count(arg_program); }
+	void discard(uint32_t arg_program) override { discarded.push_back(arg_program); }
+};
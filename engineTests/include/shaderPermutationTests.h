@@ -0,0 +1,30 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include "rendering/shaderPermutations.h"
+#include "rendering/shaderPreprocessor.h"
+
+/**\ Shader that only remembers the defines it was built with */
+class FakeShader : public Engine::Shader
+{
+public:
+	FakeShader(const Engine::ShaderDefines& arg_defines) : defines(arg_defines) {}
+	Engine::ShaderDefines defines;
+
+	uint32_t getID() const override { return 0; }
+	bool isReady() override { return true; }
+	void uploadInt(Engine::StringId arg_Name, int arg_Value) override {}
+	void uploadFloat(Engine::StringId arg_Name, float arg_Value) override {}
+	void uploadFloat2(Engine::StringId arg_Name, const glm::vec2& arg_Value) override {}
+	void uploadFloat3(Engine::StringId arg_Name, const glm::vec3& arg_Value) override {}
+	void uploadFloat4(Engine::StringId arg_Name, const glm::vec4& arg_Value) override {}
+	void uploadMat4(Engine::StringId arg_Name, const glm::mat4& arg_Value) override {}
+};
+
+int fakeShadersCreated = 0;
+
+Engine::Shader* createFakeShader(const char* arg_path, const Engine::ShaderDefines& arg_defines)
+{
+	fakeShadersCreated++;
+	return new FakeShader(arg_defines);
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "rendering/shaderPreprocessor.h"
+
+/**\ Shader files written into a temp directory for one test, removed afterwards */
+class ShaderPreprocessorTest : public ::testing::Test
+{
+protected:
+	void SetUp() override { std::filesystem::create_directories(m_directory / "include"); }
+	void TearDown() override
+	{
+		std::error_code error;
+		std::filesystem::remove_all(m_directory, error);
+	}
+
+	std::string write(const std::string& arg_name, const std::string& arg_text)
+	{
+		std::filesystem::path path = m_directory / arg_name;
+		std::ofstream(path, std::ios::binary) << arg_text;
+		return path.lexically_normal().generic_string();
+	}
+
+	const std::filesystem::path m_directory = std::filesystem::temp_directory_path() / "engineTestsShaders";
+	Engine::ShaderPreprocessor preprocessor;
+	Engine::ShaderSources sources;
+};
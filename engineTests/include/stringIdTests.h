@@ -0,0 +1,7 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "systems/stringId.h"
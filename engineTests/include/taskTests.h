@@ -0,0 +1,31 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "systems/task.h"
+#include "systems/deferredScheduler.h"
+#include "systems/jobSystem.h"
+
+/**\ Stands in for the application's main and render thread queues, which the test drains by hand, one thread
+*	 at a time. The job system isn't started, so worker steps run where they are posted
+*/
+class TaskTest : public ::testing::Test
+{
+protected:
+	void SetUp() override { Engine::Tasks::setQueues(&main, &render); }
+	void TearDown() override { Engine::Tasks::setQueues(nullptr, nullptr); }
+
+	void runMain() { main.run(std::numeric_limits<uint64_t>::max()); }
+	void runRender() { render.run(std::numeric_limits<uint64_t>::max()); }
+	void note(const std::string& arg_step) { std::lock_guard<std::mutex> lock(mutex); ran.push_back(arg_step); }
+
+	Engine::DeferredScheduler main;
+	Engine::DeferredScheduler render;
+	std::mutex mutex; //!< Steps on workers note too
+	std::vector<std::string> ran;
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "systems/timer.h"
+#include "systems/frameLimiter.h"
+#include "systems/frameStats.h"
+
+/**\ Puts the timer on a fake clock. Each read moves it on a little, as spinning on a real clock would */
+class FakeClockTest : public ::testing::Test
+{
+protected:
+	void SetUp() override { Engine::timer::setClock([this]() { now += readCost; return now; }); }
+	void TearDown() override { Engine::timer::setClock(nullptr); }
+
+	/**\ Sleeps on the fake clock, waking late by the overshoot */
+	Engine::FrameLimiter::SleepFunc fakeSleep()
+	{
+		return [this](uint64_t arg_nanoseconds) {
+			sleeps.push_back(arg_nanoseconds);
+			now += arg_nanoseconds + sleepOvershoot;
+		};
+	}
+
+	uint64_t now = 1000000000;
+	uint64_t readCost = 1000; //!< 1 us per read
+	uint64_t sleepOvershoot = 0;
+	std::vector<uint64_t> sleeps;
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "ecs/transformHierarchy.h"
+#include "systems/jobSystem.h"
+
+/**\ True if every element of two matrices is within a small tolerance */
+inline bool nearlyEqual(const glm::mat4& arg_a, const glm::mat4& arg_b)
+{
+	for (int c = 0; c < 4; c++)
+		for (int r = 0; r < 4; r++)
+			if (std::abs(arg_a[c][r] - arg_b[c][r]) > 1e-4f) return false;
+	return true;
+}
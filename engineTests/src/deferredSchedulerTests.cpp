@@ -0,0 +1,109 @@
+#include "deferredSchedulerTests.h"
+
+TEST_F(DeferredSchedulerTest, StopsAtTheBudget) {
+	Engine::DeferredScheduler scheduler;
+	for (int i = 0; i < 10; i++) scheduler.post(item(std::to_string(i))); //!< 0.1 ms each
+
+	EXPECT_EQ(scheduler.run(350000), 4); //!< The fourth starts inside the budget and finishes over it
+	EXPECT_EQ(ran, std::vector<std::string>({ "0", "1", "2", "3" }));
+
+	Engine::DeferredStats stats = scheduler.getStats();
+	EXPECT_EQ(stats.executed, 4);
+	EXPECT_EQ(stats.pending, 6);
+	EXPECT_EQ(stats.forced, 0);
+	EXPECT_EQ(stats.nanoseconds, 400000);
+
+	scheduler.run(1000000);
+	EXPECT_EQ(scheduler.getPendingCount(), 0);
+	EXPECT_EQ(scheduler.getStats().totalExecuted, 10);
+}
+
+TEST_F(DeferredSchedulerTest, HigherPriorityFirst) {
+	Engine::DeferredScheduler scheduler;
+	scheduler.post(item("low"), Engine::WorkPriority::Low);
+	scheduler.post(item("normal"), Engine::WorkPriority::Normal);
+	scheduler.post(item("high"), Engine::WorkPriority::High);
+	scheduler.post(item("high2"), Engine::WorkPriority::High);
+	scheduler.run(1000000);
+	EXPECT_EQ(ran, std::vector<std::string>({ "high", "high2", "normal", "low" }));
+}
+
+TEST_F(DeferredSchedulerTest, OldWorkIsNotStarved) {
+	Engine::DeferredSettings settings;
+	settings.minItemsPerFrame = 0;
+	Engine::DeferredScheduler scheduler(settings);
+	scheduler.post(item("low"), Engine::WorkPriority::Low);
+
+	/**\ A steady stream of high priority work that would fill every frame on its own */
+	int frames = 0;
+	while (ran.empty() || ran.back() != "low") {
+		now += 16000000;
+		scheduler.post(item("high"), Engine::WorkPriority::High);
+		scheduler.run(50000); //!< Room for one item a frame
+		ASSERT_LT(++frames, 100);
+	}
+	EXPECT_GE(frames, 31); //!< Low work waits half a second, 31 frames of 16 ms
+	EXPECT_LE(frames, 33);
+}
+
+TEST_F(DeferredSchedulerTest, MissedDeadlinesRunOverBudget) {
+	Engine::DeferredSettings settings;
+	settings.minItemsPerFrame = 0;
+	Engine::DeferredScheduler scheduler(settings);
+	scheduler.post(item("later"), now + 5000000);
+	scheduler.post(item("soon"), now + 1000000);
+	scheduler.post(item("normal"));
+
+	EXPECT_EQ(scheduler.run(0), 0); //!< Nothing due yet and no budget
+	now += 2000000;
+	EXPECT_EQ(scheduler.run(0), 1);
+	EXPECT_EQ(ran, std::vector<std::string>({ "soon" }));
+	EXPECT_EQ(scheduler.getStats().forced, 1);
+
+	scheduler.run(1000000); //!< With time, earliest due first
+	EXPECT_EQ(ran, std::vector<std::string>({ "soon", "later", "normal" }));
+}
+
+TEST_F(DeferredSchedulerTest, OverdueDeadlinesBehindAgedWorkStillRun) {
+	Engine::DeferredScheduler scheduler;
+	scheduler.post(item("first"));
+	scheduler.post(item("second"));
+	scheduler.post(item("deadline"), now + 60000000);
+	now += 100000000; //!< Every item is due, the aged ones earliest
+
+	for (int frame = 0; frame < 3; frame++) scheduler.run(0); //!< Frames over their target get no budget
+	ASSERT_FALSE(ran.empty());
+	EXPECT_EQ(ran.front(), "deadline");
+	EXPECT_EQ(scheduler.getPendingCount(), 0);
+}
+
+TEST_F(DeferredSchedulerTest, FrameSlackLimitsTheBudget) {
+	Engine::DeferredSettings settings;
+	settings.budgetMicroseconds = 2000;
+	settings.targetFrameMicroseconds = 16000;
+	settings.minItemsPerFrame = 1;
+	Engine::DeferredScheduler scheduler(settings);
+
+	EXPECT_EQ(scheduler.getBudget(5000000), 2000000); //!< Plenty of slack, the budget is the limit
+	EXPECT_EQ(scheduler.getBudget(15500000), 500000);
+	EXPECT_EQ(scheduler.getBudget(20000000), 0);
+
+	for (int i = 0; i < 3; i++) scheduler.post(item(std::to_string(i)));
+	EXPECT_EQ(scheduler.runFrame(20000000), 1); //!< An overrunning frame still makes progress
+	EXPECT_EQ(scheduler.getStats().forced, 1);
+}
+
+TEST_F(DeferredSchedulerTest, WorkCanPostWork) {
+	Engine::DeferredScheduler scheduler;
+	scheduler.post([&]() {
+		ran.push_back("first");
+		scheduler.post(item("second"));
+	});
+	scheduler.run(1000000);
+	EXPECT_EQ(ran, std::vector<std::string>({ "first", "second" }));
+
+	scheduler.post(item("dropped"));
+	scheduler.clear();
+	scheduler.run(1000000);
+	EXPECT_EQ(ran.size(), 2);
+}
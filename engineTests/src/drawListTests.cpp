@@ -0,0 +1,87 @@
+#include "drawListTests.h"
+
+TEST(LinearAllocator, AlignsAndReusesBlocks) {
+	Engine::LinearAllocator allocator(1024);
+
+	char* byte = static_cast<char*>(allocator.allocate(1, 1));
+	double* aligned = static_cast<double*>(allocator.allocate(sizeof(double), alignof(double)));
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % alignof(double), 0);
+	EXPECT_NE(static_cast<void*>(byte), static_cast<void*>(aligned));
+
+	for (int i = 0; i < 100; i++) allocator.allocate(64); //!< Spills into more blocks
+	size_t capacity = allocator.getCapacity();
+	EXPECT_GT(capacity, 1024);
+
+	allocator.reset();
+	EXPECT_EQ(allocator.getBytesUsed(), 0);
+	EXPECT_EQ(allocator.allocate(1, 1), static_cast<void*>(byte)); //!< Starts again from the first block
+	for (int i = 0; i < 100; i++) allocator.allocate(64);
+	EXPECT_EQ(allocator.getCapacity(), capacity); //!< No new blocks the second time round
+
+	allocator.release();
+	EXPECT_EQ(allocator.getCapacity(), 0);
+	EXPECT_EQ(allocator.getBlockCount(), 0);
+	allocator.allocate(1, 1);
+	EXPECT_EQ(allocator.getCapacity(), 1024); //!< Still usable, from a new block
+}
+
+TEST(LinearAllocator, OversizedRequest) {
+	Engine::LinearAllocator allocator(256);
+	void* large = allocator.allocate(4096);
+	ASSERT_NE(large, nullptr);
+	memset(large, 1, 4096);
+	EXPECT_GE(allocator.getCapacity(), 4096);
+}
+
+TEST(DrawList, BeginKeepsLastFrame) {
+	FakeVertexArray geometry;
+	Engine::Material material(std::shared_ptr<Engine::Shader>(nullptr));
+	Engine::DrawList list;
+
+	list.begin();
+	list.submit(geometry, material, taggedModel(1.f));
+	const Engine::FrameVector<Engine::DrawItem*>* lastFrame = &list.getItems();
+	Engine::DrawItem* lastItem = list.getItems()[0];
+
+	list.begin();
+	list.submit(geometry, material, taggedModel(2.f));
+	list.submit(geometry, material, taggedModel(3.f));
+
+	ASSERT_EQ(lastFrame->size(), 1); //!< Still readable by the render thread
+	EXPECT_EQ(getTag((*lastFrame)[0]), 1.f);
+	EXPECT_EQ(getTag(lastItem), 1.f);
+	EXPECT_EQ(list.getCount(), 2);
+}
+
+TEST(DrawQueue, MergesByListKeyThenItemKeyThenOrder) {
+	FakeVertexArray geometry;
+	Engine::Material material(std::shared_ptr<Engine::Shader>(nullptr));
+	Engine::DrawList opaque(0), transparent(1);
+
+	/**\ Filled on two threads, as jobs would */
+	std::thread first([&]() {
+		transparent.begin();
+		transparent.submit(geometry, material, taggedModel(5.f), 0);
+		transparent.submit(geometry, material, taggedModel(6.f), 0);
+	});
+	std::thread second([&]() {
+		opaque.begin();
+		opaque.submit(geometry, material, taggedModel(3.f), 2);
+		opaque.submit(geometry, material, taggedModel(1.f), 1);
+		opaque.submit(geometry, material, taggedModel(4.f), 2);
+		opaque.submit(geometry, material, taggedModel(2.f), 1);
+	});
+	first.join();
+	second.join();
+
+	Engine::DrawQueue queue;
+	queue.add(transparent.getItems(), transparent.getListKey());
+	queue.add(opaque.getItems(), opaque.getListKey());
+	queue.sort();
+
+	ASSERT_EQ(queue.getItems().size(), 6);
+	for (size_t i = 0; i < 6; i++) EXPECT_EQ(getTag(queue.getItems()[i]), static_cast<float>(i + 1));
+
+	queue.clear();
+	EXPECT_TRUE(queue.getItems().empty());
+}
@@ -0,0 +1,142 @@
+#include "dynamicBVHTests.h"
+
+TEST(Intersection, RayBox) {
+	AABB box(glm::vec3(-1.f), glm::vec3(1.f));
+	float distance = 100.f;
+	EXPECT_TRUE(Engine::Intersection::rayBox(Ray(glm::vec3(-5.f, 0.f, 0.f), glm::vec3(1.f, 0.f, 0.f)), box, distance));
+	EXPECT_FLOAT_EQ(distance, 4.f);
+
+	distance = 100.f;
+	EXPECT_FALSE(Engine::Intersection::rayBox(Ray(glm::vec3(-5.f, 2.f, 0.f), glm::vec3(1.f, 0.f, 0.f)), box, distance));
+	EXPECT_FALSE(Engine::Intersection::rayBox(Ray(glm::vec3(5.f, 0.f, 0.f), glm::vec3(1.f, 0.f, 0.f)), box, distance)); //!< Behind the ray
+	distance = 3.f;
+	EXPECT_FALSE(Engine::Intersection::rayBox(Ray(glm::vec3(-5.f, 0.f, 0.f), glm::vec3(1.f, 0.f, 0.f)), box, distance)); //!< Further than wanted
+	EXPECT_TRUE(Engine::Intersection::rayBox(Ray(glm::vec3(0.5f, 0.f, 0.f), glm::vec3(0.f, 1.f, 0.f)), box, distance));
+	EXPECT_FLOAT_EQ(distance, 0.f); //!< Starting inside
+}
+
+TEST(Intersection, RayTrianglesMatchesOneAtATime) {
+	/**\ 23 triangles, so the four wide loop and the leftovers both run, with a position, normal and UV stride like the scene's */
+	std::vector<float> vertices;
+	std::vector<uint32_t> indices;
+	uint32_t seed = 7;
+	auto random = [&seed]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) * (1.f / 16777216.f) * 4.f - 2.f; };
+	for (uint32_t i = 0; i < 23 * 3; i++) {
+		vertices.insert(vertices.end(), { random(), random(), random(), 0.f, 0.f, 1.f, 0.f, 0.f });
+		indices.push_back(i);
+	}
+
+	for (int test = 0; test < 200; test++) {
+		Ray ray(glm::vec3(random(), random(), -5.f), glm::vec3(random() * 0.2f, random() * 0.2f, 1.f));
+		float expected = 50.f;
+		bool expectedHit = false;
+		for (uint32_t t = 0; t < 23; t++) {
+			const float* v = vertices.data() + t * 24;
+			expectedHit |= Engine::Intersection::rayTriangle(ray, glm::vec3(v[0], v[1], v[2]), glm::vec3(v[8], v[9], v[10]), glm::vec3(v[16], v[17], v[18]), expected);
+		}
+		float distance = 50.f;
+		ASSERT_EQ(Engine::Intersection::rayTriangles(ray, vertices.data(), 8, indices.data(), 23, distance), expectedHit);
+		if (expectedHit) { EXPECT_NEAR(distance, expected, 1e-4f); }
+	}
+}
+
+TEST_F(DynamicBVHTest, QueriesMatchBruteForce) {
+	fill(2000);
+	checkQueries();
+	tree.rebuild();
+	checkQueries();
+}
+
+TEST_F(DynamicBVHTest, MoveAndRemove) {
+	fill(2000);
+	uint32_t reinserted = 0;
+	for (uint32_t i = 0; i < 1000; i++) {
+		boxes[i] = randomBox();
+		reinserted += tree.move(proxies[i], boxes[i]);
+	}
+	EXPECT_GT(reinserted, 900u); //!< Jumping across the space always leaves the margin
+
+	/**\ A small nudge stays inside the margin and doesn't touch the tree */
+	boxes[1500] = AABB(boxes[1500].min + glm::vec3(0.05f), boxes[1500].max + glm::vec3(0.05f));
+	EXPECT_FALSE(tree.move(proxies[1500], boxes[1500]));
+
+	for (uint32_t i = 1000; i < 1300; i++) {
+		tree.remove(proxies[i]);
+		boxes[i] = AABB(glm::vec3(1e6f), glm::vec3(1e6f + 1.f)); //!< Out of reach of every query
+	}
+	EXPECT_EQ(tree.getProxyCount(), 1700u);
+	checkQueries();
+
+	Engine::DynamicBVH::Proxy reused = tree.insert(randomBox(), 9999);
+	EXPECT_GE(reused, proxies[1000]);
+	EXPECT_LT(reused, proxies[1300]); //!< One of the freed ones
+}
+
+TEST_F(DynamicBVHTest, RefitAndRebuildWhenLoose) {
+	fill(2000);
+	tree.rebuild();
+	uint32_t rebuilds = tree.getRebuildCount();
+
+	/**\ Small moves: refitted in place, the tree stays good enough */
+	for (uint32_t i = 0; i < 2000; i++) {
+		boxes[i] = AABB(boxes[i].min + glm::vec3(0.3f, 0.f, 0.f), boxes[i].max + glm::vec3(0.3f, 0.f, 0.f));
+		tree.setBox(proxies[i], boxes[i]);
+	}
+	tree.refit();
+	EXPECT_EQ(tree.getRebuildCount(), rebuilds);
+	checkQueries();
+
+	/**\ Everything scattered: the refitted boxes overlap badly and the tree is rebuilt */
+	for (uint32_t i = 0; i < 2000; i++) {
+		boxes[i] = randomBox();
+		tree.setBox(proxies[i], boxes[i]);
+	}
+	tree.refit();
+	EXPECT_EQ(tree.getRebuildCount(), rebuilds + 1);
+	checkQueries();
+	EXPECT_LT(tree.getHeight(), 32u);
+}
+
+TEST_F(DynamicBVHTest, FrustumMatchesBruteForce) {
+	fill(2000);
+	tree.rebuild();
+	glm::mat4 viewProjection = glm::perspective(glm::radians(45.f), 1.25f, 0.1f, 60.f) * glm::lookAt(glm::vec3(50.f, 50.f, -20.f), glm::vec3(50.f, 50.f, 50.f), glm::vec3(0.f, 1.f, 0.f));
+	Engine::Frustum frustum = Engine::Frustum::fromMatrix(viewProjection);
+
+	std::vector<uint64_t> found, expected;
+	tree.queryFrustum(frustum, found);
+	for (uint32_t i = 0; i < boxes.size(); i++) if (frustum.test(boxes[i]) != Engine::Frustum::Result::Outside) expected.push_back(i);
+	EXPECT_FALSE(expected.empty());
+	EXPECT_LT(expected.size(), boxes.size());
+	EXPECT_EQ(sorted(found), expected);
+}
+
+TEST_F(DynamicBVHTest, ParallelBuildAndBatches) {
+	Engine::jobSystem jobs(4);
+	jobs.start();
+	{
+		fill(10000); //!< Big enough for the top of the build to be split into jobs
+		tree.rebuild();
+		checkQueries();
+
+		std::vector<Ray> rays;
+		for (int i = 0; i < 500; i++) rays.push_back(Ray(glm::vec3(random() * 100.f, random() * 100.f, -10.f), glm::normalize(glm::vec3(random() - 0.5f, random() - 0.5f, 1.f))));
+		std::vector<RayHit> hits(rays.size());
+		tree.raycastBatch(rays.data(), static_cast<uint32_t>(rays.size()), 200.f, hits.data());
+		for (uint32_t i = 0; i < rays.size(); i++) {
+			RayHit expected = tree.raycast(rays[i], 200.f);
+			ASSERT_EQ(hits[i].proxy, expected.proxy);
+		}
+
+		Engine::Frustum frustums[3];
+		for (int i = 0; i < 3; i++) frustums[i] = Engine::Frustum::fromMatrix(glm::perspective(glm::radians(30.f + 20.f * i), 1.f, 0.1f, 80.f) * glm::lookAt(glm::vec3(50.f, 50.f, -20.f), glm::vec3(50.f), glm::vec3(0.f, 1.f, 0.f)));
+		std::vector<uint64_t> results[3];
+		tree.queryFrustumBatch(frustums, 3, results);
+		for (int i = 0; i < 3; i++) {
+			std::vector<uint64_t> expected;
+			tree.queryFrustum(frustums[i], expected);
+			EXPECT_EQ(sorted(results[i]), sorted(expected));
+		}
+	}
+	jobs.stop();
+}
@@ -0,0 +1,86 @@
+#include "ecsTests.h"
+
+TEST(World, CreateAndGet) {
+	Engine::World world;
+	Engine::Entity entity = world.create(Position{ 1.f, 2.f, 3.f }, Health{ 10 });
+
+	ASSERT_TRUE(world.isAlive(entity));
+	EXPECT_TRUE(world.has<Position>(entity));
+	EXPECT_FALSE(world.has<Velocity>(entity));
+	EXPECT_EQ(world.get<Position>(entity)->y, 2.f);
+	EXPECT_EQ(world.get<Health>(entity)->value, 10);
+	EXPECT_EQ(world.get<Velocity>(entity), nullptr);
+}
+
+TEST(World, AddAndRemoveKeepValues) {
+	Engine::World world;
+	Engine::Entity entity = world.create(Position{ 1.f, 2.f, 3.f });
+
+	world.add(entity, Velocity{ 4.f, 5.f, 6.f });
+	EXPECT_EQ(world.get<Position>(entity)->x, 1.f);
+	EXPECT_EQ(world.get<Velocity>(entity)->z, 6.f);
+
+	world.add(entity, Velocity{ 7.f, 8.f, 9.f }); //!< Already has one, overwritten in place
+	EXPECT_EQ(world.get<Velocity>(entity)->x, 7.f);
+	EXPECT_EQ(world.getArchetypeCount(), 2);
+
+	world.remove<Position>(entity);
+	EXPECT_FALSE(world.has<Position>(entity));
+	EXPECT_EQ(world.get<Velocity>(entity)->y, 8.f);
+}
+
+TEST(World, DestroyMovesLastRowAndInvalidatesHandle) {
+	Engine::World world;
+	std::vector<Engine::Entity> entities;
+	for (int i = 0; i < 5; i++) entities.push_back(world.create(Health{ i }));
+
+	world.destroy(entities[1]); //!< Entity 4 fills the gap
+	EXPECT_FALSE(world.isAlive(entities[1]));
+	EXPECT_EQ(world.get<Health>(entities[1]), nullptr);
+	for (int i : { 0, 2, 3, 4 }) EXPECT_EQ(world.get<Health>(entities[i])->value, i);
+
+	Engine::Entity reused = world.create(Health{ 99 });
+	EXPECT_EQ(reused.index, entities[1].index);
+	EXPECT_NE(reused.generation, entities[1].generation);
+	EXPECT_FALSE(world.isAlive(entities[1])); //!< The old handle still can't reach the slot
+	EXPECT_EQ(world.getCount(), 5);
+}
+
+TEST(World, QueriesMatchEveryArchetypeWithTheComponents) {
+	Engine::World world(1024); //!< Small chunks so the entities span several
+	for (int i = 0; i < 500; i++) {
+		if (i % 2) world.create(Position{ 0.f, 0.f, 0.f }, Velocity{ 1.f, 0.f, 0.f });
+		else world.create(Position{ 0.f, 0.f, 0.f }, Velocity{ 2.f, 0.f, 0.f }, Health{ i });
+	}
+	world.create(Position{ 0.f, 0.f, 0.f }); //!< No velocity, not in the query
+
+	uint32_t chunks = 0;
+	world.forEachChunk<Position, Velocity>([&](uint32_t arg_count, const Engine::Entity* arg_entities, Position* arg_positions, Velocity* arg_velocities) {
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(arg_positions) % 64, 0);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(arg_velocities) % 64, 0);
+		for (uint32_t i = 0; i < arg_count; i++) arg_positions[i].x += arg_velocities[i].x;
+		chunks++;
+	});
+	EXPECT_GT(chunks, 2);
+
+	float total = 0.f;
+	uint32_t count = 0;
+	world.forEach<Position>([&](Position& arg_position) { total += arg_position.x; count++; });
+	EXPECT_EQ(count, 501);
+	EXPECT_EQ(total, 250.f * 1.f + 250.f * 2.f);
+}
+
+TEST(World, ParallelForEachVisitsEveryEntityOnce) {
+	Engine::jobSystem jobs(4);
+	jobs.start();
+	{
+		Engine::World world(2048);
+		for (int i = 0; i < 10000; i++) world.create(Health{ 0 });
+		world.parallelForEach<Health>([](Health& arg_health) { arg_health.value++; });
+
+		int32_t total = 0;
+		world.forEach<Health>([&](Health& arg_health) { EXPECT_EQ(arg_health.value, 1); total += arg_health.value; });
+		EXPECT_EQ(total, 10000);
+	}
+	jobs.stop();
+}
@@ -0,0 +1,153 @@
+#include "eventQueueTests.h"
+
+TEST(EventQueue, DispatchesCopiesInOrder) {
+	Engine::EventQueue queue(16);
+	QueueLayer layer;
+	Engine::EventDispatchTable table;
+	layer.addTo(table);
+	queue.pushLayer(table);
+
+	{
+		Engine::KeyPressedEvent first(1, 0);
+		Engine::KeyPressedEvent second(2, 0);
+		EXPECT_TRUE(queue.post(first));
+		EXPECT_TRUE(queue.post(static_cast<Engine::Event&>(second))); //!< Through the base, as the window callback does
+	}
+	EXPECT_TRUE(layer.keys.empty()); //!< Nothing runs until dispatch
+	EXPECT_EQ(queue.dispatch(), 2);
+	EXPECT_EQ(layer.keys, std::vector<int>({ 1, 2 }));
+	EXPECT_EQ(queue.dispatch(), 0);
+}
+
+TEST(EventQueue, CoalescesRunsOfTheSameType) {
+	Engine::EventQueue queue(64);
+	QueueLayer layer;
+	Engine::EventDispatchTable table;
+	layer.addTo(table);
+	queue.pushLayer(table);
+
+	for (int i = 0; i < 5; i++) queue.post(Engine::MouseMovedEvent(static_cast<float>(i), 0.f));
+	queue.post(Engine::MouseButtonPressedEvent(0));
+	for (int i = 10; i < 13; i++) queue.post(Engine::MouseMovedEvent(static_cast<float>(i), 0.f));
+	queue.post(Engine::WindowResizeEvent(800, 600));
+	queue.post(Engine::WindowResizeEvent(1024, 720));
+	queue.post(Engine::KeyPressedEvent(5, 0));
+	queue.post(Engine::KeyPressedEvent(5, 1)); //!< Keys aren't coalesced
+
+	EXPECT_EQ(queue.dispatch(), 6);
+	EXPECT_EQ(layer.moves, std::vector<float>({ 4.f, 12.f })); //!< The last of each run, either side of the click
+	EXPECT_EQ(layer.clicks, 1);
+	EXPECT_EQ(layer.resizes, 1);
+	EXPECT_EQ(layer.keys.size(), 2);
+	EXPECT_EQ(queue.getCoalescedCount(), 7);
+
+	queue.setCoalesced(Engine::EventType::MouseMoved, false);
+	for (int i = 0; i < 3; i++) queue.post(Engine::MouseMovedEvent(static_cast<float>(i), 0.f));
+	queue.dispatch();
+	EXPECT_EQ(layer.moves.size(), 5);
+}
+
+TEST(EventQueue, LayersFromTheTopUntilHandled) {
+	Engine::EventQueue queue(16);
+	QueueLayer game, overlay;
+	Engine::EventDispatchTable gameTable, overlayTable;
+	game.addTo(gameTable);
+	overlay.addTo(overlayTable);
+	queue.pushLayer(gameTable);
+	queue.pushLayer(overlayTable);
+
+	queue.post(Engine::KeyPressedEvent(1, 0));
+	queue.dispatch();
+	EXPECT_EQ(overlay.keys.size(), 1);
+	EXPECT_TRUE(game.keys.empty()); //!< The overlay handled it
+
+	overlay.handleKeys = false;
+	queue.post(Engine::KeyPressedEvent(2, 0));
+	queue.dispatch();
+	EXPECT_EQ(overlay.keys.size(), 2);
+	EXPECT_EQ(game.keys, std::vector<int>({ 2 }));
+
+	queue.removeLayer(overlayTable);
+	queue.post(Engine::KeyPressedEvent(3, 0));
+	queue.dispatch();
+	EXPECT_EQ(overlay.keys.size(), 2);
+	EXPECT_EQ(game.keys.size(), 2);
+}
+
+TEST(EventQueue, PostedWhileDispatchingWaitsForTheNextFrame) {
+	Engine::EventQueue queue(16);
+	QueueLayer layer;
+	Engine::EventDispatchTable table;
+	layer.addTo(table);
+	queue.pushLayer(table);
+	layer.postTo = &queue;
+
+	queue.post(Engine::MouseButtonPressedEvent(0));
+	EXPECT_EQ(queue.dispatch(), 1);
+	EXPECT_TRUE(layer.keys.empty());
+	EXPECT_EQ(queue.dispatch(), 1);
+	EXPECT_EQ(layer.keys, std::vector<int>({ 99 }));
+}
+
+TEST(EventQueue, DropsWhenFull) {
+	Engine::EventQueue queue(4);
+	for (int i = 0; i < 4; i++) EXPECT_TRUE(queue.post(Engine::KeyPressedEvent(i, 0)));
+	EXPECT_FALSE(queue.post(Engine::KeyPressedEvent(4, 0)));
+	EXPECT_EQ(queue.getDroppedCount(), 1);
+	EXPECT_EQ(queue.dispatch(), 4); //!< With no layers they are just discarded
+	EXPECT_TRUE(queue.post(Engine::KeyPressedEvent(5, 0)));
+}
+
+TEST(EventQueue, ThreadsPostWithoutLosingOrder) {
+	const int threadCount = 4;
+	const int postCount = 2000;
+	Engine::EventQueue queue(256);
+	QueueLayer layer;
+	Engine::EventDispatchTable table;
+	layer.addTo(table);
+	queue.pushLayer(table);
+
+	std::atomic<int> running{ threadCount };
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; t++) {
+		threads.emplace_back([&queue, &running, t]() {
+			for (int i = 0; i < postCount; i++) {
+				while (!queue.post(Engine::KeyPressedEvent(t * postCount + i, 0))) std::this_thread::yield(); //!< Full, wait for the main thread
+			}
+			running--;
+		});
+	}
+	while (running > 0) {
+		queue.dispatch();
+		std::this_thread::yield();
+	}
+	for (auto& thread : threads) thread.join();
+	queue.dispatch();
+
+	ASSERT_EQ(layer.keys.size(), threadCount * postCount);
+	int next[threadCount] = {};
+	for (int key : layer.keys) {
+		int t = key / postCount;
+		EXPECT_EQ(key % postCount, next[t]);
+		next[t]++;
+	}
+}
+
+TEST(EventQueue, StampsTheTimePosted) {
+	Engine::EventQueue queue(16);
+	QueueLayer layer;
+	Engine::EventDispatchTable table;
+	table.add<&QueueLayer::onKeyPressed>(&layer);
+	queue.pushLayer(table);
+
+	Engine::EventDispatchTable timeTable;
+	timeTable.add<&stampOf>(); //!< Above the layer, so it sees the key first
+	queue.pushLayer(timeTable);
+
+	Engine::timer::setClock([]() { return uint64_t(5000); });
+	queue.post(Engine::KeyPressedEvent(1, 0));
+	Engine::timer::setClock(nullptr);
+	queue.dispatch();
+	EXPECT_EQ(s_lastStamp, 5000);
+	EXPECT_EQ(layer.keys.size(), 1);
+}
@@ -51,4 +51,70 @@ TEST(Events, DispatchHandleFalse) {
 	dispatcher.dispatch<Engine::WindowResizeEvent>(std::bind(OnResizeFalse, std::placeholders::_1));
 	bool result = re.handled();
 	EXPECT_FALSE(result);
-}
\ No newline at end of file
+}
+
+TEST(Events, DispatchTableCallsTheHandlerForTheType) {
+	EventCounter counter;
+	Engine::EventDispatchTable table;
+	EXPECT_TRUE(table.add<&EventCounter::onResize>(&counter));
+	EXPECT_TRUE(table.add<&EventCounter::onClose>(&counter));
+
+	EXPECT_TRUE(table.dispatch(re));
+	EXPECT_TRUE(table.dispatch(ce));
+	EXPECT_TRUE(table.dispatch(re));
+	EXPECT_FALSE(table.dispatch(mme)); //!< No handler
+	EXPECT_EQ(counter.resizes, 2);
+	EXPECT_EQ(counter.closes, 1);
+	EXPECT_TRUE(re.handled());
+	EXPECT_FALSE(ce.handled());
+}
+TEST(Events, DispatchTableHandle) {
+	Engine::EventDispatchTable table;
+	table.add<&OnResizeFalse>();
+	table.dispatch(re);
+	EXPECT_FALSE(re.handled());
+
+	Engine::EventDispatchTable handling;
+	handling.add<&OnResizeTrue>();
+	handling.dispatch(re);
+	EXPECT_TRUE(re.handled());
+}
+TEST(Events, DispatchTableStopsOnceHandled) {
+	EventCounter first, second;
+	Engine::EventDispatchTable table;
+	table.add<&EventCounter::onClose>(&first); //!< Doesn't handle it
+	table.add<&EventCounter::onClose>(&second);
+	table.add<&EventCounter::onResize>(&first); //!< Handles it
+	table.add<&EventCounter::onResize>(&second);
+	EXPECT_EQ(table.getHandlerCount(Engine::EventType::WindowClose), 2);
+
+	table.dispatch(ce);
+	table.dispatch(re);
+	EXPECT_EQ(first.closes + second.closes, 2);
+	EXPECT_EQ(first.resizes, 1);
+	EXPECT_EQ(second.resizes, 0);
+
+	table.remove(&first);
+	table.dispatch(re);
+	EXPECT_EQ(second.resizes, 1);
+	EXPECT_EQ(table.getHandlerCount(Engine::EventType::WindowClose), 1);
+}
+TEST(Events, DispatchTableFiltersByCategory) {
+	EventCounter counter;
+	Engine::EventDispatchTable table;
+	table.add<&EventCounter::onResize>(&counter);
+	table.add<&EventCounter::onMouseMoved>(&counter);
+
+	table.setCategories(Engine::EventCategoryWindow); //!< Input ignored
+	EXPECT_FALSE(table.dispatch(mme));
+	EXPECT_TRUE(table.dispatch(re));
+	table.setCategories(Engine::EventDispatchTable::s_allCategories);
+	EXPECT_TRUE(table.dispatch(mme));
+	EXPECT_EQ(counter.moves, 1);
+	EXPECT_EQ(counter.resizes, 1);
+}
+TEST(Events, DispatchTableIsFull) {
+	Engine::EventDispatchTable table;
+	for (uint32_t i = 0; i < Engine::EventDispatchTable::s_maxHandlers; i++) EXPECT_TRUE(table.add<&OnResizeTrue>());
+	EXPECT_FALSE(table.add<&OnResizeTrue>());
+}
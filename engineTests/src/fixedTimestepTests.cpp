@@ -0,0 +1,67 @@
+#include "fixedTimestepTests.h"
+
+TEST_F(FixedTimestepTest, CarriesPartialTicks) {
+	now += 15000000;
+	EXPECT_EQ(timestep.advance(), 0);
+	EXPECT_NEAR(timestep.getAlpha(), 0.75f, 1e-5f);
+
+	now += 15000000; //!< 30 ms in total
+	EXPECT_EQ(timestep.advance(), 1);
+	EXPECT_NEAR(timestep.getAlpha(), 0.5f, 1e-5f);
+
+	now += 30000000; //!< 60 ms in total
+	EXPECT_EQ(timestep.advance(), 2);
+	EXPECT_NEAR(timestep.getAlpha(), 0.f, 1e-5f);
+	EXPECT_EQ(timestep.getTickCount(), 3);
+}
+
+TEST_F(FixedTimestepTest, TickCountIndependentOfFrameRate) {
+	Engine::FixedTimestep slow{ 50.0, 4, [this]() { return now; } };
+	uint64_t fastTicks = 0, slowTicks = 0;
+	for (int frame = 0; frame < 1000; frame++) { //!< 1 second at 1000 fps for one, 25 fps for the other
+		now += 1000000;
+		fastTicks += timestep.advance();
+		if (frame % 40 == 39) slowTicks += slow.advance();
+	}
+	EXPECT_EQ(fastTicks, 50);
+	EXPECT_EQ(slowTicks, 50);
+	EXPECT_EQ(slow.getDroppedTime(), 0.0);
+}
+
+TEST_F(FixedTimestepTest, LongFrameIsCapped) {
+	now += 2000000000; //!< A two second hitch
+	uint32_t ticks = 0;
+	double simulated = 0.0;
+	timestep.advance([&](double arg_step) { ticks++; simulated += arg_step; });
+
+	EXPECT_EQ(ticks, 4);
+	EXPECT_NEAR(simulated, 0.08, 1e-9);
+	EXPECT_NEAR(timestep.getDroppedTime(), 1.92, 1e-9);
+	EXPECT_LT(timestep.getAlpha(), 1.f);
+	EXPECT_NEAR(timestep.getFrameTime(), 2.0, 1e-9);
+}
+
+TEST_F(FixedTimestepTest, ResetForgetsElapsedTime) {
+	now += 5000000000; //!< i.e. loading
+	timestep.reset();
+	now += 20000000;
+	EXPECT_EQ(timestep.advance(), 1);
+}
+
+TEST(SimTransform, InterpolatesPositionAndRotation) {
+	Engine::SimTransform previous, current;
+	previous.position = glm::vec3(0.f, 0.f, 0.f);
+	current.position = glm::vec3(4.f, 2.f, 0.f);
+	current.rotation = glm::angleAxis(glm::radians(90.f), glm::vec3(0.f, 1.f, 0.f));
+
+	Engine::SimTransform halfway = Engine::SimTransform::interpolate(previous, current, 0.5f);
+	EXPECT_FLOAT_EQ(halfway.position.x, 2.f);
+	EXPECT_FLOAT_EQ(halfway.position.y, 1.f);
+
+	glm::quat expected = glm::angleAxis(glm::radians(45.f), glm::vec3(0.f, 1.f, 0.f));
+	EXPECT_NEAR(glm::dot(halfway.rotation, expected), 1.f, 1e-5f);
+
+	glm::mat4 model = current.toMatrix();
+	EXPECT_FLOAT_EQ(model[3][0], 4.f);
+	EXPECT_NEAR(model[0][2], -1.f, 1e-5f); //!< x axis turned onto -z
+}
@@ -0,0 +1,110 @@
+#include "frameAllocatorTests.h"
+
+TEST(LinearAllocator, ScopedArenasRewind) {
+	Engine::LinearAllocator allocator(256);
+	allocator.allocate(16);
+	size_t before = allocator.getBytesUsed();
+	void* first;
+	{
+		Engine::ScopedArena outer(allocator);
+		first = outer.allocate(64);
+		{
+			Engine::ScopedArena inner(allocator);
+			for (int i = 0; i < 10; i++) inner.allocate(64); //!< Spills into more blocks
+		}
+		EXPECT_EQ(allocator.getBytesUsed(), before + 64);
+	}
+	EXPECT_EQ(allocator.getBytesUsed(), before);
+	EXPECT_GE(allocator.getPeakBytesUsed(), before + 11 * 64);
+	EXPECT_EQ(allocator.allocate(64), first); //!< Reused straight away
+
+	allocator.reset();
+	EXPECT_EQ(allocator.getBytesUsed(), 0);
+	EXPECT_GE(allocator.getPeakBytesUsed(), before + 11 * 64); //!< Kept across resets
+}
+
+TEST(LinearAllocator, ContainersInAnArena) {
+	Engine::LinearAllocator allocator(1024);
+	uint32_t blocks;
+	{
+		Engine::ScopedArena arena(allocator);
+		std::vector<uint64_t, Engine::ArenaAllocator<uint64_t>> numbers(Engine::ArenaAllocator<uint64_t>(arena.getAllocator()));
+		numbers.reserve(64);
+		for (uint64_t i = 0; i < 64; i++) numbers.push_back(i * i);
+		EXPECT_EQ(numbers[63], 63 * 63);
+
+		Engine::FrameString text("long enough to not fit in the small string buffer", Engine::ArenaAllocator<char>(allocator));
+		text += " and then some";
+		EXPECT_EQ(text.size(), 63);
+		EXPECT_GE(allocator.getBytesUsed(), 64 * sizeof(uint64_t) + text.size());
+		blocks = allocator.getBlockCount();
+	}
+	EXPECT_EQ(allocator.getBytesUsed(), 0);
+	EXPECT_EQ(allocator.getBlockCount(), blocks);
+}
+
+TEST_F(FrameLoopTest, MemoryLastsBufferCountFrames) {
+	for (uint32_t bufferCount = 2; bufferCount <= 3; bufferCount++) {
+		Engine::FrameAllocator::setBufferCount(bufferCount);
+		Engine::FrameAllocator::beginFrame();
+		const char* text = Engine::FrameAllocator::format("frame %d", 1);
+		EXPECT_STREQ(text, "frame 1");
+
+		for (uint32_t frame = 1; frame < bufferCount; frame++) {
+			Engine::FrameAllocator::beginFrame();
+			Engine::FrameAllocator::format("frame %u", frame + 1);
+			EXPECT_STREQ(text, "frame 1"); //!< Still untouched
+		}
+		Engine::FrameAllocator::beginFrame();
+		EXPECT_EQ(Engine::FrameAllocator::getBytesUsed(), 0);
+		EXPECT_EQ(Engine::FrameAllocator::allocate(8, 1), static_cast<const void*>(text)); //!< Back round to the first buffer
+	}
+}
+
+TEST_F(FrameLoopTest, SteadyStateFramesDontTouchTheHeap) {
+	uint32_t indices[3] = { 0, 1, 2 };
+	std::shared_ptr<Engine::VertexArray> vertexArray(Engine::VertexArray::create());
+	std::shared_ptr<Engine::IndexBuffer> indexBuffer(Engine::IndexBuffer::create(indices, 3));
+	vertexArray->setIndexBuffer(indexBuffer);
+	Engine::Material material(std::shared_ptr<Engine::Shader>(nullptr));
+	Engine::DrawList draws;
+	std::atomic<uint32_t> textLength{ 0 };
+
+	/**\ A frame of the kinds of transient work the game loop does */
+	auto frame = [&](int arg_frame) {
+		Engine::FrameAllocator::beginFrame();
+
+		Engine::FrameVector<glm::mat4> models(Engine::FrameAllocator::getAdapter<glm::mat4>());
+		models.reserve(100);
+		for (int i = 0; i < 100; i++) models.push_back(glm::mat4(static_cast<float>(i + arg_frame)));
+		{
+			Engine::ScopedArena scratch(Engine::FrameAllocator::get());
+			float* distances = static_cast<float*>(scratch.allocate(sizeof(float) * models.size(), alignof(float)));
+			for (size_t i = 0; i < models.size(); i++) distances[i] = models[i][3][3];
+		}
+
+		draws.begin();
+		for (auto& model : models) draws.submit(*vertexArray, material, model);
+
+		const char* text = Engine::FrameAllocator::format("fps: %d p99: %dms", 60 + arg_frame % 3, 16);
+		Engine::RenderThread::record([](Engine::RenderBackend& arg_backend) { arg_backend.clear(); });
+		Engine::RenderThread::record([text, &textLength]() { textLength += static_cast<uint32_t>(strlen(text)); }); //!< Read a frame later
+		for (auto* item : draws.getItems()) Engine::RenderThread::record([vertexArray = item->geometry](Engine::RenderBackend& arg_backend) { arg_backend.drawIndexed(*vertexArray); });
+		Engine::RenderThread::endFrame();
+	};
+
+	Engine::RenderThread::start(window.getGraphicsContext());
+	for (int i = 0; i < 10; i++) frame(i); //!< Everything grows to fit
+	uint32_t blocks = Engine::FrameAllocator::getBlockCount();
+
+	uint64_t before = Engine::MemoryTracker::getAllocationCount(); //!< Every thread's, the render thread's included
+	for (int i = 10; i < 200; i++) frame(i);
+	uint64_t allocations = Engine::MemoryTracker::getAllocationCount() - before;
+	Engine::RenderThread::stop();
+
+	EXPECT_EQ(allocations, 0);
+	EXPECT_EQ(Engine::FrameAllocator::getBlockCount(), blocks);
+	EXPECT_GE(Engine::FrameAllocator::getPeakBytesUsed(), 100 * sizeof(glm::mat4));
+	EXPECT_EQ(stats.drawCalls.load(), 200 * 100);
+	EXPECT_EQ(textLength.load(), 200 * strlen("fps: 60 p99: 16ms"));
+}
@@ -0,0 +1,171 @@
+#include "inputRecorderTests.h"
+
+TEST_F(InputRecorderTest, ReplaysTheSameEventsAndTimes) {
+	ASSERT_TRUE(m_recorder.startRecording(m_path, 1024, 800));
+	m_queue.pushLayer(m_recorder.getLayer());
+
+	Engine::KeyPressedEvent key(NG_KEY_SPACE, 0);
+	Engine::MouseMovedEvent moved(12.5f, -3.25f);
+	Engine::MouseButtonPressedEvent button(NG_MOUSE_BUTTON_1);
+	Engine::KeyReleasedEvent released(NG_KEY_SPACE);
+	Engine::MouseScrolledEvent scrolled(0.f, -1.f);
+	recordFrame({ &key, &moved }, 16000000);
+	recordFrame({}, 17000000);
+	recordFrame({ &button, &released, &scrolled }, 15999999);
+	EXPECT_EQ(m_recorder.getFrameCount(), 3);
+	m_recorder.stop();
+	m_queue.removeLayer(m_recorder.getLayer());
+
+	/**\ Through another table, so it is the recording that arrives and not the input state */
+	QueueCapture capture;
+	Engine::EventQueue replayQueue(64);
+	Engine::EventDispatchTable captureTable;
+	capture.addTo(captureTable);
+	replayQueue.pushLayer(captureTable);
+
+	ASSERT_TRUE(m_recorder.startReplay(m_path));
+	std::vector<uint64_t> times;
+	while (m_recorder.beginFrame()) {
+		times.push_back(m_recorder.getTime());
+		m_recorder.sendEvents(replayQueue);
+		capture.frames++;
+	}
+	EXPECT_EQ(times, std::vector<uint64_t>({ 16000000, 33000000, 48999999 }));
+	EXPECT_EQ(capture.log, std::vector<std::string>({ "key 32 0 @0", "move 12.5 -3.25 @0", "button 0 @2", "release 32 @2", "scroll 0 -1 @2" }));
+}
+
+TEST_F(InputRecorderTest, ReplayGivesTheSameSnapshots) {
+	ASSERT_TRUE(m_recorder.startRecording(m_path, 1024, 800));
+	m_queue.pushLayer(m_recorder.getLayer());
+
+	Engine::MouseMovedEvent first(100.f, 100.f);
+	Engine::MouseMovedEvent second(110.f, 95.f);
+	Engine::MouseButtonPressedEvent pressed(NG_MOUSE_BUTTON_1);
+	Engine::MouseButtonReleasedEvent released(NG_MOUSE_BUTTON_1);
+	Engine::KeyPressedEvent key(NG_KEY_UP, 0);
+	Engine::KeyPressedEvent repeat(NG_KEY_UP, 1);
+	std::vector<Engine::InputSnapshot> recorded;
+	recordFrame({ &first, &key }, 1); recorded.push_back(Engine::InputState::getSnapshot());
+	recordFrame({ &pressed, &second, &repeat }, 1); recorded.push_back(Engine::InputState::getSnapshot());
+	recordFrame({ &released }, 1); recorded.push_back(Engine::InputState::getSnapshot());
+	recordFrame({}, 1); recorded.push_back(Engine::InputState::getSnapshot());
+	m_recorder.stop();
+	m_queue.removeLayer(m_recorder.getLayer());
+
+	/**\ Replaying into the same queue, as the application does, from nothing down */
+	Engine::InputState::reset();
+	ASSERT_TRUE(m_recorder.startReplay(m_path));
+	for (const Engine::InputSnapshot& expected : recorded) {
+		ASSERT_TRUE(m_recorder.beginFrame());
+		Engine::InputState::beginFrame();
+		const Engine::InputSnapshot& snapshot = Engine::InputState::getSnapshot();
+		EXPECT_EQ(snapshot.keysDown, expected.keysDown);
+		EXPECT_EQ(snapshot.keysPressed, expected.keysPressed);
+		EXPECT_EQ(snapshot.buttonsPressed, expected.buttonsPressed);
+		EXPECT_EQ(snapshot.buttonsReleased, expected.buttonsReleased);
+		EXPECT_EQ(snapshot.mousePosition, expected.mousePosition);
+		EXPECT_EQ(snapshot.mouseDelta, expected.mouseDelta);
+		m_recorder.sendEvents(m_queue);
+	}
+	EXPECT_FALSE(m_recorder.beginFrame());
+}
+
+TEST_F(InputRecorderTest, ReplayClockRunsTheSameTicks) {
+	uint64_t now = 0;
+	Engine::FixedTimestep live(60.0, 3, [&now]() { return now; });
+	const uint64_t frameTimes[] = { 9000000, 16666667, 40000000, 3000000, 120000000, 16666666, 1 };
+
+	ASSERT_TRUE(m_recorder.startRecording(m_path, 1024, 800));
+	std::vector<uint32_t> ticks;
+	std::vector<float> alphas;
+	for (uint64_t frameTime : frameTimes) {
+		now += frameTime;
+		ticks.push_back(live.advance());
+		alphas.push_back(live.getAlpha());
+		m_recorder.endFrame(live.getFrameTimeNanoseconds());
+	}
+	m_recorder.stop();
+
+	ASSERT_TRUE(m_recorder.startReplay(m_path));
+	Engine::FixedTimestep replayed(60.0, 3);
+	replayed.setClock([this]() { return m_recorder.getTime(); });
+	for (size_t i = 0; i < ticks.size(); i++) {
+		ASSERT_TRUE(m_recorder.beginFrame());
+		EXPECT_EQ(replayed.advance(), ticks[i]);
+		EXPECT_EQ(replayed.getAlpha(), alphas[i]); //!< Exactly, not near
+	}
+	EXPECT_EQ(replayed.getTickCount(), live.getTickCount());
+	EXPECT_EQ(replayed.getDroppedTime(), live.getDroppedTime());
+}
+
+TEST_F(InputRecorderTest, QuietFramesAreSmall) {
+	ASSERT_TRUE(m_recorder.startRecording(m_path, 1024, 800));
+	for (int i = 0; i < 600; i++) m_recorder.endFrame(16666667);
+	m_recorder.stop();
+	EXPECT_EQ(std::filesystem::file_size(m_path), 16 + 600 * 5); //!< Header, then four bytes of time and one of count a frame
+}
+
+TEST_F(InputRecorderTest, FilesStartWithTheTag) {
+	ASSERT_TRUE(m_recorder.startRecording(m_path, 1024, 800));
+	m_recorder.stop();
+	char tag[4] = {};
+	std::ifstream(m_path, std::ios::binary).read(tag, 4);
+	EXPECT_EQ(std::string(tag, 4), "NGIR");
+}
+
+TEST_F(InputRecorderTest, ReplayFollowsTheRecordedWindowSize) {
+	ASSERT_TRUE(m_recorder.startRecording(m_path, 1024, 800));
+	m_queue.pushLayer(m_recorder.getLayer());
+	Engine::WindowResizeEvent resize(1280, 720);
+	Engine::MouseMovedEvent moved(640.f, 360.f);
+	recordFrame({}, 1);
+	recordFrame({ &resize, &moved }, 1);
+	m_recorder.stop();
+	m_queue.removeLayer(m_recorder.getLayer());
+
+	QueueCapture capture;
+	Engine::EventQueue replayQueue(64);
+	Engine::EventDispatchTable captureTable;
+	capture.addTo(captureTable);
+	replayQueue.pushLayer(captureTable);
+
+	ASSERT_TRUE(m_recorder.startReplay(m_path));
+	EXPECT_EQ(m_recorder.getWindowWidth(), 1024);
+	EXPECT_EQ(m_recorder.getWindowHeight(), 800);
+	ASSERT_TRUE(m_recorder.beginFrame());
+	m_recorder.sendEvents(replayQueue);
+	ASSERT_TRUE(m_recorder.beginFrame());
+	EXPECT_EQ(m_recorder.getWindowWidth(), 1024); //!< Not until the frame's events are sent, where the resize was dispatched
+	m_recorder.sendEvents(replayQueue);
+	EXPECT_EQ(m_recorder.getWindowWidth(), 1280);
+	EXPECT_EQ(m_recorder.getWindowHeight(), 720);
+	EXPECT_EQ(capture.log, std::vector<std::string>({ "move 640 360 @0" })); //!< The resize itself isn't sent
+}
+
+TEST_F(InputRecorderTest, FailedWritesEndTheRecording) {
+	if (!std::filesystem::exists("/dev/full")) GTEST_SKIP() << "Needs a device that fails every write";
+	ASSERT_TRUE(m_recorder.startRecording("/dev/full", 1024, 800)); //!< Opens, the header is only buffered
+	for (int i = 0; i < 100000 && m_recorder.isRecording(); i++) m_recorder.endFrame(16666667);
+	EXPECT_FALSE(m_recorder.isRecording()); //!< Once the buffer is written out
+	EXPECT_LT(m_recorder.getFrameCount(), 100000);
+}
+
+TEST_F(InputRecorderTest, RejectsWhatIsntARecording) {
+	EXPECT_FALSE(m_recorder.startReplay(m_path + ".missing"));
+	{
+		std::ofstream handle(m_path, std::ios::out | std::ios::binary | std::ios::trunc);
+		handle << "not a recording";
+	}
+	EXPECT_FALSE(m_recorder.startReplay(m_path));
+	EXPECT_FALSE(m_recorder.isReplaying());
+
+	/**\ A frame cut short ends the replay rather than sending half of it */
+	ASSERT_TRUE(m_recorder.startRecording(m_path, 1024, 800));
+	m_queue.pushLayer(m_recorder.getLayer());
+	Engine::MouseMovedEvent moved(1.f, 2.f);
+	recordFrame({ &moved }, 1000);
+	m_recorder.stop();
+	std::filesystem::resize_file(m_path, std::filesystem::file_size(m_path) - 1);
+	ASSERT_TRUE(m_recorder.startReplay(m_path));
+	EXPECT_FALSE(m_recorder.beginFrame());
+}
@@ -0,0 +1,94 @@
+#include "inputStateTests.h"
+
+TEST_F(InputStateTest, KeyEdgesLastOneFrame) {
+	send(Engine::KeyPressedEvent(NG_KEY_SPACE, 0));
+	EXPECT_FALSE(Engine::InputState::isDown(NG_KEY_SPACE)); //!< Not until the frame begins
+
+	Engine::InputState::beginFrame();
+	EXPECT_TRUE(Engine::InputState::isDown(NG_KEY_SPACE));
+	EXPECT_TRUE(Engine::InputState::wasPressed(NG_KEY_SPACE));
+	EXPECT_FALSE(Engine::InputState::wasReleased(NG_KEY_SPACE));
+
+	send(Engine::KeyPressedEvent(NG_KEY_SPACE, 1)); //!< Repeat
+	Engine::InputState::beginFrame();
+	EXPECT_TRUE(Engine::InputState::isDown(NG_KEY_SPACE));
+	EXPECT_FALSE(Engine::InputState::wasPressed(NG_KEY_SPACE));
+	EXPECT_TRUE(Engine::InputState::getPrevious().keysPressed[NG_KEY_SPACE]);
+
+	send(Engine::KeyReleasedEvent(NG_KEY_SPACE));
+	Engine::InputState::beginFrame();
+	EXPECT_FALSE(Engine::InputState::isDown(NG_KEY_SPACE));
+	EXPECT_TRUE(Engine::InputState::wasReleased(NG_KEY_SPACE));
+
+	Engine::InputState::beginFrame();
+	EXPECT_FALSE(Engine::InputState::wasReleased(NG_KEY_SPACE));
+}
+
+TEST_F(InputStateTest, TapBetweenFramesIsNotMissed) {
+	send(Engine::MouseButtonPressedEvent(NG_MOUSE_BUTTON_1));
+	send(Engine::MouseButtonReleasedEvent(NG_MOUSE_BUTTON_1));
+	Engine::InputState::beginFrame();
+	EXPECT_FALSE(Engine::InputState::isMouseDown(NG_MOUSE_BUTTON_1));
+	EXPECT_TRUE(Engine::InputState::wasMousePressed(NG_MOUSE_BUTTON_1));
+	EXPECT_TRUE(Engine::InputState::wasMouseReleased(NG_MOUSE_BUTTON_1));
+}
+
+TEST_F(InputStateTest, MouseAndScrollAccumulateOverTheFrame) {
+	send(Engine::MouseMovedEvent(100.f, 100.f)); //!< First position, no delta
+	Engine::InputState::beginFrame();
+	EXPECT_EQ(Engine::InputState::getMouseDelta(), glm::vec2(0.f));
+
+	send(Engine::MouseMovedEvent(110.f, 95.f));
+	send(Engine::MouseMovedEvent(130.f, 90.f));
+	send(Engine::MouseScrolledEvent(0.f, 1.f));
+	send(Engine::MouseScrolledEvent(0.f, 2.f));
+	Engine::InputState::beginFrame();
+	EXPECT_EQ(Engine::InputState::getMousePosition(), glm::vec2(130.f, 90.f));
+	EXPECT_EQ(Engine::InputState::getMouseDelta(), glm::vec2(30.f, -10.f));
+	EXPECT_EQ(Engine::InputState::getScrollDelta(), glm::vec2(0.f, 3.f));
+
+	Engine::InputState::beginFrame();
+	EXPECT_EQ(Engine::InputState::getMouseDelta(), glm::vec2(0.f));
+	EXPECT_EQ(Engine::InputState::getMousePosition(), glm::vec2(130.f, 90.f));
+}
+
+TEST_F(InputStateTest, OtherHandlersStillRun) {
+	s_laterSawKey = false;
+	m_table.add<&laterOnKey>();
+
+	Engine::KeyPressedEvent key(NG_KEY_A, 0);
+	m_table.dispatch(key);
+	EXPECT_TRUE(s_laterSawKey);
+	EXPECT_TRUE(key.handled());
+}
+
+TEST_F(InputStateTest, SnapshotsCanBeInjected) {
+	Engine::InputSnapshot snapshot;
+	snapshot.keysDown.set(NG_KEY_W);
+	snapshot.keysPressed.set(NG_KEY_W);
+	snapshot.mouseDelta = glm::vec2(4.f, 2.f);
+	Engine::InputState::beginFrame();
+	Engine::InputState::setSnapshot(snapshot);
+
+	EXPECT_TRUE(Engine::InputState::isDown(NG_KEY_W));
+	EXPECT_TRUE(Engine::InputState::wasPressed(NG_KEY_W));
+	EXPECT_EQ(Engine::InputState::getMouseDelta(), glm::vec2(4.f, 2.f));
+	EXPECT_FALSE(Engine::InputState::isDown(-1)); //!< Out of range codes are never down
+	EXPECT_FALSE(Engine::InputState::isDown(100000));
+}
+
+TEST_F(InputStateTest, KeepsTheOldestEventTime) {
+	Engine::KeyPressedEvent key(NG_KEY_W, 0);
+	Engine::MouseMovedEvent moved(1.f, 1.f);
+	Engine::MouseMovedEvent unstamped(2.f, 2.f); //!< Never queued, i.e. replayed
+	key.setTime(300);
+	moved.setTime(200);
+	send(key);
+	send(moved);
+	send(unstamped);
+	Engine::InputState::beginFrame();
+	EXPECT_EQ(Engine::InputState::getSnapshot().eventTime, 200);
+
+	Engine::InputState::beginFrame();
+	EXPECT_EQ(Engine::InputState::getSnapshot().eventTime, 0); //!< No input this frame
+}
@@ -0,0 +1,118 @@
+#include "jobSystemTests.h"
+
+/**\ These are stress tests as much as unit tests, they are meant to be run under ThreadSanitizer as well (premake5 --tsan) */
+
+TEST(WorkStealingDeque, EveryItemTakenOnce) {
+	const int itemCount = 100000;
+	std::vector<int> items(itemCount);
+	std::vector<std::atomic<int>> taken(itemCount);
+	Engine::WorkStealingDeque<int> deque(256);
+	std::atomic<bool> done{ false };
+
+	std::vector<std::thread> thieves;
+	for (int i = 0; i < 3; i++) {
+		thieves.emplace_back([&]() {
+			while (!done || !deque.empty()) {
+				if (int* item = deque.steal()) taken[*item]++;
+			}
+		});
+	}
+
+	for (int i = 0; i < itemCount; i++) {
+		items[i] = i;
+		while (!deque.push(&items[i])) { //!< Full, the owner helps empty it
+			if (int* item = deque.pop()) taken[*item]++;
+		}
+		if (i % 3 == 0) {
+			if (int* item = deque.pop()) taken[*item]++;
+		}
+	}
+	while (int* item = deque.pop()) taken[*item]++;
+	done = true;
+	for (auto& thief : thieves) thief.join();
+
+	for (int i = 0; i < itemCount; i++) ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+}
+
+TEST_F(JobSystemTest, ManyJobsAllRun) {
+	std::atomic<uint32_t> sum{ 0 };
+	Engine::JobCounter counter;
+	for (uint32_t i = 0; i < 20000; i++) Engine::jobSystem::run([&sum]() { sum++; }, &counter);
+	Engine::jobSystem::wait(counter);
+	EXPECT_EQ(sum.load(), 20000u);
+	EXPECT_EQ(counter.getCount(), 0u);
+}
+
+TEST_F(JobSystemTest, NestedJobsFromWorkers) {
+	std::atomic<uint32_t> leaves{ 0 };
+	Engine::JobCounter counter;
+	for (int i = 0; i < 64; i++) {
+		Engine::jobSystem::run([&]() {
+			for (int j = 0; j < 64; j++) Engine::jobSystem::run([&leaves]() { leaves++; }, &counter);
+		}, &counter);
+	}
+	Engine::jobSystem::wait(counter);
+	EXPECT_EQ(leaves.load(), 64u * 64u);
+}
+
+TEST_F(JobSystemTest, DependencyRunsAfter) {
+	for (int repeat = 0; repeat < 200; repeat++) {
+		std::atomic<uint32_t> firstDone{ 0 };
+		std::atomic<bool> orderBroken{ false };
+		Engine::JobCounter first, second;
+		for (int i = 0; i < 8; i++) Engine::jobSystem::run([&firstDone]() { firstDone++; }, &first);
+		for (int i = 0; i < 8; i++) Engine::jobSystem::run([&]() { if (firstDone.load() != 8) orderBroken = true; }, &second, &first);
+		Engine::jobSystem::wait(second);
+		Engine::jobSystem::wait(first); //!< Its last job may still be releasing the second batch, counters have to outlive that
+		ASSERT_FALSE(orderBroken.load());
+	}
+}
+
+TEST_F(JobSystemTest, ParallelForCoversEachIndexOnce) {
+	std::vector<std::atomic<int>> hits(10007);
+	Engine::jobSystem::parallelFor(static_cast<uint32_t>(hits.size()), 0, [&hits](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++) hits[i]++;
+	});
+	for (auto& hit : hits) ASSERT_EQ(hit.load(), 1);
+}
+
+TEST_F(JobSystemTest, ExternalThreadSubmits) {
+	std::atomic<uint32_t> sum{ 0 };
+	Engine::JobCounter counter;
+	std::thread outside([&]() {
+		for (int i = 0; i < 1000; i++) Engine::jobSystem::run([&sum]() { sum++; }, &counter);
+	});
+	outside.join();
+	Engine::jobSystem::wait(counter);
+	EXPECT_EQ(sum.load(), 1000u);
+}
+
+TEST(JobSystem, RunsInlineWhenStopped) {
+	bool ran = false;
+	Engine::jobSystem::run([&ran]() { ran = true; });
+	EXPECT_TRUE(ran);
+}
+
+TEST(JobSystem, HelpRunsQueuedJobsOnASingleWorker) {
+	Engine::jobSystem jobs(1);
+	jobs.start();
+	bool ran = false;
+	Engine::jobSystem::run([&ran]() { ran = true; }); //!< Only this thread can run it
+	EXPECT_FALSE(ran);
+	EXPECT_TRUE(Engine::jobSystem::help());
+	EXPECT_TRUE(ran);
+	EXPECT_FALSE(Engine::jobSystem::help());
+	jobs.stop();
+	EXPECT_FALSE(Engine::jobSystem::help());
+}
+
+TEST(JobSystem, RestartRepeatedly) {
+	for (int i = 0; i < 20; i++) {
+		Engine::jobSystem jobs(3);
+		jobs.start();
+		std::atomic<int> count{ 0 };
+		Engine::jobSystem::parallelFor(100, 1, [&count](uint32_t begin, uint32_t end) { count += end - begin; });
+		EXPECT_EQ(count.load(), 100);
+		jobs.stop();
+	}
+}
@@ -0,0 +1,127 @@
+#include "loggingTests.h"
+
+TEST(LogRing, FillsThenDrainsInOrder) {
+	Engine::LogRing ring(6);
+	ASSERT_EQ(ring.getCapacity(), 8);
+
+	uint64_t ticket;
+	uint64_t firstTicket = 0;
+	Engine::LogRecord* first = nullptr;
+	for (uint32_t i = 0; i < ring.getCapacity(); i++) {
+		Engine::LogRecord* record = ring.tryClaim(ticket);
+		ASSERT_NE(record, nullptr);
+		EXPECT_EQ(ticket, i);
+		record->length = static_cast<uint16_t>(i);
+		if (i) ring.publish(*record, ticket);
+		else { first = record; firstTicket = ticket; } //!< Still being written
+	}
+	EXPECT_EQ(ring.tryClaim(ticket), nullptr);
+	EXPECT_EQ(ring.front(), nullptr); //!< Held up by the first
+
+	ring.publish(*first, firstTicket);
+	for (uint32_t i = 0; i < ring.getCapacity(); i++) {
+		Engine::LogRecord* record = ring.front();
+		ASSERT_NE(record, nullptr);
+		EXPECT_EQ(record->length, i);
+		ring.popFront();
+	}
+	EXPECT_EQ(ring.front(), nullptr);
+
+	Engine::LogRecord* record = ring.tryClaim(ticket); //!< Round again
+	ASSERT_NE(record, nullptr);
+	EXPECT_EQ(ticket, ring.getCapacity());
+}
+
+TEST_F(LoggingTest, WritesEveryThreadsMessagesInOrder) {
+	start(64, Engine::LogOverflow::Block); //!< Small, so the threads have to wait for the writer
+	const uint32_t threadCount = 4;
+	const uint32_t messageCount = 500;
+
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < threadCount; t++) {
+		threads.emplace_back([t]() {
+			for (uint32_t i = 0; i < messageCount; i++) LOG_WARN("thread {0} message {1}", t, i);
+		});
+	}
+	for (auto& thread : threads) thread.join();
+	Engine::logging::flush();
+
+	uint32_t next[threadCount] = {};
+	for (auto& line : readLines()) {
+		size_t at = line.find("thread ");
+		if (at == std::string::npos) continue;
+		uint32_t thread, message;
+		ASSERT_EQ(sscanf(line.c_str() + at, "thread %u message %u", &thread, &message), 2);
+		ASSERT_LT(thread, threadCount);
+		EXPECT_EQ(message, next[thread]);
+		next[thread] = message + 1;
+	}
+	for (uint32_t t = 0; t < threadCount; t++) EXPECT_EQ(next[t], messageCount);
+	EXPECT_EQ(Engine::logging::getDroppedCount(), 0);
+}
+
+TEST_F(LoggingTest, DropsWhenFullAndSaysSo) {
+	start(16, Engine::LogOverflow::Drop);
+	uint64_t before = Engine::logging::getDroppedCount();
+	for (uint32_t i = 0; i < 10000; i++) LOG_WARN("message {0}", i);
+	uint64_t dropped = Engine::logging::getDroppedCount() - before;
+	m_logger.stop();
+
+	uint32_t written = 0;
+	bool reported = dropped == 0;
+	for (auto& line : readLines()) {
+		if (line.find("message ") != std::string::npos) written++;
+		if (line.find("log messages dropped") != std::string::npos) reported = true;
+	}
+	EXPECT_EQ(written + dropped, 10000);
+	EXPECT_TRUE(reported);
+}
+
+TEST_F(LoggingTest, TextIsCutShortAndBadFormatsAreReported) {
+	start(64, Engine::LogOverflow::Block);
+	LOG_WARN(std::string(1000, 'x'));
+	LOG_WARN("{1}", 1); //!< No second argument
+	LOG_WARN("after {0}", "both");
+	Engine::logging::flush();
+
+	auto lines = readLines();
+	ASSERT_GE(lines.size(), 3);
+	bool cut = false, bad = false, after = false;
+	for (auto& line : lines) {
+		if (line.find(std::string(Engine::LogRecord::s_textSize, 'x')) != std::string::npos) {
+			cut = line.find(std::string(Engine::LogRecord::s_textSize + 1, 'x')) == std::string::npos;
+		}
+		if (line.find("Bad log format \"{1}\"") != std::string::npos) bad = true;
+		if (line.find("after both") != std::string::npos) after = true;
+	}
+	EXPECT_TRUE(cut);
+	EXPECT_TRUE(bad);
+	EXPECT_TRUE(after);
+}
+
+TEST_F(LoggingTest, StopWhileOtherThreadsLog) {
+	std::atomic<bool> done{ false };
+	std::vector<std::thread> threads;
+	for (int round = 0; round < 20; round++) {
+		start(16, round % 2 ? Engine::LogOverflow::Block : Engine::LogOverflow::Drop);
+		done = false;
+		for (uint32_t t = 0; t < 3; t++) {
+			threads.emplace_back([&done, t]() {
+				for (uint32_t i = 0; !done; i++) LOG_WARN("thread {0} message {1}", t, i);
+			});
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		m_logger.stop(); //!< Frees the ring under the threads, which have to notice rather than write into it
+		done = true;
+		for (auto& thread : threads) thread.join();
+		threads.clear();
+	}
+	EXPECT_FALSE(Engine::logging::isRunning());
+}
+
+TEST(Logging, CallsBeforeStartAreIgnored) {
+	ASSERT_FALSE(Engine::logging::isRunning());
+	LOG_ERROR("nobody is listening {0}", 1);
+	Engine::logging::flush();
+	SUCCEED();
+}
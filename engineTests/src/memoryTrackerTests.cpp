@@ -0,0 +1,87 @@
+#include "memoryTrackerTests.h"
+
+TEST(MemoryTracker, CountsUnderTheCurrentTag) {
+	if (!Engine::MemoryTracker::isEnabled()) GTEST_SKIP();
+	Engine::MemoryStats before = Engine::MemoryTracker::getStats(Engine::MemoryTag::Assets);
+	Engine::MemoryStats totalBefore = Engine::MemoryTracker::getTotal();
+
+	std::vector<char>* data;
+	{
+		Engine::MemoryTagScope scope(Engine::MemoryTag::Assets);
+		EXPECT_EQ(Engine::MemoryTracker::getTag(), Engine::MemoryTag::Assets);
+		data = new std::vector<char>(10000);
+	}
+	EXPECT_EQ(Engine::MemoryTracker::getTag(), Engine::MemoryTag::General);
+
+	Engine::MemoryStats during = Engine::MemoryTracker::getStats(Engine::MemoryTag::Assets);
+	EXPECT_EQ(during.liveBytes - before.liveBytes, 10000 + sizeof(std::vector<char>));
+	EXPECT_EQ(during.liveAllocations - before.liveAllocations, 2);
+	EXPECT_EQ(during.allocations - before.allocations, 2);
+	EXPECT_GE(during.peakBytes, during.liveBytes);
+	EXPECT_GE(Engine::MemoryTracker::getTotal().allocations - totalBefore.allocations, 2);
+
+	delete data;
+	Engine::MemoryStats after = Engine::MemoryTracker::getStats(Engine::MemoryTag::Assets);
+	EXPECT_EQ(after.liveBytes, before.liveBytes);
+	EXPECT_EQ(after.liveAllocations, before.liveAllocations);
+	EXPECT_EQ(after.peakBytes, during.peakBytes); //!< Peaks stay
+}
+
+TEST(MemoryTracker, FreesCountAgainstTheAllocatingTag) {
+	if (!Engine::MemoryTracker::isEnabled()) GTEST_SKIP();
+	uint64_t before = Engine::MemoryTracker::getStats(Engine::MemoryTag::Physics).liveBytes;
+
+	std::unique_ptr<char[]> memory;
+	std::thread([&memory]() {
+		Engine::MemoryTagScope scope(Engine::MemoryTag::Physics);
+		memory.reset(new char[4096]);
+	}).join();
+	EXPECT_EQ(Engine::MemoryTracker::getStats(Engine::MemoryTag::Physics).liveBytes - before, 4096);
+
+	memory.reset(); //!< On a General thread
+	EXPECT_EQ(Engine::MemoryTracker::getStats(Engine::MemoryTag::Physics).liveBytes, before);
+}
+
+TEST(MemoryTracker, AlignedAndCAllocations) {
+	std::unique_ptr<CacheLine> line(new CacheLine());
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(line.get()) % 64, 0);
+
+	uint64_t before = Engine::MemoryTracker::getStats(Engine::MemoryTag::Fonts).liveBytes;
+	char* text = static_cast<char*>(Engine::MemoryTracker::allocate(6, Engine::MemoryTag::Fonts));
+	memcpy(text, "glyph", 6);
+	text = static_cast<char*>(Engine::MemoryTracker::reallocate(text, 1000));
+	EXPECT_STREQ(text, "glyph");
+	if (Engine::MemoryTracker::isEnabled()) {
+		EXPECT_EQ(Engine::MemoryTracker::getStats(Engine::MemoryTag::Fonts).liveBytes - before, 1000); //!< Still a font allocation
+	}
+	Engine::MemoryTracker::release(text);
+	EXPECT_EQ(Engine::MemoryTracker::getStats(Engine::MemoryTag::Fonts).liveBytes, before);
+}
+
+TEST(MemoryTracker, AllocationsPerFrame) {
+	if (!Engine::MemoryTracker::isEnabled()) GTEST_SKIP();
+	Engine::MemoryTracker::beginFrame();
+	{
+		Engine::MemoryTagScope scope(Engine::MemoryTag::Events);
+		for (int i = 0; i < 3; i++) {
+			int* volatile value = new int(i); //!< volatile so the pair isn't optimised away
+			delete value;
+		}
+	}
+	Engine::MemoryTracker::beginFrame();
+	EXPECT_EQ(Engine::MemoryTracker::getStats(Engine::MemoryTag::Events).frameAllocations, 3);
+	Engine::MemoryTracker::beginFrame();
+	EXPECT_EQ(Engine::MemoryTracker::getStats(Engine::MemoryTag::Events).frameAllocations, 0);
+}
+
+TEST(MemoryTracker, ReportsWhatIsStillLive) {
+	if (NG_MEMORY_TRACKING < 2) GTEST_SKIP(); //!< Debug builds only
+	std::unique_ptr<int> before(new int(1));
+	Engine::MemoryTracker::markLeakCheck();
+	std::unique_ptr<int> leaked(new int(2));
+	std::unique_ptr<int> freed(new int(3));
+	freed.reset();
+	EXPECT_EQ(Engine::MemoryTracker::reportLeaks(0), 1);
+	leaked.reset();
+	EXPECT_EQ(Engine::MemoryTracker::reportLeaks(0), 0);
+}
@@ -0,0 +1,139 @@
+#include "nullBackendTests.h"
+
+TEST_F(NullBackendTest, FactoriesTrackResources) {
+	uint32_t indices[6] = { 0, 1, 2, 2, 3, 0 };
+	float vertices[4 * 3] = {};
+	{
+		std::shared_ptr<Engine::VertexArray> vertexArray(Engine::VertexArray::create());
+		std::shared_ptr<Engine::VertexBuffer> vertexBuffer(Engine::VertexBuffer::create(vertices, sizeof(vertices), { Engine::ShaderDataType::Float3 }));
+		std::shared_ptr<Engine::IndexBuffer> indexBuffer(Engine::IndexBuffer::create(indices, 6));
+		std::shared_ptr<Engine::Texture> texture(Engine::Texture::create(4, 2, 4, nullptr));
+		std::shared_ptr<Engine::Shader> shader(Engine::Shader::create("shader.glsl", { "TINT" }));
+		ASSERT_NE(dynamic_cast<Engine::NullVertexArray*>(vertexArray.get()), nullptr);
+
+		vertexArray->addVertexBuffer(vertexBuffer);
+		vertexArray->setIndexBuffer(indexBuffer);
+		EXPECT_EQ(vertexArray->getDrawCount(), 6);
+		EXPECT_EQ(texture->getSize(), glm::vec2(4.f, 2.f));
+		EXPECT_TRUE(shader->isReady());
+		EXPECT_NE(vertexArray->getID(), vertexBuffer->getRenderID()); //!< IDs are unique across types, like GL names
+		EXPECT_NE(vertexArray->getID(), 0);
+
+		EXPECT_EQ(stats.getLiveResources(), liveAtStart + 5);
+		EXPECT_EQ(stats.created.load(), 5);
+	}
+	EXPECT_EQ(stats.getLiveResources(), liveAtStart); //!< Released through the base class pointers
+}
+
+TEST_F(NullBackendTest, UniformBufferCountsUnknownNames) {
+	Engine::UniformBufferLayout layout = { { "u_lightPos", Engine::ShaderDataType::Float3 }, { "u_lightColour", Engine::ShaderDataType::Float3 } };
+	std::shared_ptr<Engine::UniformBuffer> uniformBuffer(Engine::UniformBuffer::create(layout));
+	glm::vec3 value(1.f);
+
+	std::string name = "u_lightPos"; //!< Same text, different pointer to the one in the layout, which used to miss
+	uniformBuffer->uploadData(name.c_str(), &value);
+	uniformBuffer->uploadData("u_lightColour", &value);
+	uniformBuffer->uploadData("u_lightsPos", &value);
+
+	EXPECT_EQ(stats.uniformUploads.load(), 3);
+	EXPECT_EQ(stats.unknownUniforms.load(), 1);
+}
+
+TEST_F(NullBackendTest, RendererUploadsMatchTheLayouts) {
+	Engine::Renderer3D::init();
+	Engine::Renderer3D::uploadCamera(glm::mat4(1.f), glm::mat4(1.f));
+	Engine::Renderer3D::uploadLights(glm::vec3(1.f), glm::vec3(0.f), glm::vec3(1.f), glm::vec4(1.f));
+
+	EXPECT_EQ(stats.uniformUploads.load(), 6);
+	EXPECT_EQ(stats.unknownUniforms.load(), 0);
+}
+
+TEST_F(NullBackendTest, RendererBindsBlocksToVariantsMadeLater) {
+	uint32_t indices[3] = { 0, 1, 2 };
+	std::shared_ptr<Engine::VertexArray> vertexArray(Engine::VertexArray::create());
+	std::shared_ptr<Engine::IndexBuffer> indexBuffer(Engine::IndexBuffer::create(indices, 3));
+	vertexArray->setIndexBuffer(indexBuffer);
+
+	Engine::Renderer3D::init();
+	Engine::Renderer3D::uploadCamera(glm::mat4(1.f), glm::mat4(1.f));
+	Engine::Renderer3D::uploadLights(glm::vec3(1.f), glm::vec3(0.f), glm::vec3(1.f), glm::vec4(1.f));
+	EXPECT_EQ(stats.blockBinds.load(), 0); //!< Nothing has been drawn yet
+
+	auto variants = std::make_shared<Engine::ShaderPermutations>("shader.glsl", std::vector<std::string>{ "TEXTURE", "TINT" });
+	auto material = std::make_shared<Engine::Material>(variants, glm::vec4(1.f)); //!< Variant compiled after the uploads
+	for (int frame = 0; frame < 2; frame++) {
+		Engine::Renderer3D::beginScene();
+		Engine::Renderer3D::submit(vertexArray, material, glm::mat4(1.f));
+		Engine::Renderer3D::endScene();
+	}
+	EXPECT_EQ(stats.blockBinds.load(), 2); //!< Camera and lights, once
+
+	Engine::Renderer3D::uploadCamera(glm::mat4(2.f), glm::mat4(1.f));
+	Engine::Renderer3D::submit(vertexArray, material, glm::mat4(1.f));
+	EXPECT_EQ(stats.blockBinds.load(), 4); //!< A new block, so bound again
+	EXPECT_EQ(stats.drawCalls.load(), 3);
+}
+
+TEST_F(NullBackendTest, RenderThreadPresentsEveryFrame) {
+	uint32_t indices[3] = { 0, 1, 2 };
+	std::shared_ptr<Engine::VertexArray> vertexArray(Engine::VertexArray::create());
+	std::shared_ptr<Engine::IndexBuffer> indexBuffer(Engine::IndexBuffer::create(indices, 3));
+	vertexArray->setIndexBuffer(indexBuffer);
+
+	Engine::RenderThread::start(window.getGraphicsContext());
+	for (int frame = 0; frame < 10; frame++) {
+		Engine::RenderThread::record([](Engine::RenderBackend& arg_backend) { arg_backend.clear(); });
+		Engine::RenderThread::record([vertexArray](Engine::RenderBackend& arg_backend) { arg_backend.drawIndexed(*vertexArray); });
+		Engine::RenderThread::endFrame();
+	}
+	Engine::RenderThread::stop();
+
+	EXPECT_EQ(stats.clears.load(), 10);
+	EXPECT_EQ(stats.drawCalls.load(), 10);
+	EXPECT_EQ(stats.indicesDrawn.load(), 30);
+	EXPECT_EQ(stats.presents.load(), 10);
+	EXPECT_EQ(static_cast<Engine::NullGraphicsContext*>(window.getGraphicsContext().get())->getSwapCount(), 10);
+}
+
+TEST_F(NullBackendTest, AfterFrameWorkRunsOncePresented) {
+	std::vector<uint64_t> presentsSeen;
+	Engine::RenderThread::setAfterFrame([this, &presentsSeen]() { presentsSeen.push_back(stats.presents.load()); });
+	Engine::RenderThread::start(window.getGraphicsContext());
+	for (int frame = 0; frame < 5; frame++) Engine::RenderThread::endFrame();
+	Engine::RenderThread::stop();
+	Engine::RenderThread::setAfterFrame(nullptr);
+
+	ASSERT_EQ(presentsSeen.size(), 6); //!< stop() hands over one more frame, without a present
+	for (uint64_t frame = 0; frame < 5; frame++) EXPECT_EQ(presentsSeen[frame], frame + 1); //!< Each after its own frame's present
+}
+
+TEST_F(NullBackendTest, TexturesThatWontDecodeAreMissing) {
+	const std::filesystem::path image = std::filesystem::temp_directory_path() / "engineTestsImage.ppm";
+	const std::filesystem::path garbage = std::filesystem::temp_directory_path() / "engineTestsGarbage.png";
+	std::ofstream(image, std::ios::binary) << "P6\n2 1\n255\n" << std::string(6, '\x40');
+	std::ofstream(garbage, std::ios::binary) << "not an image";
+
+	Engine::DeferredScheduler main, render;
+	Engine::Tasks::setQueues(&main, &render); //!< The job system isn't started, so reads and decodes run where they are posted
+	Engine::Task<std::shared_ptr<Engine::Texture>> decoded = Engine::TextureLoader::load(image.string());
+	Engine::Task<std::shared_ptr<Engine::Texture>> undecodable = Engine::TextureLoader::load(garbage.string());
+	render.run(std::numeric_limits<uint64_t>::max());
+	Engine::Tasks::setQueues(nullptr, nullptr);
+	std::filesystem::remove(image);
+	std::filesystem::remove(garbage);
+
+	ASSERT_TRUE(decoded.isReady());
+	EXPECT_EQ(decoded.get()->getSize(), glm::vec2(2.f, 1.f));
+	EXPECT_EQ(decoded.get()->getChannels(), 3);
+	ASSERT_TRUE(undecodable.isReady());
+	EXPECT_EQ(undecodable.get()->getSize(), glm::vec2(1.f, 1.f)); //!< The missing texture rather than an empty one
+	EXPECT_EQ(undecodable.get()->getChannels(), 4);
+}
+
+TEST_F(NullBackendTest, WindowCloseSendsEvent) {
+	bool closed = false;
+	window.setEventCallback([&](Engine::Event& arg_event) { closed = arg_event.getEventType() == Engine::EventType::WindowClose; });
+	EXPECT_EQ(window.getNativeWindow(), nullptr);
+	window.close();
+	EXPECT_TRUE(closed);
+}
@@ -0,0 +1,78 @@
+#include "powerPolicyTests.h"
+
+TEST_F(PowerPolicyTest, ActiveDrawsEveryFrame) {
+	for (int i = 0; i < 3; i++) {
+		Engine::FramePlan plan = m_policy.beginFrame();
+		EXPECT_TRUE(plan.render);
+		EXPECT_FALSE(plan.changed);
+		EXPECT_EQ(plan.waitTime, 0.f);
+	}
+	EXPECT_EQ(m_policy.getState(), Engine::PowerState::Active);
+	EXPECT_EQ(m_policy.getSkippedFrames(), 0);
+}
+
+TEST_F(PowerPolicyTest, LosingFocusDropsTheRate) {
+	send(Engine::WindowLostFocusEvent());
+	EXPECT_EQ(m_policy.getState(), Engine::PowerState::Background);
+	Engine::FramePlan plan = m_policy.beginFrame();
+	EXPECT_TRUE(plan.changed);
+	EXPECT_TRUE(plan.render);
+	EXPECT_EQ(plan.frameRate, 10.0);
+	EXPECT_FALSE(m_policy.beginFrame().changed); //!< Only once
+
+	send(Engine::WindowFocusEvent());
+	plan = m_policy.beginFrame();
+	EXPECT_TRUE(plan.changed);
+	EXPECT_EQ(plan.frameRate, 0.0);
+}
+
+TEST_F(PowerPolicyTest, MinimizedSkipsDrawingAndWaits) {
+	send(Engine::WindowResizeEvent(0, 0));
+	EXPECT_EQ(m_policy.getState(), Engine::PowerState::Minimized);
+	for (int i = 0; i < 4; i++) {
+		Engine::FramePlan plan = m_policy.beginFrame();
+		EXPECT_FALSE(plan.render);
+		EXPECT_EQ(plan.waitTime, 0.05f);
+	}
+	EXPECT_EQ(m_policy.getSkippedFrames(), 4);
+
+	send(Engine::WindowLostFocusEvent()); //!< Minimising usually loses focus too, still minimised
+	EXPECT_EQ(m_policy.getState(), Engine::PowerState::Minimized);
+
+	send(Engine::WindowResizeEvent(800, 600));
+	send(Engine::WindowFocusEvent());
+	Engine::FramePlan plan = m_policy.beginFrame();
+	EXPECT_TRUE(plan.render);
+	EXPECT_TRUE(plan.changed);
+	EXPECT_EQ(m_policy.getState(), Engine::PowerState::Active);
+}
+
+TEST_F(PowerPolicyTest, OnDemandDrawsOnlyWhenDirty) {
+	Engine::PowerSettings settings = m_policy.getSettings();
+	settings.onDemand = true;
+	m_policy.setSettings(settings);
+
+	EXPECT_TRUE(m_policy.beginFrame().render); //!< New settings draw once
+	Engine::FramePlan plan = m_policy.beginFrame();
+	EXPECT_FALSE(plan.render);
+	EXPECT_EQ(plan.waitTime, 0.05f);
+
+	m_policy.markDirty();
+	EXPECT_TRUE(m_policy.beginFrame().render);
+	EXPECT_FALSE(m_policy.beginFrame().render);
+
+	send(Engine::MouseMovedEvent(4.f, 2.f)); //!< Input might change what's shown
+	EXPECT_TRUE(m_policy.beginFrame().render);
+	send(Engine::KeyPressedEvent(65, 0));
+	EXPECT_TRUE(m_policy.beginFrame().render);
+	EXPECT_FALSE(m_policy.beginFrame().render);
+}
+
+TEST_F(PowerPolicyTest, HandlersLeaveEventsForLaterHandlers) {
+	Engine::WindowFocusEvent focus;
+	Engine::WindowResizeEvent resize(640, 480);
+	m_table.dispatch(focus);
+	m_table.dispatch(resize);
+	EXPECT_FALSE(focus.handled());
+	EXPECT_FALSE(resize.handled());
+}
@@ -0,0 +1,119 @@
+#include "renderThreadTests.h"
+
+TEST(RenderCommandBuffer, ExecutesInRecordingOrder) {
+	Engine::RenderCommandBuffer buffer(256); //!< Small blocks so the commands span several
+	RecordingRenderBackend backend;
+	auto captured = std::make_shared<int>(0);
+
+	for (int i = 0; i < 100; i++) {
+		if (i % 2) buffer.record([](Engine::RenderBackend& arg_backend) { arg_backend.clear(); });
+		else buffer.record([captured](Engine::RenderBackend& arg_backend) { arg_backend.present(); });
+	}
+	EXPECT_EQ(buffer.getCommandCount(), 100);
+	EXPECT_GT(captured.use_count(), 1);
+
+	buffer.execute(backend);
+	ASSERT_EQ(backend.calls.size(), 100);
+	for (int i = 0; i < 100; i++) EXPECT_EQ(backend.calls[i], i % 2 ? "clear" : "present") << "command " << i;
+
+	EXPECT_TRUE(buffer.empty());
+	EXPECT_EQ(captured.use_count(), 1); //!< Captures are destroyed once the command has run
+}
+
+TEST(RenderCommandBuffer, ClearDestroysWithoutRunning) {
+	Engine::RenderCommandBuffer buffer;
+	RecordingRenderBackend backend;
+	auto captured = std::make_shared<int>(0);
+
+	buffer.record([captured](Engine::RenderBackend& arg_backend) { arg_backend.clear(); });
+	buffer.clear();
+	EXPECT_EQ(captured.use_count(), 1);
+
+	buffer.execute(backend);
+	EXPECT_TRUE(backend.calls.empty());
+}
+
+TEST_F(RenderThreadTest, RunsInlineWhenStopped) {
+	Engine::RenderThread::record([](Engine::RenderBackend& arg_backend) { arg_backend.clear(); });
+	ASSERT_EQ(backend->calls.size(), 1);
+	EXPECT_EQ(backend->threads[0], std::this_thread::get_id());
+}
+
+TEST_F(RenderThreadTest, FramesRunOnRenderThreadInOrder) {
+	Engine::RenderThread::start(context);
+	for (int frame = 0; frame < 3; frame++) {
+		Engine::RenderThread::record([](Engine::RenderBackend& arg_backend) { arg_backend.clear(); });
+		Engine::RenderThread::record([](Engine::RenderBackend& arg_backend) { arg_backend.setDepthTest(true); });
+		Engine::RenderThread::record([](Engine::RenderBackend& arg_backend) { arg_backend.setBlend(false); });
+		Engine::RenderThread::endFrame();
+	}
+	Engine::RenderThread::stop();
+
+	std::vector<std::string> frame = { "clear", "depthOn", "blendOff", "present" };
+	ASSERT_EQ(backend->calls.size(), frame.size() * 3);
+	for (size_t i = 0; i < backend->calls.size(); i++) {
+		EXPECT_EQ(backend->calls[i], frame[i % frame.size()]);
+		EXPECT_NE(backend->threads[i], std::this_thread::get_id());
+	}
+	EXPECT_EQ(context->madeCurrent.load(), 2); //!< Render thread, then back on this thread
+	EXPECT_EQ(context->released.load(), 2);
+}
+
+TEST_F(RenderThreadTest, InvokeRunsOnRenderThread) {
+	Engine::RenderThread::start(context);
+	std::thread::id caller = std::this_thread::get_id();
+	std::thread::id creator = Engine::RenderThread::invoke([]() { return std::this_thread::get_id(); });
+	bool onRenderThread = Engine::RenderThread::invoke([]() { return Engine::RenderThread::isRenderThread(); });
+	Engine::RenderThread::stop();
+
+	EXPECT_NE(creator, caller);
+	EXPECT_TRUE(onRenderThread);
+	EXPECT_FALSE(Engine::RenderThread::isRenderThread());
+}
+
+TEST_F(RenderThreadTest, LatencyIsOneFrame) {
+	Engine::RenderThread::start(context);
+	uint64_t start = Engine::RenderThread::getFramesDrawn();
+	for (uint64_t frame = 1; frame <= 20; frame++) {
+		Engine::RenderThread::record([]() { std::this_thread::sleep_for(std::chrono::microseconds(200)); });
+		Engine::RenderThread::endFrame();
+		EXPECT_GE(Engine::RenderThread::getFramesDrawn() - start, frame - 1); //!< Frame N is only handed over once N-1 is done
+	}
+	Engine::RenderThread::stop();
+	EXPECT_EQ(Engine::RenderThread::getFramesDrawn() - start, 21); //!< Stopping submits the empty frame being recorded
+}
+
+TEST_F(RenderThreadTest, RecordedFromRenderThreadRunsInline) {
+	Engine::RenderThread::start(context);
+	Engine::RenderThread::record([]() {
+		Engine::RenderThread::record([](Engine::RenderBackend& arg_backend) { arg_backend.clear(); }); //!< i.e. a resource released inside a command
+	});
+	Engine::RenderThread::endFrame();
+	Engine::RenderThread::stop();
+
+	ASSERT_EQ(backend->calls.size(), 2);
+	EXPECT_EQ(backend->calls[0], "clear");
+	EXPECT_EQ(backend->calls[1], "present");
+}
+
+TEST_F(RenderThreadTest, GpuSyncWaitsAfterPresent) {
+	Engine::RenderThread::setGpuSync(true);
+	Engine::RenderThread::start(context);
+	uint64_t presents = Engine::RenderThread::getPresentCount();
+	Engine::RenderThread::record([]() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+	Engine::RenderThread::endFrame();
+	Engine::RenderThread::waitForIdle();
+
+	EXPECT_EQ(Engine::RenderThread::getPresentCount(), presents + 1); //!< Nothing left in flight
+	EXPECT_GE(Engine::RenderThread::getPresentLatency(), 2000000); //!< Covers the frame's work, which came after the submit
+	{
+		std::lock_guard<std::mutex> lock(backend->mutex);
+		ASSERT_EQ(backend->calls.size(), 2);
+		EXPECT_EQ(backend->calls[1], "waitForGpu");
+	}
+
+	Engine::RenderThread::setGpuSync(false);
+	Engine::RenderThread::endFrame();
+	Engine::RenderThread::stop();
+	EXPECT_EQ(backend->calls.back(), "present");
+}
@@ -0,0 +1,90 @@
+#include "shaderCacheTests.h"
+
+TEST(ShaderCache, MissThenHit) {
+	clearCacheDirectory();
+	auto driver = std::make_shared<FakeProgramBinaryDriver>();
+	{
+		Engine::ShaderProgramCache cache(driver, cacheDirectory);
+		uint64_t key = cache.makeKey({ "vertex", "fragment" });
+		EXPECT_FALSE(cache.load(key, 7));
+		EXPECT_TRUE(cache.store(key, 7));
+		EXPECT_EQ(cache.getStats().misses, 1u);
+	}
+	Engine::ShaderProgramCache cache(driver, cacheDirectory);
+	EXPECT_TRUE(cache.load(cache.makeKey({ "vertex", "fragment" }), 9));
+	EXPECT_EQ(driver->lastLoaded, 7u);
+	EXPECT_EQ(cache.getStats().hits, 1u);
+}
+
+TEST(ShaderCache, KeyDependsOnSourcesAndDriver) {
+	clearCacheDirectory();
+	auto driver = std::make_shared<FakeProgramBinaryDriver>();
+	Engine::ShaderProgramCache cache(driver, cacheDirectory);
+	EXPECT_NE(cache.makeKey({ "ab", "c" }), cache.makeKey({ "a", "bc" }));
+
+	driver->signature = "FakeVendor\nFakeRenderer\n4.6.1\n";
+	Engine::ShaderProgramCache updated(driver, cacheDirectory);
+	EXPECT_NE(cache.makeKey({ "ab", "c" }), updated.makeKey({ "ab", "c" }));
+}
+
+TEST(ShaderCache, RejectedBinaryIsRemoved) {
+	clearCacheDirectory();
+	auto driver = std::make_shared<FakeProgramBinaryDriver>();
+	Engine::ShaderProgramCache cache(driver, cacheDirectory);
+	uint64_t key = cache.makeKey({ "vertex", "fragment" });
+	cache.store(key, 3);
+
+	driver->rejectAll = true;
+	EXPECT_FALSE(cache.load(key, 3));
+	EXPECT_EQ(cache.getStats().rejected, 1u);
+	EXPECT_EQ(cache.getEntryCount(), 0u);
+}
+
+TEST(ShaderCache, CorruptFileIsRemoved) {
+	clearCacheDirectory();
+	auto driver = std::make_shared<FakeProgramBinaryDriver>();
+	uint64_t key;
+	{
+		Engine::ShaderProgramCache cache(driver, cacheDirectory);
+		key = cache.makeKey({ "vertex", "fragment" });
+		cache.store(key, 3);
+	}
+	for (auto& file : std::filesystem::directory_iterator(cacheDirectory)) {
+		std::fstream handle(file.path(), std::ios::in | std::ios::out | std::ios::binary);
+		handle.seekp(40);
+		handle.put(0x7f); //!< Flips a byte of the binary, the checksum no longer matches
+	}
+	Engine::ShaderProgramCache cache(driver, cacheDirectory);
+	EXPECT_FALSE(cache.load(key, 3));
+	EXPECT_EQ(cache.getStats().corrupt, 1u);
+	EXPECT_EQ(cache.getEntryCount(), 0u);
+}
+
+TEST(ShaderCache, EvictsLeastRecentlyUsed) {
+	clearCacheDirectory();
+	auto driver = std::make_shared<FakeProgramBinaryDriver>();
+	Engine::ShaderProgramCache cache(driver, cacheDirectory, 250); //!< Room for two 96 byte files
+	uint64_t first = cache.makeKey({ "1" });
+	uint64_t second = cache.makeKey({ "2" });
+	uint64_t third = cache.makeKey({ "3" });
+	cache.store(first, 1);
+	cache.store(second, 2);
+	cache.load(first, 1); //!< First is now more recent than second
+	cache.store(third, 3);
+
+	EXPECT_EQ(cache.getStats().evicted, 1u);
+	EXPECT_TRUE(cache.load(first, 1));
+	EXPECT_FALSE(cache.load(second, 2));
+	EXPECT_TRUE(cache.load(third, 3));
+}
+
+TEST(ShaderCache, UnsupportedDriverDisablesCache) {
+	clearCacheDirectory();
+	auto driver = std::make_shared<FakeProgramBinaryDriver>();
+	driver->supported = false;
+	Engine::ShaderProgramCache cache(driver, cacheDirectory);
+	uint64_t key = cache.makeKey({ "vertex", "fragment" });
+	EXPECT_FALSE(cache.isEnabled());
+	EXPECT_FALSE(cache.store(key, 1));
+	EXPECT_FALSE(cache.load(key, 1));
+}
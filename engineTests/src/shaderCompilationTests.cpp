@@ -0,0 +1,79 @@
+#include "shaderCompilationTests.h"
+
+TEST(ShaderCompilation, SubmitDoesNotWait) {
+	auto compiler = std::make_shared<FakeShaderCompiler>();
+	Engine::ShaderCompilationService service(compiler);
+
+	auto first = service.submit("first", "", "vertex", "fragment");
+	auto second = service.submit("second", "", "vertex", "fragment");
+	EXPECT_EQ(service.getProgram(first), 10u);
+	EXPECT_EQ(service.getProgram(second), 11u);
+	EXPECT_EQ(service.getPendingCount(), 2u);
+	EXPECT_TRUE(compiler->finished.empty()); //!< No status asked for yet
+}
+
+TEST(ShaderCompilation, ReadyOnlyOnceDriverCompletes) {
+	auto compiler = std::make_shared<FakeShaderCompiler>();
+	Engine::ShaderCompilationService service(compiler);
+	auto job = service.submit("shader", "", "vertex", "fragment");
+
+	EXPECT_FALSE(service.isReady(job));
+	service.update();
+	EXPECT_TRUE(compiler->finished.empty());
+
+	compiler->completed.insert(service.getProgram(job));
+	service.update();
+	EXPECT_TRUE(service.isReady(job));
+	EXPECT_EQ(compiler->finished.size(), 1u);
+	EXPECT_EQ(service.getPendingCount(), 0u);
+	ASSERT_EQ(service.getTimings().size(), 1u);
+	EXPECT_EQ(service.getTimings()[0].name, "shader");
+}
+
+TEST(ShaderCompilation, WaitAllFinishesInSubmitOrder) {
+	auto compiler = std::make_shared<FakeShaderCompiler>();
+	Engine::ShaderCompilationService service(compiler);
+	service.submit("a", "", "vertex", "fragment");
+	auto bad = service.submit("b", "", "bad", "fragment");
+	service.submit("c", "", "vertex", "fragment");
+
+	service.waitAll();
+	EXPECT_EQ(compiler->finished, (std::vector<uint32_t>{ 10, 11, 12 }));
+	EXPECT_EQ(service.poll(bad), Engine::ShaderJobState::Failed);
+	EXPECT_EQ(service.getProgram(bad), 0u); //!< Deleted by the compiler, not to be deleted again
+	EXPECT_FALSE(service.getTimings()[1].succeeded);
+}
+
+TEST(ShaderCompilation, ReleaseDiscardsOutstandingCompile) {
+	auto compiler = std::make_shared<FakeShaderCompiler>();
+	Engine::ShaderCompilationService service(compiler);
+	auto pending = service.submit("pending", "", "vertex", "fragment");
+	auto done = service.submit("done", "", "vertex", "fragment");
+	service.wait(done);
+
+	service.release(pending);
+	service.release(done);
+	EXPECT_EQ(compiler->discarded, (std::vector<uint32_t>{ 10 }));
+	EXPECT_EQ(service.getPendingCount(), 0u);
+}
+
+TEST(ShaderCompilation, WithoutParallelSupportUpdateFinishesOneAFrame) {
+	auto compiler = std::make_shared<FakeShaderCompiler>();
+	compiler->parallel = false;
+	Engine::ShaderCompilationService service(compiler);
+	auto first = service.submit("first", "", "vertex", "fragment");
+	auto second = service.submit("second", "", "vertex", "fragment");
+
+	EXPECT_FALSE(service.isReady(first)); //!< Never blocks mid frame
+	for (uint32_t frame = 0; frame < Engine::ShaderCompilationService::s_framesBeforeFinish; frame++) service.update();
+	EXPECT_TRUE(compiler->finished.empty()); //!< Given time to compile first
+
+	service.update();
+	EXPECT_EQ(compiler->finished, (std::vector<uint32_t>{ 10 }));
+	EXPECT_TRUE(service.isReady(first));
+	EXPECT_FALSE(service.isReady(second));
+
+	service.update();
+	EXPECT_TRUE(service.isReady(second));
+	EXPECT_EQ(service.getPendingCount(), 0u);
+}
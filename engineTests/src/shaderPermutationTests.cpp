@@ -0,0 +1,32 @@
+#include "shaderPermutationTests.h"
+
+TEST(ShaderPermutations, MaskSelectsKeywords) {
+	Engine::ShaderPermutations variants("shader.glsl", { "USE_TEXTURE", "USE_TINT", "USE_FOG" }, createFakeShader);
+	EXPECT_EQ(variants.getDefines(0), Engine::ShaderDefines{});
+	EXPECT_EQ(variants.getDefines(0b101), (Engine::ShaderDefines{ "USE_TEXTURE", "USE_FOG" }));
+
+	auto variant = std::static_pointer_cast<FakeShader>(variants.getVariant(0b011));
+	EXPECT_EQ(variant->defines, (Engine::ShaderDefines{ "USE_TEXTURE", "USE_TINT" }));
+}
+
+TEST(ShaderPermutations, VariantsAreBuiltOnceOnDemand) {
+	fakeShadersCreated = 0;
+	Engine::ShaderPermutations variants("shader.glsl", { "USE_TEXTURE", "USE_TINT" }, createFakeShader);
+	EXPECT_EQ(fakeShadersCreated, 0);
+
+	auto first = variants.getVariant(1);
+	EXPECT_EQ(first, variants.getVariant(1));
+	EXPECT_EQ(first, variants.getVariant(1 | 0b100)); //!< Bits past the last keyword don't make a new variant
+	EXPECT_EQ(fakeShadersCreated, 1);
+
+	variants.warmUp({ 0, 1, 2 });
+	EXPECT_EQ(fakeShadersCreated, 3);
+	EXPECT_EQ(variants.getCompiledVariants().size(), 3u);
+}
+
+TEST(ShaderPermutations, DefinesFollowVersion) {
+	Engine::ShaderPreprocessor preprocessor;
+	Engine::ShaderSources sources;
+	ASSERT_TRUE(preprocessor.processSource("shader.glsl", "#region Vertex\n#version 440 core\nvoid main() {}\n", sources, { "USE_TINT" }));
+	EXPECT_EQ(sources[Engine::Region::R_VERTEX], "#version 440 core\n#define USE_TINT\n#line 3 0\nvoid main() {}\n");
+}
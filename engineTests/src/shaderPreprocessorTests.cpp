@@ -0,0 +1,73 @@
+#include "shaderPreprocessorTests.h"
+
+TEST_F(ShaderPreprocessorTest, SplitsRegionsWithDefines) {
+	std::string path = write("shader.glsl", "#region Vertex\n#version 440 core\nvoid main() {}\n#region Fragment\n#version 440 core\nout vec4 colour;\n");
+	ASSERT_TRUE(preprocessor.process(path.c_str(), sources, { "USE_TINT" }));
+
+	EXPECT_EQ(sources[Engine::Region::R_VERTEX], "#version 440 core\n#define USE_TINT\n#line 3 0\nvoid main() {}\n");
+	EXPECT_EQ(sources[Engine::Region::R_FRAGMENT], "#version 440 core\n#define USE_TINT\n#line 6 0\nout vec4 colour;\n");
+	EXPECT_TRUE(sources[Engine::Region::R_GEOMETRY].empty());
+}
+
+TEST_F(ShaderPreprocessorTest, IncludesResolveFromTheIncludingFile) {
+	write("include/lights.glsl", "#include \"maths.glsl\"\nuniform vec3 u_lightPos;\n"); //!< Next to lights.glsl, not the shader
+	write("include/maths.glsl", "float square(float x) { return x * x; }\n");
+	std::string path = write("shader.glsl", "#region Vertex\n#version 440 core\n#include \"include/lights.glsl\"\nvoid main() {}\n");
+	ASSERT_TRUE(preprocessor.process(path.c_str(), sources));
+
+	EXPECT_EQ(sources[Engine::Region::R_VERTEX],
+		"#version 440 core\n#line 3 0\n"
+		"#line 1 1\n"
+		"#line 1 2\nfloat square(float x) { return x * x; }\n#line 2 1\n"
+		"uniform vec3 u_lightPos;\n#line 4 0\n"
+		"void main() {}\n");
+
+	std::string directory = (m_directory / "include").lexically_normal().generic_string();
+	EXPECT_EQ(preprocessor.getFileTable(), "0: " + path + ", 1: " + directory + "/lights.glsl, 2: " + directory + "/maths.glsl");
+}
+
+TEST_F(ShaderPreprocessorTest, PragmaOncePastedOncePerStage) {
+	write("include/common.glsl", "#pragma once\nuniform vec4 u_common;\n");
+	std::string path = write("shader.glsl",
+		"#region Vertex\n#include \"include/common.glsl\"\n#include \"include/common.glsl\"\n"
+		"#region Fragment\n#include \"include/common.glsl\"\n");
+	ASSERT_TRUE(preprocessor.process(path.c_str(), sources));
+
+	EXPECT_EQ(sources[Engine::Region::R_VERTEX], "#line 1 1\n\nuniform vec4 u_common;\n#line 3 0\n"); //!< The pragma line is kept blank so lines stay in step
+	EXPECT_EQ(sources[Engine::Region::R_FRAGMENT], "#line 1 1\n\nuniform vec4 u_common;\n#line 6 0\n");
+}
+
+TEST_F(ShaderPreprocessorTest, IncludeCyclesFail) {
+	write("include/a.glsl", "#include \"b.glsl\"\n");
+	write("include/b.glsl", "#include \"a.glsl\"\n");
+	std::string path = write("shader.glsl", "#region Vertex\n#include \"include/a.glsl\"\n");
+	EXPECT_FALSE(preprocessor.process(path.c_str(), sources)); //!< Stopped by the depth limit rather than recursing forever
+
+	write("include/c.glsl", "#pragma once\n#include \"d.glsl\"\n");
+	write("include/d.glsl", "#pragma once\n#include \"c.glsl\"\n");
+	path = write("guarded.glsl", "#region Vertex\n#include \"include/c.glsl\"\n");
+	EXPECT_TRUE(preprocessor.process(path.c_str(), sources)); //!< #pragma once breaks the cycle
+}
+
+TEST_F(ShaderPreprocessorTest, MissingFilesFail) {
+	EXPECT_FALSE(preprocessor.process((m_directory / "missing.glsl").generic_string().c_str(), sources));
+
+	std::string path = write("shader.glsl", "#region Vertex\n#include \"include/missing.glsl\"\nvoid main() {}\n");
+	EXPECT_FALSE(preprocessor.process(path.c_str(), sources));
+	EXPECT_EQ(sources[Engine::Region::R_VERTEX], "void main() {}\n"); //!< The rest of the file is still split
+
+	path = write("unterminated.glsl", "#region Vertex\n#include \"include/common.glsl\n");
+	EXPECT_FALSE(preprocessor.process(path.c_str(), sources));
+}
+
+TEST_F(ShaderPreprocessorTest, CacheKeepsFilesUntilCleared) {
+	std::string path = write("shader.glsl", "#region Vertex\nfirst\n");
+	ASSERT_TRUE(preprocessor.process(path.c_str(), sources));
+	write("shader.glsl", "#region Vertex\nsecond\n");
+
+	ASSERT_TRUE(preprocessor.process(path.c_str(), sources));
+	EXPECT_EQ(sources[Engine::Region::R_VERTEX], "first\n");
+	preprocessor.clearCache();
+	ASSERT_TRUE(preprocessor.process(path.c_str(), sources));
+	EXPECT_EQ(sources[Engine::Region::R_VERTEX], "second\n");
+}
@@ -0,0 +1,43 @@
+#include "stringIdTests.h"
+
+TEST(StringId, HashedAtCompileTime) {
+	constexpr Engine::StringId view("u_view");
+	static_assert(view.getHash() == Engine::StringId::hash("u_view"), "Literals hash at compile time");
+	static_assert(Engine::StringId::hash("") == 14695981039346656037ull, "FNV-1a offset basis");
+	static_assert(Engine::StringId::hash("a") == 0xaf63dc4c8601ec8cull, "FNV-1a of a single byte");
+	EXPECT_FALSE(Engine::StringId().isValid());
+	EXPECT_TRUE(view.isValid());
+}
+
+TEST(StringId, SameTextSameId) {
+	std::string name = "u_lightPos"; //!< Same text, different pointer to the literal
+	EXPECT_EQ(Engine::StringId(name.c_str()), Engine::StringId("u_lightPos"));
+	EXPECT_EQ(Engine::StringId(std::string_view(name)), Engine::StringId("u_lightPos"));
+	EXPECT_NE(Engine::StringId("u_lightsPos"), Engine::StringId("u_lightPos"));
+
+	std::unordered_map<Engine::StringId, int> offsets = { { "u_lightPos", 0 }, { "u_viewPos", 16 } };
+	EXPECT_EQ(offsets.count(name.c_str()), 1);
+	EXPECT_EQ(offsets.count("u_lightsPos"), 0);
+}
+
+TEST(StringId, NullIsInvalid) {
+	const char* missing = nullptr;
+	EXPECT_FALSE(Engine::StringId(missing).isValid());
+	EXPECT_EQ(Engine::StringId(missing), Engine::StringId());
+	static_assert(Engine::StringId(static_cast<const char*>(nullptr)).getHash() == 0, "Null converts at compile time too");
+}
+
+TEST(StringId, InternedTextCanBeFound) {
+	std::string name = "u_lightColour";
+	Engine::StringId id = Engine::StringId::intern(name);
+	EXPECT_EQ(id, Engine::StringId("u_lightColour"));
+	for (int i = 0; i < 1000; i++) Engine::StringId::intern("u_name" + std::to_string(i));
+	EXPECT_EQ(Engine::StringId::getCollisionCount(), 0);
+
+#if NG_STRING_TABLE
+	EXPECT_STREQ(Engine::StringId("u_lightColour").getText(), "u_lightColour"); //!< Found from the literal's id too
+	EXPECT_STREQ(Engine::StringId("u_neverInterned").getText(), "?");
+#else
+	EXPECT_STREQ(id.getText(), "?");
+#endif
+}
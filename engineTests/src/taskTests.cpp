@@ -0,0 +1,147 @@
+#include "taskTests.h"
+
+#include <filesystem>
+#include <fstream>
+
+TEST_F(TaskTest, StepsRunOnTheirThreadsInOrder) {
+	Engine::Task<int> task = Engine::Tasks::run(Engine::TaskThread::Worker, [this]() { note("read"); return 2; })
+		.then(Engine::TaskThread::Worker, [this](int& arg_read) { note("decode"); return arg_read * 3; })
+		.then(Engine::TaskThread::Render, [this](int& arg_decoded) { note("upload"); return arg_decoded + 1; })
+		.then(Engine::TaskThread::Main, [this](int& arg_uploaded) { note("ready"); return arg_uploaded * 10; });
+
+	EXPECT_EQ(ran, std::vector<std::string>({ "read", "decode" }));
+	EXPECT_EQ(render.getPendingCount(), 1);
+	EXPECT_EQ(main.getPendingCount(), 0); //!< Not queued until the upload is done
+
+	runMain();
+	EXPECT_FALSE(task.isFinished());
+	runRender();
+	EXPECT_EQ(main.getPendingCount(), 1);
+	runMain();
+	ASSERT_TRUE(task.isReady());
+	EXPECT_EQ(task.get(), 70);
+	EXPECT_EQ(ran, std::vector<std::string>({ "read", "decode", "upload", "ready" }));
+}
+
+TEST_F(TaskTest, CancelSkipsTheStepsNotStarted) {
+	Engine::Task<int> decoded = Engine::Tasks::run(Engine::TaskThread::Main, [this]() { note("decode"); return 1; });
+	Engine::Task<int> uploaded = decoded.then(Engine::TaskThread::Render, [this](int& arg_value) { note("upload"); return arg_value; });
+	Engine::Task<void> done = uploaded.then(Engine::TaskThread::Main, [this](int&) { note("done"); });
+
+	runMain();
+	uploaded.cancel(); //!< Whichever handle, the whole chain stops
+	runRender();
+	runMain();
+
+	EXPECT_EQ(ran, std::vector<std::string>({ "decode" }));
+	EXPECT_TRUE(decoded.isReady()); //!< Finished before the cancel
+	EXPECT_TRUE(uploaded.isCancelled());
+	EXPECT_TRUE(done.isCancelled());
+	EXPECT_EQ(render.getPendingCount() + main.getPendingCount(), 0);
+
+	/**\ Steps added after the cancel are cancelled too, without being queued */
+	Engine::Task<int> late = uploaded.then(Engine::TaskThread::Main, [this](int& arg_value) { note("late"); return arg_value; });
+	EXPECT_TRUE(late.isCancelled());
+	EXPECT_EQ(main.getPendingCount(), 0);
+}
+
+TEST_F(TaskTest, WhenAllWaitsForEvery) {
+	std::vector<Engine::Task<int>> loads;
+	for (int i = 0; i < 3; i++) loads.push_back(Engine::Tasks::run(i == 1 ? Engine::TaskThread::Render : Engine::TaskThread::Main, [i]() { return i * i; }));
+	Engine::Task<std::vector<int>> all = Engine::Tasks::whenAll(loads);
+
+	runMain();
+	EXPECT_FALSE(all.isFinished());
+	runRender();
+	ASSERT_TRUE(all.isReady());
+	EXPECT_EQ(all.get(), std::vector<int>({ 0, 1, 4 })); //!< In the order given, not the order finished
+
+	Engine::Task<std::tuple<int, std::string>> pair = Engine::Tasks::whenAll(
+		Engine::Tasks::run(Engine::TaskThread::Main, []() { return 7; }),
+		Engine::Tasks::run(Engine::TaskThread::Render, []() { return std::string("mesh"); }));
+	runRender();
+	runMain();
+	ASSERT_TRUE(pair.isReady());
+	EXPECT_EQ(std::get<0>(pair.get()), 7);
+	EXPECT_EQ(std::get<1>(pair.get()), "mesh");
+
+	EXPECT_TRUE(Engine::Tasks::whenAll(std::vector<Engine::Task<int>>()).isReady());
+}
+
+TEST_F(TaskTest, WhenAllIsCancelledWithAnyInput) {
+	Engine::Task<int> first = Engine::Tasks::run(Engine::TaskThread::Main, []() { return 1; });
+	Engine::Task<int> second = Engine::Tasks::run(Engine::TaskThread::Main, []() { return 2; });
+	Engine::Task<void> done = Engine::Tasks::whenAll(std::vector<Engine::Task<int>>({ first, second }))
+		.then(Engine::TaskThread::Main, [this](std::vector<int>&) { note("done"); });
+
+	second.cancel();
+	runMain();
+	EXPECT_TRUE(first.isReady());
+	EXPECT_TRUE(second.isCancelled());
+	EXPECT_TRUE(done.isCancelled());
+	EXPECT_TRUE(ran.empty());
+}
+
+TEST_F(TaskTest, VoidTasks) {
+	std::vector<Engine::Task<void>> uploads;
+	for (int i = 0; i < 4; i++) uploads.push_back(Engine::Tasks::run(Engine::TaskThread::Render, [this, i]() { note("upload" + std::to_string(i)); }));
+	Engine::Task<int> count = Engine::Tasks::whenAll(uploads).then(Engine::TaskThread::Main, [this]() { return static_cast<int>(ran.size()); });
+
+	runRender();
+	runMain();
+	ASSERT_TRUE(count.isReady());
+	EXPECT_EQ(count.get(), 4);
+}
+
+TEST_F(TaskTest, UnqueuedStepsAreDroppedUnlessInline) {
+	Engine::Tasks::setQueues(nullptr, nullptr);
+	Engine::Task<int> dropped = Engine::Tasks::run(Engine::TaskThread::Render, []() { return 1; });
+	EXPECT_FALSE(dropped.isFinished());
+
+	Engine::Tasks::setInline(true);
+	Engine::Task<int> inlined = Engine::Tasks::run(Engine::TaskThread::Main, []() { return 1; })
+		.then(Engine::TaskThread::Render, [](int& arg_value) { return arg_value + 1; });
+	Engine::Tasks::setInline(false);
+	ASSERT_TRUE(inlined.isReady());
+	EXPECT_EQ(inlined.get(), 2);
+}
+
+TEST_F(TaskTest, ReadFileOnAWorker) {
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "engineTestsTask.bin";
+	std::ofstream(path, std::ios::binary) << "level";
+
+	Engine::jobSystem jobs{ 2 };
+	jobs.start();
+	Engine::Task<size_t> size = Engine::Tasks::readFile(path.string())
+		.then(Engine::TaskThread::Main, [](std::vector<unsigned char>& arg_file) { return arg_file.size(); });
+	Engine::Task<std::vector<unsigned char>> missing = Engine::Tasks::readFile((path.parent_path() / "engineTestsMissing.bin").string());
+
+	/**\ The main thread keeps running its frames while the read is on a worker */
+	for (int frame = 0; frame < 10000 && !(size.isFinished() && missing.isFinished()); frame++) {
+		runMain();
+		std::this_thread::yield();
+	}
+	jobs.stop();
+	std::filesystem::remove(path);
+
+	ASSERT_TRUE(size.isReady());
+	EXPECT_EQ(size.get(), 5);
+	EXPECT_TRUE(missing.isCancelled());
+}
+
+TEST_F(TaskTest, StatesComeFromThePool) {
+	uint32_t live = Engine::TaskPool::getLiveCount();
+	{
+		Engine::Task<int> task = Engine::Tasks::run(Engine::TaskThread::Main, []() { return 1; })
+			.then(Engine::TaskThread::Main, [](int& arg_value) { return arg_value + 1; });
+		EXPECT_EQ(Engine::TaskPool::getLiveCount(), live + 2);
+		EXPECT_GT(Engine::TaskPool::getCapacity(), 0);
+		runMain();
+		EXPECT_EQ(task.get(), 2);
+	}
+	EXPECT_EQ(Engine::TaskPool::getLiveCount(), live); //!< The first state went when its step ran, the second with the handle
+	if (live == 0) {
+		EXPECT_TRUE(Engine::TaskPool::trim());
+		EXPECT_EQ(Engine::TaskPool::getCapacity(), 0);
+	}
+}
@@ -0,0 +1,73 @@
+#include "timerTests.h"
+
+TEST_F(FakeClockTest, TimerUsesInjectedClock) {
+	Engine::timer::startFrameTimer();
+	now += 16000000;
+	EXPECT_NEAR(Engine::timer::getFrameTimeNanoseconds(), 16000000, 10000);
+	EXPECT_NEAR(Engine::timer::getFrameTime(), 0.016f, 1e-4f);
+}
+
+TEST_F(FakeClockTest, LimiterSleepsThenSpinsToDeadline) {
+	Engine::FrameLimiter limiter(10000, 2000, fakeSleep()); //!< 10 ms frames, spin for the last 2 ms
+	sleepOvershoot = 500000; //!< Sleeps wake half a millisecond late
+
+	EXPECT_EQ(limiter.wait(), 0); //!< The first frame only starts the schedule
+	uint64_t frameStart = now;
+	for (int frame = 0; frame < 5; frame++) {
+		now += 3000000; //!< 3 ms of work
+		limiter.wait();
+		EXPECT_LT(limiter.getLastOvershoot(), 2 * readCost); //!< The spin absorbed the late wake
+		EXPECT_NEAR(static_cast<double>(now - frameStart), 10000000.0 * (frame + 1), 5000.0); //!< No drift from frame to frame
+	}
+	ASSERT_EQ(sleeps.size(), 5);
+	EXPECT_NEAR(static_cast<double>(sleeps[0]), 5000000.0, 5000.0); //!< 10 ms - 3 ms work - 2 ms spin
+}
+
+TEST_F(FakeClockTest, LimiterResyncsAfterLongFrame) {
+	Engine::FrameLimiter limiter(10000, 1000, fakeSleep());
+	limiter.wait();
+	now += 50000000; //!< Five frames late
+	EXPECT_EQ(limiter.wait(), 0);
+	EXPECT_TRUE(sleeps.empty());
+
+	now += 1000000;
+	limiter.wait(); //!< Back on a normal schedule from the long frame
+	ASSERT_EQ(sleeps.size(), 1);
+	EXPECT_NEAR(static_cast<double>(sleeps[0]), 8000000.0, 5000.0);
+}
+
+TEST_F(FakeClockTest, LimiterOffDoesNothing) {
+	Engine::FrameLimiter limiter(0, 1000, fakeSleep());
+	EXPECT_FALSE(limiter.isEnabled());
+	EXPECT_EQ(limiter.wait(), 0);
+	EXPECT_EQ(limiter.wait(), 0);
+	limiter.setTargetRate(100.0);
+	EXPECT_EQ(limiter.getFrameTime(), 10000);
+}
+
+TEST(FrameStats, PercentilesAndHistogram) {
+	Engine::FrameStats stats(100, 1000, 20); //!< 1 ms buckets up to 20 ms
+	for (int i = 0; i < 98; i++) stats.addFrame(10000000); //!< 10 ms
+	stats.addFrame(30000000); //!< Two stutters, past the last bucket
+	stats.addFrame(40000000);
+
+	EXPECT_EQ(stats.getPercentile(50.f), 10000000);
+	EXPECT_EQ(stats.getPercentile(95.f), 10000000);
+	EXPECT_EQ(stats.getPercentile(99.f), 30000000);
+	EXPECT_EQ(stats.getPercentile(100.f), 40000000);
+	EXPECT_EQ(stats.getAverage(), 10500000);
+	EXPECT_EQ(stats.getHistogram()[10], 98);
+	EXPECT_EQ(stats.getHistogram()[19], 2);
+}
+
+TEST(FrameStats, WindowRollsOver) {
+	Engine::FrameStats stats(10, 1000, 50);
+	for (int i = 0; i < 10; i++) stats.addFrame(40000000);
+	for (int i = 0; i < 10; i++) stats.addFrame(20000000); //!< Pushes every 40 ms frame out
+
+	EXPECT_EQ(stats.getCount(), 10);
+	EXPECT_EQ(stats.getPercentile(99.f), 20000000);
+	EXPECT_FLOAT_EQ(stats.getFps(), 50.f);
+	EXPECT_EQ(stats.getHistogram()[40], 0);
+	EXPECT_EQ(stats.getHistogram()[20], 10);
+}
@@ -0,0 +1,111 @@
+#include "transformHierarchyTests.h"
+
+#include <cmath>
+
+TEST(TransformHierarchy, ChildWorldIsParentTimesLocal) {
+	Engine::TransformHierarchy hierarchy;
+	glm::quat turn = glm::angleAxis(glm::radians(90.f), glm::vec3(0.f, 1.f, 0.f));
+	auto parent = hierarchy.create(Engine::TransformHierarchy::s_null, glm::vec3(10.f, 0.f, 0.f), turn, glm::vec3(2.f));
+	auto child = hierarchy.create(parent, glm::vec3(1.f, 0.f, 0.f));
+	hierarchy.update();
+
+	/**\ One unit along the parent's x is two units along -z once turned and scaled */
+	glm::vec4 origin = hierarchy.getWorld(child) * glm::vec4(0.f, 0.f, 0.f, 1.f);
+	EXPECT_NEAR(origin.x, 10.f, 1e-4f);
+	EXPECT_NEAR(origin.y, 0.f, 1e-4f);
+	EXPECT_NEAR(origin.z, -2.f, 1e-4f);
+	EXPECT_TRUE(nearlyEqual(hierarchy.getWorld(child), hierarchy.getWorld(parent) * glm::translate(glm::mat4(1.f), glm::vec3(1.f, 0.f, 0.f))));
+}
+
+TEST(TransformHierarchy, OnlyDirtySubtreesUpdate) {
+	Engine::TransformHierarchy hierarchy;
+	auto a = hierarchy.create();
+	auto b = hierarchy.create();
+	auto aChild = hierarchy.create(a);
+	hierarchy.create(aChild);
+	hierarchy.create(b);
+	hierarchy.update();
+	EXPECT_EQ(hierarchy.getUpdatedCount(), 5);
+
+	hierarchy.update();
+	EXPECT_EQ(hierarchy.getUpdatedCount(), 0); //!< Nothing moved
+
+	hierarchy.setPosition(aChild, glm::vec3(0.f, 1.f, 0.f));
+	hierarchy.update();
+	EXPECT_EQ(hierarchy.getUpdatedCount(), 2); //!< aChild and its child, not a or b's side
+
+	hierarchy.setPosition(a, glm::vec3(1.f, 0.f, 0.f));
+	hierarchy.update();
+	EXPECT_EQ(hierarchy.getUpdatedCount(), 3);
+	EXPECT_NEAR(hierarchy.getWorld(aChild)[3].x, 1.f, 1e-5f);
+	EXPECT_NEAR(hierarchy.getWorld(aChild)[3].y, 1.f, 1e-5f);
+}
+
+TEST(TransformHierarchy, SetParentRejectsLoops) {
+	Engine::TransformHierarchy hierarchy;
+	auto a = hierarchy.create(Engine::TransformHierarchy::s_null, glm::vec3(5.f, 0.f, 0.f));
+	auto b = hierarchy.create(a);
+	auto c = hierarchy.create(b, glm::vec3(0.f, 0.f, 1.f));
+
+	EXPECT_FALSE(hierarchy.setParent(a, c));
+	EXPECT_FALSE(hierarchy.setParent(a, a));
+	EXPECT_EQ(hierarchy.getParent(a), Engine::TransformHierarchy::s_null);
+
+	EXPECT_TRUE(hierarchy.setParent(c, a)); //!< Local transform kept, now only under a
+	hierarchy.update();
+	EXPECT_EQ(hierarchy.getParent(c), a);
+	EXPECT_NEAR(hierarchy.getWorld(c)[3].x, 5.f, 1e-5f);
+	EXPECT_NEAR(hierarchy.getWorld(c)[3].z, 1.f, 1e-5f);
+}
+
+TEST(TransformHierarchy, DestroyRemovesSubtreeAndReusesHandles) {
+	Engine::TransformHierarchy hierarchy;
+	auto keep = hierarchy.create(Engine::TransformHierarchy::s_null, glm::vec3(3.f, 0.f, 0.f));
+	auto gone = hierarchy.create();
+	auto goneChild = hierarchy.create(gone);
+	hierarchy.create(goneChild);
+	hierarchy.update();
+
+	hierarchy.destroy(gone);
+	EXPECT_EQ(hierarchy.getCount(), 1);
+	auto reused = hierarchy.create(keep, glm::vec3(0.f, 2.f, 0.f));
+	EXPECT_NE(reused, keep);
+	EXPECT_LT(reused, 4u); //!< One of the freed handles, not a new one
+	hierarchy.update();
+	EXPECT_EQ(hierarchy.getCount(), 2);
+	EXPECT_NEAR(hierarchy.getWorld(reused)[3].x, 3.f, 1e-5f);
+	EXPECT_NEAR(hierarchy.getWorld(reused)[3].y, 2.f, 1e-5f);
+}
+
+TEST(TransformHierarchy, ParallelSplitMatchesSerial) {
+	Engine::jobSystem jobs(4);
+	jobs.start();
+	{
+		/**\ Same tree twice, one worked out in a single range and one split into many small ones */
+		Engine::TransformHierarchy serial(1u << 30);
+		Engine::TransformHierarchy parallel(8);
+		std::vector<Engine::TransformHierarchy::Node> serialNodes, parallelNodes;
+		for (uint32_t i = 0; i < 2000; i++) {
+			Engine::TransformHierarchy::Node serialParent = Engine::TransformHierarchy::s_null, parallelParent = Engine::TransformHierarchy::s_null;
+			if (i % 50) { //!< Mostly children of an earlier node, a few roots
+				uint32_t parent = (i * 7919u) % i;
+				serialParent = serialNodes[parent];
+				parallelParent = parallelNodes[parent];
+			}
+			glm::vec3 position(static_cast<float>(i % 3), 0.1f, static_cast<float>(i % 5) * 0.2f);
+			glm::quat rotation = glm::angleAxis(0.01f * static_cast<float>(i), glm::normalize(glm::vec3(1.f, 2.f, 3.f)));
+			serialNodes.push_back(serial.create(serialParent, position, rotation));
+			parallelNodes.push_back(parallel.create(parallelParent, position, rotation));
+		}
+
+		for (int frame = 0; frame < 3; frame++) {
+			serial.setRotation(serialNodes[frame * 10 + 1], glm::angleAxis(0.5f * frame, glm::vec3(0.f, 0.f, 1.f)));
+			parallel.setRotation(parallelNodes[frame * 10 + 1], glm::angleAxis(0.5f * frame, glm::vec3(0.f, 0.f, 1.f)));
+			serial.update();
+			parallel.update();
+			EXPECT_EQ(serial.getUpdatedCount(), parallel.getUpdatedCount());
+			for (uint32_t i = 0; i < 2000; i++) ASSERT_TRUE(nearlyEqual(serial.getWorld(serialNodes[i]), parallel.getWorld(parallelNodes[i])));
+		}
+	}
+	jobs.stop();
+}
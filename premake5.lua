@@ -7,6 +7,17 @@ workspace "Engine"
 		"Release"
 	}
 
+	newoption {
+		trigger = "tsan",
+		description = "Build with ThreadSanitizer (gcc/clang only), used for the job system stress tests"
+	}
+
+	filter "options:tsan"
+		buildoptions { "-fsanitize=thread", "-g" }
+		linkoptions { "-fsanitize=thread" }
+
+	filter {}
+
 outputdir = "%{cfg.buildcfg}-%{cfg.system}"
 
 group "Engine"
@@ -59,6 +70,9 @@ project "Engine"
 			"NG_PLATFORM_WINDOWS"
 		}
 
+	filter "system:linux"
+		cppdialect "C++17" -- Always headless, pass --frames N to stop after N frames
+
 	filter "configurations:Debug"
 		defines "NG_DEBUG"
 		runtime "Debug"
@@ -106,6 +120,10 @@ project "Sandbox"
 			"NG_PLATFORM_WINDOWS"
 		}
 
+	filter "system:linux"
+		cppdialect "C++17"
+		links { "pthread", "dl" }
+
 	filter "configurations:Debug"
 		defines "NG_DEBUG"
 		runtime "Debug"
@@ -148,8 +166,72 @@ project "Sandbox"
 		}
 
 		links { 
-			"googletest"
+			"googletest",
+			"Engine"
 		}
+
+		filter "system:windows"
+			cppdialect "C++17"
+
+			defines {
+				"NG_PLATFORM_WINDOWS"
+			}
+
+		filter "system:linux"
+			cppdialect "C++17"
+			links { "pthread", "dl" }
+		
+		filter "configurations:Debug"
+			runtime "Debug"
+			symbols "On"
+
+		filter "configurations:Release"
+			runtime "Release"
+			optimize "On"
+
+project "EngineBenchmarks"
+		location "engineBenchmarks"
+        kind "ConsoleApp"
+        language "C++"
+		staticruntime "off"
+		systemversion "latest"
+
+		targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+		objdir ("build/" .. outputdir .. "/%{prj.name}")
+
+		files { 
+			"%{prj.name}/include/*.h",
+			"%{prj.name}/src/*.cpp"
+		}
+
+		includedirs { 
+			"%{prj.name}/include/",
+			"engine/enginecode/",
+			"engine/enginecode/include/independent",
+			"engine/enginecode/include/platform",
+			"engine/precompiled/",
+			"vendor/spdlog/include",
+			"vendor/glfw/include",
+			"vendor/Glad/include",
+			"vendor/glm/",
+			"vendor/stb_image",
+			"vendor/freetype2/include"
+		}
+
+		links { 
+			"Engine"
+		}
+
+		filter "system:windows"
+			cppdialect "C++17"
+
+			defines {
+				"NG_PLATFORM_WINDOWS"
+			}
+
+		filter "system:linux"
+			cppdialect "C++17"
+			links { "pthread", "dl" }
 		
 		filter "configurations:Debug"
 			runtime "Debug"
@@ -11,11 +11,7 @@ out vec2 texCoord;
 
 uniform mat4 u_model;
 
-layout (std140) uniform b_camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-};
+#include "include/camera.glsl"
 
 void main()
 {
@@ -34,15 +30,15 @@ in vec3 normal;
 in vec3 fragmentPos;
 in vec2 texCoord;
 
-layout (std140) uniform b_lights
-{	
-	vec3 u_lightPos; 
-	vec3 u_viewPos; 
-	vec3 u_lightColour;
-	vec4 u_tint;
-};
+#include "include/lights.glsl"
 
+#ifdef USE_TEXTURE
 uniform sampler2D u_texData;
+#endif
+#ifdef USE_TINT
+uniform vec4 u_materialTint;
+#endif
+
 void main()
 {
 	float ambientStrength = 0.4;
@@ -57,5 +53,13 @@ void main()
 	float spec = pow(max(dot(viewDir, reflectDir), 0.0), 64);
 	vec3 specular = specularStrength * spec * u_lightColour;  
 	
-	colour = vec4((ambient + diffuse + specular), 1.0) * texture(u_texData, texCoord) * u_tint;
+	vec4 surface = vec4(55.0, 0.0, 155.0, 255.0) / 255.0; // Untextured colour
+#ifdef USE_TEXTURE
+	surface = texture(u_texData, texCoord);
+#endif
+#ifdef USE_TINT
+	surface *= u_materialTint;
+#endif
+	
+	colour = vec4((ambient + diffuse + specular), 1.0) * surface * u_tint;
 }
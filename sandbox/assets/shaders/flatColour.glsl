@@ -8,11 +8,7 @@ out vec3 fragmentColour;
 
 uniform mat4 u_model;
 
-layout (std140) uniform b_camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-};
+#include "include/camera.glsl"
 
 void main()
 {
@@ -0,0 +1,7 @@
+#pragma once
+
+layout (std140) uniform b_camera
+{
+	mat4 u_view;
+	mat4 u_projection;
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+layout (std140) uniform b_lights
+{	
+	vec3 u_lightPos; 
+	vec3 u_viewPos; 
+	vec3 u_lightColour;
+	vec4 u_tint;
+};